@@ -0,0 +1,119 @@
+#!/usr/bin/env python
+
+# LSST Data Management System
+# Copyright 2017 AURA/LSST.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <http://www.lsstcorp.org/LegalNotices/>.
+
+"""
+Converter of empty chunk lists to binary bitmap format used by czar.
+
+Script reads text empty chunk list (whitespace-separated chunk ids, as
+produced by data loader) and writes binary file understood by
+css::ChunkBitmap, e.g.:
+
+  qserv-empty-chunks-file.py /qserv/data/qserv/empty_LSST.txt /qserv/data/qserv/empty_LSST.bin
+
+Czar prefers empty_<database>.bin over empty_<database>.txt, and picks up
+new file contents without restart. Output is written to a temporary file
+and renamed so that czar never sees partially written file.
+
+@author  Qserv team
+
+"""
+
+# -------------------------------
+#  Imports of standard modules --
+# -------------------------------
+import argparse
+import array
+import logging
+import os
+import struct
+import sys
+
+# ---------------------------------
+# Local non-exported definitions --
+# ---------------------------------
+
+_MAGIC = b"QSVEMPT1"
+_HEADER = struct.Struct("<8sQQQ")
+
+_log = logging.getLogger('EmptyChunksFile')
+
+
+def _chunks(name):
+    """Generate chunk ids from text file"""
+    inp = sys.stdin if name == '-' else open(name)
+    try:
+        for line in inp:
+            for word in line.split():
+                yield int(word)
+    finally:
+        if inp is not sys.stdin:
+            inp.close()
+
+# -----------------------
+# Exported definitions --
+# -----------------------
+
+
+def writeBitmap(path, chunks):
+    """
+    Write bitmap file at specified path, returns number of chunks written.
+    Negative chunk ids are ignored.
+    """
+    chunks = sorted(set(c for c in chunks if c >= 0))
+    nBits = chunks[-1] + 1 if chunks else 0
+    words = array.array('Q', [0]) * ((nBits + 63) // 64)
+    for chunk in chunks:
+        words[chunk // 64] |= 1 << (chunk % 64)
+    if sys.byteorder != 'little':
+        words.byteswap()
+
+    tmpPath = path + '.tmp'
+    with open(tmpPath, 'wb') as out:
+        out.write(_HEADER.pack(_MAGIC, nBits, len(chunks), 0))
+        words.tofile(out)
+    os.rename(tmpPath, path)
+    return len(chunks)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert empty chunk list to binary bitmap file for czar.')
+    parser.add_argument('-v', '--verbose', dest='verbose', default=False, action='store_true',
+                        help='Print progress information.')
+    parser.add_argument('input', metavar='INPUT',
+                        help='Text file with empty chunk ids, use "-" for standard input.')
+    parser.add_argument('output', metavar='OUTPUT', help='Path of the bitmap file to create.')
+    args = parser.parse_args()
+
+    logging.basicConfig(level=logging.INFO if args.verbose else logging.WARNING,
+                        format='%(asctime)s [%(levelname)s] %(name)s: %(message)s')
+
+    count = writeBitmap(args.output, _chunks(args.input))
+    _log.info('wrote %d chunks to %s', count, args.output)
+    return 0
+
+
+if __name__ == "__main__":
+    try:
+        sys.exit(main())
+    except Exception as exc:
+        logging.critical('Exception occured: %s', exc)
+        sys.exit(1)
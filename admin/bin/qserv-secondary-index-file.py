@@ -0,0 +1,149 @@
+#!/usr/bin/env python
+
+# LSST Data Management System
+# Copyright 2017 AURA/LSST.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <http://www.lsstcorp.org/LegalNotices/>.
+
+"""
+Builder for memory-mapped secondary index files used by czar.
+
+Script reads tab-separated (key, chunkId, subChunkId) rows and writes
+them in the binary format understood by qproc::SecondaryIndexFile.
+Input is normally produced from the secondary index table filled by the
+data loader, e.g.:
+
+  mysql --batch --skip-column-names \\
+      -e "SELECT objectId, chunkId, subChunkId FROM qservMeta.LSST__Object ORDER BY objectId" \\
+      | qserv-secondary-index-file.py --sorted - /qserv/data/sindex/LSST__Object.sidx
+
+Resulting file has to be named <database>__<table>.sidx and placed in the
+directory given by tuning.secondaryIndexFileDir in czar configuration.
+Keys must be integers fitting into signed 64-bit range.
+
+@author  Qserv team
+
+"""
+
+# -------------------------------
+#  Imports of standard modules --
+# -------------------------------
+import argparse
+import array
+import logging
+import os
+import struct
+import sys
+
+# ---------------------------------
+# Local non-exported definitions --
+# ---------------------------------
+
+_MAGIC = b"QSVSIDX1"
+_HEADER = struct.Struct("=8sIIQQ")
+_RECORD = struct.Struct("=qii")
+
+_log = logging.getLogger('SecondaryIndexFile')
+
+
+def _rows(inputs):
+    """Generate (key, chunkId, subChunkId) tuples from all input files"""
+    for name in inputs:
+        inp = sys.stdin if name == '-' else open(name)
+        try:
+            for lineno, line in enumerate(inp, 1):
+                line = line.strip()
+                if not line:
+                    continue
+                cols = line.split('\t')
+                if len(cols) != 3:
+                    raise ValueError("{}:{}: expected 3 columns, found {}".format(name, lineno, len(cols)))
+                yield int(cols[0]), int(cols[1]), int(cols[2])
+        finally:
+            if inp is not sys.stdin:
+                inp.close()
+
+# -----------------------
+# Exported definitions --
+# -----------------------
+
+
+def writeIndex(path, rows, presorted):
+    """
+    Write index file at specified path, returns number of records written.
+
+    If presorted is True then rows are streamed directly to output and
+    exception is raised if they are not ordered by key, otherwise all rows
+    are collected in memory and sorted first.
+    """
+    if not presorted:
+        keys = array.array('q')
+        chunks = array.array('i')
+        subChunks = array.array('i')
+        for key, chunkId, subChunkId in rows:
+            keys.append(key)
+            chunks.append(chunkId)
+            subChunks.append(subChunkId)
+        _log.info('sorting %d records', len(keys))
+        order = sorted(range(len(keys)), key=keys.__getitem__)
+        rows = ((keys[i], chunks[i], subChunks[i]) for i in order)
+
+    tmpPath = path + '.tmp'
+    count = 0
+    with open(tmpPath, 'wb') as out:
+        out.write(_HEADER.pack(_MAGIC, _RECORD.size, 0, 0, 0))
+        lastKey = None
+        for key, chunkId, subChunkId in rows:
+            if lastKey is not None and key < lastKey:
+                raise ValueError("input is not sorted by key: {} follows {}".format(key, lastKey))
+            lastKey = key
+            out.write(_RECORD.pack(key, chunkId, subChunkId))
+            count += 1
+        out.seek(0)
+        out.write(_HEADER.pack(_MAGIC, _RECORD.size, 0, count, 0))
+    # czar may have the old file mapped, rename keeps that mapping valid
+    os.rename(tmpPath, path)
+    return count
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Build memory-mapped secondary index file for czar.')
+    parser.add_argument('-v', '--verbose', dest='verbose', default=False, action='store_true',
+                        help='Print progress information.')
+    parser.add_argument('-s', '--sorted', dest='presorted', default=False, action='store_true',
+                        help='Input is already sorted by key, stream it without sorting in memory.')
+    parser.add_argument('inputs', nargs='+', metavar='INPUT',
+                        help='Tab-separated input files with key, chunkId, subChunkId columns, '
+                        'use "-" for standard input.')
+    parser.add_argument('output', metavar='OUTPUT', help='Path of the index file to create.')
+    args = parser.parse_args()
+
+    logging.basicConfig(level=logging.INFO if args.verbose else logging.WARNING,
+                        format='%(asctime)s [%(levelname)s] %(name)s: %(message)s')
+
+    count = writeIndex(args.output, _rows(args.inputs), args.presorted)
+    _log.info('wrote %d records to %s', count, args.output)
+    return 0
+
+
+if __name__ == "__main__":
+    try:
+        sys.exit(main())
+    except Exception as exc:
+        logging.critical('Exception occured: %s', exc)
+        sys.exit(1)
@@ -141,9 +141,19 @@ bool MergingHandler::flush(int bLen, bool& last, bool& largeResult) {
             LOGS(_log, LOG_LVL_DEBUG, "Flushed msgContinues=" << msgContinues
                  << " last=" << last << " for tableName=" << _tableName);
 
+            int jobId = _response->result.jobid();
+            int attemptCount = _response->result.attemptcount();
             auto success = _merge();
             if (msgContinues) {
                 _response.reset(new WorkerResponse());
+            } else if (success) {
+                // The job attempt delivered all of its rows, they can be streamed.
+                if (!_infileMerger->publishJobAttempt(jobId, attemptCount)) {
+                    // A speculative duplicate of this job finished first, the
+                    // Executive scrubs the rows of this attempt.
+                    _setError(ccontrol::MSG_RESULT_ERROR, "Result superseded by another attempt");
+                    success = false;
+                }
             }
             return success;
         }
@@ -209,6 +219,11 @@ bool MergingHandler::scrubResults(int jobId, int attempt) {
     return _infileMerger->scrubResults(jobId, attempt);
 }
 
+
+std::shared_ptr<qdisp::ResponseHandler> MergingHandler::newDuplicateHandler() {
+    return std::make_shared<MergingHandler>(_msgReceiver, _infileMerger, _tableName);
+}
+
 std::ostream& MergingHandler::print(std::ostream& os) const {
     return os << "MergingRequester(" << _tableName << ", flushed="
               << (_flushed ? "true)" : "false)") ;
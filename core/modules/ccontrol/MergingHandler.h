@@ -146,6 +146,8 @@ public:
     /// Scrub the results from jobId-attempt from the result table.
     bool scrubResults(int jobId, int attempt) override;
 
+    std::shared_ptr<qdisp::ResponseHandler> newDuplicateHandler() override;
+
 private:
     void _initState();
     bool _merge();
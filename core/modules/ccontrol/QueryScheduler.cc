@@ -0,0 +1,204 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "ccontrol/QueryScheduler.h"
+
+// System headers
+#include <algorithm>
+#include <chrono>
+
+// LSST headers
+#include "lsst/log/Log.h"
+
+// Qserv headers
+#include "proto/ScanTableInfo.h"
+
+namespace {
+
+LOG_LOGGER _log = LOG_GET("lsst.qserv.ccontrol.QueryScheduler");
+
+// Waiting queries check whether they were cancelled this often.
+std::chrono::milliseconds const CANCEL_POLL_INTERVAL(1000);
+
+char const* className(lsst::qserv::ccontrol::QueryScheduler::QueryClass qClass) {
+    return qClass == lsst::qserv::ccontrol::QueryScheduler::SCAN ? "scan" : "interactive";
+}
+
+} // namespace
+
+namespace lsst {
+namespace qserv {
+namespace ccontrol {
+
+QueryScheduler::Ticket::~Ticket() {
+    _scheduler->_release(_user, _qClass);
+}
+
+int QueryScheduler::Ticket::getJobLimit() const {
+    return _scheduler->_getJobLimit(_user, _qClass);
+}
+
+int QueryScheduler::Ticket::getScanRating(int rating) const {
+    if (_demoted) {
+        return std::max(rating, int(proto::ScanInfo::Rating::SLOWEST));
+    }
+    return rating;
+}
+
+QueryScheduler::Ticket::Ptr
+QueryScheduler::admit(std::string const& user, QueryClass qClass,
+                      std::function<bool()> const& cancelled) {
+    std::unique_lock<std::mutex> lock(_mtx);
+    _users[user];
+    auto waiter = _waiters.insert(_waiters.end(), Waiter{user, qClass});
+    bool waited = false;
+    while (not _isNext(waiter)) {
+        if (not waited) {
+            waited = true;
+            LOGS(_log, LOG_LVL_INFO, "queueing " << className(qClass) << " query of user '"
+                 << user << "', " << _waiters.size() << " queries waiting");
+        }
+        _cv.wait_for(lock, CANCEL_POLL_INTERVAL);
+        if (cancelled && cancelled()) {
+            _waiters.erase(waiter);
+            _forget(user);
+            // The query may have been the one blocking the next waiter.
+            _cv.notify_all();
+            LOGS(_log, LOG_LVL_INFO, "query of user '" << user << "' cancelled while queued");
+            return nullptr;
+        }
+    }
+    _waiters.erase(waiter);
+
+    auto& userState = _users[user];
+    bool demoted = qClass == SCAN && _config.fastScansPerUser > 0
+                   && userState.executing[SCAN] >= _config.fastScansPerUser;
+    ++userState.executing[qClass];
+    ++_stats.executing[qClass];
+    userState.lastAdmitted = ++_stats.admitted;
+    if (waited) ++_stats.queued;
+    if (demoted) ++_stats.demoted;
+    LOGS(_log, LOG_LVL_DEBUG, "admitted " << className(qClass) << " query of user '" << user
+         << "'" << (demoted ? " at slowest scan rating" : "") << ", " << _stats.executing[INTERACTIVE]
+         << " interactive and " << _stats.executing[SCAN] << " scan queries executing");
+
+    // Limits may allow more waiters to start now that this one is gone.
+    if (not _waiters.empty()) _cv.notify_all();
+    return Ticket::Ptr(new Ticket(shared_from_this(), user, qClass, demoted));
+}
+
+QueryScheduler::Stats QueryScheduler::getStats() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    Stats stats = _stats;
+    stats.waiting = _waiters.size();
+    return stats;
+}
+
+bool QueryScheduler::_isNext(WaiterList::iterator waiter) const {
+    // The eligible waiter of the user with the fewest executing queries goes
+    // first, then the user served longest ago, then earlier arrivals.
+    auto next = _waiters.end();
+    User const* nextUser = nullptr;
+    for (auto iter = _waiters.begin(); iter != _waiters.end(); ++iter) {
+        if (not _canStart(iter->user, iter->qClass)) continue;
+        User const& u = _users.at(iter->user);
+        if (nextUser == nullptr || u.total() < nextUser->total()
+            || (u.total() == nextUser->total() && u.lastAdmitted < nextUser->lastAdmitted)) {
+            next = iter;
+            nextUser = &u;
+        }
+    }
+    return next == waiter;
+}
+
+bool QueryScheduler::_canStart(std::string const& user, QueryClass qClass) const {
+    int const classLimit = qClass == SCAN ? _config.maxScanQueries : _config.maxInteractiveQueries;
+    if (classLimit > 0 && _stats.executing[qClass] >= classLimit) return false;
+    if (_config.maxQueriesPerUser > 0 && _executing(user) >= _config.maxQueriesPerUser) return false;
+    return true;
+}
+
+int QueryScheduler::_executing(std::string const& user) const {
+    auto iter = _users.find(user);
+    return iter == _users.end() ? 0 : iter->second.total();
+}
+
+void QueryScheduler::_forget(std::string const& user) {
+    auto iter = _users.find(user);
+    if (iter == _users.end() || iter->second.total() > 0) return;
+    for (auto const& waiter : _waiters) {
+        if (waiter.user == user) return;
+    }
+    _users.erase(iter);
+}
+
+int QueryScheduler::_getJobLimit(std::string const& user, QueryClass qClass) const {
+    if (_config.maxOutstandingJobs <= 0) return 0;
+    auto weight = [this](QueryClass c) {
+        return double(std::max(1, c == SCAN ? _config.scanJobWeight : _config.interactiveJobWeight));
+    };
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    // Every user gets the mean weight of its queries, each query an equal
+    // part of its user's share.
+    double totalWeight = 0;
+    int userExecuting = 1;
+    for (auto const& entry : _users) {
+        User const& u = entry.second;
+        int const n = u.total();
+        if (n == 0) continue;
+        double const w = (u.executing[INTERACTIVE]*weight(INTERACTIVE)
+                          + u.executing[SCAN]*weight(SCAN)) / n;
+        totalWeight += w;
+        if (entry.first == user) userExecuting = n;
+    }
+    if (totalWeight <= 0) return _config.maxOutstandingJobs;
+    // The user's share, maxOutstandingJobs*w/totalWeight, split in proportion
+    // to the weights of its queries.
+    double const share = _config.maxOutstandingJobs * weight(qClass) / (totalWeight * userExecuting);
+    return std::max(1, int(share));
+}
+
+void QueryScheduler::_release(std::string const& user, QueryClass qClass) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto iter = _users.find(user);
+    if (iter != _users.end()) {
+        --iter->second.executing[qClass];
+        _forget(user);
+    }
+    --_stats.executing[qClass];
+    _cv.notify_all();
+}
+
+std::ostream& operator<<(std::ostream& os, QueryScheduler::Stats const& stats) {
+    os << "QueryScheduler(interactive=" << stats.executing[QueryScheduler::INTERACTIVE]
+       << " scan=" << stats.executing[QueryScheduler::SCAN]
+       << " waiting=" << stats.waiting
+       << " admitted=" << stats.admitted
+       << " queued=" << stats.queued
+       << " demoted=" << stats.demoted << ")";
+    return os;
+}
+
+}}} // namespace lsst::qserv::ccontrol
@@ -0,0 +1,194 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef LSST_QSERV_CCONTROL_QUERYSCHEDULER_H
+#define LSST_QSERV_CCONTROL_QUERYSCHEDULER_H
+/**
+  * @file
+  *
+  * @brief QueryScheduler limits the number of concurrently executing SELECT
+  * queries per user and per query class, and shares worker jobs between them.
+  *
+  */
+
+// System headers
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace lsst {
+namespace qserv {
+namespace ccontrol {
+
+/**
+ *  QueryScheduler is the czar admission control for SELECT queries. A query
+ *  calls admit() before dispatching its chunk jobs and holds the returned
+ *  Ticket until it is done. admit() blocks while the user of the query, or
+ *  the class of the query (interactive or scan), is at its concurrency limit.
+ *  Waiting queries are admitted fairly: the next one comes from the user with
+ *  the fewest executing queries, among those from the user whose latest query
+ *  was admitted longest ago. A user's own queries start in arrival order.
+ *
+ *  The number of outstanding worker jobs of all admitted queries can be
+ *  bounded as well. Every user gets a share of that budget proportional to
+ *  the mean class weight of its executing queries, which these queries split
+ *  in proportion to their class weights. A user running many full-sky scans thus gets the same number of
+ *  jobs as a user running a single scan.
+ *
+ *  Scan queries a user starts beyond a configured number of concurrent scans
+ *  are demoted to the slowest scan rating, which workers run on their "snail"
+ *  scheduler, so that they do not hold back the shared scans of other users.
+ *
+ *  Limits of 0 mean unlimited. All methods are thread-safe.
+ */
+class QueryScheduler : public std::enable_shared_from_this<QueryScheduler> {
+public:
+    typedef std::shared_ptr<QueryScheduler> Ptr;
+
+    enum QueryClass { INTERACTIVE = 0, SCAN = 1 };
+
+    struct Config {
+        int maxQueriesPerUser = 0;      ///< Executing queries per user
+        int maxInteractiveQueries = 0;  ///< Executing interactive queries
+        int maxScanQueries = 0;         ///< Executing scan queries
+        int maxOutstandingJobs = 0;     ///< Started, incomplete jobs of all queries
+        int interactiveJobWeight = 4;   ///< Job share weight of interactive queries
+        int scanJobWeight = 1;          ///< Job share weight of scan queries
+        int fastScansPerUser = 0;       ///< Scans per user keeping their scan rating
+    };
+
+    /// Admission of a query, the query stops counting against the limits
+    /// when its Ticket is destroyed.
+    class Ticket {
+    public:
+        typedef std::shared_ptr<Ticket> Ptr;
+
+        Ticket(Ticket const&) = delete;
+        Ticket& operator=(Ticket const&) = delete;
+
+        ~Ticket();
+
+        /// @return maximum number of started, incomplete jobs of the query
+        ///         at this moment, 0 if unlimited.
+        int getJobLimit() const;
+
+        /// @return scan rating to send to workers for chunk jobs of this
+        ///         query, 'rating' is the rating from query analysis.
+        int getScanRating(int rating) const;
+
+        bool isDemoted() const { return _demoted; }
+
+    private:
+        friend class QueryScheduler;
+        Ticket(std::shared_ptr<QueryScheduler> const& scheduler, std::string const& user,
+               QueryClass qClass, bool demoted)
+            : _scheduler(scheduler), _user(user), _qClass(qClass), _demoted(demoted) {}
+
+        std::shared_ptr<QueryScheduler> const _scheduler;
+        std::string const _user;
+        QueryClass const _qClass;
+        bool const _demoted;
+    };
+
+    /// Scheduler state, for monitoring.
+    struct Stats {
+        int executing[2] = {0, 0};  ///< Executing queries by QueryClass
+        int waiting = 0;            ///< Queries waiting for admission
+        std::uint64_t admitted = 0; ///< Queries admitted so far
+        std::uint64_t queued = 0;   ///< Admitted queries which had to wait
+        std::uint64_t demoted = 0;  ///< Scan queries demoted so far
+    };
+
+    static Ptr create(Config const& config) {
+        return Ptr(new QueryScheduler(config));
+    }
+
+    QueryScheduler(QueryScheduler const&) = delete;
+    QueryScheduler& operator=(QueryScheduler const&) = delete;
+
+    /**
+     *  Wait until a query may execute.
+     *
+     *  @param user:       User submitting the query, may be empty
+     *  @param qClass:     Class of the query
+     *  @param cancelled:  Polled while waiting, waiting ends when it returns true
+     *  @return admission of the query, null pointer if it was cancelled.
+     */
+    Ticket::Ptr admit(std::string const& user, QueryClass qClass,
+                      std::function<bool()> const& cancelled);
+
+    Stats getStats() const;
+
+    Config const& getConfig() const { return _config; }
+
+private:
+    explicit QueryScheduler(Config const& config) : _config(config) {}
+
+    struct User {
+        int executing[2] = {0, 0}; ///< Executing queries by QueryClass
+        std::uint64_t lastAdmitted = 0; ///< Admission number of the latest query
+        int total() const { return executing[INTERACTIVE] + executing[SCAN]; }
+    };
+
+    struct Waiter {
+        std::string user;
+        QueryClass qClass;
+    };
+    typedef std::list<Waiter> WaiterList;
+
+    /// @return true if the query of 'waiter' is next to execute. Must hold _mtx.
+    bool _isNext(WaiterList::iterator waiter) const;
+
+    /// @return true if limits allow a query to start. Must hold _mtx.
+    bool _canStart(std::string const& user, QueryClass qClass) const;
+
+    /// @return number of executing queries of user. Must hold _mtx.
+    int _executing(std::string const& user) const;
+
+    /// Drop state of user if it has no executing or waiting queries. Must hold _mtx.
+    void _forget(std::string const& user);
+
+    /// @return job share of a query of 'user' of class 'qClass'.
+    int _getJobLimit(std::string const& user, QueryClass qClass) const;
+
+    /// Called by ~Ticket.
+    void _release(std::string const& user, QueryClass qClass);
+
+    Config const _config;
+    std::map<std::string, User> _users; ///< Users with executing or waiting queries
+    WaiterList _waiters;                ///< Queries waiting for admission, in arrival order
+    Stats _stats;
+    std::condition_variable _cv;        ///< Signalled when a query finishes
+    mutable std::mutex _mtx;            ///< Protects all members above
+};
+
+std::ostream& operator<<(std::ostream& os, QueryScheduler::Stats const& stats);
+
+}}} // namespace lsst::qserv::ccontrol
+
+#endif // LSST_QSERV_CCONTROL_QUERYSCHEDULER_H
@@ -0,0 +1,439 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "ccontrol/ResultCache.h"
+
+// System headers
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+// LSST headers
+#include "lsst/log/Log.h"
+
+// Qserv headers
+#include "sql/SqlConnection.h"
+#include "sql/SqlErrorObject.h"
+#include "sql/SqlResults.h"
+
+namespace {
+
+LOG_LOGGER _log = LOG_GET("lsst.qserv.ccontrol.ResultCache");
+
+// Log hit rate every this many lookups.
+std::uint64_t const STATS_LOG_INTERVAL = 100;
+
+inline bool isSpace(char c) { return std::isspace(static_cast<unsigned char>(c)); }
+
+inline bool isIdentChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+/// @return true if the upper case identifier names a function or value
+/// that changes between executions.
+bool isVolatile(std::string const& word) {
+    static char const* const words[] = {
+        "CONNECTION_ID", "CURDATE", "CURRENT_DATE", "CURRENT_TIME",
+        "CURRENT_TIMESTAMP", "CURTIME", "LOCALTIME", "LOCALTIMESTAMP",
+        "NOW", "RAND", "SYSDATE", "UNIX_TIMESTAMP", "UTC_DATE", "UTC_TIME",
+        "UTC_TIMESTAMP", "UUID", "UUID_SHORT"
+    };
+    for (auto w : words) {
+        if (word == w) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+namespace lsst {
+namespace qserv {
+namespace ccontrol {
+
+ResultCache::ResultCache(mysql::MySqlConfig const& resultDbConfig,
+                         std::shared_ptr<sql::SqlConnection> const& resultDbConn,
+                         std::string const& tablePrefix,
+                         std::size_t maxEntries,
+                         std::uint64_t maxBytes,
+                         std::chrono::seconds lifetime)
+    : _resultDbConfig(resultDbConfig), _resultDbConn(resultDbConn), _tablePrefix(tablePrefix),
+      _maxEntries(maxEntries), _maxBytes(maxBytes), _lifetime(lifetime) {
+
+    if (_maxEntries == 0) {
+        return;
+    }
+    // drop tables cached by an earlier czar instance
+    std::lock_guard<std::mutex> lock(_sqlMtx);
+    sql::SqlErrorObject errObj;
+    std::vector<std::string> tables;
+    if (not _resultDbConn->listTables(tables, errObj, _tablePrefix)) {
+        LOGS(_log, LOG_LVL_WARN, "Failed to list cached result tables: " << errObj.printErrMsg());
+        return;
+    }
+    for (auto const& table : tables) {
+        LOGS(_log, LOG_LVL_DEBUG, "Dropping stale cached result table " << table);
+        if (not _resultDbConn->dropTable(table, errObj, false)) {
+            LOGS(_log, LOG_LVL_WARN, "Failed to drop " << table << ": " << errObj.printErrMsg());
+        }
+    }
+}
+
+
+bool ResultCache::normalize(std::string const& query, std::string& normalized) {
+    normalized.clear();
+    normalized.reserve(query.size());
+    bool pendingSpace = false;
+    std::size_t const size = query.size();
+    for (std::size_t pos = 0; pos < size; ) {
+        char const c = query[pos];
+        if (isSpace(c)) {
+            pendingSpace = true;
+            ++pos;
+            continue;
+        }
+        if (pendingSpace && not normalized.empty()) {
+            normalized += ' ';
+        }
+        pendingSpace = false;
+        if (c == '\'' || c == '"' || c == '`') {
+            // copy quoted text verbatim, honoring backslash escapes and doubled quotes
+            std::size_t end = pos + 1;
+            while (end < size) {
+                if (query[end] == '\\' && c != '`') {
+                    end += 2;
+                } else if (query[end] == c) {
+                    if (end + 1 < size && query[end + 1] == c) {
+                        end += 2;
+                    } else {
+                        break;
+                    }
+                } else {
+                    ++end;
+                }
+            }
+            end = std::min(end + 1, size);
+            normalized.append(query, pos, end - pos);
+            pos = end;
+        } else if (isIdentChar(c)) {
+            std::size_t end = pos;
+            while (end < size && isIdentChar(query[end])) ++end;
+            std::string word = query.substr(pos, end - pos);
+            std::string upper = word;
+            std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+            if (isVolatile(upper)) {
+                return false;
+            }
+            normalized += word;
+            pos = end;
+        } else {
+            normalized += c;
+            ++pos;
+        }
+    }
+    // strip trailing semicolons and the white space before them
+    while (not normalized.empty() && (normalized.back() == ';' || normalized.back() == ' ')) {
+        normalized.pop_back();
+    }
+    return not normalized.empty();
+}
+
+
+ResultCache::EntryPtr ResultCache::get(std::string const& key) {
+    EntryPtr entry;
+    if (_maxEntries == 0) {
+        return entry;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        auto iter = _map.find(key);
+        if (iter != _map.end()) {
+            if (Clock::now() - iter->second->created > _lifetime) {
+                _retire(iter->second);
+            } else {
+                // Move to the front of the LRU list, iterators stay valid.
+                _lru.splice(_lru.begin(), _lru, iter->second);
+                entry = iter->second->entry;
+            }
+        }
+        if (entry) {
+            ++_stats.hits;
+        } else {
+            ++_stats.misses;
+        }
+        if ((_stats.hits + _stats.misses) % STATS_LOG_INTERVAL == 0) {
+            Stats stats = _stats;
+            stats.entries = _map.size();
+            LOGS(_log, LOG_LVL_INFO, "Result cache " << stats);
+        }
+    }
+    if (not entry) {
+        _dropRetired();
+    }
+    return entry;
+}
+
+
+/// Empty cache table made like a result table. Both tables are locked on
+/// a connection of their own until the rows are copied.
+class ResultCache::PendingPut {
+public:
+    PendingPut(std::shared_ptr<sql::SqlConnection> const& conn_, std::string const& key_,
+               std::string const& resultTable_, std::string const& table_,
+               std::string const& orderBy_)
+        : conn(conn_), key(key_), resultTable(resultTable_), table(table_), orderBy(orderBy_) {}
+
+    PendingPut(PendingPut const&) = delete;
+    PendingPut& operator=(PendingPut const&) = delete;
+
+    ~PendingPut() { release(false); }
+
+    /// Unlock the tables, the cache table is dropped unless 'keep' is true.
+    void release(bool keep) {
+        if (released) {
+            return;
+        }
+        released = true;
+        sql::SqlErrorObject errObj;
+        if (not conn->runQuery("UNLOCK TABLES", errObj)) {
+            LOGS(_log, LOG_LVL_WARN, "Failed to unlock " << resultTable << ": "
+                 << errObj.printErrMsg());
+        }
+        if (not keep and not conn->dropTable(table, errObj, false)) {
+            LOGS(_log, LOG_LVL_WARN, "Failed to drop " << table << ": " << errObj.printErrMsg());
+        }
+    }
+
+    std::shared_ptr<sql::SqlConnection> const conn;
+    std::string const key;
+    std::string const resultTable;
+    std::string const table;
+    std::string const orderBy;
+    bool released{false};
+};
+
+
+std::shared_ptr<ResultCache::PendingPut> ResultCache::startPut(std::string const& key,
+                                                               std::string const& resultTable,
+                                                               std::string const& orderBy) {
+    if (_maxEntries == 0) {
+        return nullptr;
+    }
+    std::string table;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        if (_map.count(key) != 0) {
+            // cached by a concurrent execution of the same query
+            return nullptr;
+        }
+        table = _tablePrefix + std::to_string(++_tableCounter);
+    }
+    {
+        std::lock_guard<std::mutex> lock(_sqlMtx);
+        // do not copy results which cannot be kept anyway
+        std::uint64_t const bytes = _getTableSize(resultTable);
+        if (bytes > _maxBytes) {
+            LOGS(_log, LOG_LVL_DEBUG, "Result table " << resultTable << " too large to cache: "
+                 << bytes << " bytes");
+            return nullptr;
+        }
+    }
+
+    // LOCK TABLES only lets this session use the locked tables, so every
+    // pending copy needs its own connection. A session holding the locks
+    // needs no further metadata locks to copy, so it cannot get queued
+    // behind the DROP of the proxy.
+    auto conn = _newConnection();
+    sql::SqlErrorObject errObj;
+    if (not conn->runQuery("CREATE TABLE " + table + " LIKE " + resultTable, errObj)) {
+        LOGS(_log, LOG_LVL_WARN, "Failed to cache result table " << resultTable
+             << ": " << errObj.printErrMsg());
+        return nullptr;
+    }
+    auto pending = std::make_shared<PendingPut>(conn, key, resultTable, table, orderBy);
+    if (not conn->runQuery("LOCK TABLES " + resultTable + " READ, " + table + " WRITE", errObj)) {
+        LOGS(_log, LOG_LVL_WARN, "Failed to lock result table " << resultTable
+             << ": " << errObj.printErrMsg());
+        return nullptr;
+    }
+    return pending;
+}
+
+
+bool ResultCache::finishPut(std::shared_ptr<PendingPut> const& pending) {
+    sql::SqlErrorObject errObj;
+    std::string const sql = "INSERT INTO " + pending->table + " SELECT * FROM " + pending->resultTable;
+    if (not pending->conn->runQuery(sql, errObj)) {
+        LOGS(_log, LOG_LVL_WARN, "Failed to cache result table " << pending->resultTable
+             << ": " << errObj.printErrMsg());
+        pending->release(false);
+        return false;
+    }
+    pending->release(true);
+
+    std::uint64_t bytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(_sqlMtx);
+        bytes = _getTableSize(pending->table);
+        if (bytes > _maxBytes) {
+            LOGS(_log, LOG_LVL_DEBUG, "Result table " << pending->resultTable
+                 << " too large to cache: " << bytes << " bytes");
+            _resultDbConn->dropTable(pending->table, errObj, false);
+            return false;
+        }
+    }
+
+    auto entry = std::make_shared<Entry const>(Entry{pending->table, pending->orderBy, bytes});
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        if (_map.count(pending->key) != 0) {
+            _retired.push_back(entry);
+        } else {
+            _lru.push_front(Item{pending->key, entry, Clock::now()});
+            _map[pending->key] = _lru.begin();
+            ++_stats.insertions;
+            _stats.bytes += bytes;
+            while (not _lru.empty() && (_map.size() > _maxEntries || _stats.bytes > _maxBytes)) {
+                ++_stats.evictions;
+                _retire(std::prev(_lru.end()));
+            }
+        }
+    }
+    LOGS(_log, LOG_LVL_DEBUG, "Cached result table " << pending->resultTable
+         << " as " << pending->table);
+    _dropRetired();
+    return true;
+}
+
+
+bool ResultCache::put(std::string const& key, std::string const& resultTable,
+                      std::string const& orderBy) {
+    auto pending = startPut(key, resultTable, orderBy);
+    return pending and finishPut(pending);
+}
+
+
+bool ResultCache::copy(EntryPtr const& entry, std::string const& targetTable, std::string& error) {
+    std::lock_guard<std::mutex> lock(_sqlMtx);
+    sql::SqlErrorObject errObj;
+    std::string const sql = "CREATE TABLE " + targetTable + " ENGINE=MyISAM SELECT * FROM " + entry->table;
+    if (not _resultDbConn->runQuery(sql, errObj)) {
+        error = errObj.printErrMsg();
+        LOGS(_log, LOG_LVL_WARN, "Failed to copy cached result " << entry->table
+             << " to " << targetTable << ": " << error);
+        return false;
+    }
+    return true;
+}
+
+
+void ResultCache::clear() {
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        while (not _lru.empty()) {
+            _retire(_lru.begin());
+        }
+    }
+    _dropRetired();
+}
+
+
+ResultCache::Stats ResultCache::getStats() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    Stats stats = _stats;
+    stats.entries = _map.size();
+    return stats;
+}
+
+
+std::uint64_t ResultCache::_getTableSize(std::string const& table) {
+    sql::SqlErrorObject errObj;
+    sql::SqlResults results;
+    std::string const sql = "SELECT data_length + index_length FROM information_schema.TABLES"
+                            " WHERE table_schema = '" + _resultDbConn->getActiveDbName() +
+                            "' AND table_name = '" + table + "'";
+    std::string value;
+    if (_resultDbConn->runQuery(sql, results, errObj)
+        and results.extractFirstValue(value, errObj)) {
+        try {
+            return std::stoull(value);
+        } catch (std::exception const&) {
+            // fall through
+        }
+    }
+    LOGS(_log, LOG_LVL_WARN, "Failed to get size of " << table << ": " << errObj.printErrMsg());
+    // unknown size, do not cache
+    return _maxBytes + 1;
+}
+
+
+std::shared_ptr<sql::SqlConnection> ResultCache::_newConnection() {
+    return std::make_shared<sql::SqlConnection>(_resultDbConfig);
+}
+
+
+void ResultCache::_retire(ItemList::iterator iter) {
+    _stats.bytes -= iter->entry->bytes;
+    _retired.push_back(iter->entry);
+    _map.erase(iter->key);
+    _lru.erase(iter);
+}
+
+
+void ResultCache::_dropRetired() {
+    std::vector<std::string> tables;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        for (auto iter = _retired.begin(); iter != _retired.end(); ) {
+            if (iter->use_count() == 1) {
+                tables.push_back((*iter)->table);
+                iter = _retired.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+    if (tables.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_sqlMtx);
+    sql::SqlErrorObject errObj;
+    for (auto const& table : tables) {
+        LOGS(_log, LOG_LVL_DEBUG, "Dropping cached result table " << table);
+        if (not _resultDbConn->dropTable(table, errObj, false)) {
+            LOGS(_log, LOG_LVL_WARN, "Failed to drop " << table << ": " << errObj.printErrMsg());
+        }
+    }
+}
+
+
+std::ostream& operator<<(std::ostream& os, ResultCache::Stats const& stats) {
+    return os << "hits=" << stats.hits << " misses=" << stats.misses
+              << " hitRate=" << stats.hitRate() << " insertions=" << stats.insertions
+              << " evictions=" << stats.evictions << " entries=" << stats.entries
+              << " bytes=" << stats.bytes;
+}
+
+}}} // namespace lsst::qserv::ccontrol
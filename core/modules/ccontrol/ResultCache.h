@@ -0,0 +1,237 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef LSST_QSERV_CCONTROL_RESULTCACHE_H
+#define LSST_QSERV_CCONTROL_RESULTCACHE_H
+/**
+  * @file
+  *
+  * @brief ResultCache keeps result tables of SELECT queries so that
+  * identical queries can be answered without dispatching them again.
+  *
+  */
+
+// System headers
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+// Qserv headers
+#include "mysql/MySqlConfig.h"
+
+// Forward decl
+namespace lsst {
+namespace qserv {
+namespace sql {
+class SqlConnection;
+}}}
+
+namespace lsst {
+namespace qserv {
+namespace ccontrol {
+
+/**
+ *  ResultCache maps the normalized text of a SELECT, its default database
+ *  and the CSS generation it was analyzed against (see makeKey()) to a copy
+ *  of its result table in the results database. The copy is needed because
+ *  the proxy drops result tables once they have been returned to the client.
+ *
+ *  The number of entries and the total size of the cached tables are
+ *  bounded, the least recently used entries are evicted first. Entries
+ *  expire after a fixed lifetime, because data may change without CSS
+ *  changes (e.g. empty chunk lists or data loaded into existing chunks),
+ *  results may be that old. clear() drops everything, it is used when
+ *  tables or databases are dropped or chunk caches are flushed.
+ *
+ *  Queries copying a cached table hold its Entry, the table of an evicted
+ *  entry is only dropped once no query uses it any more.
+ *
+ *  A result is cached in two steps. startPut() locks the result table
+ *  before the client is told that it is ready, so that the proxy can read
+ *  it but cannot drop it. finishPut() copies the rows afterwards, so the
+ *  client does not wait for the copy.
+ *
+ *  All methods are thread-safe.
+ */
+class ResultCache {
+public:
+    typedef std::shared_ptr<ResultCache> Ptr;
+
+    /// A cached result.
+    struct Entry {
+        std::string table;   ///< Table holding the rows, in the results database
+        std::string orderBy; ///< ORDER BY clause for the proxy-side SELECT
+        std::uint64_t bytes; ///< Size of the table
+    };
+    typedef std::shared_ptr<Entry const> EntryPtr;
+
+    /// Lookup statistics.
+    struct Stats {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t insertions = 0;
+        std::uint64_t evictions = 0;
+        std::size_t entries = 0;
+        std::uint64_t bytes = 0;
+
+        /// @return fraction of lookups which found an entry.
+        double hitRate() const {
+            return hits + misses == 0 ? 0. : double(hits) / (hits + misses);
+        }
+    };
+
+    /// Result table being copied into the cache, see startPut().
+    class PendingPut;
+
+    /**
+     *  Make a cache. Tables left over from an earlier instance using the
+     *  same prefix are dropped.
+     *
+     *  @param resultDbConfig:  Results database, for the connections used by startPut()
+     *  @param resultDbConn:  Connection to results database, used by the cache only
+     *  @param tablePrefix:   Prefix of the names of the tables made by the cache
+     *  @param maxEntries:    Maximum number of cached results, 0 disables caching
+     *  @param maxBytes:      Maximum total size of the cached tables
+     *  @param lifetime:      Time after which an entry is discarded
+     */
+    ResultCache(mysql::MySqlConfig const& resultDbConfig,
+                std::shared_ptr<sql::SqlConnection> const& resultDbConn,
+                std::string const& tablePrefix,
+                std::size_t maxEntries,
+                std::uint64_t maxBytes,
+                std::chrono::seconds lifetime);
+
+    ResultCache(ResultCache const&) = delete;
+    ResultCache& operator=(ResultCache const&) = delete;
+
+    virtual ~ResultCache() {}
+
+    /**
+     *  Normalize query text: runs of white space outside of quotes are
+     *  collapsed into a single space, leading and trailing white space and
+     *  semicolons are removed.
+     *
+     *  @return false if the result of the query may differ between identical
+     *          executions, e.g. because it calls RAND() or NOW().
+     */
+    static bool normalize(std::string const& query, std::string& normalized);
+
+    /// @return cache key for a normalized query executed with 'defaultDb'
+    ///         against CSS contents identified by 'cssGeneration'.
+    static std::string makeKey(std::string const& cssGeneration,
+                               std::string const& defaultDb, std::string const& normalized) {
+        return cssGeneration + '\n' + defaultDb + '\n' + normalized;
+    }
+
+    /// @return entry for key, null pointer if it is not cached.
+    EntryPtr get(std::string const& key);
+
+    /**
+     *  Start copying a result table into the cache. An empty cache table
+     *  like the result table is made, and both are locked on a connection
+     *  of their own: the result table can still be read, but dropping it
+     *  waits until finishPut() is done or the PendingPut is destroyed.
+     *  Tables larger than the total size limit are not copied.
+     *
+     *  @param key:          Cache key, see makeKey()
+     *  @param resultTable:  Result table of the query, complete
+     *  @param orderBy:      ORDER BY clause for the proxy-side SELECT
+     *  @return null if the result is not cached, e.g. because it is too large.
+     */
+    std::shared_ptr<PendingPut> startPut(std::string const& key, std::string const& resultTable,
+                                         std::string const& orderBy);
+
+    /**
+     *  Copy the rows of a result table started by startPut(), add the entry
+     *  and release the locks.
+     *
+     *  @return false if the result was not cached.
+     */
+    bool finishPut(std::shared_ptr<PendingPut> const& pending);
+
+    /// startPut() and finishPut() in one call.
+    /// @return false if the result was not cached.
+    bool put(std::string const& key, std::string const& resultTable, std::string const& orderBy);
+
+    /**
+     *  Copy a cached result into a new table.
+     *
+     *  @param entry:        Entry returned by get()
+     *  @param targetTable:  Name of the table to make
+     *  @param error:        Receives error message on failure
+     *  @return false on failure.
+     */
+    bool copy(EntryPtr const& entry, std::string const& targetTable, std::string& error);
+
+    /// Remove all entries.
+    void clear();
+
+    Stats getStats() const;
+
+protected:
+    /// @return size of table in bytes, called with _sqlMtx locked.
+    virtual std::uint64_t _getTableSize(std::string const& table);
+
+    /// @return new connection to the results database, for startPut().
+    virtual std::shared_ptr<sql::SqlConnection> _newConnection();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+    struct Item {
+        std::string key;
+        EntryPtr entry;
+        Clock::time_point created;
+    };
+    typedef std::list<Item> ItemList;
+
+    /// Move an item to the list of tables to drop. Must hold _mtx.
+    void _retire(ItemList::iterator iter);
+
+    /// Drop tables of retired entries that are not used any more.
+    void _dropRetired();
+
+    mysql::MySqlConfig const _resultDbConfig;
+    std::shared_ptr<sql::SqlConnection> const _resultDbConn;
+    std::mutex _sqlMtx; ///< Protects _resultDbConn
+    std::string const _tablePrefix;
+    std::size_t const _maxEntries;
+    std::uint64_t const _maxBytes;
+    Clock::duration const _lifetime;
+
+    ItemList _lru; ///< Most recently used first.
+    std::unordered_map<std::string, ItemList::iterator> _map;
+    std::list<EntryPtr> _retired; ///< Evicted entries whose tables were not dropped yet.
+    std::uint64_t _tableCounter{0};
+    Stats _stats;
+    mutable std::mutex _mtx; ///< Protects all members above.
+};
+
+std::ostream& operator<<(std::ostream& os, ResultCache::Stats const& stats);
+
+}}} // namespace lsst::qserv::ccontrol
+
+#endif // LSST_QSERV_CCONTROL_RESULTCACHE_H
@@ -32,6 +32,7 @@
   */
 
 // System headers
+#include <cstddef>
 #include <memory>
 
 // Third-party headers
@@ -39,6 +40,7 @@
 // Qserv headers
 #include "ccontrol/QueryState.h"
 #include "global/intTypes.h"
+#include "rproc/ResultPublisher.h"
 
 // Forward decl
 namespace lsst {
@@ -105,6 +107,16 @@ public:
 
     /// @return True if query is async query
     virtual bool isAsync() const { return false; }
+
+    /// @return result rows published since cursor, before the query completes.
+    /// Queries that do not stream their results return a truncated segment,
+    /// their result has to be read as a whole once the query is done.
+    virtual rproc::ResultPublisher::Segment getResultSegment(std::size_t cursor) {
+        rproc::ResultPublisher::Segment segment;
+        segment.complete = true;
+        segment.truncated = true;
+        return segment;
+    }
 };
 
 }}} // namespace lsst::qserv:ccontrol
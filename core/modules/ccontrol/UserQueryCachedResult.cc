@@ -0,0 +1,86 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "ccontrol/UserQueryCachedResult.h"
+
+// System headers
+
+// LSST headers
+#include "lsst/log/Log.h"
+
+// Qserv headers
+#include "qdisp/MessageStore.h"
+
+namespace {
+LOG_LOGGER _log = LOG_GET("lsst.qserv.ccontrol.UserQueryCachedResult");
+}
+
+namespace lsst {
+namespace qserv {
+namespace ccontrol {
+
+// Constructor
+UserQueryCachedResult::UserQueryCachedResult(std::shared_ptr<ResultCache> const& resultCache,
+                                             ResultCache::EntryPtr const& entry,
+                                             std::string const& resultTable)
+    : _resultCache(resultCache), _entry(entry), _resultTable(resultTable),
+      _orderBy(entry->orderBy), _qState(UNKNOWN),
+      _messageStore(std::make_shared<qdisp::MessageStore>()) {
+}
+
+std::string UserQueryCachedResult::getError() const {
+    return std::string();
+}
+
+// Attempt to kill in progress.
+void UserQueryCachedResult::kill() {
+}
+
+// Submit or execute the query.
+void UserQueryCachedResult::submit() {
+    LOGS(_log, LOG_LVL_DEBUG, "Copying cached result " << _entry->table << " to " << _resultTable);
+    std::string error;
+    if (_resultCache->copy(_entry, _resultTable, error)) {
+        _qState = SUCCESS;
+    } else {
+        std::string message = "Failed to read cached result: " + error;
+        _messageStore->addMessage(-1, 1146, message, MessageSeverity::MSG_ERROR);
+        _qState = ERROR;
+    }
+    // cached table may be dropped now
+    _entry.reset();
+}
+
+// Block until a submit()'ed query completes.
+QueryState UserQueryCachedResult::join() {
+    // everything should be done in submit()
+    return _qState;
+}
+
+// Release resources.
+void UserQueryCachedResult::discard() {
+    _entry.reset();
+}
+
+}}} // lsst::qserv::ccontrol
@@ -0,0 +1,107 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef LSST_QSERV_CCONTROL_USERQUERYCACHEDRESULT_H
+#define LSST_QSERV_CCONTROL_USERQUERYCACHEDRESULT_H
+
+// System headers
+#include <memory>
+#include <string>
+
+// Third-party headers
+
+// Qserv headers
+#include "ccontrol/ResultCache.h"
+#include "ccontrol/UserQuery.h"
+
+namespace lsst {
+namespace qserv {
+namespace ccontrol {
+
+/// @addtogroup ccontrol
+
+/**
+ *  @ingroup ccontrol
+ *
+ *  @brief Implementation of UserQuery for SELECTs answered from ResultCache.
+ *
+ *  The cached result is copied into a new result table, which the proxy
+ *  returns and drops like the result table of a dispatched query.
+ */
+
+class UserQueryCachedResult : public UserQuery {
+public:
+
+    /**
+     *  @param resultCache:  Cache holding the result
+     *  @param entry:        Cached result, from ResultCache::get()
+     *  @param resultTable:  Name of the result table to make
+     */
+    UserQueryCachedResult(std::shared_ptr<ResultCache> const& resultCache,
+                          ResultCache::EntryPtr const& entry,
+                          std::string const& resultTable);
+
+    UserQueryCachedResult(UserQueryCachedResult const&) = delete;
+    UserQueryCachedResult& operator=(UserQueryCachedResult const&) = delete;
+
+    // Accessors
+
+    /// @return a non-empty string describing the current error state
+    /// Returns an empty string if no errors have been detected.
+    virtual std::string getError() const override;
+
+    /// Begin execution of the query over all ChunkSpecs added so far.
+    virtual void submit() override;
+
+    /// Wait until the query has completed execution.
+    /// @return the final execution state.
+    virtual QueryState join() override;
+
+    /// Stop a query in progress (for immediate shutdowns)
+    virtual void kill() override;
+
+    /// Release resources related to user query
+    virtual void discard() override;
+
+    // Delegate objects
+    virtual std::shared_ptr<qdisp::MessageStore> getMessageStore() override {
+        return _messageStore; }
+
+    /// @return Name of the result table for this query
+    virtual std::string getResultTableName() const override { return _resultTable; }
+
+    /// @return ORDER BY part of SELECT statement to be executed by proxy
+    virtual std::string getProxyOrderBy() const override { return _orderBy; }
+
+private:
+
+    std::shared_ptr<ResultCache> const _resultCache;
+    ResultCache::EntryPtr _entry;
+    std::string const _resultTable;
+    std::string const _orderBy;
+    QueryState _qState;
+    std::shared_ptr<qdisp::MessageStore> _messageStore;
+};
+
+}}} // namespace lsst::qserv::ccontrol
+
+#endif // LSST_QSERV_CCONTROL_USERQUERYCACHEDRESULT_H
@@ -25,7 +25,10 @@
 #include "ccontrol/UserQueryFactory.h"
 
 // System headers
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <string>
 
@@ -37,7 +40,10 @@
 // Qserv headers
 #include "ccontrol/ConfigError.h"
 #include "ccontrol/ConfigMap.h"
+#include "ccontrol/QueryScheduler.h"
+#include "ccontrol/ResultCache.h"
 #include "ccontrol/UserQueryAsyncResult.h"
+#include "ccontrol/UserQueryCachedResult.h"
 #include "ccontrol/UserQueryDrop.h"
 #include "ccontrol/UserQueryFlushChunksCache.h"
 #include "ccontrol/UserQueryInvalid.h"
@@ -45,17 +51,23 @@
 #include "ccontrol/UserQuerySelect.h"
 #include "ccontrol/UserQueryType.h"
 #include "css/CssAccess.h"
+#include "css/CssError.h"
 #include "css/KvInterfaceImplMem.h"
 #include "czar/CzarConfig.h"
 #include "mysql/MySqlConfig.h"
+#include "mysql/MySqlConnectionPool.h"
 #include "parser/ParseException.h"
 #include "parser/SelectParser.h"
 #include "qdisp/Executive.h"
 #include "qdisp/MessageStore.h"
 #include "qmeta/QMetaMysql.h"
 #include "qmeta/QMetaSelect.h"
+#include "qmeta/QMetaWriteBehind.h"
+#include "qproc/ChunkCoverageCache.h"
+#include "qproc/QueryPlanCache.h"
 #include "qproc/QuerySession.h"
 #include "qproc/SecondaryIndex.h"
+#include "query/Arena.h"
 #include "query/FromList.h"
 #include "query/SelectStmt.h"
 #include "rproc/InfileMerger.h"
@@ -76,15 +88,30 @@ public:
 
     Impl(czar::CzarConfig const& czarConfig);
 
+    /// Make a session for a SELECT from the cached analysis of its shape.
+    /// @return null pointer if the query has to be parsed and analyzed.
+    std::shared_ptr<qproc::QuerySession> cachedSession(std::string const& query,
+                                                       std::string const& defaultDb);
+
+    /// @return result cache key for a SELECT, empty if its result can not be cached.
+    std::string resultCacheKey(std::string const& query, std::string const& defaultDb);
+
     /// State shared between UserQueries
     qdisp::Executive::Config::Ptr executiveConfig;
     std::shared_ptr<css::CssAccess> css;
     mysql::MySqlConfig const mysqlResultConfig;
+    mysql::MySqlConnectionPool::Ptr connectionPool; ///< null if disabled
     std::shared_ptr<qproc::SecondaryIndex> secondaryIndex;
+    std::shared_ptr<qproc::ChunkCoverageCache> coverageCache;
     std::shared_ptr<qmeta::QMeta> queryMetadata;
     std::shared_ptr<qmeta::QMetaSelect> qMetaSelect;
     std::unique_ptr<sql::SqlConnection> resultDbConn;
+    std::unique_ptr<qproc::QueryPlanCache> planCache;   ///< null if disabled
+    std::shared_ptr<ResultCache> resultCache;   ///< null if disabled
+    std::shared_ptr<QueryScheduler> queryScheduler; ///< null if disabled
     qmeta::CzarId qMetaCzarId = {0};   ///< Czar ID in QMeta database
+    std::chrono::milliseconds resultStreamDrainTimeout{0};
+    std::size_t queryArenaBlockSize{0}; ///< 0 if IR nodes are allocated individually
 };
 
 ////////////////////////////////////////////////////////////////////////
@@ -97,6 +124,16 @@ UserQueryFactory::UserQueryFactory(czar::CzarConfig const& czarConfig,
     // register czar in QMeta
     // TODO: check that czar with the same name is not active already?
     _impl->qMetaCzarId = _impl->queryMetadata->registerCzar(czarName);
+
+    if (czarConfig.getResultCacheSize() > 0) {
+        // table names include czar ID so that a restarted czar can remove its leftovers
+        auto conn = std::make_shared<sql::SqlConnection>(_impl->mysqlResultConfig);
+        _impl->resultCache = std::make_shared<ResultCache>(_impl->mysqlResultConfig, conn,
+                "qcache_" + std::to_string(_impl->qMetaCzarId) + "_",
+                czarConfig.getResultCacheSize(),
+                std::uint64_t(std::max(0, czarConfig.getResultCacheSizeMB())) << 20,
+                std::chrono::seconds(std::max(0, czarConfig.getResultCacheLifetime())));
+    }
 }
 
 UserQuery::Ptr
@@ -104,7 +141,8 @@ UserQueryFactory::newUserQuery(std::string const& aQuery,
                                std::string const& defaultDb,
                                qdisp::LargeResultMgr::Ptr const& largeResultMgr,
                                std::string const& userQueryId,
-                               std::string const& msgTableName) {
+                               std::string const& msgTableName,
+                               std::string const& user) {
 
     // result location could potentially be specified by SUBMIT command, for now
     // we keep it empty which means that UserQuerySelect uses default result table.
@@ -133,53 +171,81 @@ UserQueryFactory::newUserQuery(std::string const& aQuery,
         bool sessionValid = true;
         std::string errorExtra;
 
-        // Parse SELECT
-        std::shared_ptr<query::SelectStmt> stmt;
-        try {
-            auto parser = parser::SelectParser::newInstance(query);
-            parser->setup();
-            stmt = parser->getSelectStmt();
-        } catch(parser::ParseException const& e) {
-            return std::make_shared<UserQueryInvalid>(std::string("ParseException:") + e.what());
+        // Identical queries are answered from the result of an earlier one.
+        std::string resultCacheKey;
+        if (_impl->resultCache && not async) {
+            resultCacheKey = _impl->resultCacheKey(query, defaultDb);
+            auto entry = resultCacheKey.empty() ? nullptr : _impl->resultCache->get(resultCacheKey);
+            if (entry) {
+                LOGS(_log, LOG_LVL_DEBUG, "make UserQueryCachedResult from " << entry->table);
+                return std::make_shared<UserQueryCachedResult>(_impl->resultCache, entry,
+                                                               "result_cached_" + userQueryId);
+            }
         }
 
-        // handle special database/table names
-        auto&& tblRefList = stmt->getFromList().getTableRefList();
-        if (tblRefList.size() == 1) {
-            auto&& tblRef = tblRefList[0];
-            std::string const db = tblRef->getDb().empty() ? defaultDb : tblRef->getDb();
-            if (UserQueryType::isProcessListTable(db, tblRef->getTable())) {
-                if (async) {
-                    // no point supporting async for these
-                    auto uq = std::make_shared<UserQueryInvalid>("SUBMIT is not allowed with query: " + aQuery);
-                    return uq;
-                }
-                LOGS(_log, LOG_LVL_DEBUG, "SELECT query is a PROCESSLIST");
-                try {
-                    return std::make_shared<UserQueryProcessList>(stmt, _impl->resultDbConn.get(),
-                            _impl->qMetaSelect, _impl->qMetaCzarId, userQueryId);
-                } catch(std::exception const& exc) {
-                    return std::make_shared<UserQueryInvalid>(exc.what());
+        // Queries differing only in WHERE literals from an earlier one skip
+        // parsing and analysis.
+        auto qs = _impl->cachedSession(query, defaultDb);
+        if (not qs) {
+            // IR nodes made by parsing and analysis go to one arena per query.
+            query::Arena::Ptr arena;
+            if (_impl->queryArenaBlockSize > 0) {
+                arena = std::make_shared<query::Arena>(_impl->queryArenaBlockSize);
+            }
+            query::Arena::Scope arenaScope(arena);
+
+            // Parse SELECT
+            std::shared_ptr<query::SelectStmt> stmt;
+            try {
+                auto parser = parser::SelectParser::newInstance(query);
+                parser->setup();
+                stmt = parser->getSelectStmt();
+            } catch(parser::ParseException const& e) {
+                return std::make_shared<UserQueryInvalid>(std::string("ParseException:") + e.what());
+            }
+
+            // handle special database/table names
+            auto&& tblRefList = stmt->getFromList().getTableRefList();
+            if (tblRefList.size() == 1) {
+                auto&& tblRef = tblRefList[0];
+                std::string const db = tblRef->getDb().empty() ? defaultDb : tblRef->getDb();
+                if (UserQueryType::isProcessListTable(db, tblRef->getTable())) {
+                    if (async) {
+                        // no point supporting async for these
+                        auto uq = std::make_shared<UserQueryInvalid>("SUBMIT is not allowed with query: " + aQuery);
+                        return uq;
+                    }
+                    LOGS(_log, LOG_LVL_DEBUG, "SELECT query is a PROCESSLIST");
+                    try {
+                        return std::make_shared<UserQueryProcessList>(stmt, _impl->resultDbConn.get(),
+                                _impl->qMetaSelect, _impl->qMetaCzarId, userQueryId);
+                    } catch(std::exception const& exc) {
+                        return std::make_shared<UserQueryInvalid>(exc.what());
+                    }
                 }
             }
-        }
 
-        // This is a regular SELECT for qserv
+            // This is a regular SELECT for qserv
 
-        // Currently using the database for results to get schema information.
-        auto qs = std::make_shared<qproc::QuerySession>(_impl->css,
-                                                        _impl->mysqlResultConfig,
-                                                        defaultDb);
-        try {
-            qs->analyzeQuery(query, stmt);
-        } catch (...) {
-            errorExtra = "Unknown failure occurred setting up QuerySession (query is invalid).";
-            LOGS(_log, LOG_LVL_ERROR, errorExtra);
-            sessionValid = false;
-        }
-        if (!qs->getError().empty()) {
-            LOGS(_log, LOG_LVL_ERROR, "Invalid query: " << qs->getError());
-            sessionValid = false;
+            // Currently using the database for results to get schema information.
+            qs = std::make_shared<qproc::QuerySession>(_impl->css,
+                                                       _impl->mysqlResultConfig,
+                                                       defaultDb);
+            try {
+                qs->analyzeQuery(query, stmt);
+            } catch (...) {
+                errorExtra = "Unknown failure occurred setting up QuerySession (query is invalid).";
+                LOGS(_log, LOG_LVL_ERROR, errorExtra);
+                sessionValid = false;
+            }
+            if (!qs->getError().empty()) {
+                LOGS(_log, LOG_LVL_ERROR, "Invalid query: " << qs->getError());
+                sessionValid = false;
+            }
+            if (arena) {
+                LOGS(_log, LOG_LVL_DEBUG, "IR arena: " << arena->getAllocations()
+                     << " allocations, " << arena->getBytes() << " bytes");
+            }
         }
 
         auto messageStore = std::make_shared<qdisp::MessageStore>();
@@ -189,14 +255,23 @@ UserQueryFactory::newUserQuery(std::string const& aQuery,
             executive = qdisp::Executive::newExecutive(_impl->executiveConfig, messageStore,
                                                        largeResultMgr);
             infileMergerConfig = std::make_shared<rproc::InfileMergerConfig>(_impl->mysqlResultConfig);
+            infileMergerConfig->streamDrainTimeout = _impl->resultStreamDrainTimeout;
+            infileMergerConfig->connectionPool = _impl->connectionPool;
         }
         auto uq = std::make_shared<UserQuerySelect>(qs, messageStore, executive, infileMergerConfig,
-                                                    _impl->secondaryIndex, _impl->queryMetadata,
+                                                    _impl->secondaryIndex, _impl->coverageCache,
+                                                    _impl->queryMetadata,
                                                     _impl->qMetaCzarId, largeResultMgr,
                                                     errorExtra, async);
         if (sessionValid) {
             uq->qMetaRegister(resultLocation, msgTableName);
             uq->setupChunking();
+            if (not resultCacheKey.empty()) {
+                uq->setResultCache(_impl->resultCache, resultCacheKey);
+            }
+            if (_impl->queryScheduler) {
+                uq->setQueryScheduler(_impl->queryScheduler, user);
+            }
         }
         return uq;
     } else if (UserQueryType::isSelectResult(query, userJobId)) {
@@ -210,6 +285,9 @@ UserQueryFactory::newUserQuery(std::string const& aQuery,
         if (dbName.empty()) {
             dbName = defaultDb;
         }
+        if (_impl->planCache) _impl->planCache->clear();
+        if (_impl->resultCache) _impl->resultCache->clear();
+        if (_impl->secondaryIndex) _impl->secondaryIndex->clear();
         auto uq = std::make_shared<UserQueryDrop>(_impl->css, dbName, tableName,
                                                   _impl->resultDbConn.get(),
                                                   _impl->queryMetadata, _impl->qMetaCzarId);
@@ -217,12 +295,18 @@ UserQueryFactory::newUserQuery(std::string const& aQuery,
         return uq;
     } else if (UserQueryType::isDropDb(query, dbName)) {
         // processing DROP DATABASE
+        if (_impl->planCache) _impl->planCache->clear();
+        if (_impl->resultCache) _impl->resultCache->clear();
+        if (_impl->secondaryIndex) _impl->secondaryIndex->clear();
         auto uq = std::make_shared<UserQueryDrop>(_impl->css, dbName, std::string(),
                                                   _impl->resultDbConn.get(),
                                                   _impl->queryMetadata, _impl->qMetaCzarId);
         LOGS(_log, LOG_LVL_DEBUG, "make UserQueryDrop: db=" << dbName);
         return uq;
     } else if (UserQueryType::isFlushChunksCache(query, dbName)) {
+        if (_impl->planCache) _impl->planCache->clear();
+        if (_impl->resultCache) _impl->resultCache->clear();
+        if (_impl->secondaryIndex) _impl->secondaryIndex->clear();
         auto uq = std::make_shared<UserQueryFlushChunksCache>(_impl->css, dbName,
                                                               _impl->resultDbConn.get());
         LOGS(_log, LOG_LVL_DEBUG, "make UserQueryFlushChunksCache: " << dbName);
@@ -243,19 +327,137 @@ UserQueryFactory::newUserQuery(std::string const& aQuery,
 }
 
 UserQueryFactory::Impl::Impl(czar::CzarConfig const& czarConfig)
-    : mysqlResultConfig(czarConfig.getMySqlResultConfig()) {
+    : mysqlResultConfig(czarConfig.getMySqlResultConfig()),
+      resultStreamDrainTimeout(std::max(0, czarConfig.getResultStreamDrainTimeout())),
+      queryArenaBlockSize(std::size_t(std::max(0, czarConfig.getQueryArenaKB())) << 10) {
 
     executiveConfig = std::make_shared<qdisp::Executive::Config>(czarConfig.getXrootdFrontendUrl());
-    secondaryIndex = std::make_shared<qproc::SecondaryIndex>(mysqlResultConfig);
+    executiveConfig->speculativePercentile = std::min(100, std::max(0, czarConfig.getSpeculativePercentile()));
+    executiveConfig->speculativeMinSeconds = std::max(0, czarConfig.getSpeculativeMinSeconds());
+
+    QueryScheduler::Config schedulerConfig;
+    schedulerConfig.maxQueriesPerUser = std::max(0, czarConfig.getMaxQueriesPerUser());
+    schedulerConfig.maxInteractiveQueries = std::max(0, czarConfig.getMaxInteractiveQueries());
+    schedulerConfig.maxScanQueries = std::max(0, czarConfig.getMaxScanQueries());
+    schedulerConfig.maxOutstandingJobs = std::max(0, czarConfig.getMaxOutstandingJobs());
+    schedulerConfig.interactiveJobWeight = std::max(1, czarConfig.getInteractiveJobWeight());
+    schedulerConfig.scanJobWeight = std::max(1, czarConfig.getScanJobWeight());
+    schedulerConfig.fastScansPerUser = std::max(0, czarConfig.getFastScansPerUser());
+    if (schedulerConfig.maxQueriesPerUser > 0 || schedulerConfig.maxInteractiveQueries > 0
+        || schedulerConfig.maxScanQueries > 0 || schedulerConfig.maxOutstandingJobs > 0
+        || schedulerConfig.fastScansPerUser > 0) {
+        queryScheduler = QueryScheduler::create(schedulerConfig);
+    }
+    if (czarConfig.getMySqlPoolMaxIdle() > 0) {
+        mysql::MySqlConnectionPool::Config poolConfig;
+        poolConfig.maxIdle = czarConfig.getMySqlPoolMaxIdle();
+        poolConfig.idleTimeout = std::chrono::seconds(std::max(0, czarConfig.getMySqlPoolIdleTimeout()));
+        connectionPool = mysql::MySqlConnectionPool::create(poolConfig);
+    }
+    secondaryIndex = std::make_shared<qproc::SecondaryIndex>(mysqlResultConfig,
+            std::max(0, czarConfig.getSecondaryIndexCacheSize()),
+            std::max(1, czarConfig.getSecondaryIndexConnections()),
+            czarConfig.getSecondaryIndexFileDir(), connectionPool);
+    coverageCache = std::make_shared<qproc::ChunkCoverageCache>(
+            std::max(0, czarConfig.getChunkCoverageCacheSize()));
 
     // make one dedicated connection for results database
     resultDbConn.reset(new sql::SqlConnection(mysqlResultConfig));
 
     queryMetadata = std::make_shared<qmeta::QMetaMysql>(czarConfig.getMySqlQmetaConfig());
+    if (czarConfig.getQMetaWriteQueueSize() > 0) {
+        // keep status updates off the query execution path
+        queryMetadata = std::make_shared<qmeta::QMetaWriteBehind>(queryMetadata,
+                czarConfig.getQMetaWriteQueueSize(), std::chrono::milliseconds(1000),
+                std::max(0, czarConfig.getQMetaWriteRetries()));
+    }
     qMetaSelect = std::make_shared<qmeta::QMetaSelect>(czarConfig.getMySqlQmetaConfig());
 
     // create CssAccess instance
     css = css::CssAccess::createFromConfig(czarConfig.getCssConfigMap(), czarConfig.getEmptyChunkPath());
+
+    if (czarConfig.getQueryPlanCacheSize() > 0) {
+        planCache.reset(new qproc::QueryPlanCache(czarConfig.getQueryPlanCacheSize(),
+                std::chrono::seconds(std::max(0, czarConfig.getQueryPlanCacheLifetime()))));
+    }
+}
+
+std::shared_ptr<qproc::QuerySession>
+UserQueryFactory::Impl::cachedSession(std::string const& query, std::string const& defaultDb) {
+    std::shared_ptr<qproc::QuerySession> qs;
+    std::string shape;
+    StringVector params;
+    if (not planCache || not qproc::QueryPlanCache::parameterize(query, shape, params)) {
+        return qs;
+    }
+
+    // plans depend on CSS metadata, key includes CSS version so that cached
+    // plans are not used after e.g. table partitioning has changed
+    std::string generation;
+    try {
+        generation = css->getGeneration();
+    } catch (css::CssError const& exc) {
+        LOGS(_log, LOG_LVL_WARN, "Failed to get CSS generation, plan cache not used: " << exc.what());
+        return qs;
+    }
+    std::string const key = qproc::QueryPlanCache::makeKey(generation, defaultDb, shape);
+    qproc::QueryPlanCache::SessionPtr plan;
+    if (planCache->get(key, plan)) {
+        if (plan) {
+            qs = plan->bindParams(query, params);
+            LOGS(_log, LOG_LVL_DEBUG, "Query plan cache hit for: " << shape);
+        }
+        return qs;
+    }
+
+    // Analyze the shape itself. Shapes that fail, e.g. because the grammar
+    // wants a literal of another type, are remembered with a null session
+    // and the query goes through regular analysis, so errors mention the
+    // real query.
+    try {
+        auto parser = parser::SelectParser::newInstance(shape);
+        parser->setup();
+        auto stmt = parser->getSelectStmt();
+        auto&& tblRefList = stmt->getFromList().getTableRefList();
+        bool isProcessList = false;
+        for (auto&& tblRef : tblRefList) {
+            std::string const db = tblRef->getDb().empty() ? defaultDb : tblRef->getDb();
+            isProcessList = isProcessList || UserQueryType::isProcessListTable(db, tblRef->getTable());
+        }
+        if (not isProcessList) {
+            auto session = std::make_shared<qproc::QuerySession>(css, mysqlResultConfig, defaultDb);
+            session->analyzeQuery(shape, stmt);
+            if (session->getError().empty()) {
+                qs = session->bindParams(query, params);
+                if (qs) plan = session;
+            } else {
+                LOGS(_log, LOG_LVL_DEBUG, "Query shape not cached: " << session->getError());
+            }
+        }
+    } catch (std::exception const& exc) {
+        LOGS(_log, LOG_LVL_DEBUG, "Query shape not cached: " << exc.what());
+    } catch (...) {
+        LOGS(_log, LOG_LVL_DEBUG, "Query shape not cached: unknown failure");
+    }
+    planCache->put(key, plan);
+    return qs;
+}
+
+std::string
+UserQueryFactory::Impl::resultCacheKey(std::string const& query, std::string const& defaultDb) {
+    std::string normalized;
+    if (not ResultCache::normalize(query, normalized)) {
+        return std::string();
+    }
+    // results depend on CSS metadata, e.g. on which chunks exist
+    std::string generation;
+    try {
+        generation = css->getGeneration();
+    } catch (css::CssError const& exc) {
+        LOGS(_log, LOG_LVL_WARN, "Failed to get CSS generation, result cache not used: " << exc.what());
+        return std::string();
+    }
+    return ResultCache::makeKey(generation, defaultDb, normalized);
 }
 
 }}} // lsst::qserv::ccontrol
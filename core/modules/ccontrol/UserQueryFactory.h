@@ -67,12 +67,14 @@ public:
     /// @param largeResultMgr: Manager instance for large results
     /// @param userQueryId: Unique string identifying query
     /// @param msgTableName: Name of the message table without database name.
+    /// @param user:        Name of the user submitting the query, may be empty
     /// @return new UserQuery object
     UserQuery::Ptr newUserQuery(std::string const& query,
                                 std::string const& defaultDb,
                                 qdisp::LargeResultMgr::Ptr const& largeResultMgr,
                                 std::string const& userQueryId,
-                                std::string const& msgTableName);
+                                std::string const& msgTableName,
+                                std::string const& user=std::string());
 
 private:
     class Impl;
@@ -76,6 +76,7 @@
 
 // Qserv headers
 #include "ccontrol/MergingHandler.h"
+#include "ccontrol/ResultCache.h"
 #include "ccontrol/TmpTableName.h"
 #include "ccontrol/UserQueryError.h"
 #include "global/constants.h"
@@ -145,6 +146,7 @@ UserQuerySelect::UserQuerySelect(std::shared_ptr<qproc::QuerySession> const& qs,
                                  std::shared_ptr<qdisp::Executive> const& executive,
                                  std::shared_ptr<rproc::InfileMergerConfig> const& infileMergerConfig,
                                  std::shared_ptr<qproc::SecondaryIndex> const& secondaryIndex,
+                                 std::shared_ptr<qproc::ChunkCoverageCache> const& coverageCache,
                                  std::shared_ptr<qmeta::QMeta> const& queryMetadata,
                                  qmeta::CzarId czarId,
                                  std::shared_ptr<qdisp::LargeResultMgr> const& largeResultMgr,
@@ -152,7 +154,7 @@ UserQuerySelect::UserQuerySelect(std::shared_ptr<qproc::QuerySession> const& qs,
                                  bool async)
     :  _qSession(qs), _messageStore(messageStore), _executive(executive),
        _infileMergerConfig(infileMergerConfig), _secondaryIndex(secondaryIndex),
-       _queryMetadata(queryMetadata), _qMetaCzarId(czarId), _largeResultMgr(largeResultMgr),
+       _coverageCache(coverageCache), _queryMetadata(queryMetadata), _qMetaCzarId(czarId), _largeResultMgr(largeResultMgr),
        _errorExtra(errorExtra), _async(async) {
 }
 
@@ -181,7 +183,8 @@ void UserQuerySelect::kill() {
 
 std::string
 UserQuerySelect::getProxyOrderBy() const {
-    return _qSession->getProxyOrderBy();
+    std::lock_guard<std::mutex> lock(_mergerMutex);
+    return _proxyOrderBy;
 }
 
 /// Begin running on all chunks added so far.
@@ -196,6 +199,25 @@ void UserQuerySelect::submit() {
     LOGS(_log, LOG_LVL_DEBUG, getQueryIdString() << " UserQuerySelect beginning submission");
     assert(_infileMerger);
 
+    if (_queryScheduler) {
+        auto qClass = _qSession->getScanInteractive() ? QueryScheduler::INTERACTIVE
+                                                      : QueryScheduler::SCAN;
+        auto executive = _executive;
+        _schedulerTicket = _queryScheduler->admit(_user, qClass,
+                                                  [executive]() { return executive->getCancelled(); });
+        if (!_schedulerTicket) {
+            LOGS(_log, LOG_LVL_INFO, getQueryIdString() << " cancelled while waiting for admission");
+            _notAdmitted = true;
+            return;
+        }
+        // The executive must not keep the query admitted once it is joined.
+        std::weak_ptr<QueryScheduler::Ticket> ticket = _schedulerTicket;
+        _executive->setJobLimit([ticket]() {
+            auto t = ticket.lock();
+            return t ? t->getJobLimit() : 0;
+        });
+    }
+
     auto taskMsgFactory = std::make_shared<qproc::TaskMsgFactory>(_qMetaQueryId);
     TmpTableName ttn(_qMetaQueryId, _qSession->getOriginal());
     std::vector<int> chunks;
@@ -220,6 +242,9 @@ void UserQuerySelect::submit() {
         auto startChunkQSJ = std::chrono::system_clock::now(); // TEMPORARY-timing
         auto& chunkSpec = *i;
         auto cs = _qSession->buildChunkQuerySpec(queryTemplates, chunkSpec);
+        if (_schedulerTicket) {
+            cs->scanInfo.scanRating = _schedulerTicket->getScanRating(cs->scanInfo.scanRating);
+        }
         auto endQSpecQSJ = std::chrono::system_clock::now(); // TEMPORARY-timing
         chunks.push_back(cs->chunkId);
         std::string chunkResultName = ttn.make(cs->chunkId);
@@ -280,9 +305,27 @@ void UserQuerySelect::submit() {
 /// @return the QueryState indicating success or failure
 QueryState UserQuerySelect::join() {
     bool successful = _executive->join(); // Wait for all data
+    _schedulerTicket.reset(); // Let queued queries start.
     _infileMerger->finalize(); // Since all data are in, run final SQL commands like GROUP BY.
     _discardMerger();
+    if (_notAdmitted) {
+        // No job was dispatched, the empty result is not an answer.
+        _messageStore->addMessage(-1, 1317, "Query cancelled while waiting for admission",
+                                  MessageSeverity::MSG_ERROR);
+        std::lock_guard<std::mutex> lock(_killMutex);
+        if (!_killed) {
+            // kill() has already marked the query as aborted otherwise.
+            _qMetaUpdateStatus(qmeta::QInfo::ABORTED);
+        }
+        LOGS(_log, LOG_LVL_INFO, getQueryIdString() << " Joined query that was never admitted");
+        return ERROR;
+    }
     if (successful) {
+        if (_resultCache && !_async && !_resultCacheKey.empty()) {
+            // Locked before the client is released so that the proxy cannot
+            // drop the result before discard() has copied it to the cache.
+            _pendingPut = _resultCache->startPut(_resultCacheKey, _resultTable, getProxyOrderBy());
+        }
         _qMetaUpdateStatus(qmeta::QInfo::COMPLETED);
         LOGS(_log, LOG_LVL_DEBUG, getQueryIdString() << " Joined everything (success)");
         return SUCCESS;
@@ -296,10 +339,36 @@ QueryState UserQuerySelect::join() {
 /// Release resources held by the merger
 void UserQuerySelect::_discardMerger() {
     _infileMergerConfig.reset();
+    std::lock_guard<std::mutex> lock(_mergerMutex);
     if (_infileMerger && !_infileMerger->isFinished()) {
         throw UserQueryError(getQueryIdString() + " merger unfinished, cannot discard");
     }
+    if (_infileMerger) {
+        // Remember where the stream ended to tell late readers what they missed.
+        _resultStreamEnd = _infileMerger->getResultSegment(0).nextCursor;
+    }
     _infileMerger.reset();
+    _mergerDiscarded = true;
+}
+
+
+rproc::ResultPublisher::Segment UserQuerySelect::getResultSegment(std::size_t cursor) {
+    // Called by stream readers, possibly while the query is joined or discarded.
+    std::lock_guard<std::mutex> lock(_mergerMutex);
+    if (!_proxyOrderBy.empty()) {
+        // Rows are only ordered by the proxy once the result is complete.
+        return UserQuery::getResultSegment(cursor);
+    }
+    if (_infileMerger) {
+        return _infileMerger->getResultSegment(cursor);
+    }
+    rproc::ResultPublisher::Segment segment;
+    if (_mergerDiscarded) {
+        segment.nextCursor = _resultStreamEnd;
+        segment.complete = true;
+        segment.truncated = cursor < _resultStreamEnd;
+    }
+    return segment;
 }
 
 /// Release resources.
@@ -307,6 +376,8 @@ void UserQuerySelect::discard() {
     {
         std::lock_guard<std::mutex> lock(_killMutex);
         if (_killed) {
+            // Let the proxy drop the result without caching it.
+            _pendingPut.reset();
             return;
         }
     }
@@ -323,6 +394,13 @@ void UserQuerySelect::discard() {
         // Silence merger discarding errors, because this object is being released.
         // client no longer cares about merger errors.
     }
+    if (_pendingPut) {
+        // Identical queries get a copy of this result until it is evicted.
+        // The proxy can read the result meanwhile, dropping it waits for the
+        // lock taken by join().
+        _resultCache->finishPut(_pendingPut);
+        _pendingPut.reset();
+    }
     LOGS(_log, LOG_LVL_DEBUG, getQueryIdString() << " Discarded UserQuerySelect");
 }
 
@@ -331,7 +409,9 @@ void UserQuerySelect::_setupMerger() {
     LOGS(_log, LOG_LVL_TRACE, getQueryIdString() << " Setup merger");
     _infileMergerConfig->targetTable = _resultTable;
     _infileMergerConfig->mergeStmt = _qSession->getMergeStmt();
-    _infileMerger = std::make_shared<rproc::InfileMerger>(*_infileMergerConfig);
+    auto infileMerger = std::make_shared<rproc::InfileMerger>(*_infileMergerConfig);
+    std::lock_guard<std::mutex> lock(_mergerMutex);
+    _infileMerger = infileMerger;
 }
 
 void UserQuerySelect::setupChunking() {
@@ -344,13 +424,10 @@ void UserQuerySelect::setupChunking() {
         throw UserQueryError(getQueryIdString() + " Couldn't determine dominantDb for dispatch");
     }
 
-    std::shared_ptr<IntSet const> eSet = _qSession->getEmptyChunks();
-    {
-        eSet = _qSession->getEmptyChunks();
-        if (!eSet) {
-            eSet = std::make_shared<IntSet>();
-            LOGS(_log, LOG_LVL_WARN, getQueryIdString() << " Missing empty chunks info for " << dominantDb);
-        }
+    css::ChunkBitmap::ConstPtr eSet = _qSession->getEmptyChunks();
+    if (!eSet) {
+        eSet = std::make_shared<css::ChunkBitmap>();
+        LOGS(_log, LOG_LVL_WARN, getQueryIdString() << " Missing empty chunks info for " << dominantDb);
     }
     // FIXME add operator<< for QuerySession
     LOGS(_log, LOG_LVL_TRACE, getQueryIdString() << " _qSession: " << _qSession);
@@ -358,7 +435,7 @@ void UserQuerySelect::setupChunking() {
         std::shared_ptr<query::ConstraintVector> constraints = _qSession->getConstraints();
         css::StripingParams partStriping = _qSession->getDbStriping();
 
-        im = std::make_shared<qproc::IndexMap>(partStriping, _secondaryIndex);
+        im = std::make_shared<qproc::IndexMap>(partStriping, _secondaryIndex, _coverageCache);
         qproc::ChunkSpecVector csv;
         if (constraints) {
             csv = im->getChunks(*constraints);
@@ -368,12 +445,9 @@ void UserQuerySelect::setupChunking() {
 
         LOGS(_log, LOG_LVL_TRACE, getQueryIdString() << " Chunk specs: " << util::printable(csv));
         // Filter out empty chunks
-        for(qproc::ChunkSpecVector::const_iterator i=csv.begin(), e=csv.end();
-            i != e;
-            ++i) {
-            if (eSet->count(i->chunkId) == 0) { // chunk not in empty?
-                _qSession->addChunk(*i);
-            }
+        eSet->eraseFrom(csv, [](qproc::ChunkSpec const& cs) { return cs.chunkId; });
+        for (auto const& cs: csv) {
+            _qSession->addChunk(cs);
         }
     } else {
         LOGS(_log, LOG_LVL_TRACE, getQueryIdString() << " No chunks added, QuerySession will add dummy chunk");
@@ -387,18 +461,16 @@ void UserQuerySelect::qMetaRegister(std::string const& resultLocation, std::stri
     qmeta::QInfo::QType qType = _async ? qmeta::QInfo::ASYNC : qmeta::QInfo::SYNC;
     std::string user = "anonymous";    // we do not have access to that info yet
 
+    // Templates of a session from the query plan cache have parameter
+    // markers, only makeQueryTemplates() replaces them with the literals.
     std::string qTemplate;
-    auto const& stmtVector = _qSession->getStmtParallel();
-    for (auto itr = stmtVector.begin(); itr != stmtVector.end(); ++ itr) {
-        auto stmt = *itr;
-        if (stmt) {
-            if (not qTemplate.empty()) {
-                // if there is more than one statement separate them by
-                // special token
-                qTemplate += " /*QSEPARATOR*/; ";
-            }
-            qTemplate += stmt->getQueryTemplate().sqlFragment();
+    for (auto const& queryTemplate : _qSession->makeQueryTemplates()) {
+        if (not qTemplate.empty()) {
+            // if there is more than one statement separate them by
+            // special token
+            qTemplate += " /*QSEPARATOR*/; ";
         }
+        qTemplate += queryTemplate.sqlFragment();
     }
 
     std::string qMerge;
@@ -407,6 +479,11 @@ void UserQuerySelect::qMetaRegister(std::string const& resultLocation, std::stri
         qMerge = mergeStmt->getQueryTemplate().sqlFragment();
     }
     std::string proxyOrderBy = _qSession->getProxyOrderBy();
+    {
+        // Kept for readers of the result, _qSession is released by discard().
+        std::lock_guard<std::mutex> lock(_mergerMutex);
+        _proxyOrderBy = proxyOrderBy;
+    }
     _resultLoc = resultLocation;
     if (_resultLoc.empty()) {
         // Special token #QID# is replaced with query ID later.
@@ -39,6 +39,8 @@
 // Third-party headers
 
 // Qserv headers
+#include "ccontrol/QueryScheduler.h"
+#include "ccontrol/ResultCache.h"
 #include "ccontrol/UserQuery.h"
 #include "css/StripingParams.h"
 #include "qmeta/QInfo.h"
@@ -57,6 +59,7 @@ namespace qmeta {
 class QMeta;
 }
 namespace qproc {
+class ChunkCoverageCache;
 class QuerySession;
 class SecondaryIndex;
 }
@@ -83,6 +86,7 @@ public:
                     std::shared_ptr<qdisp::Executive> const& executive,
                     std::shared_ptr<rproc::InfileMergerConfig> const& infileMergerConfig,
                     std::shared_ptr<qproc::SecondaryIndex> const& secondaryIndex,
+                    std::shared_ptr<qproc::ChunkCoverageCache> const& coverageCache,
                     std::shared_ptr<qmeta::QMeta> const& queryMetadata,
                     qmeta::CzarId czarId,
                     std::shared_ptr<qdisp::LargeResultMgr> const& largeResultMgr,
@@ -139,8 +143,25 @@ public:
     /// @return True if query is async query
     virtual bool isAsync() const override { return _async; }
 
+    /// @return result rows published since cursor, see rproc::ResultPublisher.
+    virtual rproc::ResultPublisher::Segment getResultSegment(std::size_t cursor) override;
+
     void setupChunking();
 
+    /// Copy the result into resultCache under key once the query succeeded,
+    /// the rows are copied by discard() so that it does not delay the client.
+    void setResultCache(std::shared_ptr<ResultCache> const& resultCache, std::string const& key) {
+        _resultCache = resultCache;
+        _resultCacheKey = key;
+    }
+
+    /// Wait for admission by queryScheduler before dispatching the query.
+    void setQueryScheduler(std::shared_ptr<QueryScheduler> const& queryScheduler,
+                           std::string const& user) {
+        _queryScheduler = queryScheduler;
+        _user = user;
+    }
+
 private:
     void _setupMerger();
     void _discardMerger();
@@ -153,8 +174,21 @@ private:
     std::shared_ptr<qdisp::Executive> _executive;
     std::shared_ptr<rproc::InfileMergerConfig> _infileMergerConfig;
     std::shared_ptr<rproc::InfileMerger> _infileMerger;
+    mutable std::mutex _mergerMutex; ///< protects members below against result stream readers
+    std::size_t _resultStreamEnd{0}; ///< cursor past the last published segment
+    bool _mergerDiscarded{false};
+    std::string _proxyOrderBy;  ///< ORDER BY for the proxy, set by qMetaRegister()
     std::shared_ptr<qproc::SecondaryIndex> _secondaryIndex;
+    std::shared_ptr<qproc::ChunkCoverageCache> _coverageCache;
     std::shared_ptr<qmeta::QMeta> _queryMetadata;
+    std::shared_ptr<ResultCache> _resultCache;
+    std::string _resultCacheKey;
+    /// Started by a successful join() if _resultCache is used, finished by discard()
+    std::shared_ptr<ResultCache::PendingPut> _pendingPut;
+    std::shared_ptr<QueryScheduler> _queryScheduler;
+    std::shared_ptr<QueryScheduler::Ticket> _schedulerTicket; ///< Held while jobs execute
+    std::string _user;          ///< User submitting the query, for _queryScheduler
+    bool _notAdmitted{false};   ///< Cancelled while waiting for admission, no jobs were added
 
     qmeta::CzarId _qMetaCzarId; ///< Czar ID in QMeta database
     QueryId _qMetaQueryId{0};      ///< Query ID in QMeta database
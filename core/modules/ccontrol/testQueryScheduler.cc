@@ -0,0 +1,204 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// System headers
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Third-party headers
+
+// Qserv headers
+#include "ccontrol/QueryScheduler.h"
+#include "proto/ScanTableInfo.h"
+
+// Boost unit test header
+#define BOOST_TEST_MODULE QueryScheduler
+#include "boost/test/included/unit_test.hpp"
+
+namespace test = boost::test_tools;
+
+using lsst::qserv::ccontrol::QueryScheduler;
+
+namespace {
+
+bool never() { return false; }
+
+/// Admits a query on its own thread, recording the admission order.
+struct Submitter {
+    Submitter(QueryScheduler::Ptr const& scheduler, std::string const& user,
+              QueryScheduler::QueryClass qClass, std::vector<std::string>& order, std::mutex& mtx)
+        : thread([=, &order, &mtx]() {
+              ticket = scheduler->admit(user, qClass, never);
+              std::lock_guard<std::mutex> lock(mtx);
+              order.push_back(user);
+          }) {}
+
+    QueryScheduler::Ticket::Ptr ticket;
+    std::thread thread;
+};
+
+/// Wait until 'n' queries are waiting for admission.
+void waitForWaiting(QueryScheduler::Ptr const& scheduler, int n) {
+    while (scheduler->getStats().waiting != n) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(Suite)
+
+BOOST_AUTO_TEST_CASE(Unlimited) {
+    auto scheduler = QueryScheduler::create(QueryScheduler::Config());
+    std::vector<QueryScheduler::Ticket::Ptr> tickets;
+    for (int i = 0; i < 10; ++i) {
+        tickets.push_back(scheduler->admit("alice", QueryScheduler::SCAN, never));
+        BOOST_REQUIRE(tickets.back());
+        BOOST_CHECK_EQUAL(tickets.back()->getJobLimit(), 0);
+        BOOST_CHECK(!tickets.back()->isDemoted());
+    }
+    BOOST_CHECK_EQUAL(scheduler->getStats().executing[QueryScheduler::SCAN], 10);
+    tickets.clear();
+    BOOST_CHECK_EQUAL(scheduler->getStats().executing[QueryScheduler::SCAN], 0);
+    BOOST_CHECK_EQUAL(scheduler->getStats().admitted, 10U);
+    BOOST_CHECK_EQUAL(scheduler->getStats().queued, 0U);
+}
+
+BOOST_AUTO_TEST_CASE(FairAdmission) {
+    QueryScheduler::Config config;
+    config.maxScanQueries = 1;
+    auto scheduler = QueryScheduler::create(config);
+    std::vector<std::string> order;
+    std::mutex mtx;
+
+    auto running = scheduler->admit("alice", QueryScheduler::SCAN, never);
+    // Alice queues a burst of scans before bob submits one.
+    Submitter a1(scheduler, "alice", QueryScheduler::SCAN, order, mtx);
+    waitForWaiting(scheduler, 1);
+    Submitter a2(scheduler, "alice", QueryScheduler::SCAN, order, mtx);
+    waitForWaiting(scheduler, 2);
+    Submitter b1(scheduler, "bob", QueryScheduler::SCAN, order, mtx);
+    waitForWaiting(scheduler, 3);
+
+    // Interactive queries are not held back by the scan limit.
+    auto interactive = scheduler->admit("alice", QueryScheduler::INTERACTIVE, never);
+    BOOST_CHECK(interactive);
+    interactive.reset();
+
+    running.reset();
+    waitForWaiting(scheduler, 2);
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        BOOST_REQUIRE_EQUAL(order.size(), 1U);
+        BOOST_CHECK_EQUAL(order[0], "bob");
+    }
+    b1.thread.join();
+    b1.ticket.reset();
+    a1.thread.join();
+    a1.ticket.reset();
+    a2.thread.join();
+    a2.ticket.reset();
+    BOOST_CHECK_EQUAL(order.size(), 3U);
+    BOOST_CHECK_EQUAL(scheduler->getStats().queued, 3U);
+}
+
+BOOST_AUTO_TEST_CASE(UserLimit) {
+    QueryScheduler::Config config;
+    config.maxQueriesPerUser = 2;
+    auto scheduler = QueryScheduler::create(config);
+    auto t1 = scheduler->admit("alice", QueryScheduler::INTERACTIVE, never);
+    auto t2 = scheduler->admit("alice", QueryScheduler::SCAN, never);
+    auto t3 = scheduler->admit("bob", QueryScheduler::SCAN, never);
+    BOOST_CHECK(t1 && t2 && t3);
+
+    std::atomic<bool> cancel{false};
+    std::thread waiter([&]() {
+        auto t = scheduler->admit("alice", QueryScheduler::INTERACTIVE, [&]() { return bool(cancel); });
+        BOOST_CHECK(!t);
+    });
+    waitForWaiting(scheduler, 1);
+    cancel = true;
+    waiter.join();
+    BOOST_CHECK_EQUAL(scheduler->getStats().waiting, 0);
+    BOOST_CHECK_EQUAL(scheduler->getStats().admitted, 3U);
+}
+
+BOOST_AUTO_TEST_CASE(JobShare) {
+    QueryScheduler::Config config;
+    config.maxOutstandingJobs = 100;
+    config.interactiveJobWeight = 4;
+    config.scanJobWeight = 1;
+    auto scheduler = QueryScheduler::create(config);
+
+    auto a1 = scheduler->admit("alice", QueryScheduler::SCAN, never);
+    BOOST_CHECK_EQUAL(a1->getJobLimit(), 100);
+    auto a2 = scheduler->admit("alice", QueryScheduler::SCAN, never);
+    auto a3 = scheduler->admit("alice", QueryScheduler::SCAN, never);
+    auto a4 = scheduler->admit("alice", QueryScheduler::SCAN, never);
+    BOOST_CHECK_EQUAL(a1->getJobLimit(), 25);
+
+    // Bob's single scan gets as many jobs as all of alice's scans.
+    auto b1 = scheduler->admit("bob", QueryScheduler::SCAN, never);
+    BOOST_CHECK_EQUAL(b1->getJobLimit(), 50);
+    BOOST_CHECK_EQUAL(a4->getJobLimit(), 12);
+
+    // Interactive queries weigh more.
+    auto c1 = scheduler->admit("carol", QueryScheduler::INTERACTIVE, never);
+    BOOST_CHECK_EQUAL(c1->getJobLimit(), 66);
+    BOOST_CHECK_EQUAL(b1->getJobLimit(), 16);
+
+    c1.reset();
+    BOOST_CHECK_EQUAL(b1->getJobLimit(), 50);
+}
+
+BOOST_AUTO_TEST_CASE(ScanDemotion) {
+    QueryScheduler::Config config;
+    config.fastScansPerUser = 1;
+    auto scheduler = QueryScheduler::create(config);
+    int const rating = lsst::qserv::proto::ScanInfo::Rating::MEDIUM;
+    int const slowest = lsst::qserv::proto::ScanInfo::Rating::SLOWEST;
+
+    auto a1 = scheduler->admit("alice", QueryScheduler::SCAN, never);
+    auto a2 = scheduler->admit("alice", QueryScheduler::SCAN, never);
+    auto a3 = scheduler->admit("alice", QueryScheduler::INTERACTIVE, never);
+    auto b1 = scheduler->admit("bob", QueryScheduler::SCAN, never);
+    BOOST_CHECK_EQUAL(a1->getScanRating(rating), rating);
+    BOOST_CHECK_EQUAL(a2->getScanRating(rating), slowest);
+    BOOST_CHECK_EQUAL(a3->getScanRating(rating), rating);
+    BOOST_CHECK_EQUAL(b1->getScanRating(rating), rating);
+    BOOST_CHECK_EQUAL(scheduler->getStats().demoted, 1U);
+
+    a1.reset();
+    auto a4 = scheduler->admit("alice", QueryScheduler::SCAN, never);
+    BOOST_CHECK_EQUAL(a4->getScanRating(rating), slowest);
+    a2.reset();
+    a4.reset();
+    auto a5 = scheduler->admit("alice", QueryScheduler::SCAN, never);
+    BOOST_CHECK_EQUAL(a5->getScanRating(rating), rating);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,222 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// System headers
+#include <set>
+#include <string>
+#include <vector>
+
+// Third-party headers
+
+// Qserv headers
+#include "ccontrol/ResultCache.h"
+#include "sql/SqlConnection.h"
+#include "sql/SqlErrorObject.h"
+
+// Boost unit test header
+#define BOOST_TEST_MODULE ResultCache
+#include "boost/test/included/unit_test.hpp"
+
+namespace test = boost::test_tools;
+
+using lsst::qserv::ccontrol::ResultCache;
+
+namespace {
+
+/// Keeps the set of existing tables instead of talking to mysql.
+struct MockConnection : public lsst::qserv::sql::SqlConnection {
+    bool runQuery(std::string const query, lsst::qserv::sql::SqlErrorObject&) override {
+        queries.push_back(query);
+        std::string const create = "CREATE TABLE ";
+        if (query.compare(0, create.size(), create) == 0) {
+            tables.insert(query.substr(create.size(), query.find(' ', create.size()) - create.size()));
+        }
+        return true;
+    }
+    bool dropTable(std::string const& tableName, lsst::qserv::sql::SqlErrorObject&,
+                   bool, std::string const&) override {
+        tables.erase(tableName);
+        return true;
+    }
+    bool listTables(std::vector<std::string>& list, lsst::qserv::sql::SqlErrorObject&,
+                    std::string const& prefixed, std::string const&) override {
+        for (auto const& table : tables) {
+            if (table.compare(0, prefixed.size(), prefixed) == 0) list.push_back(table);
+        }
+        return true;
+    }
+
+    std::set<std::string> tables;
+    std::vector<std::string> queries;
+};
+
+/// Cache where every table has the same size.
+struct TestCache : public ResultCache {
+    TestCache(std::shared_ptr<MockConnection> const& conn, std::size_t maxEntries,
+              std::uint64_t maxBytes, std::uint64_t tableSize)
+        : ResultCache(lsst::qserv::mysql::MySqlConfig(), conn, "qcache_1_", maxEntries, maxBytes,
+                      std::chrono::seconds(3600)),
+          conn(conn), tableSize(tableSize) {}
+
+    std::uint64_t _getTableSize(std::string const&) override { return tableSize; }
+    std::shared_ptr<lsst::qserv::sql::SqlConnection> _newConnection() override { return conn; }
+
+    std::shared_ptr<MockConnection> conn;
+    std::uint64_t tableSize;
+};
+
+std::string key(std::string const& query) {
+    std::string normalized;
+    BOOST_REQUIRE(ResultCache::normalize(query, normalized));
+    return ResultCache::makeKey("1", "LSST", normalized);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(Suite)
+
+BOOST_AUTO_TEST_CASE(Normalize) {
+    std::string normalized;
+    BOOST_CHECK(ResultCache::normalize("  SELECT  *\n\tFROM Object ; ", normalized));
+    BOOST_CHECK_EQUAL(normalized, "SELECT * FROM Object");
+    BOOST_CHECK(ResultCache::normalize("SELECT 'a  b' FROM Object WHERE x = \"c  ;\";", normalized));
+    BOOST_CHECK_EQUAL(normalized, "SELECT 'a  b' FROM Object WHERE x = \"c  ;\"");
+    BOOST_CHECK(ResultCache::normalize("SELECT 'it''s  ok' FROM `my  table`", normalized));
+    BOOST_CHECK_EQUAL(normalized, "SELECT 'it''s  ok' FROM `my  table`");
+    BOOST_CHECK(ResultCache::normalize("SELECT nowhere, 'RAND()' FROM Object", normalized));
+    BOOST_CHECK(!ResultCache::normalize("SELECT RAND() FROM Object", normalized));
+    BOOST_CHECK(!ResultCache::normalize("SELECT * FROM Object WHERE t < now()", normalized));
+    BOOST_CHECK(!ResultCache::normalize("SELECT * FROM Object WHERE t < CURRENT_TIMESTAMP", normalized));
+    BOOST_CHECK(!ResultCache::normalize(" ; ", normalized));
+}
+
+BOOST_AUTO_TEST_CASE(StaleTablesDropped) {
+    auto conn = std::make_shared<MockConnection>();
+    conn->tables = {"qcache_1_3", "qcache_2_1", "result_5"};
+    TestCache cache(conn, 10, 1000, 1);
+    BOOST_CHECK_EQUAL(conn->tables.size(), 2U);
+    BOOST_CHECK_EQUAL(conn->tables.count("qcache_1_3"), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(HitAndCopy) {
+    auto conn = std::make_shared<MockConnection>();
+    auto cache = std::make_shared<TestCache>(conn, 10, 1000, 1);
+
+    BOOST_CHECK(!cache->get(key("SELECT * FROM Object")));
+    BOOST_CHECK(cache->put(key("SELECT * FROM Object"), "result_1", "ORDER BY id"));
+    BOOST_CHECK_EQUAL(conn->tables.size(), 1U);
+
+    auto entry = cache->get(key("SELECT  *  FROM Object;"));
+    BOOST_REQUIRE(entry);
+    BOOST_CHECK_EQUAL(entry->orderBy, "ORDER BY id");
+    std::string error;
+    BOOST_CHECK(cache->copy(entry, "result_cached_2", error));
+    BOOST_CHECK_EQUAL(conn->queries.back(),
+                      "CREATE TABLE result_cached_2 ENGINE=MyISAM SELECT * FROM " + entry->table);
+
+    BOOST_CHECK(!cache->get(ResultCache::makeKey("2", "LSST", "SELECT * FROM Object")));
+
+    auto stats = cache->getStats();
+    BOOST_CHECK_EQUAL(stats.hits, 1U);
+    BOOST_CHECK_EQUAL(stats.misses, 2U);
+    BOOST_CHECK_EQUAL(stats.insertions, 1U);
+    BOOST_CHECK_EQUAL(stats.entries, 1U);
+    BOOST_CHECK_CLOSE(stats.hitRate(), 1./3, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(Limits) {
+    auto conn = std::make_shared<MockConnection>();
+    auto cache = std::make_shared<TestCache>(conn, 2, 250, 100);
+
+    BOOST_CHECK(cache->put(key("SELECT 1"), "result_1", ""));
+    BOOST_CHECK(cache->put(key("SELECT 2"), "result_2", ""));
+    BOOST_CHECK(cache->get(key("SELECT 1")));
+    // over the size limit, the least recently used entry goes
+    BOOST_CHECK(cache->put(key("SELECT 3"), "result_3", ""));
+    BOOST_CHECK(!cache->get(key("SELECT 2")));
+    BOOST_CHECK(cache->get(key("SELECT 1")));
+    BOOST_CHECK_EQUAL(cache->getStats().evictions, 1U);
+    BOOST_CHECK_EQUAL(cache->getStats().bytes, 200U);
+    BOOST_CHECK_EQUAL(conn->tables.size(), 2U);
+
+    // too large results are not kept, nor copied
+    cache->tableSize = 300;
+    std::size_t const queries = conn->queries.size();
+    BOOST_CHECK(!cache->put(key("SELECT 4"), "result_4", ""));
+    BOOST_CHECK_EQUAL(conn->tables.size(), 2U);
+    BOOST_CHECK_EQUAL(conn->queries.size(), queries);
+}
+
+BOOST_AUTO_TEST_CASE(PendingPut) {
+    auto conn = std::make_shared<MockConnection>();
+    auto cache = std::make_shared<TestCache>(conn, 10, 1000, 1);
+
+    // the result table is locked before the client may drop it
+    auto pending = cache->startPut(key("SELECT 1"), "result_1", "");
+    BOOST_REQUIRE(pending);
+    BOOST_REQUIRE_EQUAL(conn->queries.size(), 2U);
+    BOOST_CHECK_EQUAL(conn->queries[0], "CREATE TABLE qcache_1_1 LIKE result_1");
+    BOOST_CHECK_EQUAL(conn->queries[1], "LOCK TABLES result_1 READ, qcache_1_1 WRITE");
+    BOOST_CHECK(!cache->get(key("SELECT 1")));
+
+    // rows are copied while the lock is held
+    BOOST_CHECK(cache->finishPut(pending));
+    BOOST_REQUIRE_EQUAL(conn->queries.size(), 4U);
+    BOOST_CHECK_EQUAL(conn->queries[2], "INSERT INTO qcache_1_1 SELECT * FROM result_1");
+    BOOST_CHECK_EQUAL(conn->queries[3], "UNLOCK TABLES");
+    BOOST_CHECK(cache->get(key("SELECT 1")));
+    pending.reset();
+    BOOST_CHECK_EQUAL(conn->queries.size(), 4U);
+    BOOST_CHECK_EQUAL(conn->tables.count("qcache_1_1"), 1U);
+
+    // an abandoned copy unlocks the result table and drops its table
+    pending = cache->startPut(key("SELECT 2"), "result_2", "");
+    BOOST_REQUIRE(pending);
+    BOOST_CHECK_EQUAL(conn->tables.count("qcache_1_2"), 1U);
+    pending.reset();
+    BOOST_CHECK_EQUAL(conn->queries.back(), "UNLOCK TABLES");
+    BOOST_CHECK_EQUAL(conn->tables.count("qcache_1_2"), 0U);
+    BOOST_CHECK(!cache->get(key("SELECT 2")));
+}
+
+BOOST_AUTO_TEST_CASE(ClearKeepsTablesInUse) {
+    auto conn = std::make_shared<MockConnection>();
+    auto cache = std::make_shared<TestCache>(conn, 10, 1000, 1);
+
+    BOOST_CHECK(cache->put(key("SELECT 1"), "result_1", ""));
+    BOOST_CHECK(cache->put(key("SELECT 2"), "result_2", ""));
+    auto entry = cache->get(key("SELECT 1"));
+    BOOST_REQUIRE(entry);
+
+    cache->clear();
+    BOOST_CHECK_EQUAL(cache->getStats().entries, 0U);
+    BOOST_CHECK(!cache->get(key("SELECT 2")));
+    // table of the entry still being copied survives until released
+    BOOST_CHECK_EQUAL(conn->tables.size(), 1U);
+    BOOST_CHECK_EQUAL(conn->tables.count(entry->table), 1U);
+    entry.reset();
+    cache->clear();
+    BOOST_CHECK(conn->tables.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,125 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+
+// System headers
+#include <memory>
+#include <string>
+#include <vector>
+
+// Qserv headers
+#include "ccontrol/UserQuerySelect.h"
+#include "qdisp/MessageStore.h"
+#include "qmeta/QMeta.h"
+#include "qproc/QueryPlanCache.h"
+#include "qproc/QuerySession.h"
+#include "tests/QueryAnaFixture.h"
+
+// Boost unit test header
+#define BOOST_TEST_MODULE UserQuerySelect
+#include "boost/test/included/unit_test.hpp"
+
+namespace test = boost::test_tools;
+
+using lsst::qserv::QueryId;
+using lsst::qserv::StringVector;
+using lsst::qserv::ccontrol::UserQuerySelect;
+using lsst::qserv::qdisp::MessageStore;
+using lsst::qserv::qmeta::CzarId;
+using lsst::qserv::qmeta::QInfo;
+using lsst::qserv::qmeta::QMeta;
+using lsst::qserv::qproc::QueryPlanCache;
+using lsst::qserv::qproc::QuerySession;
+using lsst::qserv::tests::QueryAnaFixture;
+
+namespace {
+
+/// QMeta which keeps the templates of registered queries.
+class TemplateQMeta : public QMeta {
+public:
+    CzarId getCzarID(std::string const&) override { return 1; }
+    CzarId registerCzar(std::string const&) override { return 1; }
+    void setCzarActive(CzarId, bool) override {}
+    QueryId registerQuery(QInfo const& qInfo, TableNames const&) override {
+        templates.push_back(qInfo.queryTemplate());
+        return templates.size();
+    }
+    void addChunks(QueryId, std::vector<int> const&) override {}
+    void assignChunk(QueryId, int, std::string const&) override {}
+    void finishChunk(QueryId, int) override {}
+    void completeQuery(QueryId, QInfo::QStatus) override {}
+    void finishQuery(QueryId) override {}
+    std::vector<QueryId> findQueries(CzarId, QInfo::QType, std::string const&,
+                                     std::vector<QInfo::QStatus> const&, int, int) override {
+        return std::vector<QueryId>();
+    }
+    std::vector<QueryId> getPendingQueries(CzarId) override { return std::vector<QueryId>(); }
+    QInfo getQueryInfo(QueryId) override { return QInfo(); }
+    std::vector<QueryId> getQueriesForDb(std::string const&) override { return std::vector<QueryId>(); }
+    std::vector<QueryId> getQueriesForTable(std::string const&, std::string const&) override {
+        return std::vector<QueryId>();
+    }
+
+    std::vector<std::string> templates;
+};
+
+/// Register a query analyzed by session, @return its template.
+std::string registerTemplate(std::shared_ptr<QuerySession> const& session,
+                             std::shared_ptr<TemplateQMeta> const& qMeta) {
+    UserQuerySelect uq(session, std::make_shared<MessageStore>(), nullptr, nullptr, nullptr,
+                       nullptr, qMeta, 1, nullptr, std::string(), false);
+    uq.qMetaRegister(std::string(), "message_1");
+    BOOST_REQUIRE(!qMeta->templates.empty());
+    return qMeta->templates.back();
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(Suite, QueryAnaFixture)
+
+BOOST_AUTO_TEST_CASE(RegisterCachedPlan) {
+    std::vector<std::string> const queries = {
+        "select * from Object where objectIdObjTest in (2,3145,9999);",
+        "SELECT COUNT(*) AS N FROM Source WHERE objectId IN(386950783579546, 386942193651348);"
+    };
+    auto qMeta = std::make_shared<TemplateQMeta>();
+    for (auto const& query : queries) {
+        std::string shape;
+        StringVector params;
+        BOOST_REQUIRE(QueryPlanCache::parameterize(query, shape, params));
+        auto plan = queryAnaHelper.buildQuerySession(qsTest, shape);
+        BOOST_REQUIRE_MESSAGE(plan->getError().empty(), plan->getError());
+        auto bound = plan->bindParams(query, params);
+        BOOST_REQUIRE(bound);
+
+        // QMeta gets the literals of the query, as if it was analyzed itself
+        std::string const qTemplate = registerTemplate(bound, qMeta);
+        BOOST_CHECK(!QueryPlanCache::hasParamMarker(qTemplate));
+        BOOST_CHECK(qTemplate.find(params.back()) != std::string::npos);
+        auto analyzed = queryAnaHelper.buildQuerySession(qsTest, query);
+        BOOST_REQUIRE_MESSAGE(analyzed->getError().empty(), analyzed->getError());
+        BOOST_CHECK_EQUAL(qTemplate, registerTemplate(analyzed, qMeta));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
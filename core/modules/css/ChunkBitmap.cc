@@ -0,0 +1,178 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "css/ChunkBitmap.h"
+
+// System headers
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// LSST headers
+#include "lsst/log/Log.h"
+
+// Qserv headers
+#include "global/ConfigError.h"
+
+namespace {
+
+LOG_LOGGER _log = LOG_GET("lsst.qserv.css.ChunkBitmap");
+
+char const MAGIC[8] = {'Q', 'S', 'V', 'E', 'M', 'P', 'T', '1'};
+
+struct Header {
+    char magic[8];
+    std::uint64_t nBits;
+    std::uint64_t count;
+    std::uint64_t reserved;
+};
+
+static_assert(sizeof(Header) == 32, "Unexpected ChunkBitmap header size");
+
+std::size_t wordCount(std::uint64_t nBits) {
+    return (nBits + 63) / 64;
+}
+
+} // anonymous namespace
+
+namespace lsst {
+namespace qserv {
+namespace css {
+
+ChunkBitmap::ChunkBitmap(std::vector<int> const& chunks) {
+    int maxChunk = -1;
+    for (int chunk: chunks) {
+        maxChunk = std::max(maxChunk, chunk);
+    }
+    _nBits = maxChunk + 1;
+    _ownWords.assign(wordCount(_nBits), 0);
+    for (int chunk: chunks) {
+        if (chunk < 0) {
+            LOGS(_log, LOG_LVL_WARN, "ignoring negative chunk id " << chunk);
+            continue;
+        }
+        _ownWords[chunk >> 6] |= Word(1) << (chunk & 63);
+    }
+    for (Word w: _ownWords) {
+        _count += __builtin_popcountll(w);
+    }
+    _words = _ownWords.data();
+}
+
+ChunkBitmap::~ChunkBitmap() {
+    if (_map != nullptr) {
+        ::munmap(_map, _mapSize);
+    }
+}
+
+ChunkBitmap::ConstPtr
+ChunkBitmap::readText(std::istream& input) {
+    std::vector<int> chunks;
+    std::copy(std::istream_iterator<int>(input), std::istream_iterator<int>(),
+              std::back_inserter(chunks));
+    return std::make_shared<ChunkBitmap>(chunks);
+}
+
+bool
+ChunkBitmap::isBinaryFile(std::string const& path) {
+    std::ifstream f(path, std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    return f.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+ChunkBitmap::ConstPtr
+ChunkBitmap::load(std::string const& path) {
+    if (not isBinaryFile(path)) {
+        std::ifstream f(path);
+        if (not f.good()) {
+            throw ConfigError("Cannot open empty chunks file " + path);
+        }
+        auto bitmap = readText(f);
+        if (f.bad() || not f.eof()) {
+            throw ConfigError("Failed to parse empty chunks file " + path);
+        }
+        return bitmap;
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw ConfigError("Cannot open empty chunks file " + path + ": " + std::strerror(errno));
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(fd);
+        throw ConfigError("Invalid empty chunks file " + path);
+    }
+    auto bitmap = std::make_shared<ChunkBitmap>();
+    bitmap->_mapSize = st.st_size;
+    void* map = ::mmap(nullptr, bitmap->_mapSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        throw ConfigError("Cannot map empty chunks file " + path + ": " + std::strerror(errno));
+    }
+    bitmap->_map = map;
+    Header const* header = static_cast<Header const*>(map);
+    // Compare counts rather than sizes, huge values must not overflow.
+    std::uint64_t const maxBits = (bitmap->_mapSize - sizeof(Header))/sizeof(Word)*64;
+    if (header->nBits > maxBits) {
+        throw ConfigError("Truncated empty chunks file " + path);
+    }
+    if (header->count > header->nBits) {
+        throw ConfigError("Invalid empty chunks file " + path);
+    }
+    bitmap->_nBits = header->nBits;
+    bitmap->_count = header->count;
+    bitmap->_words = reinterpret_cast<Word const*>(static_cast<char const*>(map) + sizeof(Header));
+    LOGS(_log, LOG_LVL_DEBUG, "Mapped empty chunks file " << path << " chunks=" << bitmap->_count);
+    return bitmap;
+}
+
+void
+ChunkBitmap::writeBinary(std::ostream& out) const {
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.nBits = _nBits;
+    header.count = _count;
+    header.reserved = 0;
+    out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    out.write(reinterpret_cast<char const*>(_words), wordCount(_nBits)*sizeof(Word));
+}
+
+IntSet
+ChunkBitmap::toIntSet() const {
+    IntSet result;
+    for (std::size_t i = 0, n = wordCount(_nBits); i != n; ++i) {
+        for (Word w = _words[i]; w != 0; w &= w - 1) {
+            result.insert(result.end(), int(i*64 + __builtin_ctzll(w)));
+        }
+    }
+    return result;
+}
+
+}}} // namespace lsst::qserv::css
@@ -0,0 +1,125 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_QSERV_CSS_CHUNKBITMAP_H
+#define LSST_QSERV_CSS_CHUNKBITMAP_H
+
+// System headers
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Qserv headers
+#include "global/intTypes.h"
+
+namespace lsst {
+namespace qserv {
+namespace css {
+
+/**
+ *  @brief Dense bitmap of (non-negative) chunk ids.
+ *
+ *  Used for empty chunk lists which may contain ~1M chunk ids per database,
+ *  membership test is a single word load. Bitmap is either built in memory
+ *  from a text list of chunk ids or memory-mapped from a binary file made
+ *  by writeBinary() (or admin/bin/qserv-empty-chunks-file.py). Binary file
+ *  has a 32-byte header (magic "QSVEMPT1", number of bits, number of set
+ *  bits, reserved) followed by 64-bit little-endian words, bit for chunk c
+ *  is bit c%64 of word c/64.
+ */
+class ChunkBitmap {
+public:
+    typedef std::uint64_t Word;
+    typedef std::shared_ptr<ChunkBitmap const> ConstPtr;
+
+    /// Make empty bitmap.
+    ChunkBitmap() {}
+
+    /// Make bitmap from a list of chunk ids, negative ids are ignored.
+    explicit ChunkBitmap(std::vector<int> const& chunks);
+
+    ~ChunkBitmap();
+
+    ChunkBitmap(ChunkBitmap const&) = delete;
+    ChunkBitmap& operator=(ChunkBitmap const&) = delete;
+
+    /// Read whitespace-separated chunk ids.
+    static ConstPtr readText(std::istream& input);
+
+    /// Load file in either binary (mapped) or text format.
+    /// @throws ConfigError if file cannot be read or is invalid
+    static ConstPtr load(std::string const& path);
+
+    /// @return true if file starts with binary format signature
+    static bool isBinaryFile(std::string const& path);
+
+    /// Write bitmap in binary format.
+    void writeBinary(std::ostream& out) const;
+
+    /// @return true if chunk is in the bitmap
+    bool contains(int chunk) const {
+        auto const c = static_cast<std::uint64_t>(static_cast<unsigned>(chunk));
+        return chunk >= 0 && c < _nBits && ((_words[c >> 6] >> (c & 63)) & 1);
+    }
+
+    /// @return number of chunks in the bitmap
+    std::size_t count() const { return _count; }
+
+    /// @return true if bitmap is memory-mapped from a file
+    bool isMapped() const { return _map != nullptr; }
+
+    /// Convert to a set, expensive for large bitmaps.
+    IntSet toIntSet() const;
+
+    /**
+     *  Remove from vector all elements whose chunk id is in the bitmap,
+     *  preserving order of remaining elements.
+     *
+     *  @param items:    vector to filter
+     *  @param chunkId:  functor returning chunk id of an element
+     */
+    template <typename T, typename ChunkIdFunc>
+    void eraseFrom(std::vector<T>& items, ChunkIdFunc chunkId) const {
+        if (_count == 0) return;
+        items.erase(std::remove_if(items.begin(), items.end(),
+                                   [this, &chunkId](T const& item) { return contains(chunkId(item)); }),
+                    items.end());
+    }
+
+private:
+    std::vector<Word> _ownWords;
+    Word const* _words = nullptr;
+    std::uint64_t _nBits = 0;
+    std::size_t _count = 0;
+    void* _map = nullptr;
+    std::size_t _mapSize = 0;
+};
+
+}}} // namespace lsst::qserv::css
+
+#endif // LSST_QSERV_CSS_CHUNKBITMAP_H
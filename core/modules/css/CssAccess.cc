@@ -25,6 +25,7 @@
 
 // System headers
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <map>
 #include <sstream>
@@ -45,6 +46,7 @@
 #include "css/KvInterface.h"
 #include "css/KvInterfaceImplMem.h"
 #include "css/KvInterfaceImplMySql.h"
+#include "css/KvInterfaceSnapshot.h"
 #include "mysql/MySqlConfig.h"
 #include "util/IterableFormatter.h"
 
@@ -116,7 +118,14 @@ CssAccess::createFromConfig(std::map<std::string, std::string> const& config,
         }
     } else if (cssConfig.getTechnology() == "mysql") {
         LOGS(_log, LOG_LVL_DEBUG, "Create CSS instance with mysql store " << cssConfig.getMySqlConfig());
-        auto kvi = std::make_shared<KvInterfaceImplMySql>(cssConfig.getMySqlConfig(), readOnly);
+        std::shared_ptr<KvInterface> kvi = std::make_shared<KvInterfaceImplMySql>(cssConfig.getMySqlConfig(),
+                                                                                 readOnly);
+        if (cssConfig.getSnapshotInterval() > 0) {
+            LOGS(_log, LOG_LVL_DEBUG, "Serve CSS reads from snapshot, check interval "
+                 << cssConfig.getSnapshotInterval() << " ms");
+            kvi = std::make_shared<KvInterfaceSnapshot>(
+                kvi, std::chrono::milliseconds(cssConfig.getSnapshotInterval()));
+        }
         return std::shared_ptr<CssAccess>(new CssAccess(kvi, std::make_shared<EmptyChunks>(emptyChunkPath)));
     } else {
         LOGS(_log, LOG_LVL_DEBUG, "Unexpected value of \"technology\" key: " << cssConfig.getTechnology());
@@ -189,6 +198,11 @@ CssAccess::getDbStatus() const {
     return kvs;
 }
 
+std::string
+CssAccess::getGeneration() const {
+    return _kvI->get(GENERATION_KEY, std::string());
+}
+
 void
 CssAccess::setDbStatus(std::string const& dbName, std::string const& status) {
     LOGS(_log, LOG_LVL_DEBUG, "setDbStatus(" << dbName << ", " << status << ")");
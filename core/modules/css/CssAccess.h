@@ -488,6 +488,17 @@ public:
      */
     EmptyChunks const& getEmptyChunks() const { return *_emptyChunks; }
 
+    /**
+     *  Return CSS generation counter.
+     *
+     *  Counter changes with every modification of CSS contents, clients can
+     *  use it to invalidate data derived from CSS. Empty string is returned
+     *  if CSS does not maintain the counter.
+     *
+     *  @throws CssError: for all CSS errors
+     */
+    std::string getGeneration() const;
+
     /**
      *  Return underlying KvInterface instance.
      *
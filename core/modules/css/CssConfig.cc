@@ -54,7 +54,8 @@ CssConfig::CssConfig(util::ConfigStore const& configStore)
            configStore.get("hostname"),
            configStore.getInt("port"),
            configStore.get("socket"),
-           configStore.get("database")) {
+           configStore.get("database")),
+      _snapshotInterval(configStore.getInt("snapshotInterval", 0)) {
 
     if (_technology.empty()) {
         std::string msg = "\"technology\" does not exist in configuration map";
@@ -73,7 +74,8 @@ CssConfig::CssConfig(util::ConfigStore const& configStore)
 
 std::ostream& operator<<(std::ostream &out, CssConfig const& cssConfig) {
     out << "[ technology=" << cssConfig._technology << ", data=" << cssConfig._data
-        << ", file=" << cssConfig._file << ", mysql_configuration=" << cssConfig._mySqlConfig <<"]";
+        << ", file=" << cssConfig._file << ", mysql_configuration=" << cssConfig._mySqlConfig
+        << ", snapshotInterval=" << cssConfig._snapshotInterval << "]";
     return out;
 }
 
@@ -100,6 +100,15 @@ public:
         return _technology;
     }
 
+    /* Get interval between checks for CSS modifications
+     *
+     * @return interval in milliseconds, 0 means that CSS contents are not
+     *         cached in memory and every request goes to the store
+     */
+    int getSnapshotInterval() const {
+        return _snapshotInterval;
+    }
+
 private:
 
     CssConfig(util::ConfigStore const& configStore);
@@ -113,6 +122,9 @@ private:
     // used by "mysql" technology
     mysql::MySqlConfig const _mySqlConfig;
 
+    // used by "mysql" technology, in milliseconds
+    int const _snapshotInterval;
+
 };
 
 }}} // namespace lsst::qserv::css
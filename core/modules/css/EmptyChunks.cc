@@ -25,11 +25,7 @@
 #include "css/EmptyChunks.h"
 
 // System headers
-#include <algorithm>
-#include <iterator>
-#include <fstream>
-#include <functional>
-#include <memory>
+#include <sys/stat.h>
 
 // LSST headers
 #include "lsst/log/Log.h"
@@ -39,39 +35,41 @@
 #include "global/stringUtil.h"
 
 using lsst::qserv::ConfigError;
-using lsst::qserv::IntSet;
 
 namespace {
 
 LOG_LOGGER _log = LOG_GET("lsst.qserv.css.EmptyChunks");
 
-std::string
-makeFilename(std::string const& db) {
-    return "empty_" + lsst::qserv::sanitizeName(db) + ".txt";
+struct FileId {
+    std::string name;
+    long long mtimeNs = 0;
+    long long size = -1;
+    unsigned long long inode = 0;
+};
+
+bool
+statFile(std::string const& name, FileId& id) {
+    struct stat st;
+    if (::stat(name.c_str(), &st) != 0 || not S_ISREG(st.st_mode)) {
+        return false;
+    }
+    id.name = name;
+    id.mtimeNs = st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+    id.size = st.st_size;
+    id.inode = st.st_ino;
+    return true;
 }
 
-void
-populate(std::string const& path,
+// Find file to read for a database, binary format is preferred
+bool
+findFile(std::string const& path,
          std::string const& fallbackFile,
-         IntSet& s,
-         std::string const& db) {
-    std::string const best = path + "/" + makeFilename(db);
-    std::string fileName = best;
-    std::ifstream rawStream(best.c_str());
-    if (!rawStream.good()) { // On error, try using default filename
-        rawStream.close();
-        rawStream.open(fallbackFile.c_str());
-        fileName = fallbackFile;
-    }
-    LOGS(_log, LOG_LVL_DEBUG, "Reading empty chunks for db " << db << " from file " << fileName);
-    if (!rawStream.good()) {
-        throw ConfigError("No such empty chunks file: " + best
-                          + " or " + fallbackFile);
-    }
-    std::istream_iterator<int> chunkStream(rawStream);
-    std::istream_iterator<int> eos;
-    std::copy(chunkStream, eos, std::insert_iterator<IntSet>(s, s.begin()));
+         std::string const& db,
+         FileId& id) {
+    std::string const base = path + "/empty_" + lsst::qserv::sanitizeName(db);
+    return statFile(base + ".bin", id) || statFile(base + ".txt", id) || statFile(fallbackFile, id);
 }
+
 } // anonymous namespace
 
 namespace lsst {
@@ -80,32 +78,88 @@ namespace css {
 
 std::shared_ptr<IntSet const>
 EmptyChunks::getEmpty(std::string const& db) const {
-    std::lock_guard<std::mutex> lock(_setsMutex);
-    IntSetMap::const_iterator i = _sets.find(db);
-    if (i != _sets.end()) {
-        IntSetConstPtr readOnly = i->second;
-        return readOnly;
+    auto bitmap = getEmptyBitmap(db);
+    {
+        std::lock_guard<std::mutex> lock(_entriesMutex);
+        auto iter = _entries.find(db);
+        if (iter != _entries.end() and iter->second.bitmap == bitmap and iter->second.intSet) {
+            return iter->second.intSet;
+        }
+    }
+    auto intSet = std::make_shared<IntSet const>(bitmap->toIntSet());
+    std::lock_guard<std::mutex> lock(_entriesMutex);
+    auto iter = _entries.find(db);
+    if (iter != _entries.end() and iter->second.bitmap == bitmap) {
+        iter->second.intSet = intSet;
+    }
+    return intSet;
+}
+
+ChunkBitmap::ConstPtr
+EmptyChunks::getEmptyBitmap(std::string const& db) const {
+    auto const now = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(_entriesMutex);
+        auto iter = _entries.find(db);
+        if (iter != _entries.end() and now < iter->second.nextCheck) {
+            return iter->second.bitmap;
+        }
+    }
+
+    FileId id;
+    bool const found = findFile(_path, _fallbackFile, db, id);
+
+    std::lock_guard<std::mutex> lock(_entriesMutex);
+    auto iter = _entries.find(db);
+    if (iter != _entries.end()) {
+        Entry& entry = iter->second;
+        if (not found or (entry.fileName == id.name and entry.mtimeNs == id.mtimeNs
+                          and entry.size == id.size and entry.inode == id.inode)) {
+            // unchanged, or file disappeared after we have read it
+            entry.nextCheck = now + _checkInterval;
+            return entry.bitmap;
+        }
+    }
+    if (not found) {
+        throw ConfigError("No such empty chunks file: " + _path + "/empty_" + sanitizeName(db)
+                          + ".{bin,txt} or " + _fallbackFile);
+    }
+
+    LOGS(_log, LOG_LVL_DEBUG, "Reading empty chunks for db " << db << " from file " << id.name);
+    ChunkBitmap::ConstPtr bitmap;
+    try {
+        bitmap = ChunkBitmap::load(id.name);
+    } catch (ConfigError const& exc) {
+        if (iter == _entries.end()) throw;
+        // e.g. file is being rewritten, keep using what we have
+        LOGS(_log, LOG_LVL_WARN, "Failed to reload empty chunks for db " << db << ": " << exc.what());
+        return iter->second.bitmap;
     }
-    IntSetPtr newSet = std::make_shared<IntSet>();
-    _sets.insert(IntSetMap::value_type(db, newSet));
-    populate(_path, _fallbackFile, *newSet, db); // Populate reference
-    return IntSetConstPtr(newSet);
+    Entry& entry = _entries[db];
+    entry.bitmap = bitmap;
+    entry.intSet.reset();
+    entry.nextCheck = now + _checkInterval;
+    entry.fileName = id.name;
+    entry.mtimeNs = id.mtimeNs;
+    entry.size = id.size;
+    entry.inode = id.inode;
+    return bitmap;
 }
 
 bool
 EmptyChunks::isEmpty(std::string const& db, int chunk) const {
-    IntSetConstPtr s = getEmpty(db);
-    return s->end() != s->find(chunk);
+    return getEmptyBitmap(db)->contains(chunk);
 }
 
 void
 EmptyChunks::clearCache(std::string const& db) const {
+    std::lock_guard<std::mutex> lock(_entriesMutex);
     if (db.empty()) {
         LOGS(_log, LOG_LVL_DEBUG, "Clearing empty chunks cache for all databases");
-        _sets.clear();
+        _entries.clear();
     } else {
         LOGS(_log, LOG_LVL_DEBUG, "Clearing empty chunks cache for database " << db);
-        _sets.erase(db);
+        _entries.erase(db);
     }
 }
 
@@ -34,12 +34,14 @@
 #define LSST_QSERV_CSS_EMPTYCHUNKS_H
 
 // System headers
+#include <chrono>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 
 // Qserv headers
+#include "css/ChunkBitmap.h"
 #include "global/intTypes.h"
 
 namespace lsst {
@@ -51,17 +53,27 @@ namespace css {
 /// per-partitioning-group scheme, at which point, we will re-think
 /// the db-based dispatch as well (user tables in the partitioning
 /// group may be extremely sparse).
+///
+/// Empty chunks for a database are read from empty_<db>.bin (binary
+/// bitmap, see ChunkBitmap) or empty_<db>.txt in the search path, or from
+/// the fallback file. Cached lists are reloaded when their file changes,
+/// files are checked for changes at most once per check interval.
 class EmptyChunks {
 public:
     EmptyChunks(std::string const& path=".",
-                std::string const& fallbackFile="emptyChunks.txt")
-        : _path(path), _fallbackFile(fallbackFile) {}
+                std::string const& fallbackFile="emptyChunks.txt",
+                std::chrono::milliseconds checkInterval=std::chrono::seconds(10))
+        : _path(path), _fallbackFile(fallbackFile), _checkInterval(checkInterval) {}
 
     // accessors
 
-    /// @return set of empty chunks for this db
+    /// @return set of empty chunks for this db, prefer getEmptyBitmap()
+    /// which does not need conversion
     std::shared_ptr<IntSet const> getEmpty(std::string const& db) const;
 
+    /// @return bitmap of empty chunks for this db
+    ChunkBitmap::ConstPtr getEmptyBitmap(std::string const& db) const;
+
     /// @return true if db/chunk is empty
     bool isEmpty(std::string const& db, int chunk) const;
 
@@ -72,15 +84,25 @@ public:
 
 private:
 
-    // Convenience types
-    typedef std::shared_ptr<IntSet> IntSetPtr;
-    typedef std::shared_ptr<IntSet const> IntSetConstPtr;
+    typedef std::chrono::steady_clock Clock;
+
+    // Cached bitmap and identity of the file it was read from
+    struct Entry {
+        ChunkBitmap::ConstPtr bitmap;
+        std::shared_ptr<IntSet const> intSet; ///< made from bitmap on demand
+        Clock::time_point nextCheck;
+        std::string fileName;
+        long long mtimeNs = 0;
+        long long size = -1;
+        unsigned long long inode = 0;
+    };
+    typedef std::map<std::string, Entry> EntryMap;
 
-    typedef std::map<std::string, IntSetPtr> IntSetMap;
     std::string _path; ///< Search path for empty chunks files
     std::string _fallbackFile; ///< Fallback path for empty chunks
-    mutable IntSetMap _sets; ///< Container for empty chunks sets (cache)
-    mutable std::mutex _setsMutex;
+    Clock::duration _checkInterval; ///< Minimum time between file checks
+    mutable EntryMap _entries; ///< Empty chunks bitmaps (cache)
+    mutable std::mutex _entriesMutex;
 };
 
 }}} // namespace lsst::qserv::css
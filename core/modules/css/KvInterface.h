@@ -144,6 +144,14 @@ public:
      */
     virtual std::string dumpKV() = 0;
 
+    /**
+     *  Returns complete CSS contents as a map of full key names to values,
+     *  the root key is not included.
+     *
+     *  Unlike dumpKV() this has no restrictions on the values.
+     */
+    virtual std::map<std::string, std::string> getAll() = 0;
+
 protected:
     KvInterface() {}
     virtual std::string _get(std::string const& key,
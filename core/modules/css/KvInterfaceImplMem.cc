@@ -275,6 +275,13 @@ std::string KvInterfaceImplMem::dumpKV() {
     return result;
 }
 
+std::map<std::string, std::string> KvInterfaceImplMem::getAll() {
+    std::map<std::string, std::string> result(_kvMap);
+    result.erase(std::string());
+    result.erase("/");
+    return result;
+}
+
 void KvInterfaceImplMem::_init(std::istream& mapStream) {
     if (mapStream.fail()) {
         throw ConnError();
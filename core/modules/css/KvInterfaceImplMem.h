@@ -64,6 +64,7 @@ public:
     virtual std::map<std::string, std::string> getChildrenValues(std::string const& key) override;
     virtual void deleteKey(std::string const& key) override;
     virtual std::string dumpKV() override;
+    virtual std::map<std::string, std::string> getAll() override;
 
     std::shared_ptr<KvInterfaceImplMem> clone() const;
 
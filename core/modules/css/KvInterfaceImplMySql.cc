@@ -53,6 +53,7 @@
 #include "lsst/log/Log.h"
 
 // Qserv headers
+#include "css/constants.h"
 #include "css/CssError.h"
 #include "sql/SqlResults.h"
 #include "sql/SqlTransaction.h"
@@ -274,6 +275,7 @@ KvInterfaceImplMySql::create(std::string const& key, std::string const& value, b
         _create(path, value, false, transaction);
     }
 
+    _bumpGeneration(transaction);
     transaction.commit();
     return path;
 }
@@ -332,6 +334,7 @@ KvInterfaceImplMySql::set(std::string const& key, std::string const& value) {
     // key is validated by _create
     KvTransaction transaction(_conn);
     _create(key, value, true, transaction);
+    _bumpGeneration(transaction);
     transaction.commit();
 }
 
@@ -532,6 +535,7 @@ KvInterfaceImplMySql::deleteKey(std::string const& keyArg) {
     if (key == "/") key.erase();
     KvTransaction transaction(_conn);
     _delete(key, transaction);
+    _bumpGeneration(transaction);
     transaction.commit();
 }
 
@@ -582,6 +586,58 @@ std::string KvInterfaceImplMySql::dumpKV() {
 }
 
 
+std::map<std::string, std::string> KvInterfaceImplMySql::getAll() {
+
+    std::string query = "SELECT kvKey, kvVal FROM kvData";
+
+    KvTransaction transaction(_conn);
+    sql::SqlErrorObject errObj;
+    sql::SqlResults results;
+    LOGS(_log, LOG_LVL_DEBUG, "getAll - executing query: " << query);
+    if (not _conn.runQuery(query, results, errObj)) {
+        std::stringstream ss;
+        ss << "getAll - " << query << " failed with err: " << errObj.errMsg() << std::ends;
+        LOGS(_log, LOG_LVL_ERROR, ss.str());
+        throw CssError(ss.str());
+    }
+
+    std::map<std::string, std::string> result;
+    for (auto& row: results) {
+        if (row[0].first[0] == '\0') {
+            // skip root key
+            continue;
+        }
+        result.insert(std::make_pair(std::string(row[0].first, row[0].second),
+                                     row[1].first ? std::string(row[1].first, row[1].second) : std::string()));
+    }
+
+    transaction.commit();
+    return result;
+}
+
+
+void
+KvInterfaceImplMySql::_bumpGeneration(KvTransaction const& transaction) {
+    if (not transaction.isActive()) {
+        throw CssError("A transaction must active here.");
+    }
+
+    std::string query = str(boost::format("UPDATE kvData SET kvVal=CAST(kvVal AS UNSIGNED)+1 WHERE kvKey='%1%'")
+                            % GENERATION_KEY);
+    sql::SqlErrorObject errObj;
+    sql::SqlResults results;
+    LOGS(_log, LOG_LVL_DEBUG, "_bumpGeneration - executing query: " << query);
+    if (not _conn.runQuery(query, results, errObj)) {
+        LOGS(_log, LOG_LVL_ERROR, "_bumpGeneration - " << query << " failed with err: " << errObj.errMsg());
+        throw CssError(errObj);
+    }
+    if (results.getAffectedRows() == 0) {
+        // CSS made before generation counter was introduced
+        _create(GENERATION_KEY, "1", true, transaction);
+    }
+}
+
+
 void
 KvInterfaceImplMySql::_delete(std::string const& key, KvTransaction const& transaction) {
     if (not transaction.isActive()) {
@@ -75,6 +75,8 @@ public:
 
     virtual std::string dumpKV() override;
 
+    virtual std::map<std::string, std::string> getAll() override;
+
 protected:
     virtual std::string _get(std::string const& key,
                              std::string const& defaultValue,
@@ -114,6 +116,11 @@ private:
      */
     void _delete(std::string const& key, KvTransaction const& transaction);
 
+    /**
+     * @brief increment the CSS generation counter, create it if it does not exist
+     */
+    void _bumpGeneration(KvTransaction const& transaction);
+
     /**
      * @brief Validate key string our key rules.
      * @param key
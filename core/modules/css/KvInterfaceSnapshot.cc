@@ -0,0 +1,213 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "css/KvInterfaceSnapshot.h"
+
+// LSST headers
+#include "lsst/log/Log.h"
+
+// Qserv headers
+#include "css/constants.h"
+#include "css/CssError.h"
+
+namespace {
+
+LOG_LOGGER _log = LOG_GET("lsst.qserv.css.KvInterfaceSnapshot");
+
+std::int64_t nowTicks() {
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+// Root key is implicit, parent of a top-level key is "/"
+std::string parentKey(std::string const& key, std::string* name) {
+    auto pos = key.rfind('/');
+    if (pos == std::string::npos) {
+        *name = key;
+        return "/";
+    }
+    *name = key.substr(pos + 1);
+    return pos == 0 ? std::string("/") : key.substr(0, pos);
+}
+
+} // namespace
+
+namespace lsst {
+namespace qserv {
+namespace css {
+
+KvInterfaceSnapshot::KvInterfaceSnapshot(std::shared_ptr<KvInterface> const& backend,
+                                         std::chrono::milliseconds checkInterval)
+    : _backend(backend), _checkInterval(checkInterval), _nextCheck(0), _reloadCount(0) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _reload(_backend->get(GENERATION_KEY, std::string()));
+}
+
+std::string
+KvInterfaceSnapshot::create(std::string const& key, std::string const& value, bool unique) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto path = _backend->create(key, value, unique);
+    _reload(_backend->get(GENERATION_KEY, std::string()));
+    return path;
+}
+
+void
+KvInterfaceSnapshot::set(std::string const& key, std::string const& value) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _backend->set(key, value);
+    _reload(_backend->get(GENERATION_KEY, std::string()));
+}
+
+bool
+KvInterfaceSnapshot::exists(std::string const& key) {
+    auto snap = _current();
+    return key == "/" or snap->values.count(key) > 0;
+}
+
+std::map<std::string, std::string>
+KvInterfaceSnapshot::getMany(std::vector<std::string> const& keys) {
+    auto snap = _current();
+    std::map<std::string, std::string> result;
+    for (auto const& key: keys) {
+        auto iter = snap->values.find(key);
+        if (iter != snap->values.end()) {
+            result.insert(*iter);
+        }
+    }
+    return result;
+}
+
+std::vector<std::string>
+KvInterfaceSnapshot::getChildren(std::string const& key) {
+    auto snap = _current();
+    auto iter = snap->children.find(key);
+    if (iter != snap->children.end()) {
+        return iter->second;
+    }
+    if (key != "/" and snap->values.count(key) == 0) {
+        throw NoSuchKey(key);
+    }
+    return std::vector<std::string>();
+}
+
+std::map<std::string, std::string>
+KvInterfaceSnapshot::getChildrenValues(std::string const& key) {
+    auto snap = _current();
+    std::map<std::string, std::string> result;
+    auto iter = snap->children.find(key);
+    if (iter == snap->children.end()) {
+        if (key != "/" and snap->values.count(key) == 0) {
+            throw NoSuchKey(key);
+        }
+        return result;
+    }
+    std::string const pfx(key == "/" ? key : key + "/");
+    for (auto const& child: iter->second) {
+        result.insert(std::make_pair(child, snap->values.at(pfx + child)));
+    }
+    return result;
+}
+
+void
+KvInterfaceSnapshot::deleteKey(std::string const& key) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _backend->deleteKey(key);
+    _reload(_backend->get(GENERATION_KEY, std::string()));
+}
+
+std::string
+KvInterfaceSnapshot::dumpKV() {
+    // rarely used, format is defined by backend
+    return _backend->dumpKV();
+}
+
+std::map<std::string, std::string>
+KvInterfaceSnapshot::getAll() {
+    return _current()->values;
+}
+
+std::string
+KvInterfaceSnapshot::generation() {
+    return _current()->generation;
+}
+
+std::string
+KvInterfaceSnapshot::_get(std::string const& key,
+                          std::string const& defaultValue,
+                          bool throwIfKeyNotFound) {
+    auto snap = _current();
+    auto iter = snap->values.find(key);
+    if (iter == snap->values.end()) {
+        if (throwIfKeyNotFound) {
+            throw NoSuchKey(key);
+        }
+        return defaultValue;
+    }
+    return iter->second;
+}
+
+KvInterfaceSnapshot::SnapshotPtr
+KvInterfaceSnapshot::_current() {
+    auto const now = nowTicks();
+    if (now >= _nextCheck.load(std::memory_order_relaxed)) {
+        // only one thread does the check, others keep using what they have
+        std::unique_lock<std::mutex> lock(_mtx, std::try_to_lock);
+        if (lock.owns_lock() and now >= _nextCheck.load()) {
+            try {
+                auto generation = _backend->get(GENERATION_KEY, std::string());
+                if (generation != std::atomic_load(&_snapshot)->generation) {
+                    LOGS(_log, LOG_LVL_DEBUG, "CSS generation changed to " << generation);
+                    _reload(generation);
+                } else {
+                    _nextCheck = nowTicks() + _checkInterval.count();
+                }
+            } catch (CssError const& exc) {
+                // keep serving old data, try again after interval
+                LOGS(_log, LOG_LVL_WARN, "failed to refresh CSS snapshot: " << exc.what());
+                _nextCheck = nowTicks() + _checkInterval.count();
+            }
+        }
+    }
+    return std::atomic_load(&_snapshot);
+}
+
+void
+KvInterfaceSnapshot::_reload(std::string const& generation) {
+    auto snap = std::make_shared<Snapshot>();
+    snap->generation = generation;
+    snap->values = _backend->getAll();
+    for (auto const& pair: snap->values) {
+        std::string name;
+        auto parent = ::parentKey(pair.first, &name);
+        if (not name.empty()) {
+            snap->children[parent].push_back(name);
+        }
+    }
+    LOGS(_log, LOG_LVL_DEBUG, "loaded CSS snapshot, generation=" << generation
+         << " keys=" << snap->values.size());
+    std::atomic_store(&_snapshot, SnapshotPtr(snap));
+    ++ _reloadCount;
+    _nextCheck = nowTicks() + _checkInterval.count();
+}
+
+}}} // namespace lsst::qserv::css
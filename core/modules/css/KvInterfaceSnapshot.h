@@ -0,0 +1,125 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_QSERV_CSS_KVINTERFACESNAPSHOT_H
+#define LSST_QSERV_CSS_KVINTERFACESNAPSHOT_H
+
+// System headers
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Qserv headers
+#include "css/KvInterface.h"
+
+namespace lsst {
+namespace qserv {
+namespace css {
+
+/// @addtogroup css
+
+/**
+ *  @ingroup css
+ *
+ *  @brief KvInterface which serves reads from an in-memory snapshot.
+ *
+ *  Complete contents of the wrapped KvInterface are loaded at construction
+ *  and are used to answer all read requests without talking to backend.
+ *  Backend is polled for the CSS generation counter (GENERATION_KEY) at most
+ *  once per check interval, snapshot is reloaded when counter has changed.
+ *  Writes are forwarded to backend and followed by immediate reload so that
+ *  the process always sees its own modifications.
+ *
+ *  Readers never block each other: snapshot is replaced atomically, reload
+ *  is done by one thread while others continue using old snapshot.
+ */
+class KvInterfaceSnapshot : public KvInterface {
+public:
+
+    /**
+     *  @param backend:  Instance which holds authoritative data
+     *  @param checkInterval:  Minimum time between checks of generation counter
+     *  @throws CssError if initial load fails
+     */
+    KvInterfaceSnapshot(std::shared_ptr<KvInterface> const& backend,
+                        std::chrono::milliseconds checkInterval);
+
+    // Instances cannot be copied
+    KvInterfaceSnapshot(KvInterfaceSnapshot const&) = delete;
+    KvInterfaceSnapshot& operator=(KvInterfaceSnapshot const&) = delete;
+
+    virtual std::string create(std::string const& key, std::string const& value,
+                               bool unique=false) override;
+    virtual void set(std::string const& key, std::string const& value) override;
+    virtual bool exists(std::string const& key) override;
+    virtual std::map<std::string, std::string> getMany(std::vector<std::string> const& keys) override;
+    virtual std::vector<std::string> getChildren(std::string const& key) override;
+    virtual std::map<std::string, std::string> getChildrenValues(std::string const& key) override;
+    virtual void deleteKey(std::string const& key) override;
+    virtual std::string dumpKV() override;
+    virtual std::map<std::string, std::string> getAll() override;
+
+    /// Generation counter value of the current snapshot, empty if backend has none.
+    std::string generation();
+
+    /// Number of times snapshot was (re)loaded from backend.
+    unsigned reloadCount() const { return _reloadCount; }
+
+protected:
+    virtual std::string _get(std::string const& key,
+                             std::string const& defaultValue,
+                             bool throwIfKeyNotFound) override;
+
+private:
+
+    struct Snapshot {
+        std::string generation;
+        std::map<std::string, std::string> values;
+        // maps key to the names (not full keys) of its children
+        std::unordered_map<std::string, std::vector<std::string>> children;
+    };
+    typedef std::shared_ptr<Snapshot const> SnapshotPtr;
+
+    // Returns current snapshot, checking for new generation if it is time
+    SnapshotPtr _current();
+
+    // Builds new snapshot from backend, must be called with _mtx locked
+    void _reload(std::string const& generation);
+
+    std::shared_ptr<KvInterface> const _backend;
+    std::chrono::steady_clock::duration const _checkInterval;
+    SnapshotPtr _snapshot;  // only accessed via std::atomic_load/atomic_store
+    std::atomic<std::int64_t> _nextCheck;  // steady_clock ticks
+    std::atomic<unsigned> _reloadCount;
+    std::mutex _mtx;  // serializes reloads and writes
+};
+
+}}} // namespace lsst::qserv::css
+
+#endif // LSST_QSERV_CSS_KVINTERFACESNAPSHOT_H
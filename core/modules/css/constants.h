@@ -40,6 +40,11 @@ int const VERSION = 1; ///< Current supported version (integer)
 // conversions I define this string once and use it with kvInterface
 char const VERSION_STR[] = "1"; ///< Current supported version
 
+// Generation counter of CSS contents, incremented by KvInterfaceImplMySql
+// with every modification. Clients caching CSS data compare it with the
+// value they have seen to find out if their copy is outdated.
+char const GENERATION_KEY[] = "/css_meta/generation";
+
 // Set of values used for database and table status.
 
 /// This status means CSS data is in inconsistent state, do not use.
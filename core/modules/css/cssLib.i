@@ -31,6 +31,7 @@ Access to the classes from the qserv_css library
 %{
 #define SWIG_FILE_WITH_INIT
 #include "css/constants.h"
+#include "css/ChunkBitmap.h"
 #include "css/CssAccess.h"
 #include "css/CssError.h"
 #include "css/EmptyChunks.h"
@@ -132,11 +133,13 @@ class ConfigError(CssError):
 }
 
 %include "std_shared_ptr.i"
+%shared_ptr(lsst::qserv::css::ChunkBitmap)
 %shared_ptr(lsst::qserv::css::CssAccess)
 %shared_ptr(lsst::qserv::css::KvInterface)
 
 %include "css/constants.h"
 %include "global/intTypes.h"
+%include "css/ChunkBitmap.h"
 %include "css/EmptyChunks.h"
 %include "css/KvInterface.h"
 %include "css/MatchTableParams.h"
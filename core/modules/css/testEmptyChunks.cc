@@ -23,12 +23,16 @@
 
 // System headers
 #include <cassert>
+#include <chrono>
+#include <cstdio>
 #include <unistd.h>
 
 // Third-party headers
 
 // Local headers
+#include "css/ChunkBitmap.h"
 #include "css/EmptyChunks.h"
+#include "global/ConfigError.h"
 
 
 // Boost unit test header
@@ -124,5 +128,98 @@ BOOST_AUTO_TEST_CASE(Basic) {
 
 }
 
+BOOST_AUTO_TEST_CASE(Bitmap) {
+    lsst::qserv::css::ChunkBitmap empty;
+    BOOST_CHECK(not empty.contains(0));
+    BOOST_CHECK_EQUAL(empty.count(), 0U);
+
+    lsst::qserv::css::ChunkBitmap bitmap(std::vector<int>{0, 5, 63, 64, 1000, 5, -3});
+    BOOST_CHECK_EQUAL(bitmap.count(), 5U);
+    BOOST_CHECK(bitmap.contains(0));
+    BOOST_CHECK(bitmap.contains(63));
+    BOOST_CHECK(bitmap.contains(64));
+    BOOST_CHECK(bitmap.contains(1000));
+    BOOST_CHECK(not bitmap.contains(1));
+    BOOST_CHECK(not bitmap.contains(1001));
+    BOOST_CHECK(not bitmap.contains(-3));
+    lsst::qserv::IntSet expected{0, 5, 63, 64, 1000};
+    BOOST_CHECK(bitmap.toIntSet() == expected);
+
+    std::vector<int> ids{1, 5, 64, 2000, 0};
+    bitmap.eraseFrom(ids, [](int c) { return c; });
+    BOOST_CHECK(ids == std::vector<int>({1, 2000}));
+}
+
+BOOST_AUTO_TEST_CASE(BinaryAndReload) {
+    std::string const binFile = dummyFile._path + "/empty_TestOne.bin";
+    {
+        lsst::qserv::css::ChunkBitmap bitmap(std::vector<int>{7, 4000});
+        std::ofstream out(binFile, std::ios::binary);
+        bitmap.writeBinary(out);
+    }
+    BOOST_CHECK(lsst::qserv::css::ChunkBitmap::isBinaryFile(binFile));
+
+    // binary file takes precedence over text file
+    EmptyChunks ec(dummyFile._path, dummyFile._fallback, std::chrono::milliseconds(0));
+    auto bitmap = ec.getEmptyBitmap("TestOne");
+    BOOST_CHECK(bitmap->isMapped());
+    BOOST_CHECK_EQUAL(bitmap->count(), 2U);
+    BOOST_CHECK(ec.isEmpty("TestOne", 4000));
+    BOOST_CHECK(not ec.isEmpty("TestOne", 3));
+
+    // replaced file is picked up without clearCache()
+    std::string const tmpFile = binFile + ".tmp";
+    {
+        lsst::qserv::css::ChunkBitmap bitmap(std::vector<int>{8});
+        std::ofstream out(tmpFile, std::ios::binary);
+        bitmap.writeBinary(out);
+    }
+    BOOST_CHECK_EQUAL(::rename(tmpFile.c_str(), binFile.c_str()), 0);
+    BOOST_CHECK(ec.isEmpty("TestOne", 8));
+    BOOST_CHECK(not ec.isEmpty("TestOne", 7));
+    // old snapshot is still usable
+    BOOST_CHECK(bitmap->contains(7));
+
+    // truncated binary file is rejected
+    {
+        std::ofstream out(tmpFile, std::ios::binary);
+        out.write("QSVEMPT1\xff\xff\xff\xff", 12);
+    }
+    BOOST_CHECK_THROW(lsst::qserv::css::ChunkBitmap::load(tmpFile), lsst::qserv::ConfigError);
+
+    // header with a bit count that would overflow the size computation
+    {
+        std::ofstream out(tmpFile, std::ios::binary);
+        char header[32] = "QSVEMPT1";
+        for (int i = 8; i < 24; ++i) header[i] = '\xff';
+        out.write(header, sizeof(header));
+    }
+    BOOST_CHECK_THROW(lsst::qserv::css::ChunkBitmap::load(tmpFile), lsst::qserv::ConfigError);
+    std::remove(tmpFile.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(CheckInterval) {
+    std::string const binFile = dummyFile._path + "/empty_TestTwo.bin";
+    EmptyChunks ec(dummyFile._path, dummyFile._fallback, std::chrono::hours(1));
+    auto s = ec.getEmpty("TestTwo");
+    BOOST_CHECK(s->find(103) != s->end());
+    // set is made once per loaded list
+    BOOST_CHECK(ec.getEmpty("TestTwo") == s);
+
+    // new file is not noticed before the check interval has passed ...
+    {
+        lsst::qserv::css::ChunkBitmap bitmap(std::vector<int>{9});
+        std::ofstream out(binFile, std::ios::binary);
+        bitmap.writeBinary(out);
+    }
+    BOOST_CHECK(ec.isEmpty("TestTwo", 103));
+    // ... unless the cache is cleared
+    ec.clearCache("TestTwo");
+    BOOST_CHECK(ec.isEmpty("TestTwo", 9));
+    BOOST_CHECK(not ec.isEmpty("TestTwo", 103));
+    BOOST_CHECK(ec.getEmpty("TestTwo") != s);
+    std::remove(binFile.c_str());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
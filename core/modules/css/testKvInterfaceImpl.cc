@@ -31,20 +31,25 @@
 
 // System headers
 #include <algorithm> // sort
+#include <chrono>
 #include <cstddef>   // nullptr
 #include <cstdlib>   // rand, srand
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <string.h>  // memset
+#include <thread>
 #include <time.h>    // time
 
 // Third-party headers
 #include "boost/lexical_cast.hpp"
 
 // Qserv headers
+#include "css/constants.h"
+#include "css/CssError.h"
 #include "css/KvInterfaceImplMem.h"
 #include "css/KvInterfaceImplMySql.h"
+#include "css/KvInterfaceSnapshot.h"
 
 // Boost unit test header
 #define BOOST_TEST_MODULE MyTest
@@ -110,4 +115,48 @@ BOOST_AUTO_TEST_CASE(testMem) {
     doIt(new lsst::qserv::css::KvInterfaceImplMem());
 }
 
+BOOST_AUTO_TEST_CASE(testSnapshot) {
+    std::cout << "========== Testing Snapshot ==========\n";
+    auto backend = std::make_shared<lsst::qserv::css::KvInterfaceImplMem>();
+    doIt(new lsst::qserv::css::KvInterfaceSnapshot(backend, std::chrono::milliseconds(0)));
+}
+
+BOOST_AUTO_TEST_CASE(testSnapshotRefresh) {
+    using lsst::qserv::css::GENERATION_KEY;
+    auto backend = std::make_shared<lsst::qserv::css::KvInterfaceImplMem>();
+    backend->create(k1, v1);
+    backend->create(GENERATION_KEY, "1");
+    lsst::qserv::css::KvInterfaceSnapshot snap(backend, std::chrono::milliseconds(200));
+    BOOST_CHECK_EQUAL(snap.generation(), "1");
+    BOOST_CHECK_EQUAL(snap.get(k1), v1);
+    BOOST_CHECK_EQUAL(snap.getChildren("/").size(), 2U);
+    BOOST_CHECK_THROW(snap.getChildren(k3), lsst::qserv::css::NoSuchKey);
+    auto children = snap.getChildrenValues(prefix);
+    BOOST_CHECK_EQUAL(children.size(), 1U);
+    BOOST_CHECK_EQUAL(children["xyzA"], v1);
+
+    // modification behind snapshot's back is not visible until
+    // generation changes and interval expires
+    backend->set(k2, v2);
+    BOOST_CHECK(not snap.exists(k2));
+    backend->set(GENERATION_KEY, "2");
+    BOOST_CHECK(not snap.exists(k2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    BOOST_CHECK(snap.exists(k2));
+    BOOST_CHECK_EQUAL(snap.generation(), "2");
+    unsigned reloads = snap.reloadCount();
+
+    // unchanged generation does not reload
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    BOOST_CHECK(snap.exists(k2));
+    BOOST_CHECK_EQUAL(snap.reloadCount(), reloads);
+
+    // own writes are visible immediately
+    snap.set(k3, "own");
+    BOOST_CHECK_EQUAL(snap.get(k3), "own");
+    snap.deleteKey(k1);
+    BOOST_CHECK(not snap.exists(k1));
+    BOOST_CHECK_EQUAL(snap.getAll().size(), backend->getAll().size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
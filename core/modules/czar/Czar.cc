@@ -123,6 +123,9 @@ Czar::submitQuery(std::string const& query,
     // client/thread and will not be able to be killed later
     int threadId = hintsConfigStore.getInt("server_thread_id", -1);
 
+    // User name is used to share resources fairly between users
+    std::string user = hintsConfigStore.get("user");
+
     std::string defaultDb = hintsConfigStore.get("db");
     LOGS(_log, LOG_LVL_INFO, "Default database is \"" << defaultDb <<"\"");
 
@@ -150,7 +153,8 @@ Czar::submitQuery(std::string const& query,
     ccontrol::UserQuery::Ptr uq;
     {
         std::lock_guard<std::mutex> lock(_mutex);
-        uq = _uqFactory->newUserQuery(query, defaultDb, getLargeResultMgr(), userQueryId, msgTableName);
+        uq = _uqFactory->newUserQuery(query, defaultDb, getLargeResultMgr(), userQueryId,
+                                      msgTableName, user);
     }
     auto queryIdStr = uq->getQueryIdString();
 
@@ -182,7 +186,7 @@ Czar::submitQuery(std::string const& query,
     finalThread.detach();
 
     // update/cleanup query map
-    _updateQueryHistory(clientId, threadId, uq);
+    _updateQueryHistory(clientId, threadId, lockName, uq);
 
     // return all info to caller
     if (uq->isAsync()) {
@@ -259,9 +263,39 @@ Czar::killQuery(std::string const& query, std::string const& clientId) {
     return std::string();
 }
 
+StreamResult
+Czar::getResultSegment(std::string const& messageTable, unsigned cursor) {
+
+    StreamResult result;
+    ccontrol::UserQuery::Ptr uq;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto iter = _msgTableToQuery.find(messageTable);
+        if (iter != _msgTableToQuery.end()) {
+            uq = iter->second.lock();
+        }
+    }
+    if (not uq) {
+        result.errorMessage = "No running query for message table " + messageTable;
+        return result;
+    }
+
+    auto segment = uq->getResultSegment(cursor);
+    result.query = segment.query;
+    result.rows = segment.rows;
+    result.cursor = segment.nextCursor;
+    result.complete = segment.complete;
+    result.truncated = segment.truncated;
+    LOGS(_log, LOG_LVL_DEBUG, uq->getQueryIdString() << " result segment from cursor " << cursor
+         << ": rows=" << result.rows << " cursor=" << result.cursor
+         << " complete=" << result.complete << " truncated=" << result.truncated);
+    return result;
+}
+
 void
 Czar::_updateQueryHistory(std::string const& clientId,
                           int threadId,
+                          std::string const& msgTableName,
                           ccontrol::UserQuery::Ptr const& uq) {
 
     std::lock_guard<std::mutex> lock(_mutex);
@@ -274,6 +308,16 @@ Czar::_updateQueryHistory(std::string const& clientId,
             ++ iter;
         }
     }
+    for (auto iter = _msgTableToQuery.begin(); iter != _msgTableToQuery.end(); ) {
+        if (iter->second.expired()) {
+            iter = _msgTableToQuery.erase(iter);
+        } else {
+            ++ iter;
+        }
+    }
+
+    // remember query (weak pointer) for clients reading its result while it runs
+    _msgTableToQuery[msgTableName] = uq;
 
     // remember query (weak pointer) in case we want to kill query
     if (not clientId.empty() and threadId >= 0) {
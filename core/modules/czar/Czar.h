@@ -37,6 +37,7 @@
 #include "ccontrol/UserQuery.h"
 #include "ccontrol/UserQueryFactory.h"
 #include "czar/CzarConfig.h"
+#include "czar/StreamResult.h"
 #include "czar/SubmitResult.h"
 #include "global/stringTypes.h"
 #include "mysql/MySqlConfig.h"
@@ -82,6 +83,15 @@ public:
      */
     std::string killQuery(std::string const& query, std::string const& clientId);
 
+    /**
+     * Return result rows of a running query which are already final.
+     *
+     * @param messageTable: Message table returned by submitQuery().
+     * @param cursor: Cursor returned by the previous call, 0 for the first call.
+     * @return Structure with a query selecting the new rows.
+     */
+    StreamResult getResultSegment(std::string const& messageTable, unsigned cursor);
+
     /**
      * Make new instance.
      *
@@ -113,6 +123,7 @@ private:
     /// Clean client-to-query map from expired entries, add new query
     void _updateQueryHistory(std::string const& clientId,
                              int threadId,
+                             std::string const& msgTableName,
                              ccontrol::UserQuery::Ptr const& uq);
 
     /// Create and fill async result table
@@ -125,6 +136,7 @@ private:
     // combines client name (ID) and its thread ID into one unique ID
     typedef std::pair<std::string, int> ClientThreadId;
     typedef std::map<ClientThreadId, std::weak_ptr<ccontrol::UserQuery>> ClientToQuery;
+    typedef std::map<std::string, std::weak_ptr<ccontrol::UserQuery>> MessageTableToQuery;
 
     std::string const _czarName;        ///< Unique czar name
     CzarConfig const _czarConfig;
@@ -132,7 +144,8 @@ private:
     std::atomic<uint64_t> _idCounter;   ///< Query/task identifier for next query
     std::unique_ptr<ccontrol::UserQueryFactory> _uqFactory;
     ClientToQuery _clientToQuery;       ///< maps client ID to query
-    std::mutex _mutex;                  ///< protects both _uqFactory and _clientToQuery
+    MessageTableToQuery _msgTableToQuery; ///< maps message table to running query
+    std::mutex _mutex;                  ///< protects _uqFactory, _clientToQuery and _msgTableToQuery
 
     qdisp::LargeResultMgr::Ptr _largeResultMgr; ///< Large result manager for all user queries.
 };
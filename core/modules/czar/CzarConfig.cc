@@ -83,7 +83,31 @@ CzarConfig::CzarConfig(util::ConfigStore const& configStore)
        _emptyChunkPath(configStore.get("partitioner.emptyChunkPath", ".")),
        _largeResultConcurrentMerges(configStore.getInt("tuning.largeResultConcurrentMerges", 3)),
        _xrootdCBThreadsMax(configStore.getInt("tuning.xrootdCBThreadsMax", 500)),
-       _xrootdCBThreadsInit(configStore.getInt("tuning.xrootdCBThreadsInit", 50)) {
+       _xrootdCBThreadsInit(configStore.getInt("tuning.xrootdCBThreadsInit", 50)),
+       _secondaryIndexCacheSize(configStore.getInt("tuning.secondaryIndexCacheSize", 1000000)),
+       _secondaryIndexConnections(configStore.getInt("tuning.secondaryIndexConnections", 4)),
+       _secondaryIndexFileDir(configStore.get("tuning.secondaryIndexFileDir")),
+       _queryPlanCacheSize(configStore.getInt("tuning.queryPlanCacheSize", 1000)),
+       _queryPlanCacheLifetime(configStore.getInt("tuning.queryPlanCacheLifetime", 300)),
+       _chunkCoverageCacheSize(configStore.getInt("tuning.chunkCoverageCacheSize", 1000)),
+       _qMetaWriteQueueSize(configStore.getInt("tuning.qMetaWriteQueueSize", 10000)),
+       _qMetaWriteRetries(configStore.getInt("tuning.qMetaWriteRetries", 10)),
+       _resultStreamDrainTimeout(configStore.getInt("tuning.resultStreamDrainTimeout", 5000)),
+       _resultCacheSize(configStore.getInt("tuning.resultCacheSize", 0)),
+       _resultCacheSizeMB(configStore.getInt("tuning.resultCacheSizeMB", 1000)),
+       _resultCacheLifetime(configStore.getInt("tuning.resultCacheLifetime", 600)),
+       _speculativePercentile(configStore.getInt("tuning.speculativePercentile", 0)),
+       _speculativeMinSeconds(configStore.getInt("tuning.speculativeMinSeconds", 30)),
+       _maxQueriesPerUser(configStore.getInt("tuning.maxQueriesPerUser", 0)),
+       _maxInteractiveQueries(configStore.getInt("tuning.maxInteractiveQueries", 0)),
+       _maxScanQueries(configStore.getInt("tuning.maxScanQueries", 0)),
+       _maxOutstandingJobs(configStore.getInt("tuning.maxOutstandingJobs", 0)),
+       _interactiveJobWeight(configStore.getInt("tuning.interactiveJobWeight", 4)),
+       _scanJobWeight(configStore.getInt("tuning.scanJobWeight", 1)),
+       _fastScansPerUser(configStore.getInt("tuning.fastScansPerUser", 0)),
+       _queryArenaKB(configStore.getInt("tuning.queryArenaKB", 64)),
+       _mySqlPoolMaxIdle(configStore.getInt("tuning.mySqlPoolMaxIdle", 8)),
+       _mySqlPoolIdleTimeout(configStore.getInt("tuning.mySqlPoolIdleTimeout", 300)) {
 }
 
 std::ostream& operator<<(std::ostream &out, CzarConfig const& czarConfig) {
@@ -136,6 +136,203 @@ public:
         return _xrootdCBThreadsInit;
     }
 
+    /* Get the maximum number of keys kept in the secondary index lookup cache.
+     *
+     * @return the cache size, 0 if the cache is disabled.
+     */
+    int getSecondaryIndexCacheSize() const {
+        return _secondaryIndexCacheSize;
+    }
+
+    /* Get the number of connections used for secondary index lookups.
+     *
+     * @return the maximum number of concurrent secondary index queries.
+     */
+    int getSecondaryIndexConnections() const {
+        return _secondaryIndexConnections;
+    }
+
+    /* Get the directory with memory-mapped secondary index files.
+     *
+     * @return the directory path, empty if index files are not used.
+     */
+    std::string const& getSecondaryIndexFileDir() const {
+        return _secondaryIndexFileDir;
+    }
+
+    /* Get the maximum number of query shapes kept in the query plan cache.
+     *
+     * @return the cache size, 0 if the cache is disabled.
+     */
+    int getQueryPlanCacheSize() const {
+        return _queryPlanCacheSize;
+    }
+
+    /* Get the lifetime of query plan cache entries.
+     *
+     * @return the lifetime in seconds.
+     */
+    int getQueryPlanCacheLifetime() const {
+        return _queryPlanCacheLifetime;
+    }
+
+    /* Get the maximum number of spatial regions kept in the chunk coverage cache.
+     *
+     * @return the cache size, 0 if the cache is disabled.
+     */
+    int getChunkCoverageCacheSize() const {
+        return _chunkCoverageCacheSize;
+    }
+
+    /* Get the maximum number of QMeta status updates waiting to be written.
+     *
+     * @return the queue size, 0 if QMeta is updated synchronously.
+     */
+    int getQMetaWriteQueueSize() const {
+        return _qMetaWriteQueueSize;
+    }
+
+    /* Get the number of retries of a QMeta status update failing with an SQL
+     * error before QMeta is considered unavailable.
+     *
+     * @return the number of retries.
+     */
+    int getQMetaWriteRetries() const {
+        return _qMetaWriteRetries;
+    }
+
+    /* Get the time a finishing query waits for its result stream reader.
+     *
+     * @return the timeout in milliseconds.
+     */
+    int getResultStreamDrainTimeout() const {
+        return _resultStreamDrainTimeout;
+    }
+
+    /* Get the maximum number of query results kept for identical queries.
+     *
+     * @return the cache size, 0 if the result cache is disabled.
+     */
+    int getResultCacheSize() const {
+        return _resultCacheSize;
+    }
+
+    /* Get the maximum total size of the cached query results.
+     *
+     * @return the size in MB.
+     */
+    int getResultCacheSizeMB() const {
+        return _resultCacheSizeMB;
+    }
+
+    /* Get the time after which a cached query result is discarded.
+     *
+     * @return the lifetime in seconds.
+     */
+    int getResultCacheLifetime() const {
+        return _resultCacheLifetime;
+    }
+
+    /* Get the percentile of job completion times above which a job that hasn't
+     * returned data gets a speculative duplicate.
+     *
+     * @return the percentile, 0 if speculative dispatch is disabled.
+     */
+    int getSpeculativePercentile() const {
+        return _speculativePercentile;
+    }
+
+    /* Get the minimum run time of a job before it can get a speculative duplicate.
+     *
+     * @return the run time in seconds.
+     */
+    int getSpeculativeMinSeconds() const {
+        return _speculativeMinSeconds;
+    }
+
+    /* Get the maximum number of concurrently executing SELECT queries of a user.
+     *
+     * @return the number of queries, 0 if unlimited.
+     */
+    int getMaxQueriesPerUser() const {
+        return _maxQueriesPerUser;
+    }
+
+    /* Get the maximum number of concurrently executing interactive queries.
+     *
+     * @return the number of queries, 0 if unlimited.
+     */
+    int getMaxInteractiveQueries() const {
+        return _maxInteractiveQueries;
+    }
+
+    /* Get the maximum number of concurrently executing scan queries.
+     *
+     * @return the number of queries, 0 if unlimited.
+     */
+    int getMaxScanQueries() const {
+        return _maxScanQueries;
+    }
+
+    /* Get the maximum number of started, incomplete chunk jobs of all queries.
+     *
+     * @return the number of jobs, 0 if unlimited.
+     */
+    int getMaxOutstandingJobs() const {
+        return _maxOutstandingJobs;
+    }
+
+    /* Get the weight of interactive queries when sharing outstanding jobs.
+     *
+     * @return the weight.
+     */
+    int getInteractiveJobWeight() const {
+        return _interactiveJobWeight;
+    }
+
+    /* Get the weight of scan queries when sharing outstanding jobs.
+     *
+     * @return the weight.
+     */
+    int getScanJobWeight() const {
+        return _scanJobWeight;
+    }
+
+    /* Get the number of concurrent scan queries of a user which keep their
+     * scan rating, further scans run at the slowest rating on workers.
+     *
+     * @return the number of queries, 0 if scans are never demoted.
+     */
+    int getFastScansPerUser() const {
+        return _fastScansPerUser;
+    }
+
+    /* Get the size of the blocks of the per-query arena holding the nodes
+     * made by parsing and analysis of a query.
+     *
+     * @return the size in KB, 0 if nodes are allocated individually.
+     */
+    int getQueryArenaKB() const {
+        return _queryArenaKB;
+    }
+
+    /* Get the number of idle connections to the result database kept for
+     * reuse, per user and database.
+     *
+     * @return the number of idle connections, 0 if connections are not pooled.
+     */
+    int getMySqlPoolMaxIdle() const {
+        return _mySqlPoolMaxIdle;
+    }
+
+    /* Get the time after which idle pooled connections are closed.
+     *
+     * @return the time in seconds.
+     */
+    int getMySqlPoolIdleTimeout() const {
+        return _mySqlPoolIdleTimeout;
+    }
+
 private:
 
     CzarConfig(util::ConfigStore const& ConfigStore);
@@ -152,6 +349,30 @@ private:
     int const _largeResultConcurrentMerges;
     int const _xrootdCBThreadsMax;
     int const _xrootdCBThreadsInit;
+    int const _secondaryIndexCacheSize;
+    int const _secondaryIndexConnections;
+    std::string const _secondaryIndexFileDir;
+    int const _queryPlanCacheSize;
+    int const _queryPlanCacheLifetime;
+    int const _chunkCoverageCacheSize;
+    int const _qMetaWriteQueueSize;
+    int const _qMetaWriteRetries;
+    int const _resultStreamDrainTimeout;
+    int const _resultCacheSize;
+    int const _resultCacheSizeMB;
+    int const _resultCacheLifetime;
+    int const _speculativePercentile;
+    int const _speculativeMinSeconds;
+    int const _maxQueriesPerUser;
+    int const _maxInteractiveQueries;
+    int const _maxScanQueries;
+    int const _maxOutstandingJobs;
+    int const _interactiveJobWeight;
+    int const _scanJobWeight;
+    int const _fastScansPerUser;
+    int const _queryArenaKB;
+    int const _mySqlPoolMaxIdle;
+    int const _mySqlPoolIdleTimeout;
 };
 
 }}} // namespace lsst::qserv::czar
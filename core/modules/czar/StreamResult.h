@@ -0,0 +1,61 @@
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef LSST_QSERV_CZAR_STREAMRESULT_H
+#define LSST_QSERV_CZAR_STREAMRESULT_H
+
+// System headers
+#include <string>
+
+// Third-party headers
+
+// Qserv headers
+
+
+namespace lsst {
+namespace qserv {
+namespace czar {
+
+/// @addtogroup czar
+
+/**
+ *  @ingroup czar
+ *
+ *  @brief Structure used for returning result rows from getResultSegment.
+ *
+ *  A client reading the result of a running query passes back the cursor
+ *  of the previous call, starting from 0, until complete is set. When
+ *  truncated is set the rows cannot be read by segment (any more) and the
+ *  result table has to be read as a whole once the query is done.
+ */
+
+struct StreamResult {
+    std::string errorMessage;   ///< empty if there is no error
+    std::string query;          ///< SELECT returning new rows, empty if there are none
+    unsigned long long rows = 0; ///< Number of rows returned by query
+    unsigned cursor = 0;        ///< Cursor for the next call
+    bool complete = false;      ///< No more rows will be published
+    bool truncated = false;     ///< Rows have to be read from the result table
+};
+
+}}} // namespace lsst::qserv::czar
+
+#endif // LSST_QSERV_CZAR_STREAMRESULT_H
@@ -48,6 +48,10 @@ MemFileSet::~MemFileSet() {
     for (auto mfP : _lockFiles) {mfP->release();}
     for (auto mfP : _flexFiles) {mfP->release();}
 
+    // Return the memory reserved for in-memory copies
+    //
+    if (_rsvCopyBytes) _memory.memRestore(_rsvCopyBytes);
+
     // Unlock this file set if it is locked
     //
     serialize(false);
@@ -78,6 +82,33 @@ int MemFileSet::add(std::string const& tabname, int chunk,
     return 0;
 }
   
+/******************************************************************************/
+/*                               a d d C o p y                                */
+/******************************************************************************/
+
+int MemFileSet::addCopy(std::string const& tabname, int chunk, bool mustLK,
+                        unsigned int percent) {
+
+    // Only the size of the data file is needed. A table that does not exist
+    // (e.g. a missing overlap table) will not be copied either.
+    //
+    MemInfo mInfo = _memory.fileInfo(_memory.filePath(tabname, chunk));
+    if (!mInfo.isValid()) {
+        return (mInfo.errCode() == ENOENT ? 0 : mInfo.errCode());
+    }
+
+    // The copy is not stored like the data file, scale its size.
+    //
+    uint64_t copyBytes = mInfo.size() / 100 * percent
+                       + mInfo.size() % 100 * percent / 100;
+
+    // Add to the appropriate total
+    //
+    if (mustLK) _copyBytes     += copyBytes;
+       else     _flexCopyBytes += copyBytes;
+    return 0;
+}
+
 /******************************************************************************/
 /*                               l o c k A l l                                */
 /******************************************************************************/
@@ -126,6 +157,16 @@ int MemFileSet::mapAll() {
 
     int rc;
 
+    // Reserve memory for the required copies. They are only accounted for as
+    // the copies are made outside of the memory manager. The reservation is
+    // returned by the destructor.
+    //
+    if (_copyBytes) {
+        if (_copyBytes > _memory.bytesFree()) return ENOMEM;
+        _memory.memReserve(_copyBytes);
+        _rsvCopyBytes = _copyBytes;
+    }
+
     // Try to map all of the required tables. Any failure is considered fatal.
     // The caller should delete the fileset upon return in this case.
     //
@@ -134,6 +175,13 @@ int MemFileSet::mapAll() {
         if (rc != 0) return rc;
     }
 
+    // Flexible copies are reserved only if that still leaves room.
+    //
+    if (_flexCopyBytes && _flexCopyBytes <= _memory.bytesFree()) {
+        _memory.memReserve(_flexCopyBytes);
+        _rsvCopyBytes += _flexCopyBytes;
+    }
+
     // Try locking as many flexible files as we can. At some point we will
     // place unlocked flex files on a "want to lock" queue. FUTURE!!! In any
     // case we ignore all errors here as these files may remain unlocked.
@@ -161,6 +209,7 @@ MemMan::Status MemFileSet::status() {
     // Fill out status information and return it.
     //
     myStatus.bytesLock = _lockBytes;
+    myStatus.bytesCopy = _rsvCopyBytes;
     myStatus.numFiles  = _numFiles;
     myStatus.chunk     = _chunk;
     return myStatus;
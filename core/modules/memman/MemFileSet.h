@@ -63,6 +63,23 @@ public:
 
     int    add(std::string const& tabname, int chunk, bool iFile, bool mustLK);
 
+    //-----------------------------------------------------------------------------
+    //! @brief Add an in-memory copy of a table's data to a file set. Memory
+    //!        for it is reserved by mapAll().
+    //!
+    //! @param  tabname - The table name in question.
+    //! @param  chunk   - Associated chunk number.
+    //! @param  mustLK  - When true  the reservation is mandatory.
+    //!                   When false it is made only if memory is available.
+    //! @param  percent - Reservation in percent of the size of the data file.
+    //!
+    //! @return =0        Copy added to fileset, a missing file adds nothing.
+    //! @return !0        Copy not added, errno value returned.
+    //-----------------------------------------------------------------------------
+
+    int    addCopy(std::string const& tabname, int chunk, bool mustLK,
+                   unsigned int percent);
+
     //-----------------------------------------------------------------------------
     //! @brief Determine ownership.
     //!
@@ -140,8 +157,9 @@ public:
     //-----------------------------------------------------------------------------
 
     MemFileSet(Memory& memory, int numLock, int numFlex, int chunk)
-              : _memory(memory), _lockBytes(0), _numFiles(0), _chunk(chunk),
-                _mtxLocked(false) {
+              : _memory(memory), _lockBytes(0), _copyBytes(0),
+                _flexCopyBytes(0), _rsvCopyBytes(0), _numFiles(0),
+                _chunk(chunk), _mtxLocked(false) {
                 _lockFiles.reserve(numLock);
                 _flexFiles.reserve(numFlex);
               }
@@ -154,6 +172,9 @@ private:
     std::vector<MemFile*> _lockFiles;
     std::vector<MemFile*> _flexFiles;
     uint64_t              _lockBytes;     // Total bytes locked
+    uint64_t              _copyBytes;     // Bytes of required copies
+    uint64_t              _flexCopyBytes; // Bytes of flexible copies
+    uint64_t              _rsvCopyBytes;  // Bytes reserved for copies
     uint32_t              _numFiles;
     int                   _chunk;
     std::atomic_bool      _mtxLocked;     // true -> _setMutex is locked
@@ -79,11 +79,12 @@ namespace memman {
 /*                                C r e a t e                                 */
 /******************************************************************************/
   
-MemMan *MemMan::create(uint64_t maxBytes, std::string const &dbPath) {
+MemMan *MemMan::create(uint64_t maxBytes, std::string const &dbPath,
+                       unsigned int copyPercent) {
 
     // Return a memory manager implementation
     //
-    return new MemManReal(dbPath, maxBytes);
+    return new MemManReal(dbPath, maxBytes, copyPercent);
 }
 }}} // namespace lsst:qserv:memman
 
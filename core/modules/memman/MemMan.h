@@ -41,6 +41,15 @@ namespace memman {
 //! previously added and marked FLEXIBLE. Tables marked FLEXIBLE are locked if
 //! there is sufficient memory. Otherwise, the required memory is reserved and
 //! a lock attempt is made when the table is encountered in the future.
+//!
+//! A table may also be copied into memory while the handle is held, e.g. the
+//! subchunk MEMORY tables built from a chunk table and its overlap. Such a
+//! copy is never locked but memory is reserved for it, REQUIRED failing and
+//! FLEXIBLE skipping the reservation when there is not enough free memory.
+//! The reservation is the size of the table's data file scaled by the copy
+//! percentage given to create(): a MEMORY table stores every row at its
+//! maximum length and adds hash index entries, and building the subchunk
+//! tables holds the rows twice, once staged and once in the subchunk tables.
 //-----------------------------------------------------------------------------
 
 class TableInfo {
@@ -57,6 +66,7 @@ public:
 
     LockType theData;         //< Lock options for the table's data
     LockType theIndex;        //< Lock options for the table's index, if any
+    LockType theCopy;         //< Reservation options for an in-memory copy
 
     //-----------------------------------------------------------------------------
     //! Constructor
@@ -64,12 +74,15 @@ public:
     //! @param  tabName   is the name of the table.
     //! @param  optData   lock options for the table's data
     //! @param  optIndex  lock options for the table's index
+    //! @param  optCopy   reservation options for an in-memory copy of the data
     //-----------------------------------------------------------------------------
 
     TableInfo(std::string const& tabName,
               LockType optData=LockType::REQUIRED,
-              LockType optIndex=LockType::NOLOCK)
-             : tableName(tabName), theData(optData), theIndex(optIndex)
+              LockType optIndex=LockType::NOLOCK,
+              LockType optCopy=LockType::NOLOCK)
+             : tableName(tabName), theData(optData), theIndex(optIndex),
+               theCopy(optCopy)
              {}
 };
 
@@ -87,14 +100,17 @@ public:
     //-----------------------------------------------------------------------------
     //! @brief Create a memory manager and initialize for processing.
     //!
-    //! @param  maxBytes   - Maximum amount of memory that can be used
-    //! @param  dbPath     - Path to directory where the database resides
+    //! @param  maxBytes    - Maximum amount of memory that can be used
+    //! @param  dbPath      - Path to directory where the database resides
+    //! @param  copyPercent - Memory reserved for an in-memory copy of a table,
+    //!                       in percent of the size of its data file
     //!
     //! @return !0: The pointer to the memory manager.
     //! @return  0: A manager could not be created.
     //-----------------------------------------------------------------------------
 
-    static MemMan* create(uint64_t maxBytes, std::string const& dbPath);
+    static MemMan* create(uint64_t maxBytes, std::string const& dbPath,
+                          unsigned int copyPercent=300);
 
     //-----------------------------------------------------------------------------
     //! @brief Lock a set of tables in memory passed to the prepare() method.
@@ -200,6 +216,7 @@ public:
 
     struct Status {
         uint64_t bytesLock; //!< Number of resource bytes locked
+        uint64_t bytesCopy; //!< Number of bytes reserved for in-memory copies
         uint32_t numFiles;  //!< Number of files resource has
         int      chunk;     //!< Chunk number associated with resource
     };
@@ -50,7 +50,8 @@ public:
                if (_alwaysLock) return HandleType::ISEMPTY;
                for (auto it=tables.begin() ; it != tables.end(); it++) {
                    if (it->theData  == TableInfo::LockType::REQUIRED
-                   ||  it->theIndex == TableInfo::LockType::REQUIRED)
+                   ||  it->theIndex == TableInfo::LockType::REQUIRED
+                   ||  it->theCopy  == TableInfo::LockType::REQUIRED)
                       {errno = ENOMEM; return HandleType::INVALID;}
                }
                return HandleType::ISEMPTY;
@@ -167,23 +167,25 @@ int MemManReal::lock(MemMan::Handle handle, bool strict) {
   
 MemMan::Handle MemManReal::prepare(std::vector<TableInfo> const& tables, int chunk) {
 
-    int  lockNum, flexNum, retc = 0;
+    int  lockNum, flexNum, copyNum, retc = 0;
     bool mustLock;
 
     // Pass 1: determine the number of files needed in the file set
     //
-    lockNum = flexNum = 0;
+    lockNum = flexNum = copyNum = 0;
     for (auto&& tab : tables) {
         if (         tab.theData  == TableInfo::LockType::REQUIRED) lockNum++;
             else if (tab.theData  == TableInfo::LockType::FLEXIBLE) flexNum++;
         if (         tab.theIndex == TableInfo::LockType::REQUIRED) lockNum++;
             else if (tab.theIndex == TableInfo::LockType::FLEXIBLE) flexNum++;
+        if (         tab.theCopy  == TableInfo::LockType::REQUIRED
+            ||       tab.theCopy  == TableInfo::LockType::FLEXIBLE) copyNum++;
     }
 
     // If we don't need to lock anything then indicate success but return a
     // a special file handle that indicates the file set is empty.
     //
-    if (lockNum == 0 && flexNum == 0) return HandleType::ISEMPTY;
+    if (lockNum == 0 && flexNum == 0 && copyNum == 0) return HandleType::ISEMPTY;
 
     // Allocate an empty file set sized to handle this request
     //
@@ -202,6 +204,12 @@ MemMan::Handle MemManReal::prepare(std::vector<TableInfo> const& tables, int chu
            retc = fileSet->add(tab.tableName, chunk, true,  mustLock);
            if (retc) break;
         }
+        mustLock =      tab.theCopy  == TableInfo::LockType::REQUIRED;
+        if (mustLock || tab.theCopy  == TableInfo::LockType::FLEXIBLE) {
+           retc = fileSet->addCopy(tab.tableName, chunk, mustLock,
+                                   _copyPercent);
+           if (retc) break;
+        }
      }
 
     // If we ended with no errors then try to memlock the file set. We do this
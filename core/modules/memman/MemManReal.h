@@ -59,8 +59,10 @@ public:
     MemManReal & operator=(const MemManReal&) = delete;
     MemManReal(const MemManReal&) = delete;
 
-    MemManReal(std::string const& dbPath, uint64_t maxBytes)
-              : _memory(dbPath, maxBytes), _numErrors(0), _numLkerrs(0),
+    MemManReal(std::string const& dbPath, uint64_t maxBytes,
+               unsigned int copyPercent=300)
+              : _memory(dbPath, maxBytes), _copyPercent(copyPercent),
+                _numErrors(0), _numLkerrs(0),
                 _numLocks(0), _numReqdFiles(0), _numFlexFiles(0) {}
 
     ~MemManReal() override {unlockAll();}
@@ -68,6 +70,7 @@ public:
 private:
 
     Memory           _memory;
+    unsigned int     _copyPercent;   // Copy reservation, % of data file size
     std::atomic_uint _numErrors;
     std::atomic_uint _numLkerrs;
     uint32_t         _numLocks;      // Under control of hanMutex
@@ -191,6 +191,44 @@ MySqlConnection::selectDb(std::string const& dbName) {
     return true;
 }
 
+bool
+MySqlConnection::ping() {
+    return _mysql != nullptr && mysql_ping(_mysql) == 0;
+}
+
+bool
+MySqlConnection::reset(std::string const& dbName) {
+    if (!_isConnected || _mysql == nullptr) {
+        return false;
+    }
+    if (_mysql_res) {
+        MYSQL_ROW row;
+        while((row = mysql_fetch_row(_mysql_res))); // Drain results.
+        freeResult();
+    }
+    // Discard the remaining results of a multi-statement query.
+    while (mysql_more_results(_mysql)) {
+        if (mysql_next_result(_mysql) > 0) {
+            return false;
+        }
+        MYSQL_RES* res = mysql_store_result(_mysql);
+        if (res) { mysql_free_result(res); }
+    }
+    {
+        std::lock_guard<std::mutex> lock(_interruptMutex);
+        _isExecuting = false;
+        _interrupted = false;
+    }
+    mysql_set_local_infile_default(_mysql);
+    if (_sqlConfig->dbName != dbName) {
+        // There is no way back to "no default database".
+        if (dbName.empty() || !selectDb(dbName)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////
 // MySqlConnection
 // private:
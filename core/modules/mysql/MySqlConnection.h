@@ -85,6 +85,18 @@ public:
     MySqlConfig const& getConfig() const { return *_sqlConfig; }
     bool selectDb(std::string const& dbName);
 
+    /// @return true if the server answers on this connection.
+    bool ping();
+
+    /**
+     *  Prepare the connection for another client: discard pending results,
+     *  clear the cancellation state and the LOCAL INFILE handler, and make
+     *  dbName the default database again.
+     *
+     * @return false if the connection can not be reused.
+     */
+    bool reset(std::string const& dbName);
+
 private:
     MYSQL* _connectHelper();
     static std::mutex _mysqlShared;
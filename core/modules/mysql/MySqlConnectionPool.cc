@@ -0,0 +1,166 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "mysql/MySqlConnectionPool.h"
+
+// System headers
+#include <sstream>
+#include <vector>
+
+// LSST headers
+#include "lsst/log/Log.h"
+
+// Qserv headers
+#include "mysql/MySqlConfig.h"
+
+namespace {
+
+LOG_LOGGER _log = LOG_GET("lsst.qserv.mysql.MySqlConnectionPool");
+
+/// @return the key of the idle list for connections made with c.
+std::string makeKey(lsst::qserv::mysql::MySqlConfig const& c) {
+    std::ostringstream os;
+    os << c.username << '\0' << c.password << '\0' << c.hostname << '\0'
+       << c.port << '\0' << c.socket << '\0' << c.dbName;
+    return os.str();
+}
+
+} // anonymous namespace
+
+namespace lsst {
+namespace qserv {
+namespace mysql {
+
+MySqlConnectionPool::Ptr MySqlConnectionPool::create(Config const& config) {
+    return Ptr(new MySqlConnectionPool(config));
+}
+
+MySqlConnectionPool::MySqlConnectionPool(Config const& config)
+    : _config(config) {
+}
+
+std::shared_ptr<MySqlConnection> MySqlConnectionPool::acquire(MySqlConfig const& sqlConfig) {
+    std::string const key = makeKey(sqlConfig);
+    std::unique_ptr<MySqlConnection> conn;
+    while (!conn) {
+        Clock::time_point since;
+        IdleList evicted; // closed after unlocking
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            auto now = Clock::now();
+            _evictIdle(now, evicted);
+            auto iter = _idle.find(key);
+            if (iter == _idle.end()) {
+                break;
+            }
+            conn = std::move(iter->second.back().conn);
+            since = iter->second.back().since;
+            iter->second.pop_back();
+            if (iter->second.empty()) {
+                _idle.erase(iter);
+            }
+            --_stats.idle;
+        }
+        // The server may have closed a connection which was idle for a while.
+        if (Clock::now() - since > _config.checkAfter && !conn->ping()) {
+            LOGS(_log, LOG_LVL_DEBUG, "dropping dead pooled connection for " << sqlConfig);
+            conn.reset();
+            std::lock_guard<std::mutex> lock(_mtx);
+            ++_stats.discarded;
+        }
+    }
+    if (conn) {
+        std::lock_guard<std::mutex> lock(_mtx);
+        ++_stats.reused;
+    } else {
+        conn.reset(new MySqlConnection(sqlConfig));
+        if (conn->connect()) {
+            std::lock_guard<std::mutex> lock(_mtx);
+            ++_stats.created;
+        }
+    }
+
+    std::weak_ptr<MySqlConnectionPool> weakPool = shared_from_this();
+    std::string const dbName = sqlConfig.dbName;
+    return std::shared_ptr<MySqlConnection>(conn.release(),
+        [weakPool, key, dbName](MySqlConnection* c) {
+            auto pool = weakPool.lock();
+            if (pool) {
+                pool->_release(c, key, dbName);
+            } else {
+                delete c;
+            }
+        });
+}
+
+void MySqlConnectionPool::evictIdle() {
+    IdleList evicted; // closed after unlocking
+    std::lock_guard<std::mutex> lock(_mtx);
+    _evictIdle(Clock::now(), evicted);
+}
+
+MySqlConnectionPool::Stats MySqlConnectionPool::getStats() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _stats;
+}
+
+void MySqlConnectionPool::_release(MySqlConnection* conn, std::string const& key,
+                                   std::string const& dbName) {
+    std::unique_ptr<MySqlConnection> owned(conn); // closed after unlocking unless kept
+    bool const reusable = owned->getMySql() != nullptr && owned->reset(dbName);
+    IdleList evicted;
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto now = Clock::now();
+    _evictIdle(now, evicted);
+    if (!reusable) {
+        if (owned->connected()) { ++_stats.discarded; }
+        return;
+    }
+    IdleList& idle = _idle[key];
+    if (idle.size() >= _config.maxIdle) {
+        ++_stats.discarded;
+        return;
+    }
+    idle.push_back(Idle{std::move(owned), now});
+    ++_stats.idle;
+}
+
+void MySqlConnectionPool::_evictIdle(Clock::time_point now, IdleList& evicted) {
+    for (auto iter = _idle.begin(); iter != _idle.end();) {
+        IdleList& idle = iter->second;
+        while (!idle.empty() && now - idle.front().since > _config.idleTimeout) {
+            evicted.push_back(std::move(idle.front()));
+            idle.pop_front();
+            --_stats.idle;
+            ++_stats.discarded;
+        }
+        if (idle.empty()) {
+            iter = _idle.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+}}} // namespace lsst::qserv::mysql
@@ -0,0 +1,113 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_QSERV_MYSQL_MYSQLCONNECTIONPOOL_H
+#define LSST_QSERV_MYSQL_MYSQLCONNECTIONPOOL_H
+
+// System headers
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Qserv headers
+#include "mysql/MySqlConnection.h"
+
+namespace lsst {
+namespace qserv {
+namespace mysql {
+
+/**
+ *  MySqlConnectionPool keeps idle connections to mysqld for reuse, so that
+ *  short-lived clients (chunk tasks, result iterators, index lookups) don't
+ *  pay for connection setup.
+ *
+ *  Connections are pooled separately for each user, server and default
+ *  database. A connection is returned to the pool when the last reference
+ *  to it is released; it is reset then, and dropped if the reset fails or
+ *  if enough connections are already idle. Connections idle for a while are
+ *  pinged before reuse, and closed once they exceed the idle timeout.
+ *
+ *  All methods are thread safe.
+ */
+class MySqlConnectionPool : public std::enable_shared_from_this<MySqlConnectionPool> {
+public:
+    typedef std::shared_ptr<MySqlConnectionPool> Ptr;
+
+    struct Config {
+        unsigned maxIdle = 4; ///< Idle connections kept per user and database.
+        std::chrono::seconds idleTimeout{300}; ///< Idle connections are closed after this.
+        std::chrono::seconds checkAfter{5}; ///< Idle connections are pinged after this.
+    };
+
+    struct Stats {
+        std::uint64_t created = 0;   ///< New connections made.
+        std::uint64_t reused = 0;    ///< Connections taken from the pool.
+        std::uint64_t discarded = 0; ///< Connections closed by the pool.
+        std::size_t idle = 0;        ///< Connections currently in the pool.
+    };
+
+    static Ptr create(Config const& config);
+
+    MySqlConnectionPool(MySqlConnectionPool const&) = delete;
+    MySqlConnectionPool& operator=(MySqlConnectionPool const&) = delete;
+
+    /**
+     *  Get a connection for sqlConfig, from the pool if one is idle.
+     *
+     * @return a connection, which is not connected() if mysqld can not be
+     *         reached. Releasing the last reference returns it to the pool.
+     */
+    std::shared_ptr<MySqlConnection> acquire(MySqlConfig const& sqlConfig);
+
+    /// Close the idle connections which exceeded the idle timeout.
+    void evictIdle();
+
+    Stats getStats() const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Idle {
+        std::unique_ptr<MySqlConnection> conn;
+        Clock::time_point since;
+    };
+    typedef std::deque<Idle> IdleList; ///< Most recently used at the back.
+
+    explicit MySqlConnectionPool(Config const& config);
+
+    void _release(MySqlConnection* conn, std::string const& key, std::string const& dbName);
+    void _evictIdle(Clock::time_point now, IdleList& evicted);
+
+    Config const _config;
+    std::map<std::string, IdleList> _idle; ///< Key identifies user, server and database.
+    Stats _stats;
+    mutable std::mutex _mtx; ///< Protects _idle and _stats.
+};
+
+}}} // namespace lsst::qserv::mysql
+
+#endif // LSST_QSERV_MYSQL_MYSQLCONNECTIONPOOL_H
@@ -0,0 +1,651 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+/**
+  * @file
+  *
+  * @brief Implementation of FastSelectParser.
+  *
+  */
+
+// Class header
+#include "parser/FastSelectParser.h"
+
+// System headers
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <sstream>
+
+// LSST headers
+#include "lsst/log/Log.h"
+
+// Qserv headers
+#include "global/constants.h"
+#include "query/Arena.h"
+#include "query/BoolTerm.h"
+#include "query/ColumnRef.h"
+#include "query/FromList.h"
+#include "query/FuncExpr.h"
+#include "query/GroupByClause.h"
+#include "query/OrderByClause.h"
+#include "query/Predicate.h"
+#include "query/QsRestrictor.h"
+#include "query/SelectList.h"
+#include "query/SelectStmt.h"
+#include "query/SqlSQL2Tokens.h" // (generated) SqlSQL2Tokens
+#include "query/TableRef.h"
+#include "query/ValueExpr.h"
+#include "query/ValueFactor.h"
+#include "query/WhereClause.h"
+
+namespace {
+
+LOG_LOGGER _log = LOG_GET("lsst.qserv.parser.FastSelectParser");
+
+/// Thrown inside FastSelectParser when the statement leaves the supported
+/// subset. It never escapes FastSelectParser::parse().
+struct Unsupported {
+    explicit Unsupported(char const* reason_) : reason(reason_) {}
+    char const* reason;
+};
+
+/// Words the ANTLR lexer turns into reserved-word tokens (the SQL2RW_*
+/// entries of query/SqlSQL2Tokens.txt). A name spelled like one of these is
+/// not a REGULAR_ID for the grammar, so the fast path must not accept it as
+/// one. Sorted for binary search.
+char const* const reservedWords[] = {
+    "absolute", "action", "add", "all", "allocate", "alter", "and", "any",
+    "are", "as", "asc", "assertion", "at", "authorization", "avg", "begin",
+    "between", "bit", "bit_length", "both", "by", "cascade", "cascaded", "case",
+    "cast", "catalog", "char", "char_length", "character", "character_length",
+    "check", "close", "coalesce", "collate", "collation", "column", "commit",
+    "connect", "connection", "constraint", "constraints", "continue", "convert",
+    "corresponding", "count", "create", "cross", "current", "current_date",
+    "current_time", "current_timestamp", "current_user", "cursor", "date",
+    "day", "deallocate", "dec", "decimal", "declare", "default", "deferrable",
+    "deferred", "delete", "desc", "describe", "descriptor", "diagnostics",
+    "disconnect", "distinct", "domain", "double", "drop", "else", "end",
+    "end-exec", "escape", "except", "exception", "exec", "execute", "exists",
+    "external", "extract", "false", "fetch", "first", "float", "for", "foreign",
+    "found", "from", "full", "get", "global", "go", "goto", "grant", "group",
+    "having", "hour", "identity", "immediate", "in", "indicator", "initially",
+    "inner", "input", "insensitive", "insert", "int", "integer", "intersect",
+    "interval", "into", "is", "isolation", "join", "key", "language", "last",
+    "leading", "left", "level", "like", "limit", "local", "lower", "match",
+    "max", "min", "minute", "module", "month", "names", "national", "natural",
+    "nchar", "next", "no", "not", "null", "nullif", "numeric", "octet_length",
+    "of", "on", "only", "open", "option", "or", "order", "outer", "output",
+    "overlaps", "pad", "partial", "position", "precision", "prepare",
+    "preserve", "primary", "prior", "privileges", "procedure", "public",
+    "qserv_areaspec_box", "qserv_areaspec_circle", "qserv_areaspec_ellipse",
+    "qserv_areaspec_hull", "qserv_areaspec_poly", "read", "real", "references",
+    "relative", "restrict", "revoke", "right", "rollback", "rows", "schema",
+    "scroll", "second", "section", "select", "session", "session_user", "set",
+    "size", "smallint", "some", "space", "sql", "sqlcode", "sqlerror",
+    "sqlstate", "substring", "sum", "system_user", "table", "temporary", "then",
+    "time", "timestamp", "timezone_hour", "timezone_minute", "to", "trailing",
+    "transaction", "translate", "translation", "trim", "true", "union",
+    "unique", "unknown", "update", "upper", "usage", "user", "using", "value",
+    "values", "varchar", "varying", "view", "when", "whenever", "where", "with",
+    "work", "write", "year", "zone",
+};
+
+bool lessThan(char const* a, char const* b) {
+    return std::strcmp(a, b) < 0;
+}
+
+char const* const areaspecNames[] = {
+    "qserv_areaspec_box", "qserv_areaspec_circle", "qserv_areaspec_ellipse",
+    "qserv_areaspec_hull", "qserv_areaspec_poly"
+};
+
+} // anonymous namespace
+
+namespace lsst {
+namespace qserv {
+namespace parser {
+
+FastSelectParser::Token::Token(Type type_, std::string const& text_)
+    : type(type_), text(text_), lower(text_) {
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+}
+
+std::shared_ptr<query::SelectStmt>
+FastSelectParser::parse(std::string const& statement) {
+    std::vector<Token> tokens;
+    if (!_tokenize(statement, tokens)) {
+        LOGS(_log, LOG_LVL_DEBUG, "Fast path declined (lexing): " << statement);
+        return std::shared_ptr<query::SelectStmt>();
+    }
+    try {
+        FastSelectParser p(tokens);
+        return p._statement();
+    } catch (Unsupported const& e) {
+        LOGS(_log, LOG_LVL_DEBUG, "Fast path declined (" << e.reason << "): " << statement);
+    }
+    return std::shared_ptr<query::SelectStmt>();
+}
+
+FastSelectParser::FastSelectParser(std::vector<Token>& tokens)
+    : _tokens(tokens), _pos(0) {
+}
+
+/// Split a statement into tokens, mirroring the ANTLR lexer for the
+/// characters it accepts. Returns false on anything the ANTLR lexer would
+/// treat specially (quotes, comments, introducers, characters it filters).
+bool
+FastSelectParser::_tokenize(std::string const& s, std::vector<Token>& tokens) {
+    std::size_t const n = s.size();
+    std::size_t i = 0;
+    auto digitAt = [&s, n](std::size_t j) {
+        return j < n && std::isdigit(static_cast<unsigned char>(s[j]));
+    };
+    while (i < n) {
+        unsigned char c = s[i];
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            ++i;
+        } else if (c < 0x80 && std::isalpha(c)) {
+            std::size_t j = i + 1;
+            while (j < n && s[j] > 0
+                   && (std::isalnum(static_cast<unsigned char>(s[j])) || s[j] == '_')) {
+                ++j;
+            }
+            tokens.emplace_back(Token::WORD, s.substr(i, j - i));
+            i = j;
+        } else if (std::isdigit(c) || (c == '.' && digitAt(i + 1))) {
+            std::size_t j = i;
+            while (digitAt(j)) { ++j; }
+            if (j < n && s[j] == '.') {
+                ++j;
+                while (digitAt(j)) { ++j; }
+            }
+            if (j < n && (s[j] == 'e' || s[j] == 'E')) {
+                ++j;
+                if (j < n && (s[j] == '+' || s[j] == '-')) { ++j; }
+                if (!digitAt(j)) { return false; }
+                while (digitAt(j)) { ++j; }
+            }
+            // "1abc" lexes as two tokens for ANTLR; not worth mirroring.
+            if (j < n && (std::isalpha(static_cast<unsigned char>(s[j])) || s[j] == '_')) {
+                return false;
+            }
+            tokens.emplace_back(Token::NUMBER, s.substr(i, j - i));
+            i = j;
+        } else {
+            std::size_t len = 1;
+            switch (c) {
+            case '(': case ')': case ',': case '*': case '+': case '/':
+            case '=': case ';':
+                break;
+            case '.':
+                if (i + 1 < n && s[i + 1] == '.') { return false; }
+                break;
+            case '-':
+                if (i + 1 < n && s[i + 1] == '-') { return false; } // comment
+                break;
+            case '<':
+                if (i + 1 < n && (s[i + 1] == '=' || s[i + 1] == '>')) { len = 2; }
+                break;
+            case '>':
+                if (i + 1 < n && s[i + 1] == '=') { len = 2; }
+                break;
+            case '!':
+                if (i + 1 < n && s[i + 1] == '=') { len = 2; }
+                else { return false; }
+                break;
+            default:
+                return false;
+            }
+            tokens.emplace_back(Token::PUNCT, s.substr(i, len));
+            i += len;
+        }
+    }
+    tokens.emplace_back(Token::END, std::string());
+    return true;
+}
+
+bool
+FastSelectParser::_isReserved(std::string const& lowerWord) {
+    return std::binary_search(std::begin(reservedWords), std::end(reservedWords),
+                              lowerWord.c_str(), lessThan);
+}
+
+FastSelectParser::Token const&
+FastSelectParser::_peek(std::size_t ahead) const {
+    std::size_t i = std::min(_pos + ahead, _tokens.size() - 1);
+    return _tokens[i];
+}
+
+bool
+FastSelectParser::_isWord(char const* keyword, std::size_t ahead) const {
+    Token const& t = _peek(ahead);
+    return t.type == Token::WORD && t.lower == keyword;
+}
+
+bool
+FastSelectParser::_isPunct(char const* punct, std::size_t ahead) const {
+    Token const& t = _peek(ahead);
+    return t.type == Token::PUNCT && t.text == punct;
+}
+
+bool
+FastSelectParser::_isAreaspec(std::size_t ahead) const {
+    Token const& t = _peek(ahead);
+    return t.type == Token::WORD
+        && std::binary_search(std::begin(areaspecNames), std::end(areaspecNames),
+                              t.lower.c_str(), lessThan);
+}
+
+bool
+FastSelectParser::_acceptWord(char const* keyword) {
+    if (!_isWord(keyword)) { return false; }
+    ++_pos;
+    return true;
+}
+
+bool
+FastSelectParser::_acceptPunct(char const* punct) {
+    if (!_isPunct(punct)) { return false; }
+    ++_pos;
+    return true;
+}
+
+void
+FastSelectParser::_expectWord(char const* keyword) {
+    if (!_acceptWord(keyword)) { throw Unsupported("expected keyword"); }
+}
+
+void
+FastSelectParser::_expectPunct(char const* punct) {
+    if (!_acceptPunct(punct)) { throw Unsupported("expected punctuation"); }
+}
+
+/// Consume a table, column or alias name.
+std::string
+FastSelectParser::_identifier() {
+    Token const& t = _peek();
+    if (t.type != Token::WORD || _isReserved(t.lower)) {
+        throw Unsupported("expected name");
+    }
+    ++_pos;
+    return t.text;
+}
+
+/// @return true if the next token is a bare alias, i.e. a name that is not
+///         a reserved word (FROM, WHERE, JOIN, ... are all reserved).
+bool
+FastSelectParser::_hasAlias() const {
+    Token const& t = _peek();
+    return t.type == Token::WORD && !_isReserved(t.lower);
+}
+
+std::shared_ptr<query::SelectStmt>
+FastSelectParser::_statement() {
+    _expectWord("select");
+    std::shared_ptr<query::SelectStmt> stmt = query::makeShared<query::SelectStmt>();
+    stmt->_hasDistinct = _acceptWord("distinct");
+    stmt->_selectList = _selectList();
+    _expectWord("from");
+    stmt->_fromList = _fromList();
+    if (_acceptWord("where")) {
+        stmt->_whereClause = _whereClause();
+    }
+    if (_acceptWord("group")) {
+        _expectWord("by");
+        stmt->_groupBy = _groupBy();
+    }
+    if (_acceptWord("order")) {
+        _expectWord("by");
+        stmt->_orderBy = _orderBy();
+    }
+    stmt->_limit = NOTSET;
+    if (_acceptWord("limit")) {
+        stmt->_limit = _limit();
+    }
+    while (_acceptPunct(";")) {}
+    if (_peek().type != Token::END) {
+        throw Unsupported("unsupported clause");
+    }
+    return stmt;
+}
+
+/// Mirrors SelectListFactory
+std::shared_ptr<query::SelectList>
+FastSelectParser::_selectList() {
+    std::shared_ptr<query::SelectList> list = query::makeShared<query::SelectList>();
+    query::ValueExprPtrVector& exprs = *list->getValueExprList();
+    if (_acceptPunct("*")) {
+        exprs.push_back(query::ValueExpr::newSimple(query::ValueFactor::newStarFactor("")));
+        return list;
+    }
+    do {
+        if (_peek().type == Token::WORD && _isPunct(".", 1) && _isPunct("*", 2)) {
+            std::string table = _identifier();
+            _pos += 2;
+            exprs.push_back(query::ValueExpr::newSimple(query::ValueFactor::newStarFactor(table)));
+            continue;
+        }
+        query::ValueExprPtr ve = _valueExpr();
+        if (_acceptWord("as") || _hasAlias()) {
+            ve->setAlias(_identifier());
+        }
+        exprs.push_back(ve);
+    } while (_acceptPunct(","));
+    return list;
+}
+
+/// Mirrors FromFactory for comma-separated tables, joins are declined.
+std::shared_ptr<query::FromList>
+FastSelectParser::_fromList() {
+    query::TableRefListPtr refs = query::makeShared<query::TableRefList>();
+    do {
+        std::string db;
+        std::string table = _identifier();
+        if (_acceptPunct(".")) {
+            db = table;
+            table = _identifier();
+        }
+        std::string alias;
+        if (_acceptWord("as") || _hasAlias()) {
+            alias = _identifier();
+        }
+        refs->push_back(query::makeShared<query::TableRef>(db, table, alias));
+    } while (_acceptPunct(","));
+    return query::makeShared<query::FromList>(refs);
+}
+
+/// Mirrors WhereFactory: leading qserv_areaspec_xxx() calls become
+/// QsRestrictors, the rest becomes an OrTerm of a single AndTerm.
+std::shared_ptr<query::WhereClause>
+FastSelectParser::_whereClause() {
+    std::shared_ptr<query::WhereClause> wc = query::makeShared<query::WhereClause>();
+    wc->_restrs = query::makeShared<query::QsRestrictor::PtrVector>();
+    if (_isAreaspec()) {
+        wc->_restrs->push_back(_restrictor());
+        while (_isWord("and") && _isAreaspec(1)) {
+            ++_pos;
+            wc->_restrs->push_back(_restrictor());
+        }
+        if (!_acceptWord("and")) {
+            return wc;
+        }
+    }
+    std::size_t const begin = _pos;
+    wc->_tree = _searchCondition();
+    std::string original;
+    for (std::size_t i = begin; i < _pos; ++i) {
+        if (!original.empty()) { original += " "; }
+        original += _tokens[i].text;
+    }
+    wc->_original = original;
+    return wc;
+}
+
+std::shared_ptr<query::QsRestrictor>
+FastSelectParser::_restrictor() {
+    std::shared_ptr<query::QsRestrictor> restr = query::makeShared<query::QsRestrictor>();
+    restr->_name = _peek().lower;
+    ++_pos;
+    _expectPunct("(");
+    do {
+        // signed_num_lit, printed compactly as "-1" like WhereFactory does.
+        std::string param;
+        if (_isPunct("-") || _isPunct("+")) {
+            param = _peek().text;
+            ++_pos;
+        }
+        if (_peek().type != Token::NUMBER) {
+            throw Unsupported("non-numeric areaspec parameter");
+        }
+        param += _peek().text;
+        ++_pos;
+        restr->_params.push_back(param);
+    } while (_acceptPunct(","));
+    _expectPunct(")");
+    return restr;
+}
+
+std::shared_ptr<query::BoolTerm>
+FastSelectParser::_searchCondition() {
+    std::shared_ptr<query::AndTerm> andTerm = query::makeShared<query::AndTerm>();
+    do {
+        if (_isWord("not")) {
+            throw Unsupported("NOT");
+        }
+        std::shared_ptr<query::BoolFactor> bf = query::makeShared<query::BoolFactor>();
+        bf->_terms.push_back(_predicate());
+        andTerm->_terms.push_back(bf);
+    } while (_acceptWord("and"));
+    if (_isWord("or")) {
+        throw Unsupported("OR");
+    }
+    std::shared_ptr<query::OrTerm> orTerm = query::makeShared<query::OrTerm>();
+    orTerm->_terms.push_back(andTerm);
+    return orTerm;
+}
+
+/// Mirrors PredicateFactory
+std::shared_ptr<query::BoolFactorTerm>
+FastSelectParser::_predicate() {
+    query::ValueExprPtr value = _valueExpr();
+    Token const& t = _peek();
+    if (t.type == Token::PUNCT) {
+        int op;
+        if (t.text == "=") { op = SqlSQL2Tokens::EQUALS_OP; }
+        else if (t.text == "<>") { op = SqlSQL2Tokens::NOT_EQUALS_OP; }
+        else if (t.text == "!=") { op = SqlSQL2Tokens::NOT_EQUALS_OP_ALT; }
+        else if (t.text == "<") { op = SqlSQL2Tokens::LESS_THAN_OP; }
+        else if (t.text == ">") { op = SqlSQL2Tokens::GREATER_THAN_OP; }
+        else if (t.text == "<=") { op = SqlSQL2Tokens::LESS_THAN_OR_EQUALS_OP; }
+        else if (t.text == ">=") { op = SqlSQL2Tokens::GREATER_THAN_OR_EQUALS_OP; }
+        else { throw Unsupported("expected comparison"); }
+        ++_pos;
+        std::shared_ptr<query::CompPredicate> p = query::makeShared<query::CompPredicate>();
+        p->left = value;
+        p->op = op;
+        p->right = _valueExpr();
+        return p;
+    }
+    if (_acceptWord("between")) {
+        std::shared_ptr<query::BetweenPredicate> p = query::makeShared<query::BetweenPredicate>();
+        p->value = value;
+        p->minValue = _valueExpr();
+        _expectWord("and");
+        p->maxValue = _valueExpr();
+        return p;
+    }
+    if (_acceptWord("in")) {
+        std::shared_ptr<query::InPredicate> p = query::makeShared<query::InPredicate>();
+        p->value = value;
+        _expectPunct("(");
+        do {
+            p->cands.push_back(_valueExpr());
+        } while (_acceptPunct(","));
+        _expectPunct(")");
+        return p;
+    }
+    if (_acceptWord("is")) {
+        std::shared_ptr<query::NullPredicate> p = query::makeShared<query::NullPredicate>();
+        p->value = value;
+        p->hasNot = _acceptWord("not");
+        _expectWord("null");
+        return p;
+    }
+    throw Unsupported("unsupported predicate");
+}
+
+/// ModFactory only handles a single grouping column, so does this.
+std::shared_ptr<query::GroupByClause>
+FastSelectParser::_groupBy() {
+    std::shared_ptr<query::GroupByClause> groupBy = query::makeShared<query::GroupByClause>();
+    query::GroupByTerm term;
+    term.getExpr() = query::ValueExpr::newSimple(
+        query::ValueFactor::newColumnRefFactor(_columnRef()));
+    groupBy->_addTerm(term);
+    return groupBy;
+}
+
+std::shared_ptr<query::OrderByClause>
+FastSelectParser::_orderBy() {
+    std::shared_ptr<query::OrderByClause> orderBy = query::makeShared<query::OrderByClause>();
+    do {
+        query::ValueExprPtr key = query::ValueExpr::newSimple(
+            query::ValueFactor::newColumnRefFactor(_columnRef()));
+        query::OrderByTerm::Order order = query::OrderByTerm::DEFAULT;
+        if (_acceptWord("asc")) {
+            order = query::OrderByTerm::ASC;
+        } else if (_acceptWord("desc")) {
+            order = query::OrderByTerm::DESC;
+        }
+        orderBy->getTerms()->push_back(query::OrderByTerm(key, order, std::string()));
+    } while (_acceptPunct(","));
+    return orderBy;
+}
+
+int
+FastSelectParser::_limit() {
+    Token const& t = _peek();
+    if (t.type != Token::NUMBER
+        || t.text.find_first_not_of("0123456789") != std::string::npos) {
+        throw Unsupported("LIMIT expects an unsigned integer");
+    }
+    ++_pos;
+    int limit = NOTSET;
+    std::stringstream ss(t.text);
+    ss >> limit;
+    return limit;
+}
+
+/// Mirrors ValueExprFactory::newExpr: the factors and operators are kept as
+/// the flat sequence the grammar produces, without precedence.
+query::ValueExprPtr
+FastSelectParser::_valueExpr() {
+    query::ValueExprPtr expr = query::makeShared<query::ValueExpr>();
+    query::ValueExpr::FactorOpVector& factorOps = expr->getFactorOps();
+    while (true) {
+        query::ValueExpr::FactorOp factorOp(_factor());
+        if (_acceptPunct("+")) { factorOp.op = query::ValueExpr::PLUS; }
+        else if (_acceptPunct("-")) { factorOp.op = query::ValueExpr::MINUS; }
+        else if (_acceptPunct("*")) { factorOp.op = query::ValueExpr::MULTIPLY; }
+        else if (_acceptPunct("/")) { factorOp.op = query::ValueExpr::DIVIDE; }
+        factorOps.push_back(factorOp);
+        if (factorOp.op == query::ValueExpr::NONE) {
+            break;
+        }
+    }
+    if (expr->isFactor() && expr->getFactor()->getType() == query::ValueFactor::EXPR) {
+        return factorOps.front().factor->getExpr();
+    }
+    return expr;
+}
+
+/// Mirrors ValueFactorFactory::newFactor
+std::shared_ptr<query::ValueFactor>
+FastSelectParser::_factor() {
+    Token const& t = _peek();
+    if (t.type == Token::PUNCT && (t.text == "-" || t.text == "+")) {
+        // The grammar keeps a signed number as one constant, "-0.5".
+        if (_peek(1).type != Token::NUMBER) {
+            throw Unsupported("unary sign on an expression");
+        }
+        std::string text = t.text + _peek(1).text;
+        _pos += 2;
+        return query::ValueFactor::newConstFactor(text);
+    }
+    if (t.type == Token::NUMBER) {
+        ++_pos;
+        return query::ValueFactor::newConstFactor(t.text);
+    }
+    if (_acceptPunct("(")) {
+        query::ValueExprPtr ve = _valueExpr();
+        _expectPunct(")");
+        if (ve->isFactor() && ve->getAlias().empty()) {
+            return ve->getFactorOps().front().factor;
+        }
+        return query::ValueFactor::newExprFactor(ve);
+    }
+    if (t.type != Token::WORD) {
+        throw Unsupported("expected value");
+    }
+    if (_isPunct("(", 1)) {
+        if (t.lower == "count" || t.lower == "avg" || t.lower == "max"
+            || t.lower == "min" || t.lower == "sum") {
+            return _aggregate();
+        }
+        return _function();
+    }
+    return query::ValueFactor::newColumnRefFactor(_columnRef());
+}
+
+/// Mirrors ValueFactorFactory::_newSetFctSpec, which only keeps a single
+/// column (or * for count) as the argument.
+std::shared_ptr<query::ValueFactor>
+FastSelectParser::_aggregate() {
+    std::shared_ptr<query::FuncExpr> fe = query::makeShared<query::FuncExpr>();
+    fe->name = _peek().text;
+    bool const isCount = _peek().lower == "count";
+    _pos += 2;
+    std::shared_ptr<query::ValueFactor> param;
+    if (isCount && _acceptPunct("*")) {
+        param = query::ValueFactor::newStarFactor("");
+    } else {
+        param = query::ValueFactor::newColumnRefFactor(_columnRef());
+    }
+    _expectPunct(")");
+    fe->params.push_back(query::ValueExpr::newSimple(param));
+    return query::ValueFactor::newAggFactor(fe);
+}
+
+std::shared_ptr<query::ValueFactor>
+FastSelectParser::_function() {
+    std::shared_ptr<query::FuncExpr> fe = query::makeShared<query::FuncExpr>();
+    fe->name = _identifier();
+    _expectPunct("(");
+    do {
+        fe->params.push_back(_valueExpr());
+    } while (_acceptPunct(","));
+    _expectPunct(")");
+    return query::ValueFactor::newFuncFactor(fe);
+}
+
+/// Column references are normalized like ColumnRefH does: column,
+/// table.column or db.table.column.
+std::shared_ptr<query::ColumnRef>
+FastSelectParser::_columnRef() {
+    std::string names[3];
+    int count = 0;
+    names[count++] = _identifier();
+    while (count < 3 && _acceptPunct(".")) {
+        names[count++] = _identifier();
+    }
+    if (_isPunct(".") || _isPunct("(")) {
+        throw Unsupported("qualified function or long column name");
+    }
+    switch (count) {
+    case 1: return query::makeShared<query::ColumnRef>("", "", names[0]);
+    case 2: return query::makeShared<query::ColumnRef>("", names[0], names[1]);
+    default: return query::makeShared<query::ColumnRef>(names[0], names[1], names[2]);
+    }
+}
+
+}}} // namespace lsst::qserv::parser
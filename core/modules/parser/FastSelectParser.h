@@ -0,0 +1,136 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef LSST_QSERV_PARSER_FASTSELECTPARSER_H
+#define LSST_QSERV_PARSER_FASTSELECTPARSER_H
+/**
+  * @file
+  *
+  * @brief FastSelectParser builds a SelectStmt for common SELECT shapes
+  * without going through the ANTLR grammar.
+  *
+  */
+
+// System headers
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Qserv headers
+#include "query/typedefs.h"
+
+// Forward declarations
+namespace lsst {
+namespace qserv {
+namespace query {
+    class BoolTerm;
+    class BoolFactorTerm;
+    class ColumnRef;
+    class FromList;
+    class GroupByClause;
+    class OrderByClause;
+    class QsRestrictor;
+    class SelectList;
+    class SelectStmt;
+    class ValueFactor;
+    class WhereClause;
+}}} // End of forward declarations
+
+
+namespace lsst {
+namespace qserv {
+namespace parser {
+
+/// FastSelectParser is a hand-written recursive-descent parser for the
+/// SELECT statements that make up most of the query traffic:
+///
+///   SELECT [DISTINCT] select_list FROM table [[AS] alias], ...
+///   [WHERE [qserv_areaspec_xxx(...) AND ...] predicate AND ...]
+///   [GROUP BY column] [ORDER BY column [ASC|DESC], ...] [LIMIT n]
+///
+/// where predicates are comparisons, BETWEEN, IN lists and IS [NOT] NULL
+/// over value expressions built from columns, numbers, function calls and
+/// the count/avg/max/min/sum aggregates.
+///
+/// It produces the same SelectStmt the ANTLR grammar and the parse tree
+/// factories (SelectFactory, WhereFactory, ...) would produce, including
+/// their quirks. Anything outside this subset, or whose lexing could differ
+/// from the ANTLR lexer (string literals, quoted identifiers, comments,
+/// reserved words used as names), is declined so the caller can fall back
+/// to the grammar.
+class FastSelectParser {
+public:
+    /// @return the parsed statement, or nullptr if the statement is outside
+    ///         the supported subset and should be handed to SelectParser's
+    ///         ANTLR path.
+    static std::shared_ptr<query::SelectStmt> parse(std::string const& statement);
+
+private:
+    struct Token {
+        enum Type {END, WORD, NUMBER, PUNCT};
+        Token(Type type_, std::string const& text_);
+        Type type;
+        std::string text;
+        std::string lower; ///< lower-cased text, for keyword matching
+    };
+
+    explicit FastSelectParser(std::vector<Token>& tokens);
+
+    static bool _tokenize(std::string const& statement, std::vector<Token>& tokens);
+    static bool _isReserved(std::string const& lowerWord);
+
+    Token const& _peek(std::size_t ahead=0) const;
+    bool _isWord(char const* keyword, std::size_t ahead=0) const;
+    bool _isPunct(char const* punct, std::size_t ahead=0) const;
+    bool _isAreaspec(std::size_t ahead=0) const;
+    bool _acceptWord(char const* keyword);
+    bool _acceptPunct(char const* punct);
+    void _expectWord(char const* keyword);
+    void _expectPunct(char const* punct);
+    std::string _identifier();
+    bool _hasAlias() const;
+
+    std::shared_ptr<query::SelectStmt> _statement();
+    std::shared_ptr<query::SelectList> _selectList();
+    std::shared_ptr<query::FromList> _fromList();
+    std::shared_ptr<query::WhereClause> _whereClause();
+    std::shared_ptr<query::QsRestrictor> _restrictor();
+    std::shared_ptr<query::BoolTerm> _searchCondition();
+    std::shared_ptr<query::BoolFactorTerm> _predicate();
+    std::shared_ptr<query::GroupByClause> _groupBy();
+    std::shared_ptr<query::OrderByClause> _orderBy();
+    int _limit();
+
+    query::ValueExprPtr _valueExpr();
+    std::shared_ptr<query::ValueFactor> _factor();
+    std::shared_ptr<query::ValueFactor> _aggregate();
+    std::shared_ptr<query::ValueFactor> _function();
+    std::shared_ptr<query::ColumnRef> _columnRef();
+
+    std::vector<Token>& _tokens;
+    std::size_t _pos;
+};
+
+}}} // namespace lsst::qserv::parser
+
+#endif // LSST_QSERV_PARSER_FASTSELECTPARSER_H
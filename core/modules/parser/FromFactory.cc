@@ -46,6 +46,7 @@
 #include "parser/ParseException.h"
 #include "parser/parseTreeUtil.h"
 #include "parser/SqlSQL2Parser.hpp" // applies several "using antlr::***".
+#include "query/Arena.h"
 #include "query/BoolTerm.h"
 #include "query/ColumnRef.h"
 #include "query/FromList.h" // for class FromList
@@ -324,7 +325,7 @@ private:
         std::shared_ptr<query::JoinSpec> js = _processJoinSpec(sib);
 
         std::shared_ptr<query::JoinRef> p =
-                std::make_shared<query::JoinRef>(right, j, false, js);
+                query::makeShared<query::JoinRef>(right, j, false, js);
         return p;
     }
     /// "natural" ( "inner" | outer_join_type ("outer")? )? "join" table_ref
@@ -346,7 +347,7 @@ private:
         RefAST tableChild = sib->getFirstChild();
         query::TableRef::Ptr right = _generate(tableChild);
         std::shared_ptr<query::JoinRef> p =
-                std::make_shared<query::JoinRef>(
+                query::makeShared<query::JoinRef>(
                         right,
                         j,
                         true, // Natural join, no conditions
@@ -370,7 +371,7 @@ private:
         RefAST tableChild = sib->getFirstChild();
         query::TableRef::Ptr right = _generate(tableChild);
         std::shared_ptr<query::JoinRef> p =
-                std::make_shared<query::JoinRef>(right, query::JoinRef::UNION,
+                query::makeShared<query::JoinRef>(right, query::JoinRef::UNION,
                         false, // union join: no condititons
                         query::JoinSpec::Ptr());
         return p;
@@ -392,7 +393,7 @@ private:
         RefAST tableChild = sib->getFirstChild();
         query::TableRef::Ptr right = _generate(tableChild);
         std::shared_ptr<query::JoinRef> p =
-                std::make_shared<query::JoinRef>(
+                query::makeShared<query::JoinRef>(
                         right,
                         query::JoinRef::CROSS,
                         false, // cross join: no conditions
@@ -426,7 +427,7 @@ private:
                 || token->getType() != SqlSQL2TokenTypes::COLUMN_NAME_LIST) {
                 break;
             }
-            js = std::make_shared<query::JoinSpec>(
+            js = query::makeShared<query::JoinSpec>(
                     _processColumn(token->getFirstChild()));
             token = token->getNextSibling();
             if (!token.get()
@@ -446,7 +447,7 @@ private:
                 throw ParseException("Expected OR_OP in join condition", specToken);
             }
             bt = _bFactory.newOrTerm(token);
-            js = std::make_shared<query::JoinSpec>(bt->getReduced());
+            js = query::makeShared<query::JoinSpec>(bt->getReduced());
             return js;
 
         default:
@@ -496,7 +497,7 @@ private:
             throw ParseException("Bad column node for USING", sib);
         }
         std::shared_ptr<query::ColumnRef> c =
-                std::make_shared<query::ColumnRef>("", "", tokenText(sib));
+                query::makeShared<query::ColumnRef>("", "", tokenText(sib));
         return c;
     }
     query::TableRef::Ptr _processQualifiedName(RefAST n) const {
@@ -507,7 +508,7 @@ private:
         QualifiedName qn(n->getFirstChild());
         std::string db;
         if (qn.names.size() > 1) db = qn.getQual(1);
-        return std::make_shared<query::TableRef>(
+        return query::makeShared<query::TableRef>(
                 db,
                 qn.getName(),
                 alias);
@@ -545,8 +546,8 @@ FromFactory::attachTo(SqlSQL2Parser& p) {
 
 void
 FromFactory::_import(antlr::RefAST a) {
-    std::shared_ptr<query::TableRefList> r = std::make_shared<query::TableRefList>();
-    _list = std::make_shared<query::FromList>(r);
+    std::shared_ptr<query::TableRefList> r = query::makeShared<query::TableRefList>();
+    _list = query::makeShared<query::FromList>(r);
 
     assert(_bFactory);
     for(RefGenerator refGen(a, _aliases, *_bFactory);
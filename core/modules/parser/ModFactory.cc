@@ -50,6 +50,7 @@
 #include "parser/parseTreeUtil.h"
 #include "parser/ParseException.h"
 #include "parser/ValueExprFactory.h"
+#include "query/Arena.h"
 #include "query/GroupByClause.h" // Clauses
 #include "query/HavingClause.h"  // Clauses
 #include "query/OrderByClause.h" // Clauses
@@ -143,7 +144,7 @@ void ModFactory::_importOrderBy(antlr::RefAST a) {
     if (!a.get()) {
         throw std::invalid_argument("Cannot _importOrderBy(NULL)");
     }
-    _orderBy = std::make_shared<query::OrderByClause>();
+    _orderBy = query::makeShared<query::OrderByClause>();
     // ORDER BY takes a column ref (expression)
     LOGS(_log, LOG_LVL_DEBUG, "ORDER BY got " << walkTreeString(a));
     while(a.get()) {
@@ -194,7 +195,7 @@ void ModFactory::_importOrderBy(antlr::RefAST a) {
 }
 
 void ModFactory::_importGroupBy(antlr::RefAST a) {
-    _groupBy = std::make_shared<query::GroupByClause>();
+    _groupBy = query::makeShared<query::GroupByClause>();
     // GROUP BY takes a column reference (expression?)
     if (!a.get()) {
         throw std::invalid_argument("Cannot _importGroupBy(NULL)");
@@ -225,7 +226,7 @@ void ModFactory::_importGroupBy(antlr::RefAST a) {
 }
 
 void ModFactory::_importHaving(antlr::RefAST a) {
-    _having = std::make_shared<query::HavingClause>();
+    _having = query::makeShared<query::HavingClause>();
     // HAVING takes an boolean expression that is dependent on an
     // aggregation expression that was specified in the select list.
     // Online examples for SQL HAVING always have only one aggregation
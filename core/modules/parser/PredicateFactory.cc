@@ -42,6 +42,7 @@
 #include "parser/parseTreeUtil.h"
 #include "parser/SqlSQL2Parser.hpp" // (generated) SqlSQL2TokenTypes
 #include "parser/ValueExprFactory.h"
+#include "query/Arena.h"
 #include "query/Predicate.h"
 
 
@@ -51,7 +52,7 @@ namespace parser {
 
 std::shared_ptr<query::CompPredicate>
 PredicateFactory::newCompPredicate(antlr::RefAST a) {
-    std::shared_ptr<query::CompPredicate> p = std::make_shared<query::CompPredicate>();
+    std::shared_ptr<query::CompPredicate> p = query::makeShared<query::CompPredicate>();
     if (a->getType() == SqlSQL2TokenTypes::COMP_PREDICATE) {
         a = a->getFirstChild();
     }
@@ -65,7 +66,7 @@ PredicateFactory::newCompPredicate(antlr::RefAST a) {
 }
 
 std::shared_ptr<query::BetweenPredicate> PredicateFactory::newBetweenPredicate(antlr::RefAST a) {
-    std::shared_ptr<query::BetweenPredicate> p = std::make_shared<query::BetweenPredicate>();
+    std::shared_ptr<query::BetweenPredicate> p = query::makeShared<query::BetweenPredicate>();
     if (a->getType() == SqlSQL2TokenTypes::BETWEEN_PREDICATE) {
         a = a->getFirstChild();
     }
@@ -81,7 +82,7 @@ std::shared_ptr<query::BetweenPredicate> PredicateFactory::newBetweenPredicate(a
 
 std::shared_ptr<query::InPredicate>
 PredicateFactory::newInPredicate(antlr::RefAST a) {
-    std::shared_ptr<query::InPredicate> p = std::make_shared<query::InPredicate>();
+    std::shared_ptr<query::InPredicate> p = query::makeShared<query::InPredicate>();
     if (a->getType() == SqlSQL2TokenTypes::IN_PREDICATE) {
         a = a->getFirstChild();
     }
@@ -104,7 +105,7 @@ PredicateFactory::newInPredicate(antlr::RefAST a) {
 
 std::shared_ptr<query::LikePredicate>
 PredicateFactory::newLikePredicate(antlr::RefAST a) {
-    std::shared_ptr<query::LikePredicate> p = std::make_shared<query::LikePredicate>();
+    std::shared_ptr<query::LikePredicate> p = query::makeShared<query::LikePredicate>();
     if (a->getType() == SqlSQL2TokenTypes::LIKE_PREDICATE) {
         a = a->getFirstChild();
     }
@@ -120,7 +121,7 @@ PredicateFactory::newLikePredicate(antlr::RefAST a) {
 
 std::shared_ptr<query::NullPredicate>
 PredicateFactory::newNullPredicate(antlr::RefAST a) {
-    std::shared_ptr<query::NullPredicate> p = std::make_shared<query::NullPredicate>();
+    std::shared_ptr<query::NullPredicate> p = query::makeShared<query::NullPredicate>();
 
     if (a->getType() == SqlSQL2TokenTypes::NULL_PREDICATE) { a = a->getFirstChild(); }
     RefAST value = a;
@@ -50,6 +50,7 @@
 #include "parser/ParseAliasMap.h"
 #include "parser/ParseException.h"
 #include "parser/parseTreeUtil.h"
+#include "query/Arena.h"
 #include "query/SelectList.h"
 #include "query/SelectStmt.h"
 #include "query/ValueFactor.h"
@@ -88,7 +89,7 @@ SelectFactory::attachTo(SqlSQL2Parser& p) {
 
 std::shared_ptr<query::SelectStmt>
 SelectFactory::getStatement() {
-    std::shared_ptr<query::SelectStmt> stmt = std::make_shared<query::SelectStmt>();
+    std::shared_ptr<query::SelectStmt> stmt = query::makeShared<query::SelectStmt>();
     stmt->_selectList = _slFactory->getProduct();
     stmt->_fromList = _fFactory->getProduct();
     stmt->_whereClause = _wFactory->getProduct();
@@ -41,6 +41,7 @@
 #include "parser/parseTreeUtil.h"
 #include "parser/SqlSQL2Parser.hpp" // applies several "using antlr::***".
 #include "parser/ValueExprFactory.h"
+#include "query/Arena.h"
 #include "query/SelectList.h"
 #include "query/ValueFactor.h"
 
@@ -91,7 +92,7 @@ SelectListFactory::SelectListFactory(std::shared_ptr<ParseAliasMap> aliasMap,
                                      std::shared_ptr<ValueExprFactory> vf)
     : _aliases(aliasMap),
       _vFactory(vf),
-      _valueExprList(std::make_shared<ValueExprPtrVector>()) {
+      _valueExprList(query::makeShared<ValueExprPtrVector>()) {
 }
 
 /// attach the column alias handler. This is needed until we implement code to
@@ -104,7 +105,7 @@ SelectListFactory::attachTo(SqlSQL2Parser& p) {
 }
 
 std::shared_ptr<query::SelectList> SelectListFactory::getProduct() {
-    std::shared_ptr<query::SelectList> slist = std::make_shared<query::SelectList>();
+    std::shared_ptr<query::SelectList> slist = query::makeShared<query::SelectList>();
     slist->_valueExprList = _valueExprList;
     return slist;
 }
@@ -48,12 +48,14 @@
 
 // Qserv headers
 #include "global/Bug.h"
+#include "parser/FastSelectParser.h"
 #include "parser/ParseException.h"
 #include "parser/parseTreeUtil.h"
 #include "parser/SelectFactory.h"
 #include "parser/SqlSQL2Parser.hpp"   //!!! Order is important, SqlSQL2Parser must be first
 #include "parser/SqlSQL2Lexer.hpp"
 #include "parser/SqlSQL2TokenTypes.hpp"
+#include "query/Arena.h"
 #include "query/SelectStmt.h"
 
 // ANTLR headers, declare after auto-generated headers to
@@ -131,18 +133,24 @@ public:
 
 // Static factory function
 SelectParser::Ptr
-SelectParser::newInstance(std::string const& statement) {
-    return std::shared_ptr<SelectParser>(new SelectParser(statement));
+SelectParser::newInstance(std::string const& statement, bool useFastPath) {
+    return std::shared_ptr<SelectParser>(new SelectParser(statement, useFastPath));
 }
 
 // Construtor
-SelectParser::SelectParser(std::string const& statement)
-    :_statement(statement) {
+SelectParser::SelectParser(std::string const& statement, bool useFastPath)
+    :_statement(statement), _useFastPath(useFastPath) {
 }
 
 void
 SelectParser::setup() {
-    _selectStmt = std::make_shared<query::SelectStmt>();
+    if (_useFastPath) {
+        _selectStmt = FastSelectParser::parse(_statement);
+        if (_selectStmt) {
+            return;
+        }
+    }
+    _selectStmt = query::makeShared<query::SelectStmt>();
     _aParser = std::make_shared<AntlrParser>(_statement);
     // model 3: parse tree construction to build intermediate expr.
     SelectFactory sf;
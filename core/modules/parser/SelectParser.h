@@ -65,9 +65,11 @@ class SelectParser {
 public:
     typedef std::shared_ptr<SelectParser> Ptr;
 
-    static Ptr newInstance(std::string const& statement);
+    /// @param useFastPath try FastSelectParser before the ANTLR grammar
+    static Ptr newInstance(std::string const& statement, bool useFastPath=true);
 
-    /// Setup the parser and parse into a SelectStmt
+    /// Setup the parser and parse into a SelectStmt. Statements in the
+    /// FastSelectParser subset skip the ANTLR grammar unless disabled.
     void setup();
 
     // @return Original select statement
@@ -76,9 +78,10 @@ public:
     std::shared_ptr<query::SelectStmt> getSelectStmt() { return _selectStmt; }
 
 private:
-    SelectParser(std::string const& statement);
+    SelectParser(std::string const& statement, bool useFastPath);
 
     std::string const _statement;
+    bool const _useFastPath;
     std::shared_ptr<query::SelectStmt> _selectStmt;
     std::shared_ptr<AntlrParser> _aParser;
 };
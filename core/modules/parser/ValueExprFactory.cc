@@ -39,6 +39,7 @@
 // Qserv headers
 #include "parser/ValueFactorFactory.h"
 #include "parser/ColumnRefH.h"
+#include "query/Arena.h"
 #include "query/ValueExpr.h" // For ValueExpr, FuncExpr
 #include "query/ValueFactor.h" // For ValueFactor
 #include "parser/ParseException.h" //
@@ -68,7 +69,7 @@ ValueExprFactory::ValueExprFactory(std::shared_ptr<ColumnRefNodeMap> cMap)
 /// @param first child of VALUE_EXP node.
 std::shared_ptr<query::ValueExpr>
 ValueExprFactory::newExpr(antlr::RefAST a) {
-    std::shared_ptr<query::ValueExpr> expr = std::make_shared<query::ValueExpr>();
+    std::shared_ptr<query::ValueExpr> expr = query::makeShared<query::ValueExpr>();
     while(a.get()) {
         query::ValueExpr::FactorOp newFactorOp;
         RefAST op = a->getNextSibling();
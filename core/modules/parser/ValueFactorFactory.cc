@@ -46,6 +46,7 @@
 #include "parser/ParseException.h"
 #include "parser/SqlSQL2TokenTypes.hpp"
 #include "parser/ValueExprFactory.h"   // For expression nesting
+#include "query/Arena.h"
 #include "query/ColumnRef.h"
 #include "query/FuncExpr.h"
 #include "query/ValueExpr.h"   // For ValueExpr
@@ -154,7 +155,7 @@ ValueFactorFactory::_newColumnFactor(antlr::RefAST t) {
         t = child;
         child = t->getFirstChild();
     }
-    std::shared_ptr<query::ValueFactor> vt = std::make_shared<query::ValueFactor>();
+    std::shared_ptr<query::ValueFactor> vt = query::makeShared<query::ValueFactor>();
     std::shared_ptr<query::FuncExpr> fe;
     RefAST last;
     int tType = t->getType();
@@ -174,7 +175,7 @@ ValueFactorFactory::_newColumnFactor(antlr::RefAST t) {
             ColumnRefNodeMap::Ref r = it->second;
 
             std::shared_ptr<query::ColumnRef> newColumnRef;
-            newColumnRef = std::make_shared<query::ColumnRef>(
+            newColumnRef = query::makeShared<query::ColumnRef>(
                     tokenText(r.db),
                     tokenText(r.table),
                     tokenText(r.column));
@@ -182,7 +183,7 @@ ValueFactorFactory::_newColumnFactor(antlr::RefAST t) {
         }
         return vt;
     case SqlSQL2TokenTypes::FUNCTION_SPEC:
-        fe = std::make_shared<query::FuncExpr>();
+        fe = query::makeShared<query::FuncExpr>();
         last = walkToSiblingBefore(child, SqlSQL2TokenTypes::LEFT_PAREN);
         fe->name = getSiblingStringBounded(child, last);
         last = last->getNextSibling(); // Advance to LEFT_PAREN
@@ -224,7 +225,7 @@ std::shared_ptr<query::ValueFactor>
 ValueFactorFactory::_newSetFctSpec(antlr::RefAST expr) {
     assert(_columnRefNodeMap);
     // ColumnRefNodeMap& cMap = *_columnRefNodeMap; // for gdb
-    std::shared_ptr<query::FuncExpr> fe = std::make_shared<query::FuncExpr>();
+    std::shared_ptr<query::FuncExpr> fe = query::makeShared<query::FuncExpr>();
     RefAST nNode = expr->getFirstChild();
     if (!nNode.get()) {
         throw ParseException("Missing name node of function spec", expr);
@@ -259,7 +260,7 @@ ValueFactorFactory::_newSetFctSpec(antlr::RefAST expr) {
 std::shared_ptr<query::ValueFactor>
 ValueFactorFactory::_newFunctionSpecFactor(antlr::RefAST fspec) {
     assert(_columnRefNodeMap);
-    std::shared_ptr<query::FuncExpr> fe = std::make_shared<query::FuncExpr>();
+    std::shared_ptr<query::FuncExpr> fe = query::makeShared<query::FuncExpr>();
     RefAST nNode = fspec->getFirstChild();
     if (!nNode.get()) {
         throw ParseException("Missing name node of function spec", fspec);
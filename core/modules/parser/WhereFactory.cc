@@ -51,6 +51,7 @@
 #include "parser/parseTreeUtil.h"
 #include "parser/ParseException.h"
 #include "parser/SqlSQL2Parser.hpp" // applies several "using antlr::***".
+#include "query/Arena.h"
 #include "query/WhereClause.h"
 
 
@@ -188,7 +189,7 @@ WhereFactory::getProduct() {
 
 std::shared_ptr<query::WhereClause>
 WhereFactory::newEmpty() {
-    std::shared_ptr<query::WhereClause> w = std::make_shared<query::WhereClause>();
+    std::shared_ptr<query::WhereClause> w = query::makeShared<query::WhereClause>();
     return w;
 }
 
@@ -200,8 +201,8 @@ WhereFactory::attachTo(SqlSQL2Parser& p) {
 
 void
 WhereFactory::_import(antlr::RefAST a) {
-    _clause = std::make_shared<query::WhereClause>();
-    _clause->_restrs = std::make_shared<query::QsRestrictor::PtrVector>();
+    _clause = query::makeShared<query::WhereClause>();
+    _clause->_restrs = query::makeShared<query::QsRestrictor::PtrVector>();
     if (a->getType() != SqlSQL2TokenTypes::SQL2RW_where) {
         throw ParseException("Bug: _import expected WHERE node", a);
     }
@@ -227,7 +228,7 @@ WhereFactory::_addQservRestrictor(antlr::RefAST a) {
     std::string r(a->getText()); // e.g. qserv_areaspec_box
     ParamGenerator pg(a->getNextSibling());
 
-    query::QsRestrictor::Ptr restr = std::make_shared<query::QsRestrictor>();
+    query::QsRestrictor::Ptr restr = query::makeShared<query::QsRestrictor>();
     StringVector& params = restr->_params;
 
     std::copy(pg.begin(), pg.end(), std::back_inserter(params));
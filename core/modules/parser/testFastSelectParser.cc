@@ -0,0 +1,257 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+/**
+  * @brief Differential test of FastSelectParser against the ANTLR grammar.
+  *
+  */
+
+// System headers
+#include <memory>
+#include <sstream>
+#include <string>
+
+// Qserv headers
+#include "parser/FastSelectParser.h"
+#include "parser/SelectParser.h"
+#include "query/BoolTerm.h"
+#include "query/ColumnRef.h"
+#include "query/FromList.h"
+#include "query/FuncExpr.h"
+#include "query/GroupByClause.h"
+#include "query/OrderByClause.h"
+#include "query/Predicate.h"
+#include "query/QsRestrictor.h"
+#include "query/QueryTemplate.h"
+#include "query/SelectList.h"
+#include "query/SelectStmt.h"
+#include "query/TableRef.h"
+#include "query/ValueExpr.h"
+#include "query/ValueFactor.h"
+#include "query/WhereClause.h"
+#include "tests/QueryCorpus.h"
+
+// Boost unit test header
+#define BOOST_TEST_MODULE FastSelectParser_1
+#include "boost/test/included/unit_test.hpp"
+
+namespace test = boost::test_tools;
+
+using lsst::qserv::parser::FastSelectParser;
+using lsst::qserv::parser::SelectParser;
+using lsst::qserv::tests::queryAnaCorpus;
+using namespace lsst::qserv::query;
+
+namespace {
+
+void dumpExpr(std::ostream& os, ValueExprPtr const& ve);
+
+void dumpFactor(std::ostream& os, std::shared_ptr<ValueFactor const> const& vf) {
+    os << ValueFactor::getTypeString(vf->getType()) << "(";
+    switch (vf->getType()) {
+    case ValueFactor::COLUMNREF:
+        os << vf->getColumnRef()->db << "|" << vf->getColumnRef()->table
+           << "|" << vf->getColumnRef()->column;
+        break;
+    case ValueFactor::FUNCTION:
+    case ValueFactor::AGGFUNC:
+        os << vf->getFuncExpr()->name;
+        for (auto const& p : vf->getFuncExpr()->params) { dumpExpr(os, p); }
+        break;
+    case ValueFactor::EXPR:
+        dumpExpr(os, std::const_pointer_cast<ValueExpr>(vf->getExpr()));
+        break;
+    default:
+        os << vf->getTableStar();
+        break;
+    }
+    os << ")" << vf->getAlias();
+}
+
+void dumpExpr(std::ostream& os, ValueExprPtr const& ve) {
+    os << "[";
+    for (auto const& fo : ve->getFactorOps()) {
+        dumpFactor(os, fo.factor);
+        os << " " << fo.op << " ";
+    }
+    os << "]" << ve->getAlias();
+}
+
+void dumpBoolTerm(std::ostream& os, BoolTerm::Ptr const& term) {
+    os << term->getName() << "{";
+    auto bf = std::dynamic_pointer_cast<BoolFactor>(term);
+    if (bf) {
+        for (auto const& t : bf->_terms) {
+            if (auto p = std::dynamic_pointer_cast<CompPredicate>(t)) {
+                os << "CMP ";
+                dumpExpr(os, p->left);
+                os << p->op;
+                dumpExpr(os, p->right);
+            } else if (auto p = std::dynamic_pointer_cast<BetweenPredicate>(t)) {
+                os << "BETWEEN ";
+                dumpExpr(os, p->value);
+                dumpExpr(os, p->minValue);
+                dumpExpr(os, p->maxValue);
+            } else if (auto p = std::dynamic_pointer_cast<InPredicate>(t)) {
+                os << "IN ";
+                dumpExpr(os, p->value);
+                for (auto const& c : p->cands) { dumpExpr(os, c); }
+            } else if (auto p = std::dynamic_pointer_cast<NullPredicate>(t)) {
+                os << "NULL " << p->hasNot;
+                dumpExpr(os, p->value);
+            } else {
+                t->putStream(os);
+            }
+            os << ";";
+        }
+    } else {
+        for (auto i = term->iterBegin(); i != term->iterEnd(); ++i) {
+            dumpBoolTerm(os, *i);
+        }
+    }
+    os << "}";
+}
+
+/// Render the IR structure, which the generated SQL alone does not show
+/// (factor types, unwrapped parentheses, restrictors, ...).
+std::string dumpStmt(SelectStmt& stmt) {
+    std::ostringstream os;
+    os << stmt.getQueryTemplate().sqlFragment() << "\n";
+    os << "distinct:" << stmt.getDistinct() << " limit:" << stmt.getLimit() << "\n";
+    for (auto const& ve : *stmt.getSelectList().getValueExprList()) {
+        dumpExpr(os, ve);
+    }
+    os << "\nfrom:";
+    for (auto const& t : stmt.getFromList().getTableRefList()) {
+        os << t->getDb() << "|" << t->getTable() << "|" << t->getAlias()
+           << "|" << t->getJoins().size() << " ";
+    }
+    os << "\nwhere:";
+    if (stmt.hasWhereClause()) {
+        WhereClause& wc = stmt.getWhereClause();
+        for (auto const& r : *wc.getRestrs()) {
+            os << r->_name << "(";
+            for (auto const& p : r->_params) { os << p << ","; }
+            os << ")";
+        }
+        if (wc.getRootTerm()) {
+            dumpBoolTerm(os, wc.getRootTerm());
+        }
+    }
+    os << "\ngroupby:";
+    if (stmt.hasGroupBy()) {
+        ValueExprPtrVector exprs;
+        stmt.getGroupBy().findValueExprs(exprs);
+        for (auto const& ve : exprs) { dumpExpr(os, ve); }
+    }
+    os << "\norderby:";
+    if (stmt.hasOrderBy()) {
+        for (auto& t : *stmt.getOrderBy().getTerms()) {
+            dumpExpr(os, t.getExpr());
+            os << t.getOrder();
+        }
+    }
+    os << "\nhaving:" << stmt.hasHaving();
+    return os.str();
+}
+
+/// @return the ANTLR parse of stmt, or nullptr if the grammar rejects it.
+SelectStmt::Ptr parseWithAntlr(std::string const& stmt) {
+    try {
+        SelectParser::Ptr p = SelectParser::newInstance(stmt, false);
+        p->setup();
+        return p->getSelectStmt();
+    } catch (...) {
+        return SelectStmt::Ptr();
+    }
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(Suite)
+
+BOOST_AUTO_TEST_CASE(CorpusAgreesWithAntlr) {
+    int fastCount = 0;
+    for (std::string const& stmt : queryAnaCorpus()) {
+        SelectStmt::Ptr fast = FastSelectParser::parse(stmt);
+        if (!fast) {
+            continue;
+        }
+        ++fastCount;
+        SelectStmt::Ptr slow = parseWithAntlr(stmt);
+        BOOST_CHECK_MESSAGE(slow, "fast path accepted what ANTLR rejects: " << stmt);
+        if (slow) {
+            BOOST_CHECK_EQUAL(dumpStmt(*fast), dumpStmt(*slow));
+        }
+    }
+    // Most of the corpus is in the fast-path subset.
+    BOOST_CHECK_GT(fastCount, 40);
+}
+
+BOOST_AUTO_TEST_CASE(FastPathTaken) {
+    char const* const stmts[] = {
+        "SELECT * FROM Object WHERE objectId = 430213989000",
+        "select ra_PS, decl_PS AS d FROM LSST.Object o WHERE "
+        "qserv_areaspec_box(-1, -2.5, 3, 4) AND o.iFlux_PS > -0.5 "
+        "AND objectId IN (1, 2) AND flags IS NOT NULL ORDER BY ra_PS DESC LIMIT 10;",
+        "SELECT objectId, COUNT(*) AS n FROM Source GROUP BY objectId",
+        "SELECT DISTINCT s.* FROM Source s, Object o "
+        "WHERE s.objectId = o.objectId AND o.ra BETWEEN 1 AND 2 ;;",
+        "SELECT (1+f(one))/f2(two) FROM  Object",
+    };
+    for (char const* stmt : stmts) {
+        SelectStmt::Ptr fast = FastSelectParser::parse(stmt);
+        BOOST_CHECK_MESSAGE(fast, "fast path declined: " << stmt);
+        SelectStmt::Ptr slow = parseWithAntlr(stmt);
+        BOOST_REQUIRE(slow);
+        if (fast) {
+            BOOST_CHECK_EQUAL(dumpStmt(*fast), dumpStmt(*slow));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Fallback) {
+    char const* const stmts[] = {
+        "SELECT * FROM Object o JOIN Source s USING (objectId)",
+        "SELECT * FROM Object WHERE a = 1 OR b = 2",
+        "SELECT * FROM Object WHERE NOT a = 1",
+        "SELECT * FROM Object WHERE (a = 1 AND b = 2)",
+        "SELECT * FROM Filter WHERE filterName = 'g'",
+        "SELECT objectId FROM Source GROUP BY objectId HAVING COUNT(*) > 1",
+        "SELECT objectId FROM Source GROUP BY objectId, filterId",
+        "SELECT * FROM (SELECT * FROM Object) WHERE a > 1",
+        "SELECT * FROM Object -- comment\n",
+        "SELECT `ra` FROM Object",
+        "SELECT _chunkId FROM Object",
+        "SELECT count FROM Object",
+        "SELECT COUNT(DISTINCT objectId) FROM Object",
+        "SELECT * FROM Object WHERE x > -y",
+        "SELECT * FROM Object ORDER BY 1",
+        "SELECT * FROM Object LIMIT 2.5",
+        "SELECT * FROM Object WHERE qserv_areaspec_box()",
+    };
+    for (char const* stmt : stmts) {
+        BOOST_CHECK_MESSAGE(!FastSelectParser::parse(stmt), "fast path accepted: " << stmt);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
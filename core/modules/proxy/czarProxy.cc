@@ -110,6 +110,14 @@ killQuery(std::string const& query, std::string const& clientId) {
     return ::_czar->killQuery(query, clientId);
 }
 
+czar::StreamResult
+getResultSegment(std::string const& messageTable, unsigned cursor) {
+    if (not ::_czar) {
+        throw std::runtime_error("czarProxy/getResultSegment(): czar instance not initialized");
+    }
+    return ::_czar->getResultSegment(messageTable, cursor);
+}
+
 void log(std::string const& loggername, std::string const& level,
          std::string const& filename, std::string const& funcname,
          unsigned int lineno, std::string const& message) {
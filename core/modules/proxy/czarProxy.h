@@ -30,6 +30,7 @@
 // Third-party headers
 
 // Qserv headers
+#include "czar/StreamResult.h"
 #include "czar/SubmitResult.h"
 
 
@@ -79,6 +80,18 @@ czar::SubmitResult submitQuery(std::string const& query,
  */
 std::string killQuery(std::string const& query, std::string const& clientId);
 
+/**
+ * Return result rows of a running query which are already final.
+ *
+ * mysql-proxy itself can only return a complete result to its client, this
+ * is for clients which read the result database while the query runs.
+ *
+ * @param messageTable: message table returned by submitQuery
+ * @param cursor: cursor returned by the previous call, 0 for the first call
+ * @return Structure with a query selecting the new rows.
+ */
+czar::StreamResult getResultSegment(std::string const& messageTable, unsigned cursor);
+
 /**
  *  Send message to logging system. level is a string like "DEBUG".
  */
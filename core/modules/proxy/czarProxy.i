@@ -95,5 +95,6 @@
     }
 }
 
+%include "czar/StreamResult.h"
 %include "czar/SubmitResult.h"
 %include "proxy/czarProxy.h"
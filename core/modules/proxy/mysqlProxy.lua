@@ -313,6 +313,8 @@ function queryProcessing()
         local queryToPassStr = q
         -- Add client db context
         hintsToPassArr["db"] = proxy.connection.client.default_db
+        -- Add user name for fair sharing between users
+        hintsToPassArr["user"] = proxy.connection.client.username
 
         -- Need to save thread_id and reuse for killing query
         hintsToPassArr["client_dst_name"] = proxy.connection.client.dst.name
@@ -42,6 +42,7 @@
 // Qserv headers
 #include "qana/CheckAggregation.h"
 #include "query/AggOp.h"
+#include "query/Arena.h"
 #include "query/FuncExpr.h"
 #include "query/QueryContext.h"
 #include "query/QueryTemplate.h"
@@ -61,7 +62,7 @@ namespace qana {
 
 inline query::ValueExprPtr
 newExprFromAlias(std::string const& alias) {
-    std::shared_ptr<query::ColumnRef> cr = std::make_shared<query::ColumnRef>("", "", alias);
+    std::shared_ptr<query::ColumnRef> cr = query::makeShared<query::ColumnRef>("", "", alias);
     std::shared_ptr<query::ValueFactor> vf;
     vf = query::ValueFactor::newColumnRefFactor(cr);
     return query::ValueExpr::newSimple(vf);
@@ -113,7 +114,7 @@ private:
         // constituent ValueFactors, compute the lists in parallel, and
         // then compute the expression result from the parallel
         // results during merging.
-        query::ValueExprPtr mergeExpr = std::make_shared<query::ValueExpr>();
+        query::ValueExprPtr mergeExpr = query::makeShared<query::ValueExpr>();
         query::ValueExpr::FactorOpVector& mergeFactorOps = mergeExpr->getFactorOps();
         query::ValueExpr::FactorOpVector const& factorOps = e.getFactorOps();
         for(query::ValueExpr::FactorOpVector::const_iterator i=factorOps.begin();
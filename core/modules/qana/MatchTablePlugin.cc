@@ -38,6 +38,7 @@
 #include "css/CssAccess.h"
 #include "parser/SqlSQL2Parser.hpp" // (generated) SqlSQL2TokenTypes
 #include "qana/QueryPlugin.h"
+#include "query/Arena.h"
 #include "query/BoolTerm.h"
 #include "query/ColumnRef.h"
 #include "query/FromList.h"
@@ -116,38 +117,38 @@ void MatchTablePlugin::applyLogical(query::SelectStmt& stmt,
     //
     // First, create IR nodes for "dirCol1 IS NULL".
     std::shared_ptr<NullPredicate> nullPred =
-        std::make_shared<NullPredicate>();
+        query::makeShared<NullPredicate>();
     nullPred->hasNot = false;
     nullPred->value = ValueExpr::newSimple(ValueFactor::newColumnRefFactor(
-        std::make_shared<ColumnRef>("", "", mt.dirColName1)));
+        query::makeShared<ColumnRef>("", "", mt.dirColName1)));
     // Then create IR nodes for "flagCol<>2".
     std::shared_ptr<CompPredicate> compPred =
-        std::make_shared<CompPredicate>();
+        query::makeShared<CompPredicate>();
     compPred->left = ValueExpr::newSimple(ValueFactor::newColumnRefFactor(
-        std::make_shared<ColumnRef>("", "", mt.flagColName)));
+        query::makeShared<ColumnRef>("", "", mt.flagColName)));
     compPred->op = SqlSQL2TokenTypes::NOT_EQUALS_OP;
     compPred->right = ValueExpr::newSimple(ValueFactor::newConstFactor("2"));
     // Create BoolFactors for each Predicate node.
-    std::shared_ptr<BoolFactor> bf1 = std::make_shared<BoolFactor>();
+    std::shared_ptr<BoolFactor> bf1 = query::makeShared<BoolFactor>();
     bf1->_terms.push_back(nullPred);
-    std::shared_ptr<BoolFactor> bf2 = std::make_shared<BoolFactor>();
+    std::shared_ptr<BoolFactor> bf2 = query::makeShared<BoolFactor>();
     bf2->_terms.push_back(compPred);
     // OR together the BoolFactors created above and place
     // inside a BoolTermFactor.
-    std::shared_ptr<OrTerm> bfs = std::make_shared<OrTerm>();
+    std::shared_ptr<OrTerm> bfs = query::makeShared<OrTerm>();
     bfs->_terms.push_back(bf1);
     bfs->_terms.push_back(bf2);
     std::shared_ptr<BoolTermFactor> btf =
-        std::make_shared<BoolTermFactor>();
+        query::makeShared<BoolTermFactor>();
     btf->_term = bfs;
     // Create PassTerm objects for parentheses.
     // TODO: remove this after DM-737 is resolved.
-    std::shared_ptr<PassTerm> openParen = std::make_shared<PassTerm>();
+    std::shared_ptr<PassTerm> openParen = query::makeShared<PassTerm>();
     openParen->_text = "(";
-    std::shared_ptr<PassTerm> closeParen = std::make_shared<PassTerm>();
+    std::shared_ptr<PassTerm> closeParen = query::makeShared<PassTerm>();
     closeParen->_text = ")";
     // Wrap everything up in a BoolFactor
-    std::shared_ptr<BoolFactor> filter = std::make_shared<BoolFactor>();
+    std::shared_ptr<BoolFactor> filter = query::makeShared<BoolFactor>();
     filter->_terms.push_back(openParen);
     filter->_terms.push_back(btf);
     filter->_terms.push_back(closeParen);
@@ -156,7 +157,7 @@ void MatchTablePlugin::applyLogical(query::SelectStmt& stmt,
         stmt.getWhereClause().prependAndTerm(filter);
     } else {
         std::shared_ptr<WhereClause> where =
-            std::make_shared<WhereClause>();
+            query::makeShared<WhereClause>();
         where->prependAndTerm(filter);
         stmt.setWhereClause(where);
     }
@@ -47,6 +47,7 @@
 #include "css/CssAccess.h"
 #include "global/stringTypes.h"
 #include "qana/AnalysisError.h"
+#include "query/Arena.h"
 #include "query/ColumnRef.h"
 #include "query/FromList.h"
 #include "query/FuncExpr.h"
@@ -92,7 +93,7 @@ query::ColumnRef::Vector resolveAsColumnRef(query::QueryContext& context, query:
     std::string column = cr->column;
     query::DbTableSet set = context.resolve(cr);
     for (auto const& dbTblPair : set) {
-        columnRefs.push_back(std::make_shared<query::ColumnRef>(dbTblPair.db, dbTblPair.table, column));
+        columnRefs.push_back(query::makeShared<query::ColumnRef>(dbTblPair.db, dbTblPair.table, column));
     }
     return columnRefs;
 }
@@ -157,7 +158,7 @@ query::QsRestrictor::Ptr newRestrictor(
     }
 
     // Build the QsRestrictor
-    query::QsRestrictor::Ptr restrictor = std::make_shared<query::QsRestrictor>();
+    query::QsRestrictor::Ptr restrictor = query::makeShared<query::QsRestrictor>();
     if (restrictorType==SECONDARY_INDEX_IN) {
         restrictor->_name = "sIndex";
     }
@@ -305,13 +306,13 @@ query::QsRestrictor::PtrVector getSecIndexRestrictors(query::QueryContext& conte
 
 
 query::PassTerm::Ptr newPass(std::string const& s) {
-    query::PassTerm::Ptr p = std::make_shared<query::PassTerm>();
+    query::PassTerm::Ptr p = query::makeShared<query::PassTerm>();
     p->_text = s;
     return p;
 }
 template <typename C>
 query::PassListTerm::Ptr newPassList(C& c) {
-    query::PassListTerm::Ptr p = std::make_shared<query::PassListTerm>();
+    query::PassListTerm::Ptr p = query::makeShared<query::PassListTerm>();
     p->_terms.insert(p->_terms.begin(), c.begin(), c.end());
     return p;
 }
@@ -320,9 +321,9 @@ query::InPredicate::Ptr
 newInPred(std::string const& aliasTable,
           std::string const& secIndexColumn,
           std::vector<std::string> const& params) {
-    query::InPredicate::Ptr p = std::make_shared<query::InPredicate>();
+    query::InPredicate::Ptr p = query::makeShared<query::InPredicate>();
     std::shared_ptr<query::ColumnRef> cr =
-               std::make_shared<query::ColumnRef>(
+               query::makeShared<query::ColumnRef>(
                        "", aliasTable, secIndexColumn);
     p->value =
         query::ValueExpr::newSimple(query::ValueFactor::newColumnRefFactor(cr));
@@ -341,15 +342,15 @@ query::FuncExpr::Ptr newFuncExpr(char const fName[],
                                  std::string const& tableAlias,
                                  StringPair const& chunkColumns,
                                  C& c) {
-    query::FuncExpr::Ptr fe = std::make_shared<query::FuncExpr>();
+    query::FuncExpr::Ptr fe = query::makeShared<query::FuncExpr>();
     fe->name = UDF_PREFIX + fName;
     fe->params.push_back(
           query::ValueExpr::newSimple(query::ValueFactor::newColumnRefFactor(
-                  std::make_shared<query::ColumnRef>(
+                  query::makeShared<query::ColumnRef>(
                           "", tableAlias, chunkColumns.first))));
     fe->params.push_back(
           query::ValueExpr::newSimple(query::ValueFactor::newColumnRefFactor(
-                  std::make_shared<query::ColumnRef>(
+                  query::makeShared<query::ColumnRef>(
                           "", tableAlias, chunkColumns.second))));
 
     typename C::const_iterator i;
@@ -456,10 +457,10 @@ private:
 
         virtual query::BoolFactor::Ptr operator()(RestrictorEntry const& e) {
             query::BoolFactor::Ptr newFactor =
-                    std::make_shared<query::BoolFactor>();
+                    query::makeShared<query::BoolFactor>();
             query::BoolFactorTerm::PtrVector& terms = newFactor->_terms;
             query::CompPredicate::Ptr cp =
-                    std::make_shared<query::CompPredicate>();
+                    query::makeShared<query::CompPredicate>();
             std::shared_ptr<query::FuncExpr> fe =
                 newFuncExpr(fName, e.alias, e.chunkColumns, params);
             cp->left =
@@ -545,7 +546,7 @@ QservRestrictorPlugin::applyLogical(query::SelectStmt& stmt,
             throw AnalysisError("Spatial restrictor w/o partitioned table");
         }
 
-        auto newTerm = std::make_shared<query::AndTerm>();
+        auto newTerm = query::makeShared<query::AndTerm>();
         // spatial restrictions
         // Now, for each of the qserv restrictors:
         for (auto const& restrictor : *whereClauseRestrictors) {
@@ -567,7 +568,7 @@ QservRestrictorPlugin::applyLogical(query::SelectStmt& stmt,
     ctxRestrictors.insert(ctxRestrictors.end(), secIndexPreds.begin(), secIndexPreds.end());
 
     if (not ctxRestrictors.empty()) {
-        context.restrictors = std::make_shared<query::QueryContext::RestrList>(ctxRestrictors);
+        context.restrictors = query::makeShared<query::QueryContext::RestrList>(ctxRestrictors);
     }
 }
 
@@ -47,6 +47,7 @@
 
 // Qserv headers
 #include "qproc/ChunkSpec.h"
+#include "query/Arena.h"
 #include "query/QueryTemplate.h"
 
 
@@ -110,7 +111,7 @@ public:
     virtual ~Mapping() {}
 
     query::QueryTemplate::Entry::Ptr mapEntry(query::QueryTemplate::Entry const& e) const override {
-        auto newE = std::make_shared<query::QueryTemplate::StringEntry>(e.getValue());
+        auto newE = query::makeShared<query::QueryTemplate::StringEntry>(e.getValue());
 
         // FIXME see if this works
         //if (!e.isDynamic()) {return newE; }
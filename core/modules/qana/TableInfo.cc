@@ -33,6 +33,7 @@
 #include "lsst/log/Log.h"
 
 // Qserv headers
+#include "query/Arena.h"
 #include "query/ColumnRef.h"
 
 
@@ -55,15 +56,15 @@ void appendColumnRefs(std::string const& column,
         return;
     }
     std::string const _; // an empty string
-    refs.push_back(std::make_shared<lsst::qserv::query::ColumnRef>(_, _, column));
+    refs.push_back(lsst::qserv::query::makeShared<ColumnRef>(_, _, column));
     if (!tableAlias.empty()) {
         // If a table alias has been introduced, then it is an error to
         // refer to a column using table.column or db.table.column
-        refs.push_back(std::make_shared<ColumnRef>(_, tableAlias, column));
+        refs.push_back(lsst::qserv::query::makeShared<ColumnRef>(_, tableAlias, column));
     } else if (!table.empty()) {
-        refs.push_back(std::make_shared<ColumnRef>(_, table, column));
+        refs.push_back(lsst::qserv::query::makeShared<ColumnRef>(_, table, column));
         if (!database.empty()) {
-            refs.push_back(std::make_shared<ColumnRef>(database, table, column));
+            refs.push_back(lsst::qserv::query::makeShared<ColumnRef>(database, table, column));
         }
     }
 }
@@ -176,7 +176,9 @@ JobQuery::Ptr Executive::add(JobDescription::Ptr const& jobDesc) {
 
 
 void Executive::_queueJobStart(JobQuery::Ptr const& job) {
-    std::function<void(util::CmdData*)> func = [job](util::CmdData*) {
+    Ptr thisPtr = shared_from_this();
+    std::function<void(util::CmdData*)> func = [thisPtr, job](util::CmdData*) {
+        thisPtr->_waitForJobSlot(job->getIdInt());
         job->runJob();
     };
     auto cmd = std::make_shared<util::Command>(func);
@@ -184,6 +186,29 @@ void Executive::_queueJobStart(JobQuery::Ptr const& job) {
 }
 
 
+/// Block until the job limit allows another job to start, or the query is cancelled.
+void Executive::_waitForJobSlot(int jobId) {
+    if (!_jobLimit) return;
+    std::unique_lock<std::mutex> lock(_incompleteJobsMutex);
+    bool waited = false;
+    while (!_cancelled) {
+        int limit = _jobLimit();
+        if (limit < 1 || static_cast<int>(_startedJobs.size()) < limit) break;
+        if (!waited) {
+            waited = true;
+            LOGS(_log, LOG_LVL_DEBUG, QueryIdHelper::makeIdStr(_id, jobId)
+                 << " waiting to start, job limit=" << limit);
+        }
+        // The limit also changes when other queries start or finish, check it periodically.
+        _jobSlotFreed.wait_for(lock, std::chrono::seconds(1));
+    }
+    // Jobs cancelled before they started are not tracked any more.
+    if (_incompleteJobs.find(jobId) != _incompleteJobs.end()) {
+        _startedJobs.insert(jobId);
+    }
+}
+
+
 void Executive::waitForAllJobsToStart() {
     _startJobsPool->endAll();
     _startJobsPool->waitForResize(0); // No time limit.
@@ -218,18 +243,17 @@ bool Executive::join() {
     // Check to see if _requesters is empty, if not, then sleep on a condition.
     _waitAllUntilEmpty();
     // Okay to merge. probably not the Executive's responsibility
-    struct successF {
-        static bool f(Executive::JobMap::value_type const& entry) {
-            JobStatus::Info const& esI = entry.second->getStatus()->getInfo();
-            LOGS(_log, LOG_LVL_DEBUG, "entry state:" << (void*)entry.second.get() << " " << esI);
-            return (esI.state == JobStatus::RESPONSE_DONE) || (esI.state == JobStatus::COMPLETE);
-        }
+    auto successF = [this](Executive::JobMap::value_type const& entry) {
+        JobQuery::Ptr job = _getResultJob(entry.first, entry.second);
+        JobStatus::Info const& esI = job->getStatus()->getInfo();
+        LOGS(_log, LOG_LVL_DEBUG, "entry state:" << (void*)job.get() << " " << esI);
+        return (esI.state == JobStatus::RESPONSE_DONE) || (esI.state == JobStatus::COMPLETE);
     };
 
     int sCount = 0;
     {
         std::lock_guard<std::recursive_mutex> lock(_jobsMutex);
-        sCount = std::count_if(_jobMap.begin(), _jobMap.end(), successF::f);
+        sCount = std::count_if(_jobMap.begin(), _jobMap.end(), successF);
     }
     if (sCount == _requestCount) {
         LOGS(_log, LOG_LVL_DEBUG, "Query execution succeeded: " << _requestCount
@@ -247,6 +271,22 @@ bool Executive::join() {
 }
 
 void Executive::markCompleted(int jobId, bool success) {
+    if (_resolveDuplicate(jobId, false, success)) {
+        _markCompleted(jobId, success);
+    }
+}
+
+
+void Executive::markDuplicateCompleted(int jobId, bool success) {
+    LOGS(_log, LOG_LVL_DEBUG, "Executive::markDuplicateCompleted "
+         << QueryIdHelper::makeIdStr(_id, jobId) << " " << success);
+    if (_resolveDuplicate(jobId, true, success)) {
+        _markCompleted(jobId, success);
+    }
+}
+
+
+void Executive::_markCompleted(int jobId, bool success) {
     ResponseHandler::Error err;
     std::string idStr = QueryIdHelper::makeIdStr(_id, jobId);
     LOGS(_log, LOG_LVL_DEBUG, "Executive::markCompleted " << idStr
@@ -284,6 +324,9 @@ void Executive::markCompleted(int jobId, bool success) {
                  << " registered errors: " << _multiError);
         }
     }
+    if (success) {
+        _recordCompletion(jobId);
+    }
     _unTrack(jobId);
     if (!success) {
         LOGS(_log, LOG_LVL_ERROR, "Executive: requesting squash, cause: "
@@ -301,6 +344,11 @@ void Executive::squash() {
     }
 
     LOGS(_log, LOG_LVL_DEBUG, getIdStr() << " Executive::squash Trying to cancel all queries...");
+    {
+        // Release jobs waiting for the job limit.
+        std::lock_guard<std::mutex> lock(_incompleteJobsMutex);
+        _jobSlotFreed.notify_all();
+    }
     std::deque<JobQuery::Ptr> jobsToCancel;
     {
         std::lock_guard<std::recursive_mutex> lock(_jobsMutex);
@@ -308,6 +356,12 @@ void Executive::squash() {
             jobsToCancel.push_back(jobEntry.second);
         }
     }
+    {
+        std::lock_guard<std::mutex> lock(_duplicatesMutex);
+        for (auto const& dupEntry : _duplicates) {
+            jobsToCancel.push_back(dupEntry.second.duplicate);
+        }
+    }
 
     for (auto const& job : jobsToCancel) {
         job->cancel();
@@ -392,6 +446,7 @@ void Executive::_unTrack(int jobId) {
         if (i != _incompleteJobs.end()) {
             _incompleteJobs.erase(i);
             untracked = true;
+            if (_startedJobs.erase(jobId) > 0) _jobSlotFreed.notify_one();
             if (_incompleteJobs.empty()) _allJobsComplete.notify_all();
         }
         if (!untracked || LOG_CHECK_LVL(_log, LOG_LVL_DEBUG)) {
@@ -431,7 +486,7 @@ void Executive::_updateProxyMessages() {
     {
         std::lock_guard<std::recursive_mutex> lock(_jobsMutex);
         for (auto const& entry : _jobMap) {
-            JobQuery::Ptr const& job = entry.second;
+            JobQuery::Ptr job = _getResultJob(entry.first, entry.second);
             auto const& info = job->getStatus()->getInfo();
             std::ostringstream os;
             os << info.state << " " << info.stateCode;
@@ -481,7 +536,163 @@ void Executive::_waitAllUntilEmpty() {
             }
         }
         _allJobsComplete.wait_for(lock, statePrintDelay);
+        if (_config.speculativePercentile > 0 && !_incompleteJobs.empty()) {
+            lock.unlock();
+            _duplicateStragglers();
+            lock.lock();
+        }
+    }
+}
+
+
+/// Handle the completion of a job that may have a speculative duplicate.
+/// The first copy of the job to succeed provides the result, the other copy is
+/// cancelled and its rows are scrubbed from the result table. The job only fails
+/// if both copies fail.
+/// @param duplicate - true if the completed copy is the speculative duplicate.
+/// @return true if the completion should be processed as the completion of the job.
+bool Executive::_resolveDuplicate(int jobId, bool duplicate, bool success) {
+    std::string idStr = QueryIdHelper::makeIdStr(_id, jobId);
+    JobQuery::Ptr loser;
+    {
+        std::lock_guard<std::mutex> lock(_duplicatesMutex);
+        auto iter = _duplicates.find(jobId);
+        if (iter == _duplicates.end()) {
+            return true; // The job was not duplicated.
+        }
+        Duplicate& dup = iter->second;
+        if (dup.winner != Duplicate::NONE) {
+            // The other copy already provided the result, this one was cancelled or superseded.
+            LOGS(_log, LOG_LVL_DEBUG, idStr << " ignoring completion of "
+                 << (duplicate ? "duplicate" : "original") << " success=" << success);
+            return false;
+        }
+        if (!success) {
+            if (duplicate) {
+                dup.duplicateFailed = true;
+            } else {
+                dup.originalFailed = true;
+            }
+            return dup.duplicateFailed && dup.originalFailed;
+        }
+        dup.winner = duplicate ? Duplicate::DUPLICATE : Duplicate::ORIGINAL;
+        loser = duplicate ? dup.original : dup.duplicate;
+    }
+    LOGS(_log, LOG_LVL_INFO, idStr << " " << (duplicate ? "speculative duplicate" : "original")
+         << " finished first, cancelling the other copy");
+    // The completion of the cancelled copy is ignored as the job has a winner.
+    loser->cancel();
+    auto desc = loser->getDescription();
+    if (desc->getAttemptCount() >= desc->getFirstAttempt()) {
+        desc->respHandler()->scrubResults(jobId, desc->getAttemptCount());
+    }
+    return true;
+}
+
+
+/// Record the run time of a successful job, measured on the copy that provided
+/// its result so that speculative duplicates don't inflate the straggler threshold.
+void Executive::_recordCompletion(int jobId) {
+    JobQuery::Ptr job;
+    {
+        std::lock_guard<std::recursive_mutex> lock(_jobsMutex);
+        auto iter = _jobMap.find(jobId);
+        if (iter == _jobMap.end()) return;
+        job = iter->second;
     }
+    job = _getResultJob(jobId, job);
+    std::chrono::steady_clock::time_point startTime;
+    if (!job->getStartTime(startTime)) return;
+    std::chrono::duration<double> runTime = std::chrono::steady_clock::now() - startTime;
+    std::lock_guard<std::mutex> lock(_duplicatesMutex);
+    _completedSeconds.push_back(runTime.count());
+}
+
+
+/// Dispatch speculative duplicates of straggler jobs. Once speculativePercentile
+/// percent of the jobs have completed, jobs that have not returned data yet and
+/// have run longer than that percentile of the completion times are duplicated.
+void Executive::_duplicateStragglers() {
+    int const percentile = _config.speculativePercentile;
+    if (percentile <= 0 || _cancelled) return;
+    double threshold = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(_duplicatesMutex);
+        std::size_t const completed = _completedSeconds.size();
+        if (completed == 0 || completed * 100 < static_cast<std::size_t>(_requestCount) * percentile) {
+            return;
+        }
+        std::vector<double> seconds(_completedSeconds);
+        auto nth = seconds.begin() + std::min(completed - 1, completed * percentile / 100);
+        std::nth_element(seconds.begin(), nth, seconds.end());
+        threshold = std::max(*nth, static_cast<double>(_config.speculativeMinSeconds));
+    }
+
+    std::vector<JobQuery::Ptr> jobs;
+    {
+        std::lock_guard<std::mutex> lock(_incompleteJobsMutex);
+        for (auto const& entry : _incompleteJobs) {
+            jobs.push_back(entry.second);
+        }
+    }
+    auto now = std::chrono::steady_clock::now();
+    for (auto const& job : jobs) {
+        std::chrono::steady_clock::time_point startTime;
+        if (!job->getStartTime(startTime)) continue;
+        std::chrono::duration<double> runTime = now - startTime;
+        if (runTime.count() <= threshold) continue;
+        switch (job->getStatus()->getInfo().state) {
+        case JobStatus::PROVISION:
+        case JobStatus::PROVISION_NACK:
+        case JobStatus::REQUEST:
+        case JobStatus::RESPONSE_READY:
+            // No data received yet, the job is stuck on its worker.
+            _addDuplicate(job);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+
+/// Dispatch a speculative duplicate of job, unless it already has one. xrootd
+/// routes the duplicate to any worker serving the chunk's resource unit.
+void Executive::_addDuplicate(JobQuery::Ptr const& job) {
+    int const jobId = job->getIdInt();
+    auto handler = job->getDescription()->respHandler()->newDuplicateHandler();
+    if (handler == nullptr) return;
+    JobQuery::Ptr duplicate;
+    {
+        std::lock_guard<std::recursive_mutex> lock(_cancelled.getMutex());
+        if (_cancelled) return;
+        std::lock_guard<std::mutex> dupLock(_duplicatesMutex);
+        if (_duplicates.find(jobId) != _duplicates.end()) return;
+        Ptr thisPtr = shared_from_this();
+        auto mcf = std::make_shared<MarkCompleteFunc>(thisPtr, jobId, true);
+        duplicate = JobQuery::newJobQuery(thisPtr, job->getDescription()->newDuplicate(handler),
+                                          std::make_shared<JobStatus>(), mcf, _id);
+        Duplicate& dup = _duplicates[jobId];
+        dup.original = job;
+        dup.duplicate = duplicate;
+    }
+    LOGS(_log, LOG_LVL_INFO, duplicate->getIdStr() << " straggler, dispatching speculative duplicate");
+    // _startJobsPool is finished by now, start the duplicate from this thread.
+    if (!duplicate->runJob()) {
+        markDuplicateCompleted(jobId, false);
+    }
+}
+
+
+/// @return the copy of the job that provided its result, the speculative duplicate
+/// if it finished first, job otherwise.
+JobQuery::Ptr Executive::_getResultJob(int jobId, JobQuery::Ptr const& job) {
+    std::lock_guard<std::mutex> lock(_duplicatesMutex);
+    auto iter = _duplicates.find(jobId);
+    if (iter != _duplicates.end() && iter->second.winner == Duplicate::DUPLICATE) {
+        return iter->second.duplicate;
+    }
+    return job;
 }
 
 std::ostream& operator<<(std::ostream& os, Executive::JobMap::value_type const& v) {
@@ -28,9 +28,12 @@
 
 // System headers
 #include <atomic>
+#include <functional>
+#include <map>
 #include <mutex>
 #include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 // Qserv headers
@@ -73,6 +76,13 @@ public:
 
         std::string serviceUrl; ///< XrdSsi service URL, e.g. localhost:1094
         static std::string getMockStr() {return "Mock";};
+
+        /// A job that has not returned any data yet, and has been running longer than
+        /// this percentile of the completion times of the finished jobs of the query,
+        /// gets a speculative duplicate once this percentage of the jobs are complete.
+        /// 0 disables speculative dispatch.
+        int speculativePercentile{0};
+        int speculativeMinSeconds{30}; ///< Minimum run time before a job can be duplicated.
     };
 
     /// Construct an Executive.
@@ -87,6 +97,11 @@ public:
     std::shared_ptr<JobQuery> add(JobDescription::Ptr const& s);
 
 
+    /// Limit the number of started, incomplete jobs to the value returned by
+    /// jobLimit, which is called whenever a job is about to start. Values < 1
+    /// mean no limit. Must be called before any job is added.
+    void setJobLimit(std::function<int()> const& jobLimit) { _jobLimit = jobLimit; }
+
     /// Waits for all jobs on _startJobsPool to start. This should not be called
     /// before ALL jobs have been added to the pool.
     void waitForAllJobsToStart();
@@ -99,6 +114,9 @@ public:
     /// Notify the executive that an item has completed
     void markCompleted(int refNum, bool success);
 
+    /// Notify the executive that the speculative duplicate of an item has completed.
+    void markDuplicateCompleted(int refNum, bool success);
+
     /// Squash all the jobs.
     void squash();
 
@@ -134,12 +152,15 @@ public:
     int endQSEASum{0}; // TEMPORARY-timing
 
 private:
+    friend class ExecutiveDebug;
+
     Executive(Config::Ptr const& c, std::shared_ptr<MessageStore> const& ms,
               std::shared_ptr<LargeResultMgr> const& largeResultMgr);
 
     void _setup();
 
     void _queueJobStart(std::shared_ptr<JobQuery> const& job);
+    void _waitForJobSlot(int jobId);
     bool _track(int refNum, std::shared_ptr<JobQuery> const& r);
     void _unTrack(int refNum);
     bool _addJobToMap(std::shared_ptr<JobQuery> const& job);
@@ -149,6 +170,13 @@ private:
 
     void _waitAllUntilEmpty();
 
+    void _markCompleted(int jobId, bool success);
+    bool _resolveDuplicate(int jobId, bool duplicate, bool success);
+    void _recordCompletion(int jobId);
+    void _duplicateStragglers();
+    void _addDuplicate(std::shared_ptr<JobQuery> const& job);
+    std::shared_ptr<JobQuery> _getResultJob(int jobId, std::shared_ptr<JobQuery> const& job);
+
     // for debugging
     void _printState(std::ostream& os);
 
@@ -173,8 +201,27 @@ private:
     mutable std::mutex _errorsMutex;
 
     std::condition_variable _allJobsComplete;
+
+    std::function<int()> _jobLimit; ///< Limit on started, incomplete jobs, see setJobLimit().
+    std::unordered_set<int> _startedJobs; ///< Started, incomplete jobs, protected by _incompleteJobsMutex.
+    std::condition_variable _jobSlotFreed; ///< Signalled when a started job completes.
     mutable std::recursive_mutex _jobsMutex;
 
+    /// A straggler job and its speculative duplicate. The first of the two to
+    /// complete successfully provides the job's result, the other one is cancelled
+    /// and its rows are scrubbed from the result table.
+    struct Duplicate {
+        enum Winner { NONE, ORIGINAL, DUPLICATE };
+        std::shared_ptr<JobQuery> original;
+        std::shared_ptr<JobQuery> duplicate;
+        Winner winner{NONE};
+        bool originalFailed{false};
+        bool duplicateFailed{false};
+    };
+    std::map<int, Duplicate> _duplicates; ///< Duplicated jobs by job id.
+    std::vector<double> _completedSeconds; ///< Run times of successful jobs.
+    std::mutex _duplicatesMutex; ///< protects _duplicates and _completedSeconds.
+
     QueryId _id{0}; ///< Unique identifier for this query.
     std::string    _idStr{QueryIdHelper::makeIdStr(0, true)};
     util::InstanceCount _instC{"Executive"};
@@ -187,19 +234,25 @@ class MarkCompleteFunc {
 public:
     typedef std::shared_ptr<MarkCompleteFunc> Ptr;
 
-    MarkCompleteFunc(Executive::Ptr const& e, int jobId) : _executive(e), _jobId(jobId) {}
+    MarkCompleteFunc(Executive::Ptr const& e, int jobId, bool duplicate=false)
+        : _executive(e), _jobId(jobId), _duplicate(duplicate) {}
     virtual ~MarkCompleteFunc() {}
 
     virtual void operator()(bool success) {
         auto exec = _executive.lock();
         if (exec != nullptr) {
-            exec->markCompleted(_jobId, success);
+            if (_duplicate) {
+                exec->markDuplicateCompleted(_jobId, success);
+            } else {
+                exec->markCompleted(_jobId, success);
+            }
         }
     }
 
 private:
     std::weak_ptr<Executive> _executive;
     int _jobId;
+    bool _duplicate; ///< True if this is for a speculative duplicate of the job.
 };
 
 }}} // namespace lsst::qserv::qdisp
@@ -49,20 +49,32 @@ namespace qserv {
 namespace qdisp {
 
 
+int const JobDescription::SPECULATIVE_FIRST_ATTEMPT;
+
+
 JobDescription::JobDescription(QueryId qId, int jobId, ResourceUnit const& resource,
     std::shared_ptr<ResponseHandler> const& respHandler,
     std::shared_ptr<qproc::TaskMsgFactory> const& taskMsgFactory,
     std::shared_ptr<qproc::ChunkQuerySpec> const& chunkQuerySpec,
-    std::string const& chunkResultName, bool mock)
+    std::string const& chunkResultName, bool mock, int firstAttempt)
     : _queryId(qId), _jobId(jobId), _qIdStr(QueryIdHelper::makeIdStr(_queryId, _jobId)),
+      _firstAttempt(firstAttempt), _attemptCount(firstAttempt - 1),
       _resource(resource), _respHandler(respHandler),
      _taskMsgFactory(taskMsgFactory), _chunkQuerySpec(chunkQuerySpec), _chunkResultName(chunkResultName),
      _mock(mock) {
 }
 
 
+JobDescription::Ptr JobDescription::newDuplicate(std::shared_ptr<ResponseHandler> const& respHandler) const {
+    JobDescription::Ptr jd(new JobDescription(_queryId, _jobId, _resource, respHandler,
+                                              _taskMsgFactory, _chunkQuerySpec,
+                                              _chunkResultName, _mock, SPECULATIVE_FIRST_ATTEMPT));
+    return jd;
+}
+
+
 bool JobDescription::incrAttemptCountScrubResults() {
-    if (_attemptCount >= 0) {
+    if (_attemptCount >= _firstAttempt) {
         _respHandler->scrubResults(_jobId, _attemptCount);
     }
     ++_attemptCount;
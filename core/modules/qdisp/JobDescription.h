@@ -69,6 +69,15 @@ public:
         return jd;
     }
 
+    /// @return a description of a speculative duplicate of this job, with results
+    /// going to respHandler. Its attempts are numbered from SPECULATIVE_FIRST_ATTEMPT
+    /// so that they can be told apart from, and scrubbed independently of, the
+    /// attempts of the original job.
+    JobDescription::Ptr newDuplicate(std::shared_ptr<ResponseHandler> const& respHandler) const;
+
+    /// First attempt number of speculative duplicates.
+    static int const SPECULATIVE_FIRST_ATTEMPT = MAX_JOB_ATTEMPTS / 2;
+
     JobDescription(JobDescription const&) = delete;
     JobDescription& operator=(JobDescription const&) = delete;
 
@@ -78,6 +87,7 @@ public:
     std::string const& payload()  { return _payloads[_attemptCount]; }
     std::shared_ptr<ResponseHandler> respHandler() { return _respHandler; }
     int getAttemptCount() const { return _attemptCount; }
+    int getFirstAttempt() const { return _firstAttempt; } ///< Number of the first attempt.
 
     /// @returns true when _attemptCount is incremented correctly and the payload is built.
     /// If the starting value of _attemptCount was greater than or equal to zero, that
@@ -91,11 +101,12 @@ private:
             std::shared_ptr<ResponseHandler> const& respHandler,
             std::shared_ptr<qproc::TaskMsgFactory> const& taskMsgFactory,
             std::shared_ptr<qproc::ChunkQuerySpec> const& chunkQuerySpec,
-            std::string const& chunkResultName, bool mock=false);
+            std::string const& chunkResultName, bool mock=false, int firstAttempt=0);
     QueryId _queryId;
     int _jobId; ///< Job's Id number.
     std::string const _qIdStr;
-    int _attemptCount{-1}; ///< Start at -1 so that first attempt will be 0, see incrAttemptCount().
+    int const _firstAttempt; ///< 0, or SPECULATIVE_FIRST_ATTEMPT for a speculative duplicate.
+    int _attemptCount; ///< Start at _firstAttempt-1, see incrAttemptCountScrubResults().
     ResourceUnit _resource; ///< path, e.g. /q/LSST/23125
 
     /// _payloads - encoded requests, one per attempt. No guarantee that xrootd is done
@@ -83,7 +83,12 @@ bool JobQuery::runJob() {
         LOGS(_log, LOG_LVL_DEBUG, _idStr << " runJob checking attempt=" << _jobDescription->getAttemptCount());
         auto qr = std::make_shared<QueryResource>(shared_from_this());
         std::lock_guard<std::recursive_mutex> lock(_rmutex);
-        if (_jobDescription->getAttemptCount() < _getMaxAttempts()) {
+        if (!_started) {
+            _started = true;
+            _startTime = std::chrono::steady_clock::now();
+        }
+        int attempts = _jobDescription->getAttemptCount() - _jobDescription->getFirstAttempt();
+        if (attempts < _getMaxAttempts()) {
             bool okCount = _jobDescription->incrAttemptCountScrubResults();
             if (!okCount) {
                 criticalErr("hit structural max of retries");
@@ -158,7 +163,7 @@ bool JobQuery::cancel() {
                 LOGS(_log, LOG_LVL_ERROR, " can't markComplete cancelled, executive == nullptr");
                 return false;
             }
-            executive->markCompleted(getIdInt(), false);
+            _markCompleteFunc->operator()(false);
         }
         _jobDescription->respHandler()->processCancel();
         return true;
@@ -28,6 +28,7 @@
 
 // System headers
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 
@@ -94,6 +95,14 @@ public:
         return _queryResourcePtr;
     }
 
+    /// @return true and set startTime to when the first attempt of this job was
+    ///         started, false if it hasn't been started.
+    bool getStartTime(std::chrono::steady_clock::time_point& startTime) const {
+        std::lock_guard<std::recursive_mutex> lock(_rmutex);
+        startTime = _startTime;
+        return _started;
+    }
+
     friend std::ostream& operator<<(std::ostream& os, JobQuery const& jq);
 
     /// Make a copy of the job description. JobQuery::_setup() must be called after creation.
@@ -129,11 +138,13 @@ protected:
 
     // Values that need mutex protection
     mutable std::recursive_mutex _rmutex; ///< protects _jobDescription, _queryResourcePtr,
-                                          /// _queryRequestPtr
+                                          /// _queryRequestPtr, _started, _startTime
 
     // xrootd items
     std::shared_ptr<QueryResource> _queryResourcePtr;
     std::shared_ptr<QueryRequest> _queryRequestPtr;
+    bool _started{false}; ///< True after the first attempt was started.
+    std::chrono::steady_clock::time_point _startTime; ///< Start of the first attempt.
 
     // Cancellation
     std::atomic<bool> _cancelled {false}; ///< Lock to make sure cancel() is only called once.
@@ -86,6 +86,10 @@ public:
     /// Scrub the results from jobId-attempt from the result table.
     virtual bool scrubResults(int jobId, int attempt) = 0;
 
+    /// @return a new handler merging into the same destination, used by a
+    /// speculative duplicate of the job. nullptr if duplicates are not supported.
+    virtual std::shared_ptr<ResponseHandler> newDuplicateHandler() { return nullptr; }
+
     std::weak_ptr<JobQuery> getJobQuery() { return _jobQuery; }
 
 private:
@@ -194,6 +194,43 @@ public:
 }}} // namespace lsst::qserv::qproc
 
 
+namespace lsst {
+namespace qserv {
+namespace qdisp {
+
+/// Access to the speculative duplicate handling of Executive.
+class ExecutiveDebug {
+public:
+    static void addDuplicate(Executive& ex, JobQuery::Ptr const& job) {
+        ex._addDuplicate(job);
+    }
+    static std::vector<double> getCompletedSeconds(Executive& ex) {
+        std::lock_guard<std::mutex> lock(ex._duplicatesMutex);
+        return ex._completedSeconds;
+    }
+};
+
+}}} // namespace lsst::qserv::qdisp
+
+
+/** ResponseHandler that can be duplicated and records scrubbed attempts.
+ */
+class DuplicatingHandlerTest : public ResponseHandlerTest {
+public:
+    std::shared_ptr<qdisp::ResponseHandler> newDuplicateHandler() override {
+        auto handler = std::make_shared<DuplicatingHandlerTest>();
+        duplicate = handler;
+        return handler;
+    }
+    bool scrubResults(int jobId, int attempt) override {
+        scrubbed.push_back(attempt);
+        return true;
+    }
+    std::shared_ptr<DuplicatingHandlerTest> duplicate;
+    std::vector<int> scrubbed;
+};
+
+
 qdisp::JobDescription::Ptr makeMockJobDescription(qdisp::Executive::Ptr const& ex, int sequence,
                                                   ResourceUnit const& ru, std::string msg,
                                                   std::shared_ptr<qdisp::ResponseHandler> const& mHandler) {
@@ -513,6 +550,78 @@ BOOST_AUTO_TEST_CASE(ExecutiveCancel) {
 
 }
 
+BOOST_AUTO_TEST_CASE(DuplicateJobDescription) {
+    LOGS_DEBUG("Check the attempts of a speculative duplicate");
+    std::string str = qdisp::Executive::Config::getMockStr();
+    qdisp::Executive::Config::Ptr conf = std::make_shared<qdisp::Executive::Config>(str);
+    std::shared_ptr<qdisp::MessageStore> ms = std::make_shared<qdisp::MessageStore>();
+    qdisp::LargeResultMgr::Ptr lgResMgr = std::make_shared<qdisp::LargeResultMgr>();
+    qdisp::Executive::Ptr ex = qdisp::Executive::newExecutive(conf, ms, lgResMgr);
+    ResourceUnit ru;
+    auto respReq = std::make_shared<ResponseHandlerTest>();
+    BOOST_CHECK(respReq->newDuplicateHandler() == nullptr);
+    auto jobDesc = makeMockJobDescription(ex, 3, ru, "a message", respReq);
+    BOOST_CHECK(jobDesc->incrAttemptCountScrubResults());
+    BOOST_CHECK_EQUAL(jobDesc->getAttemptCount(), 0);
+
+    auto dupReq = std::make_shared<ResponseHandlerTest>();
+    auto dupDesc = jobDesc->newDuplicate(dupReq);
+    BOOST_CHECK_EQUAL(dupDesc->id(), 3);
+    BOOST_CHECK(dupDesc->respHandler() == dupReq);
+    int const first = qdisp::JobDescription::SPECULATIVE_FIRST_ATTEMPT;
+    BOOST_CHECK_EQUAL(dupDesc->getFirstAttempt(), first);
+    BOOST_CHECK(dupDesc->incrAttemptCountScrubResults());
+    BOOST_CHECK_EQUAL(dupDesc->getAttemptCount(), first);
+    BOOST_CHECK(dupDesc->incrAttemptCountScrubResults());
+    BOOST_CHECK_EQUAL(dupDesc->getAttemptCount(), first + 1);
+    BOOST_CHECK_EQUAL(jobDesc->getAttemptCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(DuplicateWinner) {
+    LOGS_DEBUG("Check that the winning duplicate provides the result and its run time");
+    std::string str = qdisp::Executive::Config::getMockStr();
+    qdisp::Executive::Config::Ptr conf = std::make_shared<qdisp::Executive::Config>(str);
+    std::shared_ptr<qdisp::MessageStore> ms = std::make_shared<qdisp::MessageStore>();
+    qdisp::LargeResultMgr::Ptr lgResMgr = std::make_shared<qdisp::LargeResultMgr>();
+    qdisp::Executive::Ptr ex = qdisp::Executive::newExecutive(conf, ms, lgResMgr);
+    ResourceUnit ru;
+    int const jobId = 5;
+    auto respReq = std::make_shared<DuplicatingHandlerTest>();
+    // Keep both copies on their worker until the winner is decided.
+    qdisp::XrdSsiServiceMock::_go.exchangeNotify(false);
+    ex->add(makeMockJobDescription(ex, jobId, ru, "0", respReq));
+    ex->waitForAllJobsToStart();
+    auto original = ex->getJobQuery(jobId);
+    std::chrono::steady_clock::time_point startTime;
+    BOOST_REQUIRE(original->getStartTime(startTime));
+    usleep(300000); // The original straggles.
+
+    qdisp::ExecutiveDebug::addDuplicate(*ex, original);
+    BOOST_REQUIRE(respReq->duplicate != nullptr);
+    ex->markDuplicateCompleted(jobId, true);
+
+    // The loser is cancelled and its rows scrubbed, the duplicate keeps its rows.
+    BOOST_CHECK(respReq->_processCancelCalled);
+    BOOST_CHECK(!respReq->duplicate->_processCancelCalled);
+    BOOST_CHECK(respReq->scrubbed == std::vector<int>{0});
+    BOOST_CHECK(respReq->duplicate->scrubbed.empty());
+    // Completion of the cancelled original is ignored.
+    ex->markCompleted(jobId, false);
+    BOOST_CHECK_EQUAL(ex->getNumInflight(), 0);
+
+    // Only the run time of the winning copy is recorded.
+    auto seconds = qdisp::ExecutiveDebug::getCompletedSeconds(*ex);
+    BOOST_REQUIRE_EQUAL(seconds.size(), 1U);
+    BOOST_CHECK_LT(seconds[0], 0.25);
+
+    // Late completions of both copies are ignored, the query succeeds with
+    // the result of the duplicate.
+    qdisp::XrdSsiServiceMock::_go.exchangeNotify(true);
+    usleep(250000); // Give mock threads a quarter second to complete.
+    BOOST_CHECK(ex->join());
+    BOOST_CHECK_EQUAL(qdisp::ExecutiveDebug::getCompletedSeconds(*ex).size(), 1U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
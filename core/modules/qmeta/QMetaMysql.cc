@@ -329,18 +329,26 @@ QMetaMysql::addChunks(QueryId queryId, std::vector<int> const& chunks) {
 
     QMetaTransaction trans(_conn);
 
-    // register all tables
+    // register all chunks, multi-row inserts limited in size to stay
+    // below max_allowed_packet
+    std::size_t const maxRows = 1000;
+    std::string const qIdStr = boost::lexical_cast<std::string>(queryId);
     sql::SqlErrorObject errObj;
-    for (std::vector<int>::const_iterator itr = chunks.begin(); itr != chunks.end(); ++ itr) {
-        std::string query = "INSERT INTO QWorker (queryId, chunk) VALUES (";
-        query += boost::lexical_cast<std::string>(queryId);
-        query += ", ";
-        query += boost::lexical_cast<std::string>(*itr);
-        query += ")";
+    for (std::size_t begin = 0; begin < chunks.size(); begin += maxRows) {
+        std::size_t const end = std::min(chunks.size(), begin + maxRows);
+        std::string query = "INSERT INTO QWorker (queryId, chunk) VALUES ";
+        for (std::size_t i = begin; i != end; ++ i) {
+            if (i != begin) query += ", ";
+            query += "(";
+            query += qIdStr;
+            query += ", ";
+            query += boost::lexical_cast<std::string>(chunks[i]);
+            query += ")";
+        }
 
-        LOGS(_log, LOG_LVL_DEBUG, "Executing query: " << query);
+        LOGS(_log, LOG_LVL_DEBUG, "Executing query: " << query.substr(0, 256));
         if (not _conn.runQuery(query, errObj)) {
-            LOGS(_log, LOG_LVL_ERROR, "SQL query failed: " << query);
+            LOGS(_log, LOG_LVL_ERROR, "SQL query failed: " << query.substr(0, 256));
             throw SqlError(ERR_LOC, errObj);
         }
     }
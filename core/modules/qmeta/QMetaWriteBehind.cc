@@ -0,0 +1,344 @@
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "qmeta/QMetaWriteBehind.h"
+
+// System headers
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+// LSST headers
+#include "lsst/log/Log.h"
+
+// Qserv headers
+#include "qmeta/Exceptions.h"
+
+namespace {
+
+LOG_LOGGER _log = LOG_GET("lsst.qserv.qmeta.QMetaWriteBehind");
+
+// Maximum number of updates taken from the queue in one go
+std::size_t const MAX_BATCH = 1000;
+
+}
+
+namespace lsst {
+namespace qserv {
+namespace qmeta {
+
+QMetaWriteBehind::QMetaWriteBehind(std::shared_ptr<QMeta> const& backend,
+                                   std::size_t maxQueueSize,
+                                   std::chrono::milliseconds retryDelay,
+                                   unsigned maxRetries)
+    : _backend(backend), _maxQueueSize(std::max<std::size_t>(maxQueueSize, 1)),
+      _retryDelay(retryDelay), _maxRetries(maxRetries) {
+    _thread = std::thread(&QMetaWriteBehind::_run, this);
+}
+
+QMetaWriteBehind::~QMetaWriteBehind() {
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _stop = true;
+    }
+    _workCv.notify_all();
+    _thread.join();
+}
+
+void
+QMetaWriteBehind::flush() {
+    std::unique_lock<std::mutex> lock(_mtx);
+    std::uint64_t const target = _enqueued;
+    _doneCv.wait(lock, [this, target]() { return _done >= target; });
+}
+
+std::size_t
+QMetaWriteBehind::getDeferredCount() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _deferredCount;
+}
+
+std::uint64_t
+QMetaWriteBehind::getBackendCalls() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _backendCalls;
+}
+
+CzarId
+QMetaWriteBehind::getCzarID(std::string const& name) {
+    return _backend->getCzarID(name);
+}
+
+CzarId
+QMetaWriteBehind::registerCzar(std::string const& name) {
+    flush();
+    return _backend->registerCzar(name);
+}
+
+void
+QMetaWriteBehind::setCzarActive(CzarId czarId, bool active) {
+    flush();
+    _backend->setCzarActive(czarId, active);
+}
+
+QueryId
+QMetaWriteBehind::registerQuery(QInfo const& qInfo, TableNames const& tables) {
+    // query ID is needed right away, this cannot be deferred
+    return _backend->registerQuery(qInfo, tables);
+}
+
+void
+QMetaWriteBehind::addChunks(QueryId queryId, std::vector<int> const& chunks) {
+    if (chunks.empty()) return;
+    Update update{Update::ADD_CHUNKS, queryId, chunks, std::string(), QInfo::EXECUTING};
+    _enqueue(std::move(update));
+}
+
+void
+QMetaWriteBehind::assignChunk(QueryId queryId, int chunk, std::string const& xrdEndpoint) {
+    Update update{Update::ASSIGN_CHUNK, queryId, std::vector<int>(1, chunk), xrdEndpoint,
+                  QInfo::EXECUTING};
+    _enqueue(std::move(update));
+}
+
+void
+QMetaWriteBehind::finishChunk(QueryId queryId, int chunk) {
+    Update update{Update::FINISH_CHUNK, queryId, std::vector<int>(1, chunk), std::string(),
+                  QInfo::EXECUTING};
+    _enqueue(std::move(update));
+}
+
+void
+QMetaWriteBehind::completeQuery(QueryId queryId, QInfo::QStatus qStatus) {
+    Update update{Update::COMPLETE_QUERY, queryId, std::vector<int>(), std::string(), qStatus};
+    _enqueue(std::move(update));
+}
+
+void
+QMetaWriteBehind::finishQuery(QueryId queryId) {
+    Update update{Update::FINISH_QUERY, queryId, std::vector<int>(), std::string(), QInfo::EXECUTING};
+    _enqueue(std::move(update));
+}
+
+std::vector<QueryId>
+QMetaWriteBehind::findQueries(CzarId czarId, QInfo::QType qType, std::string const& user,
+                              std::vector<QInfo::QStatus> const& status, int completed, int returned) {
+    flush();
+    return _backend->findQueries(czarId, qType, user, status, completed, returned);
+}
+
+std::vector<QueryId>
+QMetaWriteBehind::getPendingQueries(CzarId czarId) {
+    flush();
+    return _backend->getPendingQueries(czarId);
+}
+
+QInfo
+QMetaWriteBehind::getQueryInfo(QueryId queryId) {
+    flush();
+    return _backend->getQueryInfo(queryId);
+}
+
+std::vector<QueryId>
+QMetaWriteBehind::getQueriesForDb(std::string const& dbName) {
+    flush();
+    return _backend->getQueriesForDb(dbName);
+}
+
+std::vector<QueryId>
+QMetaWriteBehind::getQueriesForTable(std::string const& dbName, std::string const& tableName) {
+    flush();
+    return _backend->getQueriesForTable(dbName, tableName);
+}
+
+void
+QMetaWriteBehind::_enqueue(Update&& update) {
+    std::unique_lock<std::mutex> lock(_mtx);
+    _doneCv.wait(lock, [this]() { return _queue.size() < _maxQueueSize; });
+    _queue.push_back(std::move(update));
+    ++ _enqueued;
+    _workCv.notify_one();
+}
+
+void
+QMetaWriteBehind::_run() {
+    std::unique_lock<std::mutex> lock(_mtx);
+    while (true) {
+        auto const ready = [this]() { return _stop or not _queue.empty(); };
+        if (_deferredCount == 0) {
+            _workCv.wait(lock, ready);
+        } else {
+            _workCv.wait_until(lock, _nextDeferredTry, ready);
+            if (std::chrono::steady_clock::now() >= _nextDeferredTry) {
+                lock.unlock();
+                _applyDeferred();
+                lock.lock();
+            }
+        }
+        if (_queue.empty()) {
+            if (_stop) break;
+            continue;
+        }
+        std::vector<Update> batch;
+        while (not _queue.empty() and batch.size() < MAX_BATCH) {
+            batch.push_back(std::move(_queue.front()));
+            _queue.pop_front();
+        }
+        std::size_t const count = batch.size();
+        lock.unlock();
+        _apply(batch);
+        lock.lock();
+        _done += count;
+        _doneCv.notify_all();
+    }
+    lock.unlock();
+
+    // last chance for deferred updates, whatever is left is lost
+    if (not _deferred.empty()) {
+        _backendDown = false;
+        _applyDeferred();
+    }
+    for (auto const& update : _deferred) {
+        LOGS(_log, LOG_LVL_ERROR, "QMeta is unavailable, status of query " << update.queryId
+             << " is not recorded");
+    }
+}
+
+void
+QMetaWriteBehind::_apply(std::vector<Update>& batch) {
+    LOGS(_log, LOG_LVL_DEBUG, "applying " << batch.size() << " QMeta updates");
+    std::vector<bool> merged(batch.size(), false);
+    for (std::size_t i = 0; i != batch.size(); ++ i) {
+        if (merged[i]) continue;
+        Update& update = batch[i];
+        if (update.type == Update::ADD_CHUNKS) {
+            // merge following addChunks of the same query, up to a different
+            // kind of update for that query
+            for (std::size_t j = i + 1; j != batch.size(); ++ j) {
+                if (batch[j].queryId != update.queryId) continue;
+                if (batch[j].type != Update::ADD_CHUNKS) break;
+                update.chunks.insert(update.chunks.end(), batch[j].chunks.begin(), batch[j].chunks.end());
+                merged[j] = true;
+            }
+        }
+        _applyOne(update);
+    }
+}
+
+void
+QMetaWriteBehind::_applyOne(Update const& update) {
+    // updates of a query with deferred updates have to wait for them
+    for (auto const& deferred : _deferred) {
+        if (deferred.queryId == update.queryId) {
+            _defer(update);
+            return;
+        }
+    }
+    if (_call(update) != UNAVAILABLE) return;
+    if (update.type == Update::COMPLETE_QUERY or update.type == Update::FINISH_QUERY) {
+        LOGS(_log, LOG_LVL_ERROR, "QMeta is unavailable, status update for query "
+             << update.queryId << " is deferred");
+        _defer(update);
+    } else {
+        LOGS(_log, LOG_LVL_ERROR, "QMeta is unavailable, chunk update for query "
+             << update.queryId << " is dropped");
+    }
+}
+
+void
+QMetaWriteBehind::_applyDeferred() {
+    while (not _deferred.empty()) {
+        if (_call(_deferred.front()) == UNAVAILABLE) break;
+        _deferred.pop_front();
+    }
+    std::lock_guard<std::mutex> lock(_mtx);
+    _deferredCount = _deferred.size();
+    _nextDeferredTry = std::chrono::steady_clock::now() + _retryDelay;
+}
+
+void
+QMetaWriteBehind::_defer(Update const& update) {
+    _deferred.push_back(update);
+    std::lock_guard<std::mutex> lock(_mtx);
+    if (_deferredCount == 0) {
+        _nextDeferredTry = std::chrono::steady_clock::now() + _retryDelay;
+    }
+    _deferredCount = _deferred.size();
+}
+
+QMetaWriteBehind::CallStatus
+QMetaWriteBehind::_call(Update const& update) {
+    for (unsigned retry = 0; ; ++ retry) {
+        try {
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                ++ _backendCalls;
+            }
+            switch (update.type) {
+            case Update::ADD_CHUNKS:
+                _backend->addChunks(update.queryId, update.chunks);
+                break;
+            case Update::ASSIGN_CHUNK:
+                _backend->assignChunk(update.queryId, update.chunks.front(), update.xrdEndpoint);
+                break;
+            case Update::FINISH_CHUNK:
+                _backend->finishChunk(update.queryId, update.chunks.front());
+                break;
+            case Update::COMPLETE_QUERY:
+                _backend->completeQuery(update.queryId, update.qStatus);
+                break;
+            case Update::FINISH_QUERY:
+                _backend->finishQuery(update.queryId);
+                break;
+            }
+            if (_backendDown) {
+                LOGS(_log, LOG_LVL_INFO, "QMeta is available again");
+            }
+            _backendDown = false;
+            return APPLIED;
+        } catch (SqlError const& exc) {
+            bool stopping;
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                stopping = _stop;
+            }
+            if (_backendDown or stopping or retry >= _maxRetries) {
+                if (not _backendDown) {
+                    LOGS(_log, LOG_LVL_ERROR, "QMeta is unavailable after " << retry
+                         << " retries: " << exc.what());
+                }
+                _backendDown = true;
+                return UNAVAILABLE;
+            }
+            LOGS(_log, LOG_LVL_WARN, "QMeta update for query " << update.queryId
+                 << " failed, will retry: " << exc.what());
+            std::this_thread::sleep_for(_retryDelay);
+        } catch (std::exception const& exc) {
+            LOGS(_log, LOG_LVL_ERROR, "QMeta update for query " << update.queryId
+                 << " failed, dropped: " << exc.what());
+            return REJECTED;
+        }
+    }
+}
+
+}}} // namespace lsst::qserv::qmeta
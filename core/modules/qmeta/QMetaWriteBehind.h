@@ -0,0 +1,192 @@
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef LSST_QSERV_QMETA_QMETAWRITEBEHIND_H
+#define LSST_QSERV_QMETA_QMETAWRITEBEHIND_H
+
+// System headers
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Qserv headers
+#include "qmeta/QMeta.h"
+
+namespace lsst {
+namespace qserv {
+namespace qmeta {
+
+/// @addtogroup qmeta
+
+/**
+ *  @ingroup qmeta
+ *
+ *  @brief QMeta implementation which applies status updates asynchronously.
+ *
+ *  Status updates (addChunks, assignChunk, finishChunk, completeQuery,
+ *  finishQuery) are queued and return immediately, a background thread
+ *  applies them to the wrapped QMeta instance in the order they were made.
+ *  Updates queued while the thread is busy are applied together: queued
+ *  addChunks() calls for the same query are merged into a single call, as
+ *  long as no other kind of update for that query is queued between them.
+ *  Updates of different queries are independent and may be reordered
+ *  relative to each other.
+ *
+ *  Methods which return data from QMeta (including registerQuery and all
+ *  find/get methods) first wait until all previously queued updates are
+ *  applied so that callers always see their own updates, except for
+ *  deferred updates described below.
+ *
+ *  Updates failing with SqlError (e.g. lost connection) are retried after
+ *  a delay without reordering, up to a maximum number of retries. After
+ *  that the backend is considered unavailable and failing updates are not
+ *  retried until an update succeeds again, so that a dead QMeta cannot
+ *  block the queue. Chunk updates failing while the backend is unavailable
+ *  are logged and dropped. Query status updates (completeQuery and
+ *  finishQuery) are never dropped: they are deferred, together with all
+ *  later updates of the same query, and applied in order once QMeta is
+ *  back; getDeferredCount() reports how many are waiting. Deferred updates
+ *  which still fail when the instance is destroyed are logged as errors.
+ *  Other errors mean that update cannot be applied and it is logged and
+ *  dropped. When the queue is full callers block until there is space in
+ *  it.
+ */
+class QMetaWriteBehind : public QMeta {
+public:
+
+    /**
+     *  @param backend:       QMeta instance which receives the updates
+     *  @param maxQueueSize:  Maximum number of queued updates, must be positive
+     *  @param retryDelay:    Delay before re-trying failed update
+     *  @param maxRetries:    Maximum number of retries of an update failing
+     *                        with SqlError before QMeta is considered unavailable
+     */
+    QMetaWriteBehind(std::shared_ptr<QMeta> const& backend,
+                     std::size_t maxQueueSize,
+                     std::chrono::milliseconds retryDelay=std::chrono::milliseconds(1000),
+                     unsigned maxRetries=10);
+
+    // Instances cannot be copied
+    QMetaWriteBehind(QMetaWriteBehind const&) = delete;
+    QMetaWriteBehind& operator=(QMetaWriteBehind const&) = delete;
+
+    /// Applies all queued updates and stops background thread.
+    virtual ~QMetaWriteBehind();
+
+    /// Wait until all updates queued before this call are applied, dropped
+    /// or deferred.
+    void flush();
+
+    /// @return number of deferred updates waiting for QMeta to become available
+    std::size_t getDeferredCount() const;
+
+    /// @return number of calls made to backend to apply the updates
+    std::uint64_t getBackendCalls() const;
+
+    // Methods below are documented in QMeta
+
+    virtual CzarId getCzarID(std::string const& name) override;
+    virtual CzarId registerCzar(std::string const& name) override;
+    virtual void setCzarActive(CzarId czarId, bool active) override;
+    virtual QueryId registerQuery(QInfo const& qInfo,
+                                  TableNames const& tables) override;
+    virtual void addChunks(QueryId queryId, std::vector<int> const& chunks) override;
+    virtual void assignChunk(QueryId queryId,
+                             int chunk,
+                             std::string const& xrdEndpoint) override;
+    virtual void finishChunk(QueryId queryId, int chunk) override;
+    virtual void completeQuery(QueryId queryId, QInfo::QStatus qStatus) override;
+    virtual void finishQuery(QueryId queryId) override;
+    virtual std::vector<QueryId> findQueries(CzarId czarId=0,
+                                             QInfo::QType qType=QInfo::ANY,
+                                             std::string const& user=std::string(),
+                                             std::vector<QInfo::QStatus> const& status=std::vector<QInfo::QStatus>(),
+                                             int completed=-1,
+                                             int returned=-1) override;
+    virtual std::vector<QueryId> getPendingQueries(CzarId czarId) override;
+    virtual QInfo getQueryInfo(QueryId queryId) override;
+    virtual std::vector<QueryId> getQueriesForDb(std::string const& dbName) override;
+    virtual std::vector<QueryId> getQueriesForTable(std::string const& dbName,
+                                                    std::string const& tableName) override;
+
+private:
+
+    struct Update {
+        enum Type { ADD_CHUNKS, ASSIGN_CHUNK, FINISH_CHUNK, COMPLETE_QUERY, FINISH_QUERY };
+        Type type;
+        QueryId queryId;
+        std::vector<int> chunks;
+        std::string xrdEndpoint;
+        QInfo::QStatus qStatus;
+    };
+
+    // Add update to the queue, blocks if queue is full
+    void _enqueue(Update&& update);
+
+    // Background thread method
+    void _run();
+
+    // Apply a batch of updates to backend
+    void _apply(std::vector<Update>& batch);
+
+    // Apply single update, defer it if it cannot be applied now
+    void _applyOne(Update const& update);
+
+    // Try again to apply deferred updates, stops at the first failure
+    void _applyDeferred();
+
+    // Move update to the deferred list
+    void _defer(Update const& update);
+
+    enum CallStatus { APPLIED, REJECTED, UNAVAILABLE };
+
+    // Make backend call applying an update, retrying on SqlError
+    CallStatus _call(Update const& update);
+
+    std::shared_ptr<QMeta> const _backend;
+    std::size_t const _maxQueueSize;
+    std::chrono::milliseconds const _retryDelay;
+    unsigned const _maxRetries;
+    bool _backendDown = false;         // only used by background thread
+    std::deque<Update> _deferred;      // only used by background thread
+    std::chrono::steady_clock::time_point _nextDeferredTry;  // only used by background thread
+
+    std::deque<Update> _queue;
+    std::uint64_t _enqueued = 0;       // number of updates ever queued
+    std::uint64_t _done = 0;           // number of updates applied or dropped
+    std::uint64_t _backendCalls = 0;
+    std::size_t _deferredCount = 0;    // size of _deferred
+    bool _stop = false;
+    mutable std::mutex _mtx;
+    std::condition_variable _workCv;   // signals new updates or stop
+    std::condition_variable _doneCv;   // signals progress and free space
+    std::thread _thread;
+};
+
+}}} // namespace lsst::qserv::qmeta
+
+#endif // LSST_QSERV_QMETA_QMETAWRITEBEHIND_H
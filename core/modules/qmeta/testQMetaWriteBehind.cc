@@ -0,0 +1,217 @@
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// System headers
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Qserv headers
+#include "qmeta/Exceptions.h"
+#include "qmeta/QMetaWriteBehind.h"
+#include "sql/SqlErrorObject.h"
+
+// Boost unit test header
+#define BOOST_TEST_MODULE QMetaWriteBehind
+#include "boost/test/included/unit_test.hpp"
+
+using lsst::qserv::QueryId;
+using namespace lsst::qserv::qmeta;
+
+namespace {
+
+// QMeta which records calls, optionally slow or failing
+class RecordingQMeta : public QMeta {
+public:
+    CzarId getCzarID(std::string const&) override { return 1; }
+    CzarId registerCzar(std::string const&) override { return 1; }
+    void setCzarActive(CzarId, bool) override {}
+    QueryId registerQuery(QInfo const&, TableNames const&) override { return ++lastQueryId; }
+    void addChunks(QueryId queryId, std::vector<int> const& chunks) override {
+        _record("add " + std::to_string(queryId) + " " + std::to_string(chunks.size()));
+    }
+    void assignChunk(QueryId queryId, int chunk, std::string const& xrd) override {
+        _record("assign " + std::to_string(queryId) + " " + std::to_string(chunk) + " " + xrd);
+    }
+    void finishChunk(QueryId queryId, int chunk) override {
+        _record("finish " + std::to_string(queryId) + " " + std::to_string(chunk));
+    }
+    void completeQuery(QueryId queryId, QInfo::QStatus) override {
+        _record("complete " + std::to_string(queryId));
+    }
+    void finishQuery(QueryId queryId) override {
+        if (queryId == 666) throw QueryIdError(ERR_LOC, queryId);
+        _record("finishQuery " + std::to_string(queryId));
+    }
+    std::vector<QueryId> findQueries(CzarId, QInfo::QType, std::string const&,
+                                     std::vector<QInfo::QStatus> const&, int, int) override {
+        return std::vector<QueryId>();
+    }
+    std::vector<QueryId> getPendingQueries(CzarId) override { return std::vector<QueryId>(); }
+    QInfo getQueryInfo(QueryId) override { return QInfo(); }
+    std::vector<QueryId> getQueriesForDb(std::string const&) override { return std::vector<QueryId>(); }
+    std::vector<QueryId> getQueriesForTable(std::string const&, std::string const&) override {
+        return std::vector<QueryId>();
+    }
+
+    std::vector<std::string> getCalls() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return calls;
+    }
+
+    std::mutex mtx;
+    std::vector<std::string> calls;
+    QueryId lastQueryId = 0;
+    int failures = 0;  // number of calls to fail with SqlError
+    std::chrono::milliseconds delay{0};
+
+protected:
+    void _record(std::string const& call) {
+        std::this_thread::sleep_for(delay);
+        std::lock_guard<std::mutex> lock(mtx);
+        if (failures > 0) {
+            -- failures;
+            throw SqlError(ERR_LOC, lsst::qserv::sql::SqlErrorObject());
+        }
+        calls.push_back(call);
+    }
+};
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(Suite)
+
+BOOST_AUTO_TEST_CASE(Ordering) {
+    auto backend = std::make_shared<RecordingQMeta>();
+    QMetaWriteBehind qmeta(backend, 100);
+    qmeta.addChunks(1, {1, 2, 3});
+    qmeta.assignChunk(1, 2, "worker:1094");
+    qmeta.finishChunk(1, 2);
+    qmeta.completeQuery(1, QInfo::COMPLETED);
+    qmeta.finishQuery(1);
+    qmeta.flush();
+    std::vector<std::string> expected{"add 1 3", "assign 1 2 worker:1094", "finish 1 2",
+                                      "complete 1", "finishQuery 1"};
+    BOOST_CHECK(backend->getCalls() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(Coalescing) {
+    auto backend = std::make_shared<RecordingQMeta>();
+    backend->delay = std::chrono::milliseconds(50);
+    QMetaWriteBehind qmeta(backend, 100);
+    // first update keeps background thread busy while the rest is queued
+    qmeta.completeQuery(7, QInfo::COMPLETED);
+    qmeta.addChunks(1, {1, 2});
+    qmeta.addChunks(1, {3});
+    qmeta.addChunks(1, {4, 5});
+    qmeta.addChunks(2, {1});
+    // reads see all previous updates
+    qmeta.getQueryInfo(1);
+    std::vector<std::string> expected{"complete 7", "add 1 5", "add 2 1"};
+    BOOST_CHECK(backend->getCalls() == expected);
+    BOOST_CHECK_EQUAL(qmeta.getBackendCalls(), 3U);
+}
+
+BOOST_AUTO_TEST_CASE(Errors) {
+    auto backend = std::make_shared<RecordingQMeta>();
+    backend->failures = 2;
+    QMetaWriteBehind qmeta(backend, 100, std::chrono::milliseconds(1));
+    qmeta.addChunks(1, {1});
+    qmeta.finishQuery(666);
+    qmeta.finishQuery(1);
+    qmeta.flush();
+    // SqlError is retried, other errors drop update
+    std::vector<std::string> expected{"add 1 1", "finishQuery 1"};
+    BOOST_CHECK(backend->getCalls() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(RetryLimit) {
+    auto backend = std::make_shared<RecordingQMeta>();
+    backend->failures = 100;
+    QMetaWriteBehind qmeta(backend, 100, std::chrono::milliseconds(1), 2);
+    // chunk update is dropped after two retries
+    qmeta.finishChunk(1, 1);
+    // backend is unavailable now, dropped without retrying
+    qmeta.finishChunk(2, 1);
+    qmeta.flush();
+    BOOST_CHECK(backend->getCalls().empty());
+    BOOST_CHECK_EQUAL(qmeta.getBackendCalls(), 4U);
+    BOOST_CHECK_EQUAL(qmeta.getDeferredCount(), 0U);
+    {
+        std::lock_guard<std::mutex> lock(backend->mtx);
+        backend->failures = 0;
+    }
+    qmeta.finishQuery(3);
+    qmeta.flush();
+    {
+        std::lock_guard<std::mutex> lock(backend->mtx);
+        backend->failures = 1;
+    }
+    // backend recovered, failures are retried again
+    qmeta.finishQuery(4);
+    qmeta.flush();
+    std::vector<std::string> expected{"finishQuery 3", "finishQuery 4"};
+    BOOST_CHECK(backend->getCalls() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(DeferredStatus) {
+    auto backend = std::make_shared<RecordingQMeta>();
+    backend->failures = 100;
+    QMetaWriteBehind qmeta(backend, 100, std::chrono::milliseconds(1), 1);
+    // status updates are kept while QMeta is unavailable, together with
+    // later updates of the same query
+    qmeta.completeQuery(1, QInfo::COMPLETED);
+    qmeta.finishChunk(1, 5);
+    qmeta.finishQuery(1);
+    qmeta.finishChunk(2, 5);
+    qmeta.flush();
+    BOOST_CHECK(backend->getCalls().empty());
+    BOOST_CHECK_EQUAL(qmeta.getDeferredCount(), 3U);
+    {
+        std::lock_guard<std::mutex> lock(backend->mtx);
+        backend->failures = 0;
+    }
+    // they are applied in order once QMeta is back
+    for (int i = 0; i < 1000 and qmeta.getDeferredCount() > 0; ++ i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK_EQUAL(qmeta.getDeferredCount(), 0U);
+    std::vector<std::string> expected{"complete 1", "finish 1 5", "finishQuery 1"};
+    BOOST_CHECK(backend->getCalls() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(Backpressure) {
+    auto backend = std::make_shared<RecordingQMeta>();
+    backend->delay = std::chrono::milliseconds(1);
+    {
+        QMetaWriteBehind qmeta(backend, 2);
+        for (int i = 0; i < 20; ++ i) {
+            qmeta.finishChunk(1, i);
+        }
+        // destructor applies everything that is queued
+    }
+    BOOST_CHECK_EQUAL(backend->getCalls().size(), 20U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,137 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#include "qproc/ChunkCoverageCache.h"
+
+// System headers
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+char const AREASPEC_PREFIX[] = "qserv_areaspec_";
+
+} // anonymous namespace
+
+namespace lsst {
+namespace qserv {
+namespace qproc {
+
+ChunkCoverageCache::ChunkCoverageCache(std::size_t maxEntries)
+    : _maxEntries(maxEntries) {
+}
+
+
+ChunkCoverageCache::CoveragePtr ChunkCoverageCache::get(std::string const& key) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto iter = _map.find(key);
+    if (iter == _map.end()) {
+        ++_misses;
+        return CoveragePtr();
+    }
+    ++_hits;
+    // Move to the front of the LRU list, iterators stay valid.
+    _lru.splice(_lru.begin(), _lru, iter->second);
+    return iter->second->second;
+}
+
+
+void ChunkCoverageCache::put(std::string const& key, CoveragePtr const& coverage) {
+    if (_maxEntries == 0 || key.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto iter = _map.find(key);
+    if (iter != _map.end()) {
+        iter->second->second = coverage;
+        _lru.splice(_lru.begin(), _lru, iter->second);
+        return;
+    }
+    _lru.emplace_front(key, coverage);
+    _map[key] = _lru.begin();
+    while (_map.size() > _maxEntries) {
+        _map.erase(_lru.back().first);
+        _lru.pop_back();
+    }
+}
+
+
+void ChunkCoverageCache::clear() {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _map.clear();
+    _lru.clear();
+}
+
+
+std::size_t ChunkCoverageCache::size() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _map.size();
+}
+
+
+std::uint64_t ChunkCoverageCache::getHits() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _hits;
+}
+
+
+std::uint64_t ChunkCoverageCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _misses;
+}
+
+
+std::string ChunkCoverageCache::makeKey(css::StripingParams const& sp,
+                                        std::string const& name, StringVector const& params) {
+    std::string key = makeAllChunksKey(sp);
+    key += ' ';
+    if (name.compare(0, sizeof(AREASPEC_PREFIX) - 1, AREASPEC_PREFIX) == 0) {
+        key.append(name, sizeof(AREASPEC_PREFIX) - 1, std::string::npos);
+    } else {
+        key += name;
+    }
+    for (auto const& param : params) {
+        char* end = nullptr;
+        errno = 0;
+        double value = std::strtod(param.c_str(), &end);
+        if (end == param.c_str() || *end != '\0' || errno != 0) {
+            return std::string();
+        }
+        if (value == 0) {
+            value = 0;  // -0 and 0 give the same region
+        }
+        // 17 significant digits round-trip any double exactly
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), " %.17g", value);
+        key += buf;
+    }
+    return key;
+}
+
+
+std::string ChunkCoverageCache::makeAllChunksKey(css::StripingParams const& sp) {
+    return std::to_string(sp.stripes) + '/' + std::to_string(sp.subStripes);
+}
+
+}}} // namespace lsst::qserv::qproc
@@ -0,0 +1,116 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef LSST_QSERV_QPROC_CHUNKCOVERAGECACHE_H
+#define LSST_QSERV_QPROC_CHUNKCOVERAGECACHE_H
+/**
+  * @file
+  *
+  * @brief ChunkCoverageCache keeps chunk coverage of recently used spatial
+  * regions in memory on the czar.
+  *
+  */
+
+// System headers
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// Qserv headers
+#include "css/StripingParams.h"
+#include "global/stringTypes.h"
+#include "qproc/ChunkSpec.h"
+
+namespace lsst {
+namespace qserv {
+namespace qproc {
+
+/**
+ *  ChunkCoverageCache maps (striping, region) to the list of chunks and
+ *  subchunks intersecting the region. Computing coverage of large regions
+ *  over fine subchunking is expensive and the same regions tend to be
+ *  queried repeatedly. The number of entries is bounded, the least
+ *  recently used entries are evicted first.
+ *
+ *  All methods are thread-safe.
+ */
+class ChunkCoverageCache {
+public:
+    typedef std::shared_ptr<ChunkSpecVector const> CoveragePtr;
+
+    /// @param maxEntries - maximum number of cached regions, 0 disables caching.
+    explicit ChunkCoverageCache(std::size_t maxEntries);
+
+    ChunkCoverageCache(ChunkCoverageCache const&) = delete;
+    ChunkCoverageCache& operator=(ChunkCoverageCache const&) = delete;
+
+    /// @return coverage for 'key', null pointer if it is not cached.
+    CoveragePtr get(std::string const& key);
+
+    /// Add or refresh coverage for 'key'.
+    void put(std::string const& key, CoveragePtr const& coverage);
+
+    void clear();
+
+    std::size_t size() const;
+    std::size_t getMaxEntries() const { return _maxEntries; }
+    std::uint64_t getHits() const;
+    std::uint64_t getMisses() const;
+
+    /**
+     *  Make cache key for region defined by a spatial restrictor.
+     *
+     *  Restrictor aliases (e.g. "qserv_areaspec_box" and "box") and
+     *  different spellings of the same number ("1", "1.0", "1e0") map to the
+     *  same key. Parameters are not rounded, regions differing by any amount
+     *  have different coverage keys.
+     *
+     *  @param sp:      striping parameters
+     *  @param name:    restrictor or UDF name
+     *  @param params:  restrictor parameters
+     *  @return cache key, empty string if parameters are not numbers.
+     */
+    static std::string makeKey(css::StripingParams const& sp,
+                               std::string const& name, StringVector const& params);
+
+    /// @return cache key for coverage of the whole sky.
+    static std::string makeAllChunksKey(css::StripingParams const& sp);
+
+private:
+    typedef std::pair<std::string, CoveragePtr> Entry;
+    typedef std::list<Entry> EntryList;
+
+    std::size_t const _maxEntries;
+    EntryList _lru; ///< Most recently used first.
+    std::unordered_map<std::string, EntryList::iterator> _map;
+    std::uint64_t _hits{0};
+    std::uint64_t _misses{0};
+    mutable std::mutex _mtx; ///< Protects all members above.
+};
+
+}}} // namespace lsst::qserv::qproc
+
+#endif // LSST_QSERV_QPROC_CHUNKCOVERAGECACHE_H
@@ -34,6 +34,7 @@
 // System headers
 #include <algorithm>
 #include <cassert>
+#include <future>
 #include <iterator>
 #include <stdexcept>
 #include <set>
@@ -50,6 +51,7 @@
 #include "global/Bug.h"
 #include "global/intTypes.h"
 #include "global/stringTypes.h"
+#include "qproc/ChunkCoverageCache.h"
 #include "qproc/geomAdapter.h"
 #include "qproc/QueryProcessingError.h"
 #include "qproc/SecondaryIndex.h"
@@ -147,7 +149,6 @@ lsst::qserv::qproc::ChunkSpec convertSgSubChunks(SubChunks const& sc) {
 namespace lsst {
 namespace qserv {
 namespace qproc {
-typedef std::vector<std::shared_ptr<Region> > RegionPtrVector;
 
 ////////////////////////////////////////////////////////////////////////
 // IndexMap::PartitioningMap definition and implementation
@@ -159,49 +160,103 @@ public:
         NoRegion() : std::invalid_argument("No region specified")
             {}
     };
-    explicit PartitioningMap(css::StripingParams const& sp) {
+    PartitioningMap(css::StripingParams const& sp,
+                    std::shared_ptr<ChunkCoverageCache> const& cache)
+        : _sp(sp), _cache(cache) {
         _chunker = std::make_shared<lsst::sphgeom::Chunker>(sp.stripes,
                                                             sp.subStripes);
 
     }
-    /// @return un-canonicalized vector<SubChunks> of concatenated region
-    /// results. Regions are assumed to be joined by implicit "OR" and not "AND"
-    /// Throws NoRegion if no region is passed.
-    SubChunksVector getIntersect(RegionPtrVector const& rv) {
-        SubChunksVector scv;
-        bool hasRegion = false;
-        for(RegionPtrVector::const_iterator i=rv.begin(), e=rv.end();
-            i != e;
-            ++i) {
-            if (*i) {
-                SubChunksVector area = getCoverage(**i);
-                scv.insert(scv.end(), area.begin(), area.end());
-                hasRegion = true;
-            } else {
+    /// @return un-canonicalized vector of concatenated coverage of spatial
+    /// constraints. Regions are assumed to be joined by implicit "OR" and
+    /// not "AND". Throws NoRegion if there is no spatial constraint.
+    ChunkSpecVector getIntersect(query::ConstraintVector const& cv) {
+        struct Area {
+            std::string key;
+            std::shared_ptr<Region> region;
+            ChunkCoverageCache::CoveragePtr coverage;
+        };
+        std::vector<Area> areas;
+        for (auto const& c : cv) {
+            Area area;
+            area.region = getRegion(c);
+            if (!area.region) {
                 // Ignore null-regions
                 continue;
             }
+            if (_cache) {
+                area.key = ChunkCoverageCache::makeKey(_sp, c.name, c.params);
+                if (!area.key.empty()) {
+                    area.coverage = _cache->get(area.key);
+                }
+            }
+            areas.push_back(std::move(area));
         }
-        if (!hasRegion) {
+        if (areas.empty()) {
             throw NoRegion();
         }
-        return scv;
+
+        // Coverage of large regions is expensive, when several regions are
+        // not cached compute them concurrently, first one in this thread.
+        std::vector<std::pair<Area*, std::future<ChunkCoverageCache::CoveragePtr>>> pending;
+        Area* local = nullptr;
+        for (auto& area : areas) {
+            if (area.coverage) continue;
+            if (local == nullptr) {
+                local = &area;
+            } else {
+                Region const* region = area.region.get();
+                pending.emplace_back(&area, std::async(std::launch::async,
+                                                       [this, region]() { return getCoverage(*region); }));
+            }
+        }
+        if (local != nullptr) {
+            local->coverage = getCoverage(*local->region);
+        }
+        for (auto& p : pending) {
+            p.first->coverage = p.second.get();
+        }
+
+        ChunkSpecVector csv;
+        for (auto& area : areas) {
+            if (_cache) {
+                _cache->put(area.key, area.coverage);
+            }
+            csv.insert(csv.end(), area.coverage->begin(), area.coverage->end());
+        }
+        return csv;
     }
 
-    inline SubChunksVector getCoverage(Region const& r) {
-        return _chunker->getSubChunksIntersecting(r);
+    ChunkCoverageCache::CoveragePtr getCoverage(Region const& r) const {
+        SubChunksVector scv = _chunker->getSubChunksIntersecting(r);
+        auto csv = std::make_shared<ChunkSpecVector>();
+        csv->reserve(scv.size());
+        std::transform(scv.begin(), scv.end(), std::back_inserter(*csv), convertSgSubChunks);
+        return csv;
     }
+
     ChunkSpecVector getAllChunks() const {
+        std::string const key = ChunkCoverageCache::makeAllChunksKey(_sp);
+        if (_cache) {
+            if (auto coverage = _cache->get(key)) {
+                return *coverage;
+            }
+        }
         Int32Vector allChunks = _chunker->getAllChunks();
-        ChunkSpecVector csv;
-        csv.reserve(allChunks.size());
+        auto csv = std::make_shared<ChunkSpecVector>();
+        csv->reserve(allChunks.size());
         for(IntVector::const_iterator i=allChunks.begin(), e=allChunks.end();
             i != e; ++i) {
-            csv.push_back(ChunkSpec(*i, _chunker->getAllSubChunks(*i)));
+            csv->push_back(ChunkSpec(*i, _chunker->getAllSubChunks(*i)));
         }
-        return csv;
+        if (_cache) {
+            _cache->put(key, csv);
+        }
+        return *csv;
     }
 private:
+    css::StripingParams const _sp;
+    std::shared_ptr<ChunkCoverageCache> const _cache;
     std::shared_ptr<lsst::sphgeom::Chunker> _chunker;
 };
 
@@ -209,8 +264,9 @@ private:
 // IndexMap implementation
 ////////////////////////////////////////////////////////////////////////
 IndexMap::IndexMap(css::StripingParams const& sp,
-                   std::shared_ptr<SecondaryIndex> si)
-    : _pm(std::make_shared<PartitioningMap>(sp)),
+                   std::shared_ptr<SecondaryIndex> si,
+                   std::shared_ptr<ChunkCoverageCache> const& coverageCache)
+    : _pm(std::make_shared<PartitioningMap>(sp, coverageCache)),
       _si(si) {
 }
 
@@ -238,11 +294,9 @@ ChunkSpecVector IndexMap::getChunks(query::ConstraintVector const& cv) {
     }
 
     // Spatial area lookups
-    RegionPtrVector rv;
-    std::transform(cv.begin(), cv.end(), std::back_inserter(rv), getRegion);
-    SubChunksVector scv;
+    ChunkSpecVector regionSpecs;
     try {
-        scv = _pm->getIntersect(rv);
+        regionSpecs = _pm->getIntersect(cv);
     } catch(PartitioningMap::NoRegion& e) {
         hasRegion = false;
     } catch(std::invalid_argument& a) {
@@ -250,9 +304,6 @@ ChunkSpecVector IndexMap::getChunks(query::ConstraintVector const& cv) {
     } catch(std::runtime_error& e) {
         throw QueryProcessingError(e.what());
     }
-    ChunkSpecVector regionSpecs;
-    std::transform(scv.begin(), scv.end(),
-                   std::back_inserter(regionSpecs), convertSgSubChunks);
     LOGS(_log, LOG_LVL_DEBUG, "indexSpecs subChunks " << util::printable(indexSpecs));
     LOGS(_log, LOG_LVL_DEBUG, "regionSpecs subChunks " << util::printable(regionSpecs));
 
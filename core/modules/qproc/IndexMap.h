@@ -30,6 +30,9 @@
   * @author Daniel L. Wang, SLAC
   */
 
+// System headers
+#include <memory>
+
 // Qserv headers
 #include "css/StripingParams.h"
 #include "query/Constraint.h"
@@ -39,12 +42,19 @@ namespace lsst {
 namespace qserv {
 namespace qproc {
 
+class ChunkCoverageCache;
 class SecondaryIndex;
 
 class IndexMap {
 public:
+    /** @param sp:             striping parameters of the queried database
+     *  @param si:             secondary index used for index constraints
+     *  @param coverageCache:  optional cache of spatial region coverage,
+     *                         usually shared by all queries
+     */
     IndexMap(css::StripingParams const& sp,
-             std::shared_ptr<SecondaryIndex> si);
+             std::shared_ptr<SecondaryIndex> si,
+             std::shared_ptr<ChunkCoverageCache> const& coverageCache=nullptr);
 
     /** Compute the chunks list for the whole partitioning scheme
      *
@@ -0,0 +1,298 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "qproc/QueryPlanCache.h"
+
+// System headers
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+// Markers are 19 digit numbers, long enough to never be typed by a user
+// and of equal length so that no marker is a prefix of another one.
+char const MARKER_PREFIX[] = "31415926535897";
+int const MARKER_INDEX_DIGITS = 5;
+std::size_t const MAX_LITERALS = 99999;
+
+inline bool isSpace(char c) { return std::isspace(static_cast<unsigned char>(c)); }
+inline bool isDigit(char c) { return std::isdigit(static_cast<unsigned char>(c)); }
+
+inline bool isIdentStart(char c) {
+    return std::isalpha(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+inline bool isIdentChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+/// @return true if a value, and thus possibly a signed literal, can follow
+/// keyword 'word' (upper case).
+bool isOperatorKeyword(std::string const& word) {
+    static char const* const keywords[] = {
+        "AND", "BETWEEN", "CASE", "DIV", "ELSE", "IN", "IS", "LIKE", "MOD",
+        "NOT", "ON", "OR", "REGEXP", "THEN", "WHEN", "WHERE", "XOR"
+    };
+    for (auto keyword : keywords) {
+        if (word == keyword) return true;
+    }
+    return false;
+}
+
+/// @return true if keyword 'word' (upper case) ends the WHERE clause.
+bool endsWhereClause(std::string const& word) {
+    return word == "GROUP" || word == "HAVING" || word == "ORDER" || word == "LIMIT"
+        || word == "UNION" || word == "INTO" || word == "FOR" || word == "LOCK";
+}
+
+/// @return position after a numeric literal starting at 'pos'.
+std::size_t skipNumber(std::string const& query, std::size_t pos) {
+    bool plain = true; // only digits and decimal point seen so far
+    std::size_t const size = query.size();
+    while (pos < size) {
+        char const c = query[pos];
+        if (isDigit(c) || c == '.') {
+            ++pos;
+        } else if (plain && (c == 'e' || c == 'E') && pos + 1 < size
+                   && (query[pos + 1] == '+' || query[pos + 1] == '-')) {
+            pos += 2;
+            plain = false;
+        } else if (isIdentChar(c)) {
+            // hexadecimal literals, exponents without sign
+            ++pos;
+            plain = false;
+        } else {
+            break;
+        }
+    }
+    return pos;
+}
+
+} // namespace
+
+namespace lsst {
+namespace qserv {
+namespace qproc {
+
+QueryPlanCache::QueryPlanCache(std::size_t maxEntries, std::chrono::seconds lifetime)
+    : _maxEntries(maxEntries), _lifetime(lifetime) {
+}
+
+
+bool QueryPlanCache::get(std::string const& key, SessionPtr& session) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto iter = _map.find(key);
+    if (iter == _map.end()) {
+        ++_misses;
+        return false;
+    }
+    if (Clock::now() - iter->second->created > _lifetime) {
+        _lru.erase(iter->second);
+        _map.erase(iter);
+        ++_misses;
+        return false;
+    }
+    ++_hits;
+    // Move to the front of the LRU list, iterators stay valid.
+    _lru.splice(_lru.begin(), _lru, iter->second);
+    session = iter->second->session;
+    return true;
+}
+
+
+void QueryPlanCache::put(std::string const& key, SessionPtr const& session) {
+    if (_maxEntries == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto iter = _map.find(key);
+    if (iter != _map.end()) {
+        iter->second->session = session;
+        iter->second->created = Clock::now();
+        _lru.splice(_lru.begin(), _lru, iter->second);
+        return;
+    }
+    _lru.push_front(Entry{key, session, Clock::now()});
+    _map[key] = _lru.begin();
+    while (_map.size() > _maxEntries) {
+        _map.erase(_lru.back().key);
+        _lru.pop_back();
+    }
+}
+
+
+void QueryPlanCache::clear() {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _map.clear();
+    _lru.clear();
+}
+
+
+std::size_t QueryPlanCache::size() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _map.size();
+}
+
+
+std::uint64_t QueryPlanCache::getHits() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _hits;
+}
+
+
+std::uint64_t QueryPlanCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _misses;
+}
+
+
+std::string QueryPlanCache::paramMarker(std::size_t index) {
+    std::ostringstream os;
+    os << MARKER_PREFIX << std::setw(MARKER_INDEX_DIGITS) << std::setfill('0') << index;
+    return os.str();
+}
+
+
+bool QueryPlanCache::hasParamMarker(std::string const& text) {
+    return text.find(MARKER_PREFIX) != std::string::npos;
+}
+
+
+bool QueryPlanCache::parameterize(std::string const& query, std::string& shape, StringVector& literals) {
+    shape.clear();
+    literals.clear();
+    if (hasParamMarker(query)) {
+        return false;
+    }
+
+    std::size_t const size = query.size();
+    bool inWhere = false;
+    bool afterValue = false; // true if the last token can end a value expression
+    int depth = 0;
+    std::size_t pos = 0;
+
+    auto addLiteral = [&](std::size_t begin, std::size_t end) {
+        shape += paramMarker(literals.size());
+        literals.push_back(query.substr(begin, end - begin));
+    };
+
+    while (pos < size) {
+        char const c = query[pos];
+        if (isSpace(c)) {
+            while (pos < size && isSpace(query[pos])) ++pos;
+            if (!shape.empty()) shape += ' ';
+            continue;
+        }
+        if (c == '#' || (c == '-' && pos + 1 < size && query[pos + 1] == '-')
+            || (c == '/' && pos + 1 < size && query[pos + 1] == '*')) {
+            // Comments are rare in queries we care about, not worth handling.
+            return false;
+        }
+        if (c == '\'' || c == '"' || c == '`') {
+            std::size_t end = pos + 1;
+            while (end < size) {
+                if (query[end] == '\\' && c != '`') {
+                    end += 2;
+                } else if (query[end] == c) {
+                    if (end + 1 < size && query[end + 1] == c) {
+                        end += 2; // doubled quote
+                    } else {
+                        break;
+                    }
+                } else {
+                    ++end;
+                }
+            }
+            if (end >= size) {
+                return false; // unterminated
+            }
+            ++end;
+            if (c == '\'' && inWhere) {
+                addLiteral(pos, end);
+            } else {
+                shape.append(query, pos, end - pos);
+            }
+            pos = end;
+            afterValue = true;
+            continue;
+        }
+        if (isIdentStart(c)) {
+            std::size_t end = pos;
+            while (end < size && isIdentChar(query[end])) ++end;
+            std::string word = query.substr(pos, end - pos);
+            std::transform(word.begin(), word.end(), word.begin(), ::toupper);
+            if (depth == 0) {
+                if (word == "WHERE") {
+                    inWhere = true;
+                } else if (endsWhereClause(word)) {
+                    inWhere = false;
+                }
+            }
+            afterValue = !isOperatorKeyword(word);
+            shape.append(query, pos, end - pos);
+            pos = end;
+            continue;
+        }
+        bool const numberStart = isDigit(c) || (c == '.' && pos + 1 < size && isDigit(query[pos + 1]));
+        if (numberStart || (inWhere && !afterValue && (c == '-' || c == '+'))) {
+            std::size_t numPos = pos;
+            if (!numberStart) {
+                // A sign belongs to the literal if a number follows it.
+                ++numPos;
+                while (numPos < size && isSpace(query[numPos])) ++numPos;
+                if (numPos == size || !(isDigit(query[numPos])
+                      || (query[numPos] == '.' && numPos + 1 < size && isDigit(query[numPos + 1])))) {
+                    shape += c;
+                    ++pos;
+                    continue;
+                }
+            }
+            std::size_t const end = skipNumber(query, numPos);
+            if (inWhere) {
+                addLiteral(pos, end);
+            } else {
+                shape.append(query, pos, end - pos);
+            }
+            pos = end;
+            afterValue = true;
+            continue;
+        }
+        if (c == '(') {
+            ++depth;
+        } else if (c == ')') {
+            --depth;
+        }
+        afterValue = (c == ')');
+        shape += c;
+        ++pos;
+    }
+    while (!shape.empty() && shape.back() == ' ') {
+        shape.pop_back();
+    }
+    return !literals.empty() && literals.size() <= MAX_LITERALS;
+}
+
+}}} // namespace lsst::qserv::qproc
@@ -0,0 +1,144 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef LSST_QSERV_QPROC_QUERYPLANCACHE_H
+#define LSST_QSERV_QPROC_QUERYPLANCACHE_H
+/**
+  * @file
+  *
+  * @brief QueryPlanCache keeps analyzed query sessions for queries that
+  * only differ in the literals of their WHERE clause.
+  *
+  */
+
+// System headers
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// Qserv headers
+#include "global/stringTypes.h"
+
+namespace lsst {
+namespace qserv {
+namespace qproc {
+
+class QuerySession;
+
+/**
+ *  QueryPlanCache maps a query shape, i.e. the query text with literals
+ *  of the WHERE clause replaced by parameter markers (see parameterize()),
+ *  to the QuerySession obtained by analyzing that text. The cached session
+ *  is never dispatched itself, QuerySession::bindParams() makes a session
+ *  for a concrete query from it.
+ *
+ *  A null session is cached for shapes which can not be handled this way,
+ *  so that they go straight to regular analysis next time.
+ *
+ *  The number of entries is bounded, the least recently used entries are
+ *  evicted first. Entries expire after a fixed lifetime so that metadata
+ *  changes made through other czars are eventually picked up.
+ *
+ *  All methods are thread-safe.
+ */
+class QueryPlanCache {
+public:
+    typedef std::shared_ptr<QuerySession const> SessionPtr;
+
+    /// @param maxEntries - maximum number of cached shapes, 0 disables caching.
+    /// @param lifetime - time after which an entry is discarded.
+    QueryPlanCache(std::size_t maxEntries, std::chrono::seconds lifetime);
+
+    QueryPlanCache(QueryPlanCache const&) = delete;
+    QueryPlanCache& operator=(QueryPlanCache const&) = delete;
+
+    /// Look up a shape.
+    /// @return true if the shape is in the cache, 'session' is then set
+    ///         to the cached session which may be null.
+    bool get(std::string const& key, SessionPtr& session);
+
+    /// Add or replace the session for a shape.
+    void put(std::string const& key, SessionPtr const& session);
+
+    /// Remove all entries, e.g. after a table or database was dropped.
+    void clear();
+
+    std::size_t size() const;
+    std::size_t getMaxEntries() const { return _maxEntries; }
+    std::uint64_t getHits() const;
+    std::uint64_t getMisses() const;
+
+    /// @return cache key for a query shape executed with 'defaultDb' against
+    ///         CSS contents identified by 'cssGeneration'.
+    static std::string makeKey(std::string const& cssGeneration,
+                               std::string const& defaultDb, std::string const& shape) {
+        return cssGeneration + '\n' + defaultDb + '\n' + shape;
+    }
+
+    /**
+     *  Replace literals in the WHERE clause of a SELECT with parameter
+     *  markers. Numeric and single-quoted string literals, including the
+     *  sign of a numeric literal, are replaced; everything before WHERE and
+     *  from GROUP BY, HAVING, ORDER BY or LIMIT on is left as is. Runs of
+     *  white space outside of quotes are collapsed into a single space.
+     *
+     *  @param query - query text.
+     *  @param shape - receives the text with markers.
+     *  @param literals - receives the replaced literals, in order of appearance.
+     *  @return false if there is nothing to replace or the query can not be
+     *          parameterized.
+     */
+    static bool parameterize(std::string const& query, std::string& shape, StringVector& literals);
+
+    /// @return the marker that replaces literal number 'index', a numeric
+    /// literal that does not appear in regular queries.
+    static std::string paramMarker(std::size_t index);
+
+    /// @return true if 'text' contains something looking like a marker.
+    static bool hasParamMarker(std::string const& text);
+
+private:
+    typedef std::chrono::steady_clock Clock;
+    struct Entry {
+        std::string key;
+        SessionPtr session;
+        Clock::time_point created;
+    };
+    typedef std::list<Entry> EntryList;
+
+    std::size_t const _maxEntries;
+    Clock::duration const _lifetime;
+    EntryList _lru; ///< Most recently used first.
+    std::unordered_map<std::string, EntryList::iterator> _map;
+    std::uint64_t _hits{0};
+    std::uint64_t _misses{0};
+    mutable std::mutex _mtx; ///< Protects all members above.
+};
+
+}}} // namespace lsst::qserv::qproc
+
+#endif // LSST_QSERV_QPROC_QUERYPLANCACHE_H
@@ -67,6 +67,7 @@
 #include "qana/ScanTablePlugin.h"
 #include "qana/TablePlugin.h"
 #include "qana/WherePlugin.h"
+#include "qproc/QueryPlanCache.h"
 #include "qproc/QueryProcessingBug.h"
 #include "query/Constraint.h"
 #include "query/QsRestrictor.h"
@@ -137,6 +138,52 @@ void QuerySession::analyzeQuery(std::string const& sql, std::shared_ptr<query::S
     }
 }
 
+std::shared_ptr<QuerySession>
+QuerySession::bindParams(std::string const& sql, StringVector const& params) const {
+    // Statements are only read once analysis is done and can be shared,
+    // except for the merge statement which gets its FROM list from InfileMerger.
+    auto qs = std::make_shared<QuerySession>(*this);
+    qs->_original = sql;
+    if (_stmtMerge) {
+        qs->_stmtMerge = _stmtMerge->clone();
+    }
+    qs->_params.clear();
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        qs->_params[QueryPlanCache::paramMarker(i)] = params[i];
+    }
+
+    // Context collects chunk coverage, each session needs its own.
+    qs->_context = std::make_shared<query::QueryContext>(*_context);
+    if (_context->restrictors) {
+        auto restrictors = std::make_shared<query::QueryContext::RestrList>();
+        for (auto const& restr : *_context->restrictors) {
+            auto bound = std::make_shared<query::QsRestrictor>(*restr);
+            for (auto& param : bound->_params) {
+                auto iter = qs->_params.find(param);
+                if (iter != qs->_params.end()) {
+                    param = iter->second;
+                } else if (QueryPlanCache::hasParamMarker(param)) {
+                    return std::shared_ptr<QuerySession>();
+                }
+            }
+            restrictors->push_back(bound);
+        }
+        qs->_context->restrictors = restrictors;
+    }
+
+    for (auto const& queryTemplate : qs->makeQueryTemplates()) {
+        if (QueryPlanCache::hasParamMarker(queryTemplate.sqlFragment())) {
+            LOGS(_log, LOG_LVL_DEBUG, "Unbound parameter in " << queryTemplate);
+            return std::shared_ptr<QuerySession>();
+        }
+    }
+    if (qs->_stmtMerge
+        && QueryPlanCache::hasParamMarker(qs->_stmtMerge->getQueryTemplate().sqlFragment())) {
+        return std::shared_ptr<QuerySession>();
+    }
+    return qs;
+}
+
 bool QuerySession::needsMerge() const {
     // Aggregate: having an aggregate fct spec in the select list.
     // Stmt itself knows whether aggregation is present. More
@@ -232,10 +279,10 @@ QuerySession::getDbStriping() {
     return _context->getDbStriping();
 }
 
-std::shared_ptr<IntSet const>
+css::ChunkBitmap::ConstPtr
 QuerySession::getEmptyChunks() {
     // FIXME: do we need to catch an exception here?
-    return _css->getEmptyChunks().getEmpty(_context->dominantDb);
+    return _css->getEmptyChunks().getEmptyBitmap(_context->dominantDb);
 }
 
 /// Returns the merge statment, if appropriate.
@@ -341,6 +388,7 @@ void QuerySession::_applyConcretePlugins() {
 /// Some code useful for debugging.
 void QuerySession::print(std::ostream& os) const {
     query::QueryTemplate par = _stmtParallel.front()->getQueryTemplate();
+    par.replaceStrings(_params);
     query::QueryTemplate mer = _stmtMerge->getQueryTemplate();
     os << "QuerySession description:\n";
     os << "  original: " << this->_original << "\n";
@@ -361,6 +409,9 @@ std::vector<query::QueryTemplate> QuerySession::makeQueryTemplates() {
     std::vector<query::QueryTemplate> queryTemplates;
     for(auto stmtIter=_stmtParallel.begin(), e=_stmtParallel.end(); stmtIter != e; ++stmtIter) {
         queryTemplates.push_back((*stmtIter)->getQueryTemplate());
+        if (!_params.empty()) {
+            queryTemplates.back().replaceStrings(_params);
+        }
     }
     return queryTemplates;
 }
@@ -40,8 +40,10 @@
 #include "boost/iterator/iterator_facade.hpp"
 
 // Qserv headers
+#include "css/ChunkBitmap.h"
 #include "css/CssAccess.h"
 #include "global/intTypes.h"
+#include "global/stringTypes.h"
 #include "mysql/MySqlConfig.h"
 #include "qana/QueryPlugin.h"
 #include "qproc/ChunkQuerySpec.h"
@@ -99,6 +101,21 @@ public:
      * @param stmt: parsed select statement
      */
     void analyzeQuery(std::string const& sql, std::shared_ptr<query::SelectStmt> const& stmt);
+    /**
+     * @brief Make a session for a query from the analysis of its shape
+     *
+     * This session must have analyzed the query shape returned by
+     * QueryPlanCache::parameterize(). The new session shares the analysis
+     * results, parameter markers are replaced by the literals in the
+     * generated queries and in the restrictors. Nothing is parsed or
+     * analyzed again.
+     *
+     * @param sql: the sql query text
+     * @param params: literals replacing the parameter markers, in order
+     * @return the new session, or a null pointer if some markers could not
+     *         be replaced, e.g. because a literal was merged into another token
+     */
+    std::shared_ptr<QuerySession> bindParams(std::string const& sql, StringVector const& params) const;
     bool needsMerge() const;
     bool hasChunks() const;
 
@@ -128,7 +145,7 @@ public:
     bool containsTable(std::string const& dbName, std::string const& tableName) const;
     bool validateDominantDb() const;
     css::StripingParams getDbStriping();
-    std::shared_ptr<IntSet const> getEmptyChunks();
+    css::ChunkBitmap::ConstPtr getEmptyChunks();
     std::string const& getError() const { return _error; }
 
     std::shared_ptr<query::SelectStmt> getMergeStmt() const;
@@ -155,6 +172,9 @@ public:
 
     void setScanInteractive();
 
+    /// @return true if the query can be considered interactive, see setScanInteractive().
+    bool getScanInteractive() const { return _scanInteractive; }
+
     /**
      *  Print query session to stream.
      *
@@ -222,6 +242,7 @@ private:
     std::string _resultTable;
     std::string _error;
     int _isFinal{0}; ///< Has query analysis/optimization completed?
+    StringMap _params; ///< Parameter marker to literal, set by bindParams()
 
     ChunkSpecVector _chunks; ///< Chunk coverage
     std::shared_ptr<QueryPluginPtrVector> _plugins; ///< Analysis plugin chain
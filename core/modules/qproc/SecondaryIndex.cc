@@ -33,6 +33,14 @@
 
 // System headers
 #include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // LSST headers
 #include "lsst/log/Log.h"
@@ -46,8 +54,13 @@
 #include "global/constants.h"
 #include "global/stringUtil.h"
 #include "qproc/ChunkSpec.h"
+#include "qproc/QueryProcessingError.h"
+#include "qproc/SecondaryIndexCache.h"
+#include "qproc/SecondaryIndexFile.h"
 #include "query/Constraint.h"
 #include "sql/SqlConnection.h"
+#include "sql/SqlErrorObject.h"
+#include "sql/SqlResults.h"
 #include "util/IterableFormatter.h"
 
 namespace {
@@ -68,12 +81,22 @@ public:
     /// Lookup an index constraint. Ignore constraints that are not "sIndex"
     /// constraints.
     virtual ChunkSpecVector lookup(query::ConstraintVector const& cv) = 0;
+    /// Forget everything cached about the index tables.
+    virtual void clear() {}
 };
 
 class MySqlBackend : public SecondaryIndex::Backend {
 public:
-    MySqlBackend(mysql::MySqlConfig const& c)
-        : _sqlConnection(c, true) {
+    MySqlBackend(mysql::MySqlConfig const& c, std::size_t cacheSize, unsigned maxConnections,
+                 mysql::MySqlConnectionPool::Ptr const& connectionPool)
+        : _sqlConfig(c), _cache(cacheSize),
+          _maxConnections(std::max(1u, maxConnections)),
+          _connectionPool(connectionPool) {
+        if (!_connectionPool) {
+            mysql::MySqlConnectionPool::Config poolConfig;
+            poolConfig.maxIdle = _maxConnections;
+            _connectionPool = mysql::MySqlConnectionPool::create(poolConfig);
+        }
     }
 
     ChunkSpecVector lookup(query::ConstraintVector const& cv) override {
@@ -84,7 +107,7 @@ public:
             ++i) {
             if (i->name == "sIndex"){
                 hasIndex = true;
-                _sqlLookup(output, i->params, IN);
+                _inLookup(output, i->params);
             }
             else if (i->name == "sIndexBetween") {
                 hasIndex = true;
@@ -98,8 +121,16 @@ public:
         return output;
     }
 
+    void clear() override {
+        _cache.clear();
+    }
 
 private:
+    typedef std::map<int, Int32Vector> ChunkMap;
+
+    /// Maximum number of keys in a single IN (...) lookup query.
+    static unsigned const BATCH_SIZE = 1000;
+
     static std::string _buildIndexTableName(
         std::string const& db,
         std::string const& table) {
@@ -123,7 +154,7 @@ private:
      *                     to find chunk ids.
      *
      *  @return:   the sql query string to run against secondary index in
-     *             order to get (chunks, subchunks) couples containing [id_0, ..., id_n]
+     *             order to get (key, chunk, subchunk) triplets for [id_0, ..., id_n]
      */
     static std::string _buildLookupQuery(
         std::vector<std::string> const& params,
@@ -137,7 +168,8 @@ private:
         std::string const& key_column = *(iter++); // params[2]
 
         std::string index_table = _buildIndexTableName(db, table);
-        std::string sql = "SELECT " + std::string(CHUNK_COLUMN) + ", " + std::string(SUB_CHUNK_COLUMN) +
+        std::string sql = "SELECT " + key_column + ", " + std::string(CHUNK_COLUMN) + ", "
+                          + std::string(SUB_CHUNK_COLUMN) +
                           " FROM " + index_table +
                           " WHERE " + key_column;
         if (query_type == QueryType::IN) {
@@ -168,6 +200,72 @@ private:
     }
 
 
+    /**
+     *  Resolve an "sIndex" constraint, using the cache for the keys that
+     *  were looked up before. The remaining keys are looked up in batches of
+     *  at most BATCH_SIZE keys, running concurrently on pooled connections.
+     *
+     *  @param output:      existing ChunkSpec vector
+     *  @param params:      [db, table, keyColumn, id_0, ..., id_n]
+     */
+    void _inLookup(ChunkSpecVector& output, StringVector const& params) {
+        if (params.size() < 4) {
+            throw Bug("Incorrect parameters for secondary index lookup");
+        }
+        std::string const indexTable = _buildIndexTableName(params[0], params[1]);
+        StringVector keys(params.begin() + 3, params.end());
+        SecondaryIndexCache::LocationVector found;
+        StringVector missing = _cache.get(indexTable, keys, found);
+        LOGS(_log, LOG_LVL_DEBUG, "secondary index cache " << indexTable
+             << " hits=" << found.size() << " misses=" << missing.size()
+             << " size=" << _cache.size());
+
+        ChunkMap tmp;
+        for (auto const& loc : found) {
+            tmp[loc.chunkId].push_back(loc.subChunkId);
+        }
+
+        // Split the missing keys into batches.
+        std::vector<StringVector> batches;
+        for (unsigned j = 0; j < missing.size(); j += BATCH_SIZE) {
+            StringVector batch(params.begin(), params.begin() + 3);
+            auto bEnd = missing.begin() + std::min<std::size_t>(j + BATCH_SIZE, missing.size());
+            batch.insert(batch.end(), missing.begin() + j, bEnd);
+            batches.push_back(std::move(batch));
+        }
+        if (batches.size() == 1) {
+            _sqlQuery(tmp, batches[0], IN);
+        } else if (!batches.empty()) {
+            // Each worker thread takes batches in turn and fills its own map.
+            unsigned nThreads = std::min<std::size_t>(_maxConnections, batches.size());
+            std::vector<ChunkMap> results(nThreads);
+            std::vector<std::thread> threads;
+            for (unsigned t = 0; t < nThreads; ++t) {
+                threads.emplace_back([this, t, nThreads, &batches, &results]() {
+                    for (unsigned b = t; b < batches.size(); b += nThreads) {
+                        _sqlQuery(results[t], batches[b], IN);
+                    }
+                });
+            }
+            for (auto& thrd : threads) {
+                thrd.join();
+            }
+            for (auto const& result : results) {
+                for (auto const& elem : result) {
+                    Int32Vector& subChunks = tmp[elem.first];
+                    subChunks.insert(subChunks.end(), elem.second.begin(), elem.second.end());
+                }
+            }
+        }
+
+        // Add results to output
+        for(auto i=tmp.begin(), e=tmp.end();
+            i != e; ++i) {
+            output.push_back(ChunkSpec(i->first, i->second));
+        }
+    }
+
+
     /**
      *  Add results from secondary index sql query to existing ChunkSpec vector
      *
@@ -178,32 +276,8 @@ private:
      *                      to find chunk ids.
      */
     void _sqlLookup(ChunkSpecVector& output, StringVector const& params, QueryType const& query_type) {
-        IntVector ids;
-
-        std::string sql = _buildLookupQuery(params, query_type);
-        std::map<int, Int32Vector> tmp;
-
-        // Insert sql query result:
-        //   chunkId_x1, subChunkId_y1
-        //   chunkId_x1, subChunkId_y2
-        //   ...
-        //   chunkId_xi, subChunkId_yj
-        //   ...
-        //   chunkId_xm, subChunkId_yn
-        //
-        // in a std::map<int, Int32Vector>:
-        // key       , value
-        // chunkId_x1, [subChunkId_y1, subChunkId_y2, ...]
-        // chunkId_xi, [subChunkId_yj, ..., subChunkId_yk]
-        // chunkId_xm, [subChunkId_yl, ..., subChunkId_yn]
-        for(std::shared_ptr<sql::SqlResultIter> results = _sqlConnection.getQueryIter(sql);
-            not results->done();
-            ++(*results)) {
-            StringVector const& row = **results;
-            int chunkId = std::stoi(row[0]);
-            int subChunkId = std::stoi(row[1]);
-            tmp[chunkId].push_back(subChunkId);
-        }
+        ChunkMap tmp;
+        _sqlQuery(tmp, params, query_type);
 
         // Add results to output
         for(auto i=tmp.begin(), e=tmp.end();
@@ -212,7 +286,191 @@ private:
         }
     }
 
-    sql::SqlConnection _sqlConnection;
+
+    /**
+     *  Run a lookup query and insert its results:
+     *    key_1, chunkId_x1, subChunkId_y1
+     *    key_2, chunkId_x1, subChunkId_y2
+     *    ...
+     *    key_n, chunkId_xm, subChunkId_yn
+     *
+     *  in a std::map<int, Int32Vector>:
+     *  key       , value
+     *  chunkId_x1, [subChunkId_y1, subChunkId_y2, ...]
+     *  chunkId_xm, [subChunkId_yl, ..., subChunkId_yn]
+     *
+     *  All returned keys are added to the cache.
+     */
+    void _sqlQuery(ChunkMap& tmp, StringVector const& params, QueryType const& query_type) {
+        std::string sql = _buildLookupQuery(params, query_type);
+        std::string const indexTable = _buildIndexTableName(params[0], params[1]);
+        sql::SqlConnection conn(_sqlConfig, true, _connectionPool);
+        sql::SqlResults results;
+        sql::SqlErrorObject errObj;
+        if (!conn.runQuery(sql, results, errObj)) {
+            LOGS(_log, LOG_LVL_ERROR, "secondary index lookup failed: " << errObj.printErrMsg());
+            return;
+        }
+        for (auto const& row : results) {
+            if (row[0].first == nullptr || row[1].first == nullptr || row[2].first == nullptr) {
+                continue;
+            }
+            SecondaryIndexCache::Location loc(std::strtol(row[1].first, nullptr, 10),
+                                              std::strtol(row[2].first, nullptr, 10));
+            tmp[loc.chunkId].push_back(loc.subChunkId);
+            _cache.put(indexTable, std::string(row[0].first, row[0].second), loc);
+        }
+        results.freeResults();
+    }
+
+    mysql::MySqlConfig const _sqlConfig;
+    SecondaryIndexCache _cache;
+    unsigned const _maxConnections; ///< Lookup concurrency.
+    mysql::MySqlConnectionPool::Ptr _connectionPool;
+};
+
+/// Backend resolving constraints on director tables that have a
+/// SecondaryIndexFile in a local directory, and delegating all other
+/// constraints to another backend.
+class FileBackend : public SecondaryIndex::Backend {
+public:
+    FileBackend(std::string const& dir, std::shared_ptr<SecondaryIndex::Backend> const& fallback)
+        : _dir(dir), _fallback(fallback) {
+    }
+
+    ChunkSpecVector lookup(query::ConstraintVector const& cv) override {
+        ChunkSpecVector output;
+        query::ConstraintVector rest;
+        bool hasIndex = false;
+        for (auto const& constraint : cv) {
+            if (constraint.name == "sIndex" || constraint.name == "sIndexBetween") {
+                hasIndex = true;
+                if (!_fileLookup(output, constraint)) {
+                    rest.push_back(constraint);
+                }
+            }
+        }
+        if (!hasIndex) {
+            throw SecondaryIndex::NoIndexConstraint();
+        }
+        if (!rest.empty()) {
+            ChunkSpecVector fromFallback = _fallback->lookup(rest);
+            output.insert(output.end(), fromFallback.begin(), fromFallback.end());
+        }
+        normalize(output);
+        return output;
+    }
+
+    void clear() override {
+        {
+            std::lock_guard<std::mutex> lock(_filesMtx);
+            _files.clear();
+        }
+        _fallback->clear();
+    }
+
+private:
+    /// Resolve 'constraint' from an index file if there is one for its table
+    /// and all its keys are integers.
+    /// @return false if the constraint must be resolved by the fallback.
+    bool _fileLookup(ChunkSpecVector& output, query::Constraint const& constraint) {
+        StringVector const& params = constraint.params;
+        if (params.size() < 4) {
+            return false;
+        }
+        std::vector<std::int64_t> keys;
+        for (auto iter = params.begin() + 3; iter != params.end(); ++iter) {
+            std::string const key = SecondaryIndexCache::normalizeKey(*iter);
+            char* end = nullptr;
+            errno = 0;
+            long long value = std::strtoll(key.c_str(), &end, 10);
+            if (key.empty() || *end != '\0' || errno != 0) {
+                return false;
+            }
+            keys.push_back(value);
+        }
+        SecondaryIndexFile::Ptr file = _getFile(params[0], params[1]);
+        if (!file) {
+            return false;
+        }
+        std::map<int, Int32Vector> tmp;
+        if (constraint.name == "sIndexBetween") {
+            if (keys.size() != 2) {
+                throw Bug("Incorrect parameters for bounded secondary index lookup ");
+            }
+            auto range = file->range(keys[0], keys[1]);
+            for (auto r = range.first; r != range.second; ++r) {
+                tmp[r->chunkId].push_back(r->subChunkId);
+            }
+        } else {
+            for (auto key : keys) {
+                auto r = file->find(key);
+                if (r != nullptr) {
+                    tmp[r->chunkId].push_back(r->subChunkId);
+                }
+            }
+        }
+        for (auto const& elem : tmp) {
+            output.push_back(ChunkSpec(elem.first, elem.second));
+        }
+        return true;
+    }
+
+    /// @return the index file for a director table, or nullptr if there is
+    /// no usable file. A file that was replaced or rewritten since it was
+    /// mapped is mapped again.
+    SecondaryIndexFile::Ptr _getFile(std::string const& db, std::string const& table) {
+        std::string const path = _dir + "/" + sanitizeName(db) + "__" + sanitizeName(table)
+                                 + ".sidx";
+        struct stat st;
+        bool const found = ::stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode)
+                           && ::access(path.c_str(), R_OK) == 0;
+
+        std::lock_guard<std::mutex> lock(_filesMtx);
+        auto iter = _files.find(path);
+        if (not found) {
+            // Files may be added or removed at any time, absent files are
+            // not remembered.
+            if (iter != _files.end()) _files.erase(iter);
+            return nullptr;
+        }
+        long long const mtimeNs = st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+        if (iter != _files.end()) {
+            Entry const& entry = iter->second;
+            if (entry.mtimeNs == mtimeNs and entry.size == st.st_size
+                and entry.inode == st.st_ino) {
+                return entry.file;
+            }
+        }
+        LOGS(_log, LOG_LVL_DEBUG, "Mapping secondary index file " << path);
+        SecondaryIndexFile::Ptr file;
+        try {
+            file = std::make_shared<SecondaryIndexFile>(path);
+        } catch (QueryProcessingError const& exc) {
+            LOGS(_log, LOG_LVL_ERROR, exc.what());
+            // e.g. file is being rewritten, keep using what we have
+            return iter == _files.end() ? nullptr : iter->second.file;
+        }
+        Entry& entry = _files[path];
+        entry.file = file;
+        entry.mtimeNs = mtimeNs;
+        entry.size = st.st_size;
+        entry.inode = st.st_ino;
+        return file;
+    }
+
+    /// A mapped index file and the identity of the file it was mapped from.
+    struct Entry {
+        SecondaryIndexFile::Ptr file;
+        long long mtimeNs = 0;
+        long long size = -1;
+        unsigned long long inode = 0;
+    };
+
+    std::string const _dir;
+    std::shared_ptr<SecondaryIndex::Backend> _fallback;
+    std::map<std::string, Entry> _files;
+    std::mutex _filesMtx; ///< Protects _files.
 };
 
 class FakeBackend : public SecondaryIndex::Backend {
@@ -239,8 +497,13 @@ private:
     }
 };
 
-SecondaryIndex::SecondaryIndex(mysql::MySqlConfig const& c)
-    : _backend(std::make_shared<MySqlBackend>(c)) {
+SecondaryIndex::SecondaryIndex(mysql::MySqlConfig const& c, std::size_t cacheSize,
+                               unsigned maxConnections, std::string const& indexFileDir,
+                               mysql::MySqlConnectionPool::Ptr const& connectionPool)
+    : _backend(std::make_shared<MySqlBackend>(c, cacheSize, maxConnections, connectionPool)) {
+    if (!indexFileDir.empty()) {
+        _backend = std::make_shared<FileBackend>(indexFileDir, _backend);
+    }
 }
 
 SecondaryIndex::SecondaryIndex()
@@ -255,5 +518,11 @@ ChunkSpecVector SecondaryIndex::lookup(query::ConstraintVector const& cv) {
     }
 }
 
+void SecondaryIndex::clear() {
+    if (_backend) {
+        _backend->clear();
+    }
+}
+
 }}} // namespace lsst::qserv::qproc
 
@@ -33,9 +33,11 @@
 // System headers
 #include <memory>
 #include <stdexcept>
+#include <string>
 
 // Qserv headers
 #include "mysql/MySqlConfig.h"
+#include "mysql/MySqlConnectionPool.h"
 #include "qproc/ChunkSpec.h"
 #include "query/Constraint.h"
 
@@ -51,7 +53,23 @@ namespace qproc {
  */
 class SecondaryIndex {
 public:
-    explicit SecondaryIndex(mysql::MySqlConfig const& c);
+    /** Construct an instance looking up the index tables in mysql
+     *
+     *  @param cacheSize: maximum number of keys kept in the lookup cache,
+     *                    0 disables the cache.
+     *  @param maxConnections: number of concurrent lookup queries for a
+     *                    large IN list.
+     *  @param indexFileDir: if not empty, directory with memory-mapped
+     *                    index files (<db>__<table>.sidx, see
+     *                    SecondaryIndexFile) used instead of mysql for the
+     *                    director tables that have one.
+     *  @param connectionPool: pool of lookup connections, if null a private
+     *                    pool keeping maxConnections idle connections is used.
+     */
+    explicit SecondaryIndex(mysql::MySqlConfig const& c, std::size_t cacheSize=0,
+                            unsigned maxConnections=1,
+                            std::string const& indexFileDir=std::string(),
+                            std::shared_ptr<mysql::MySqlConnectionPool> const& connectionPool=nullptr);
 
     /** Construct a fake instance
      *
@@ -66,6 +84,13 @@ public:
      */
     ChunkSpecVector lookup(query::ConstraintVector const& cv);
 
+    /** Drop all cached index data.
+     *
+     *  Call after the index tables may have changed, e.g. when a
+     *  database or table is dropped.
+     */
+    void clear();
+
     class NoIndexConstraint : public std::invalid_argument {
     public:
         NoIndexConstraint()
@@ -0,0 +1,120 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "qproc/SecondaryIndexCache.h"
+
+namespace lsst {
+namespace qserv {
+namespace qproc {
+
+SecondaryIndexCache::SecondaryIndexCache(std::size_t maxEntries)
+    : _maxEntries(maxEntries) {
+}
+
+
+StringVector SecondaryIndexCache::get(std::string const& indexTable, StringVector const& keys,
+                                      LocationVector& found) {
+    StringVector missing;
+    std::lock_guard<std::mutex> lock(_mtx);
+    for (auto const& key : keys) {
+        std::string const normKey = normalizeKey(key);
+        auto iter = _map.find(_makeKey(indexTable, normKey));
+        if (iter == _map.end()) {
+            ++_misses;
+            missing.push_back(key);
+            continue;
+        }
+        ++_hits;
+        // Move to the front of the LRU list, iterators stay valid.
+        _lru.splice(_lru.begin(), _lru, iter->second);
+        found.push_back(iter->second->second);
+    }
+    return missing;
+}
+
+
+void SecondaryIndexCache::put(std::string const& indexTable, std::string const& key,
+                              Location const& loc) {
+    if (_maxEntries == 0) {
+        return;
+    }
+    std::string mapKey = _makeKey(indexTable, normalizeKey(key));
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto iter = _map.find(mapKey);
+    if (iter != _map.end()) {
+        iter->second->second = loc;
+        _lru.splice(_lru.begin(), _lru, iter->second);
+        return;
+    }
+    _lru.emplace_front(mapKey, loc);
+    _map[mapKey] = _lru.begin();
+    while (_map.size() > _maxEntries) {
+        _map.erase(_lru.back().first);
+        _lru.pop_back();
+    }
+}
+
+
+void SecondaryIndexCache::clear() {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _map.clear();
+    _lru.clear();
+}
+
+
+std::size_t SecondaryIndexCache::size() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _map.size();
+}
+
+
+std::uint64_t SecondaryIndexCache::getHits() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _hits;
+}
+
+
+std::uint64_t SecondaryIndexCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _misses;
+}
+
+
+std::string SecondaryIndexCache::normalizeKey(std::string const& key) {
+    std::string::size_type begin = key.find_first_not_of(" \t\n");
+    if (begin == std::string::npos) {
+        return std::string();
+    }
+    std::string::size_type end = key.find_last_not_of(" \t\n") + 1;
+    if (end - begin >= 2) {
+        char q = key[begin];
+        if ((q == '\'' || q == '"') && key[end - 1] == q) {
+            ++begin;
+            --end;
+        }
+    }
+    return key.substr(begin, end - begin);
+}
+
+}}} // namespace lsst::qserv::qproc
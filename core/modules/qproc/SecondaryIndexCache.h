@@ -0,0 +1,112 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef LSST_QSERV_QPROC_SECONDARYINDEXCACHE_H
+#define LSST_QSERV_QPROC_SECONDARYINDEXCACHE_H
+/**
+  * @file
+  *
+  * @brief SecondaryIndexCache keeps recent secondary index lookup results
+  * in memory on the czar.
+  *
+  */
+
+// System headers
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Qserv headers
+#include "global/stringTypes.h"
+
+namespace lsst {
+namespace qserv {
+namespace qproc {
+
+/**
+ *  SecondaryIndexCache maps (index table, key value) to the chunk and
+ *  subchunk holding the row with that key. The number of entries is
+ *  bounded, the least recently used entries are evicted first.
+ *
+ *  All methods are thread-safe.
+ */
+class SecondaryIndexCache {
+public:
+    /// Location of a director table row.
+    struct Location {
+        Location() = default;
+        Location(int chunkId_, int subChunkId_) : chunkId(chunkId_), subChunkId(subChunkId_) {}
+        int chunkId{-1};
+        int subChunkId{-1};
+    };
+    typedef std::vector<Location> LocationVector;
+
+    /// @param maxEntries - maximum number of cached keys, 0 disables caching.
+    explicit SecondaryIndexCache(std::size_t maxEntries);
+
+    SecondaryIndexCache(SecondaryIndexCache const&) = delete;
+    SecondaryIndexCache& operator=(SecondaryIndexCache const&) = delete;
+
+    /// Look up 'keys' of 'indexTable'. Locations of the cached keys are
+    /// appended to 'found'.
+    /// @return the keys that are not in the cache, as given in 'keys'.
+    StringVector get(std::string const& indexTable, StringVector const& keys,
+                     LocationVector& found);
+
+    /// Add or refresh the location of 'key' in 'indexTable'. The key is
+    /// normalized like the keys passed to get().
+    void put(std::string const& indexTable, std::string const& key, Location const& loc);
+
+    void clear();
+
+    std::size_t size() const;
+    std::size_t getMaxEntries() const { return _maxEntries; }
+    std::uint64_t getHits() const;
+    std::uint64_t getMisses() const;
+
+    /// @return 'key' as it is returned by the index table, i.e. without
+    /// surrounding white space and quotes.
+    static std::string normalizeKey(std::string const& key);
+
+private:
+    typedef std::pair<std::string, Location> Entry;
+    typedef std::list<Entry> EntryList;
+
+    static std::string _makeKey(std::string const& indexTable, std::string const& key) {
+        return indexTable + '\t' + key;
+    }
+
+    std::size_t const _maxEntries;
+    EntryList _lru; ///< Most recently used first.
+    std::unordered_map<std::string, EntryList::iterator> _map;
+    std::uint64_t _hits{0};
+    std::uint64_t _misses{0};
+    mutable std::mutex _mtx; ///< Protects all members above.
+};
+
+}}} // namespace lsst::qserv::qproc
+
+#endif // LSST_QSERV_QPROC_SECONDARYINDEXCACHE_H
@@ -0,0 +1,201 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "qproc/SecondaryIndexFile.h"
+
+// System headers
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// LSST headers
+#include "lsst/log/Log.h"
+
+// Qserv headers
+#include "qproc/QueryProcessingError.h"
+
+namespace {
+
+LOG_LOGGER _log = LOG_GET("lsst.qserv.qproc.SecondaryIndexFile");
+
+char const MAGIC[8] = {'Q', 'S', 'V', 'S', 'I', 'D', 'X', '1'};
+
+struct Header {
+    char magic[8];
+    std::uint32_t recordSize;
+    std::uint32_t reserved1;
+    std::uint64_t count;
+    std::uint64_t reserved2;
+};
+
+using lsst::qserv::qproc::SecondaryIndexFile;
+
+static_assert(sizeof(Header) == 32, "Unexpected SecondaryIndexFile header size");
+static_assert(sizeof(SecondaryIndexFile::Record) == 16, "Unexpected SecondaryIndexFile record size");
+
+bool keyLess(SecondaryIndexFile::Record const& r, std::int64_t key) {
+    return r.key < key;
+}
+
+bool keyGreater(std::int64_t key, SecondaryIndexFile::Record const& r) {
+    return key < r.key;
+}
+
+/// Number of interpolation probes before switching to binary search, which
+/// bounds the cost for badly distributed keys.
+int const MAX_PROBES = 8;
+
+} // anonymous namespace
+
+namespace lsst {
+namespace qserv {
+namespace qproc {
+
+SecondaryIndexFile::SecondaryIndexFile(std::string const& path) : _path(path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw QueryProcessingError("Cannot open secondary index file " + path + ": "
+                                   + std::strerror(errno));
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(fd);
+        throw QueryProcessingError("Invalid secondary index file " + path);
+    }
+    _mapSize = st.st_size;
+    _map = ::mmap(nullptr, _mapSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (_map == MAP_FAILED) {
+        _map = nullptr;
+        throw QueryProcessingError("Cannot map secondary index file " + path + ": "
+                                   + std::strerror(errno));
+    }
+    Header const* header = static_cast<Header const*>(_map);
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0
+        || header->recordSize != sizeof(Record)
+        || header->count > (_mapSize - sizeof(Header))/sizeof(Record)) {
+        ::munmap(_map, _mapSize);
+        _map = nullptr;
+        throw QueryProcessingError("Bad header in secondary index file " + path);
+    }
+    _count = header->count;
+    _records = reinterpret_cast<Record const*>(static_cast<char const*>(_map) + sizeof(Header));
+    // Lookups touch few, scattered pages.
+    ::madvise(_map, _mapSize, MADV_RANDOM);
+    LOGS(_log, LOG_LVL_INFO, "Mapped secondary index " << path << " records=" << _count);
+}
+
+
+SecondaryIndexFile::~SecondaryIndexFile() {
+    if (_map != nullptr) {
+        ::munmap(_map, _mapSize);
+    }
+}
+
+
+SecondaryIndexFile::Record const* SecondaryIndexFile::find(std::int64_t key) const {
+    if (_count == 0) {
+        return nullptr;
+    }
+    // Interpolation search, object ids are close to uniformly distributed
+    // within a table so this usually needs very few probes.
+    std::size_t lo = 0;
+    std::size_t hi = _count - 1;
+    for (int probe = 0; probe < MAX_PROBES; ++probe) {
+        std::int64_t const loKey = _records[lo].key;
+        std::int64_t const hiKey = _records[hi].key;
+        if (key < loKey || key > hiKey) {
+            return nullptr;
+        }
+        if (loKey == hiKey) {
+            return (key == loKey) ? &_records[lo] : nullptr;
+        }
+        // Distinct keys far from zero may convert to the same double, bisect then.
+        double const span = double(hiKey) - double(loKey);
+        double fraction = (double(key) - double(loKey))/span;
+        if (!(span > 0) || !std::isfinite(fraction)) {
+            fraction = 0.5;
+        }
+        fraction = std::min(std::max(fraction, 0.), 1.);
+        std::size_t pos = lo + static_cast<std::size_t>(fraction*(hi - lo));
+        pos = std::min(std::max(pos, lo), hi);
+        std::int64_t const posKey = _records[pos].key;
+        if (posKey == key) {
+            return &_records[pos];
+        } else if (posKey < key) {
+            lo = pos + 1;
+        } else {
+            if (pos == 0) {
+                return nullptr;
+            }
+            hi = pos - 1;
+        }
+        if (lo > hi) {
+            return nullptr;
+        }
+    }
+    Record const* end = _records + hi + 1;
+    Record const* r = std::lower_bound(_records + lo, end, key, keyLess);
+    return (r != end && r->key == key) ? r : nullptr;
+}
+
+
+SecondaryIndexFile::RecordRange SecondaryIndexFile::range(std::int64_t lo, std::int64_t hi) const {
+    Record const* end = _records + _count;
+    if (hi < lo) {
+        return RecordRange(end, end);
+    }
+    Record const* first = std::lower_bound(_records, end, lo, keyLess);
+    Record const* last = std::upper_bound(first, end, hi, keyGreater);
+    return RecordRange(first, last);
+}
+
+
+void SecondaryIndexFile::write(std::string const& path, std::vector<Record> records) {
+    std::sort(records.begin(), records.end(),
+              [](Record const& a, Record const& b) { return a.key < b.key; });
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.recordSize = sizeof(Record);
+    header.reserved1 = 0;
+    header.count = records.size();
+    header.reserved2 = 0;
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    if (!records.empty()) {
+        out.write(reinterpret_cast<char const*>(records.data()), records.size()*sizeof(Record));
+    }
+    out.close();
+    if (!out) {
+        throw QueryProcessingError("Failed to write secondary index file " + path);
+    }
+}
+
+}}} // namespace lsst::qserv::qproc
@@ -0,0 +1,105 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef LSST_QSERV_QPROC_SECONDARYINDEXFILE_H
+#define LSST_QSERV_QPROC_SECONDARYINDEXFILE_H
+/**
+  * @file
+  *
+  * @brief SecondaryIndexFile is a read-only, memory-mapped secondary index
+  * for one director table.
+  *
+  */
+
+// System headers
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace lsst {
+namespace qserv {
+namespace qproc {
+
+/**
+ *  SecondaryIndexFile gives access to a file of (key, chunkId, subChunkId)
+ *  records sorted by key, which is mapped into memory. The file layout
+ *  (all integers in host byte order) is:
+ *
+ *    32 byte header:
+ *      char     magic[8]     "QSVSIDX1"
+ *      uint32_t recordSize   16
+ *      uint32_t reserved     0
+ *      uint64_t count        number of records
+ *      uint64_t reserved     0
+ *    count records:
+ *      int64_t key, int32_t chunkId, int32_t subChunkId
+ *
+ *  Files are written by write() or by admin/bin/qserv-secondary-index-file.py.
+ *  Instances are immutable and can be shared between threads.
+ */
+class SecondaryIndexFile {
+public:
+    using Ptr = std::shared_ptr<SecondaryIndexFile>;
+
+    struct Record {
+        std::int64_t key;
+        std::int32_t chunkId;
+        std::int32_t subChunkId;
+    };
+
+    typedef std::pair<Record const*, Record const*> RecordRange;
+
+    /// Map the file at 'path' into memory.
+    /// @throws QueryProcessingError if the file is missing or invalid.
+    explicit SecondaryIndexFile(std::string const& path);
+
+    ~SecondaryIndexFile();
+
+    SecondaryIndexFile(SecondaryIndexFile const&) = delete;
+    SecondaryIndexFile& operator=(SecondaryIndexFile const&) = delete;
+
+    /// @return the record for 'key', or nullptr if there is none.
+    Record const* find(std::int64_t key) const;
+
+    /// @return the records with keys in [lo, hi].
+    RecordRange range(std::int64_t lo, std::int64_t hi) const;
+
+    std::size_t size() const { return _count; }
+    std::string const& getPath() const { return _path; }
+
+    /// Write 'records' to a new index file at 'path', sorting them by key.
+    /// @throws QueryProcessingError if the file cannot be written.
+    static void write(std::string const& path, std::vector<Record> records);
+
+private:
+    std::string _path;
+    void* _map{nullptr};     ///< Start of the mapped file
+    std::size_t _mapSize{0};
+    Record const* _records{nullptr};
+    std::size_t _count{0};
+};
+
+}}} // namespace lsst::qserv::qproc
+
+#endif // LSST_QSERV_QPROC_SECONDARYINDEXFILE_H
@@ -0,0 +1,109 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+/**
+  * @file
+  *
+  * @brief Test ChunkCoverageCache.
+  *
+  */
+
+// System headers
+#include <memory>
+#include <string>
+
+// Qserv headers
+#include "qproc/ChunkCoverageCache.h"
+
+// Boost unit test header
+#define BOOST_TEST_MODULE ChunkCoverageCache
+#include "boost/test/included/unit_test.hpp"
+
+namespace test = boost::test_tools;
+
+using lsst::qserv::css::StripingParams;
+using lsst::qserv::qproc::ChunkCoverageCache;
+using lsst::qserv::qproc::ChunkSpec;
+using lsst::qserv::qproc::ChunkSpecVector;
+
+namespace {
+
+ChunkCoverageCache::CoveragePtr makeCoverage(int chunkId) {
+    auto csv = std::make_shared<ChunkSpecVector>();
+    csv->push_back(ChunkSpec(chunkId, {1, 2, 3}));
+    return csv;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(Suite)
+
+BOOST_AUTO_TEST_CASE(MakeKey) {
+    StripingParams sp(340, 12, 1, 0.01);
+    std::string key = ChunkCoverageCache::makeKey(sp, "qserv_areaspec_box", {"0", "0.5", "1", "2"});
+    BOOST_CHECK(not key.empty());
+    // aliases and different spelling of numbers give same key
+    BOOST_CHECK_EQUAL(key, ChunkCoverageCache::makeKey(sp, "box", {"-0", "5e-1", "1.0", "2."}));
+    // any difference in region or striping gives different key
+    BOOST_CHECK(key != ChunkCoverageCache::makeKey(sp, "box", {"0", "0.5", "1", "2.0000000001"}));
+    BOOST_CHECK(key != ChunkCoverageCache::makeKey(sp, "circle", {"0", "0.5", "1", "2"}));
+    BOOST_CHECK(key != ChunkCoverageCache::makeKey(StripingParams(340, 3, 1, 0.01),
+                                                   "box", {"0", "0.5", "1", "2"}));
+    BOOST_CHECK(key != ChunkCoverageCache::makeAllChunksKey(sp));
+    // non-numeric parameters are not cached
+    BOOST_CHECK(ChunkCoverageCache::makeKey(sp, "box", {"0", "x", "1", "2"}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(GetPut) {
+    ChunkCoverageCache cache(10);
+    BOOST_CHECK(not cache.get("a"));
+    cache.put("a", makeCoverage(100));
+    auto coverage = cache.get("a");
+    BOOST_REQUIRE(coverage);
+    BOOST_REQUIRE_EQUAL(coverage->size(), 1U);
+    BOOST_CHECK_EQUAL((*coverage)[0].chunkId, 100);
+    // empty key is never cached
+    cache.put("", makeCoverage(1));
+    BOOST_CHECK_EQUAL(cache.size(), 1U);
+    BOOST_CHECK_EQUAL(cache.getHits(), 1U);
+    BOOST_CHECK_EQUAL(cache.getMisses(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(Eviction) {
+    ChunkCoverageCache cache(2);
+    cache.put("a", makeCoverage(1));
+    cache.put("b", makeCoverage(2));
+    BOOST_CHECK(cache.get("a"));
+    cache.put("c", makeCoverage(3));
+    BOOST_CHECK_EQUAL(cache.size(), 2U);
+    BOOST_CHECK(cache.get("a"));
+    BOOST_CHECK(not cache.get("b"));
+    BOOST_CHECK(cache.get("c"));
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0U);
+
+    ChunkCoverageCache disabled(0);
+    disabled.put("a", makeCoverage(1));
+    BOOST_CHECK(not disabled.get("a"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
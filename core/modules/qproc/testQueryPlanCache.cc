@@ -0,0 +1,197 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+ /**
+  * @file
+  *
+  * @brief Test QueryPlanCache and QuerySession::bindParams().
+  *
+  */
+
+// System headers
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Boost unit test header
+#define BOOST_TEST_MODULE QueryPlanCache
+#include "boost/test/included/unit_test.hpp"
+
+// Qserv headers
+#include "qproc/QueryPlanCache.h"
+#include "query/Constraint.h"
+#include "query/SelectStmt.h"
+#include "tests/QueryAnaFixture.h"
+
+namespace test = boost::test_tools;
+
+using lsst::qserv::StringVector;
+using lsst::qserv::qproc::QueryPlanCache;
+using lsst::qserv::qproc::QuerySession;
+using lsst::qserv::tests::QueryAnaFixture;
+
+namespace {
+
+std::string m(std::size_t i) {
+    return QueryPlanCache::paramMarker(i);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(Suite)
+
+BOOST_AUTO_TEST_CASE(Parameterize) {
+    std::string shape;
+    StringVector literals;
+    BOOST_CHECK(QueryPlanCache::parameterize(
+        "SELECT ra, 2*decl FROM  Object\n WHERE objectId IN(386950783579546,  -12) LIMIT 10",
+        shape, literals));
+    BOOST_CHECK_EQUAL(shape, "SELECT ra, 2*decl FROM Object WHERE objectId IN(" + m(0) + ", " + m(1)
+                      + ") LIMIT 10");
+    BOOST_CHECK_EQUAL(literals.size(), 2U);
+    BOOST_CHECK_EQUAL(literals[0], "386950783579546");
+    BOOST_CHECK_EQUAL(literals[1], "-12");
+
+    BOOST_CHECK(QueryPlanCache::parameterize(
+        "select * from Object where qserv_areaspec_box(359.1, -3.16e-1, 359.2,3.17) "
+        "and flux-1 > .5 and name like 'a''b\\'c' and `col 2` = \"x\" order by flux",
+        shape, literals));
+    BOOST_CHECK_EQUAL(shape, "select * from Object where qserv_areaspec_box(" + m(0) + ", " + m(1) + ", "
+                      + m(2) + "," + m(3) + ") and flux-" + m(4) + " > " + m(5) + " and name like "
+                      + m(6) + " and `col 2` = \"x\" order by flux");
+    StringVector expected = {"359.1", "-3.16e-1", "359.2", "3.17", "1", ".5", "'a''b\\'c'"};
+    BOOST_CHECK_EQUAL_COLLECTIONS(literals.begin(), literals.end(), expected.begin(), expected.end());
+
+    // Identifiers containing digits are not literals.
+    BOOST_CHECK(QueryPlanCache::parameterize("SELECT o1.x FROM Object_2 o1 WHERE o1.x2=3", shape, literals));
+    BOOST_CHECK_EQUAL(shape, "SELECT o1.x FROM Object_2 o1 WHERE o1.x2=" + m(0));
+
+    // Nothing to replace
+    BOOST_CHECK(!QueryPlanCache::parameterize("SELECT 1 FROM Object LIMIT 5", shape, literals));
+    // Markers in the query, comments, unterminated strings
+    BOOST_CHECK(!QueryPlanCache::parameterize("SELECT * FROM Object WHERE id=" + m(1), shape, literals));
+    BOOST_CHECK(!QueryPlanCache::parameterize("SELECT * FROM Object WHERE id=1 -- x", shape, literals));
+    BOOST_CHECK(!QueryPlanCache::parameterize("SELECT * FROM Object WHERE id='1", shape, literals));
+}
+
+BOOST_AUTO_TEST_CASE(Markers) {
+    BOOST_CHECK_EQUAL(m(0).size(), m(99999).size());
+    BOOST_CHECK(QueryPlanCache::hasParamMarker("a IN(" + m(7) + ")"));
+    BOOST_CHECK(!QueryPlanCache::hasParamMarker("a IN(7)"));
+}
+
+BOOST_AUTO_TEST_CASE(GetPut) {
+    QueryPlanCache cache(2, std::chrono::seconds(100));
+    QuerySession::Test t;
+    t.cfgNum = 0;
+    t.defaultDb = "LSST";
+    QueryPlanCache::SessionPtr session = std::make_shared<QuerySession>(t);
+    QueryPlanCache::SessionPtr found;
+
+    BOOST_CHECK(!cache.get("a", found));
+    cache.put("a", session);
+    cache.put("b", QueryPlanCache::SessionPtr());
+    BOOST_CHECK(cache.get("a", found));
+    BOOST_CHECK(found == session);
+    // Shapes that can not be cached are remembered as null sessions.
+    BOOST_CHECK(cache.get("b", found));
+    BOOST_CHECK(!found);
+    BOOST_CHECK(cache.get("a", found));
+    // "b" is the least recently used.
+    cache.put("c", session);
+    BOOST_CHECK_EQUAL(cache.size(), 2U);
+    BOOST_CHECK(!cache.get("b", found));
+    BOOST_CHECK(cache.get("c", found));
+    BOOST_CHECK_EQUAL(cache.getHits(), 4U);
+    BOOST_CHECK_EQUAL(cache.getMisses(), 2U);
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0U);
+    BOOST_CHECK(!cache.get("a", found));
+    BOOST_CHECK(QueryPlanCache::makeKey("1", "LSST", "x") != QueryPlanCache::makeKey("1", "", "x"));
+    BOOST_CHECK(QueryPlanCache::makeKey("1", "LSST", "x") != QueryPlanCache::makeKey("2", "LSST", "x"));
+}
+
+BOOST_AUTO_TEST_CASE(Lifetime) {
+    QueryPlanCache cache(10, std::chrono::seconds(0));
+    QueryPlanCache::SessionPtr found;
+    cache.put("a", QueryPlanCache::SessionPtr());
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    BOOST_CHECK(!cache.get("a", found));
+    BOOST_CHECK_EQUAL(cache.size(), 0U);
+
+    QueryPlanCache disabled(0, std::chrono::seconds(100));
+    disabled.put("a", QueryPlanCache::SessionPtr());
+    BOOST_CHECK(!disabled.get("a", found));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(Bind, QueryAnaFixture)
+
+BOOST_AUTO_TEST_CASE(BindMatchesAnalysis) {
+    std::vector<std::string> const queries = {
+        "select * from Object where objectIdObjTest in (2,3145,9999);",
+        "SELECT COUNT(*) AS N FROM Source WHERE objectId IN(386950783579546, 386942193651348);",
+        "select * from LSST.Object WHERE ra_PS BETWEEN 150 AND 150.2 and decl_PS between 1.6 and 1.7 limit 2;",
+        "select count(*) from Object where qserv_areaspec_box(359.1, 3.16, 359.2,3.17);",
+        "SELECT count(*), sum(Source.flux), flux2, Source.flux3 from Source "
+            "where qserv_areaspec_box(0,0,1,1) and flux4=2 and Source.flux5=3;"
+    };
+    for (auto const& query : queries) {
+        std::string shape;
+        StringVector params;
+        BOOST_REQUIRE(QueryPlanCache::parameterize(query, shape, params));
+        auto plan = queryAnaHelper.buildQuerySession(qsTest, shape);
+        BOOST_REQUIRE_MESSAGE(plan->getError().empty(), plan->getError());
+        auto bound = plan->bindParams(query, params);
+        BOOST_REQUIRE(bound);
+        BOOST_CHECK_EQUAL(bound->getOriginal(), query);
+
+        auto constraints = bound->getConstraints();
+        auto expected = queryAnaHelper.getInternalQueries(qsTest, query);
+        auto expectedConstraints = queryAnaHelper.querySession->getConstraints();
+        queryAnaHelper.querySession = bound;
+        BOOST_CHECK_EQUAL(queryAnaHelper.buildFirstParallelQuery(), expected[0]);
+        if (bound->needsMerge()) {
+            BOOST_CHECK_EQUAL(bound->getMergeStmt()->getQueryTemplate().sqlFragment(), expected[1]);
+        }
+        BOOST_CHECK_EQUAL(bound->getProxyOrderBy(), expected[2]);
+
+        BOOST_REQUIRE_EQUAL(static_cast<bool>(constraints), static_cast<bool>(expectedConstraints));
+        if (constraints) {
+            BOOST_REQUIRE_EQUAL(constraints->size(), expectedConstraints->size());
+            for (std::size_t i = 0; i < constraints->size(); ++i) {
+                BOOST_CHECK_EQUAL((*constraints)[i].name, (*expectedConstraints)[i].name);
+                BOOST_CHECK_EQUAL_COLLECTIONS((*constraints)[i].params.begin(), (*constraints)[i].params.end(),
+                                              (*expectedConstraints)[i].params.begin(),
+                                              (*expectedConstraints)[i].params.end());
+            }
+        }
+        // The cached session is left untouched.
+        BOOST_CHECK(QueryPlanCache::hasParamMarker(plan->makeQueryTemplates()[0].sqlFragment()));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
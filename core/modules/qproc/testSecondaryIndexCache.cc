@@ -0,0 +1,137 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+ /**
+  * @file
+  *
+  * @brief Test SecondaryIndexCache.
+  *
+  */
+
+// System headers
+#include <string>
+#include <thread>
+#include <vector>
+
+// Qserv headers
+#include "qproc/SecondaryIndexCache.h"
+
+// Boost unit test header
+#define BOOST_TEST_MODULE SecondaryIndexCache
+#include "boost/test/included/unit_test.hpp"
+
+namespace test = boost::test_tools;
+
+using lsst::qserv::StringVector;
+using lsst::qserv::qproc::SecondaryIndexCache;
+
+BOOST_AUTO_TEST_SUITE(Suite)
+
+BOOST_AUTO_TEST_CASE(GetPut) {
+    SecondaryIndexCache cache(10);
+    SecondaryIndexCache::LocationVector found;
+    StringVector missing = cache.get("qservMeta.LSST__Object", {"1", "2"}, found);
+    BOOST_CHECK(found.empty());
+    BOOST_CHECK_EQUAL(missing.size(), 2U);
+    cache.put("qservMeta.LSST__Object", "1", SecondaryIndexCache::Location(100, 3));
+    missing = cache.get("qservMeta.LSST__Object", {" 1 ", "2"}, found);
+    BOOST_REQUIRE_EQUAL(found.size(), 1U);
+    BOOST_CHECK_EQUAL(found[0].chunkId, 100);
+    BOOST_CHECK_EQUAL(found[0].subChunkId, 3);
+    BOOST_REQUIRE_EQUAL(missing.size(), 1U);
+    BOOST_CHECK_EQUAL(missing[0], "2");
+    // Keys of different index tables do not mix.
+    found.clear();
+    missing = cache.get("qservMeta.LSST__Source", {"1"}, found);
+    BOOST_CHECK(found.empty());
+    BOOST_CHECK_EQUAL(cache.getHits(), 1U);
+    BOOST_CHECK_EQUAL(cache.getMisses(), 4U);
+}
+
+BOOST_AUTO_TEST_CASE(NormalizeKey) {
+    BOOST_CHECK_EQUAL(SecondaryIndexCache::normalizeKey(" 386942193651348 "), "386942193651348");
+    BOOST_CHECK_EQUAL(SecondaryIndexCache::normalizeKey("'abc'"), "abc");
+    BOOST_CHECK_EQUAL(SecondaryIndexCache::normalizeKey("\"abc\""), "abc");
+    BOOST_CHECK_EQUAL(SecondaryIndexCache::normalizeKey("'"), "'");
+    BOOST_CHECK_EQUAL(SecondaryIndexCache::normalizeKey("  "), "");
+}
+
+BOOST_AUTO_TEST_CASE(NormalizedPut) {
+    // Keys are normalized when stored too, e.g. string keys returned with
+    // trailing blanks.
+    SecondaryIndexCache cache(10);
+    SecondaryIndexCache::LocationVector found;
+    cache.put("qservMeta.LSST__Object", "abc ", SecondaryIndexCache::Location(100, 3));
+    StringVector missing = cache.get("qservMeta.LSST__Object", {"'abc'"}, found);
+    BOOST_CHECK(missing.empty());
+    BOOST_REQUIRE_EQUAL(found.size(), 1U);
+    BOOST_CHECK_EQUAL(found[0].chunkId, 100);
+}
+
+BOOST_AUTO_TEST_CASE(Eviction) {
+    SecondaryIndexCache cache(3);
+    for (int i = 0; i < 3; ++i) {
+        cache.put("t", std::to_string(i), SecondaryIndexCache::Location(i, i));
+    }
+    SecondaryIndexCache::LocationVector found;
+    cache.get("t", {"0"}, found); // "0" becomes the most recently used.
+    cache.put("t", "3", SecondaryIndexCache::Location(3, 3));
+    BOOST_CHECK_EQUAL(cache.size(), 3U);
+    found.clear();
+    StringVector missing = cache.get("t", {"0", "1", "2", "3"}, found);
+    BOOST_REQUIRE_EQUAL(missing.size(), 1U);
+    BOOST_CHECK_EQUAL(missing[0], "1");
+    BOOST_CHECK_EQUAL(found.size(), 3U);
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(Disabled) {
+    SecondaryIndexCache cache(0);
+    cache.put("t", "1", SecondaryIndexCache::Location(1, 1));
+    SecondaryIndexCache::LocationVector found;
+    StringVector missing = cache.get("t", {"1"}, found);
+    BOOST_CHECK(found.empty());
+    BOOST_CHECK_EQUAL(missing.size(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(Threads) {
+    SecondaryIndexCache cache(1000);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t]() {
+            for (int i = 0; i < 500; ++i) {
+                std::string key = std::to_string(t*500 + i);
+                cache.put("t", key, SecondaryIndexCache::Location(t, i));
+                SecondaryIndexCache::LocationVector found;
+                cache.get("t", {key}, found);
+            }
+        });
+    }
+    for (auto& thrd : threads) {
+        thrd.join();
+    }
+    BOOST_CHECK_EQUAL(cache.size(), 1000U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
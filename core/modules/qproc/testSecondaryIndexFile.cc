@@ -0,0 +1,203 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+ /**
+  * @file
+  *
+  * @brief Test SecondaryIndexFile and the SecondaryIndex file backend.
+  *
+  */
+
+// System headers
+#include <cstdint>
+#include <cstdio>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// Qserv headers
+#include "mysql/MySqlConfig.h"
+#include "qproc/ChunkSpec.h"
+#include "qproc/QueryProcessingError.h"
+#include "qproc/SecondaryIndex.h"
+#include "qproc/SecondaryIndexFile.h"
+#include "query/Constraint.h"
+
+// Boost unit test header
+#define BOOST_TEST_MODULE SecondaryIndexFile
+#include "boost/test/included/unit_test.hpp"
+
+namespace test = boost::test_tools;
+
+using lsst::qserv::qproc::ChunkSpecVector;
+using lsst::qserv::qproc::QueryProcessingError;
+using lsst::qserv::qproc::SecondaryIndex;
+using lsst::qserv::qproc::SecondaryIndexFile;
+
+struct Fixture {
+
+    Fixture() {
+        char tmpl[] = "/tmp/testSecondaryIndexFile.XXXXXX";
+        dir = ::mkdtemp(tmpl);
+        path = dir + "/LSST__Object.sidx";
+        // Unevenly spaced keys, written out of order.
+        std::vector<SecondaryIndexFile::Record> records;
+        for (std::int64_t i = 999; i >= 0; --i) {
+            std::int64_t key = (i < 500) ? 3*i : 1000000 + i*i;
+            records.push_back({key, int(1000 + i/100), int(i%10)});
+        }
+        SecondaryIndexFile::write(path, records);
+    }
+    ~Fixture() {
+        std::remove(path.c_str());
+        ::rmdir(dir.c_str());
+    }
+
+    std::string dir;
+    std::string path;
+};
+
+BOOST_FIXTURE_TEST_SUITE(Suite, Fixture)
+
+BOOST_AUTO_TEST_CASE(Find) {
+    SecondaryIndexFile file(path);
+    BOOST_CHECK_EQUAL(file.size(), 1000U);
+    for (std::int64_t i = 0; i < 1000; ++i) {
+        std::int64_t key = (i < 500) ? 3*i : 1000000 + i*i;
+        auto r = file.find(key);
+        BOOST_REQUIRE(r != nullptr);
+        BOOST_CHECK_EQUAL(r->key, key);
+        BOOST_CHECK_EQUAL(r->chunkId, 1000 + i/100);
+        BOOST_CHECK_EQUAL(r->subChunkId, i%10);
+    }
+    BOOST_CHECK(file.find(1) == nullptr);
+    BOOST_CHECK(file.find(-5) == nullptr);
+    BOOST_CHECK(file.find(1000000 + 999*999 + 1) == nullptr);
+    BOOST_CHECK(file.find(1000000 + 600*600 + 1) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Range) {
+    SecondaryIndexFile file(path);
+    auto range = file.range(3, 30);
+    BOOST_CHECK_EQUAL(range.second - range.first, 10);
+    BOOST_CHECK_EQUAL(range.first->key, 3);
+    range = file.range(1400, 1000000 + 501*501);
+    BOOST_CHECK_EQUAL(range.second - range.first, 35);
+    range = file.range(30, 3);
+    BOOST_CHECK(range.first == range.second);
+}
+
+BOOST_AUTO_TEST_CASE(BadFile) {
+    BOOST_CHECK_THROW(SecondaryIndexFile(dir + "/missing.sidx"), QueryProcessingError);
+    std::string bad = dir + "/bad.sidx";
+    FILE* f = std::fopen(bad.c_str(), "w");
+    std::fputs("this is not an index file, not at all", f);
+    std::fclose(f);
+    BOOST_CHECK_THROW(SecondaryIndexFile{bad}, QueryProcessingError);
+
+    // record count so large that the size computation would overflow
+    SecondaryIndexFile::write(bad, {{1, 2, 3}});
+    f = std::fopen(bad.c_str(), "r+");
+    std::uint64_t const count = 0x1000000000000001ULL;
+    std::fseek(f, 16, SEEK_SET);
+    std::fwrite(&count, sizeof(count), 1, f);
+    std::fclose(f);
+    BOOST_CHECK_THROW(SecondaryIndexFile{bad}, QueryProcessingError);
+    std::remove(bad.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(LargeKeys) {
+    // Keys this large differ by less than the precision of a double.
+    std::string large = dir + "/large.sidx";
+    std::int64_t const base = 0x7ffffffffffff000LL;
+    std::vector<SecondaryIndexFile::Record> records;
+    for (std::int64_t i = 0; i < 100; ++i) {
+        records.push_back({base + i, int(i), 0});
+    }
+    SecondaryIndexFile::write(large, records);
+    SecondaryIndexFile file(large);
+    for (std::int64_t i = 0; i < 100; ++i) {
+        auto r = file.find(base + i);
+        BOOST_REQUIRE(r != nullptr);
+        BOOST_CHECK_EQUAL(r->chunkId, i);
+    }
+    BOOST_CHECK(file.find(base + 100) == nullptr);
+    std::remove(large.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(Backend) {
+    // All constraints are on a table with an index file, so the mysql
+    // backend is never used.
+    SecondaryIndex si(lsst::qserv::mysql::MySqlConfig(), 0, 1, dir);
+    lsst::qserv::query::Constraint in;
+    in.name = "sIndex";
+    in.params = {"LSST", "Object", "objectId", "0", "3", "'1251001'", "7"};
+    lsst::qserv::query::ConstraintVector cv = {in};
+    ChunkSpecVector csv = si.lookup(cv);
+    BOOST_REQUIRE_EQUAL(csv.size(), 2U);
+    BOOST_CHECK_EQUAL(csv[0].chunkId, 1000);
+    BOOST_CHECK_EQUAL(csv[0].subChunks.size(), 2U);
+    BOOST_CHECK_EQUAL(csv[1].chunkId, 1005);
+
+    lsst::qserv::query::Constraint between;
+    between.name = "sIndexBetween";
+    between.params = {"LSST", "Object", "objectId", "0", "599"};
+    cv = {between};
+    csv = si.lookup(cv);
+    BOOST_REQUIRE_EQUAL(csv.size(), 2U);
+    BOOST_CHECK_EQUAL(csv[0].chunkId, 1000);
+    BOOST_CHECK_EQUAL(csv[1].chunkId, 1001);
+
+    BOOST_CHECK_THROW(si.lookup(lsst::qserv::query::ConstraintVector()),
+                      SecondaryIndex::NoIndexConstraint);
+}
+
+BOOST_AUTO_TEST_CASE(BackendReload) {
+    SecondaryIndex si(lsst::qserv::mysql::MySqlConfig(), 0, 1, dir);
+    lsst::qserv::query::Constraint in;
+    in.name = "sIndex";
+    in.params = {"LSST", "Object", "objectId", "3"};
+    lsst::qserv::query::ConstraintVector cv = {in};
+    ChunkSpecVector csv = si.lookup(cv);
+    BOOST_REQUIRE_EQUAL(csv.size(), 1U);
+    BOOST_CHECK_EQUAL(csv[0].chunkId, 1000);
+
+    // Replace the file, as a loader would, the new one must be used.
+    std::string tmp = dir + "/LSST__Object.sidx.tmp";
+    SecondaryIndexFile::write(tmp, {{3, 2000, 4}, {5, 2001, 1}});
+    BOOST_REQUIRE_EQUAL(std::rename(tmp.c_str(), path.c_str()), 0);
+    csv = si.lookup(cv);
+    BOOST_REQUIRE_EQUAL(csv.size(), 1U);
+    BOOST_CHECK_EQUAL(csv[0].chunkId, 2000);
+
+    // Clearing must keep lookups working, the file is just mapped again.
+    si.clear();
+    in.params = {"LSST", "Object", "objectId", "5"};
+    cv = {in};
+    csv = si.lookup(cv);
+    BOOST_REQUIRE_EQUAL(csv.size(), 1U);
+    BOOST_CHECK_EQUAL(csv[0].chunkId, 2001);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
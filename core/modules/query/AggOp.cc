@@ -39,6 +39,7 @@
 // Third-party headers
 
 // Qserv headers
+#include "query/Arena.h"
 #include "query/FuncExpr.h"
 #include "query/ValueExpr.h"
 #include "query/ValueFactor.h"
@@ -57,7 +58,7 @@ public:
     explicit PassAggOp(AggOp::Mgr& mgr) : AggOp(mgr) {}
 
     virtual AggRecord::Ptr operator()(ValueFactor const& orig) {
-        AggRecord::Ptr arp = std::make_shared<AggRecord>();
+        AggRecord::Ptr arp = makeShared<AggRecord>();
         arp->orig = orig.clone();
         arp->parallel.push_back(ValueExpr::newSimple(orig.clone()));
         arp->merge = orig.clone();
@@ -72,7 +73,7 @@ public:
     explicit CountAggOp(AggOp::Mgr& mgr) : AggOp(mgr) {}
 
     virtual AggRecord::Ptr operator()(ValueFactor const& orig) {
-        AggRecord::Ptr arp = std::make_shared<AggRecord>();
+        AggRecord::Ptr arp = makeShared<AggRecord>();
         std::string interName = _mgr.getAggName("COUNT");
         arp->orig = orig.clone();
         std::shared_ptr<FuncExpr> fe;
@@ -104,7 +105,7 @@ public:
     }
 
     virtual AggRecord::Ptr operator()(ValueFactor const& orig) {
-        AggRecord::Ptr arp = std::make_shared<AggRecord>();
+        AggRecord::Ptr arp = makeShared<AggRecord>();
         std::string interName = _mgr.getAggName(accName);
         arp->orig = orig.clone();
         std::shared_ptr<FuncExpr> fe;
@@ -131,7 +132,7 @@ public:
 
     virtual AggRecord::Ptr operator()(ValueFactor const& orig) {
 
-        AggRecord::Ptr arp = std::make_shared<AggRecord>();
+        AggRecord::Ptr arp = makeShared<AggRecord>();
         arp->orig = orig.clone();
         // Parallel: get each aggregation subterm.
         std::shared_ptr<FuncExpr> fe;
@@ -153,7 +154,7 @@ public:
         std::shared_ptr<FuncExpr> feCount;
         feSum = FuncExpr::newArg1("SUM", sAlias);
         feCount = FuncExpr::newArg1("SUM", cAlias);
-        ve = std::make_shared<ValueExpr>();
+        ve = makeShared<ValueExpr>();
         ve->setAlias(orig.getAlias());
         ValueExpr::FactorOpVector& factorOps = ve->getFactorOps();
         factorOps.clear();
@@ -0,0 +1,76 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "query/Arena.h"
+
+// System headers
+#include <cstdint>
+
+namespace {
+
+thread_local lsst::qserv::query::Arena::Ptr currentArena;
+
+} // namespace
+
+namespace lsst {
+namespace qserv {
+namespace query {
+
+Arena::Scope::Scope(Ptr const& arena) : _previous(currentArena) {
+    currentArena = arena;
+}
+
+Arena::Scope::~Scope() {
+    currentArena = std::move(_previous);
+}
+
+Arena::Ptr const& Arena::current() {
+    return currentArena;
+}
+
+void* Arena::allocate(std::size_t bytes, std::size_t alignment) {
+    ++_allocations;
+    if (bytes > _blockSize/4) {
+        // Large allocations get a block of their own, so that the free
+        // space of the current block is not wasted.
+        _blocks.emplace_back(new char[bytes]);
+        _bytes += bytes;
+        return _blocks.back().get();
+    }
+    std::size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(_next) % alignment) % alignment;
+    if (padding + bytes > _left) {
+        // Blocks from new[] are aligned for any fundamental type.
+        _blocks.emplace_back(new char[_blockSize]);
+        _bytes += _blockSize;
+        _next = _blocks.back().get();
+        _left = _blockSize;
+        padding = 0;
+    }
+    char* p = _next + padding;
+    _next = p + bytes;
+    _left -= padding + bytes;
+    return p;
+}
+
+}}} // namespace lsst::qserv::query
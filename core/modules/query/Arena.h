@@ -0,0 +1,133 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef LSST_QSERV_QUERY_ARENA_H
+#define LSST_QSERV_QUERY_ARENA_H
+/**
+  * @file
+  *
+  * @brief Arena is a bump allocator holding the IR nodes of one query.
+  *
+  */
+
+// System headers
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace lsst {
+namespace qserv {
+namespace query {
+
+/// Arena hands out memory from large blocks and never reuses it, the blocks
+/// are released together when the Arena is destroyed. Analysis of a query
+/// allocates many small IR nodes which live until the query is done, an
+/// Arena makes each of these allocations a pointer increment.
+///
+/// An Arena is made current for a thread by an Arena::Scope, while it is
+/// current makeShared() allocates from it. Nodes allocated this way keep
+/// their Arena alive, so they may outlive the Scope and be released from any
+/// thread. Allocation itself is not thread-safe, an Arena should only be
+/// current in one thread at a time.
+class Arena {
+public:
+    typedef std::shared_ptr<Arena> Ptr;
+
+    /// Sets the current Arena of the thread, restores the previous one when destroyed.
+    class Scope {
+    public:
+        explicit Scope(Ptr const& arena);
+        ~Scope();
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+    private:
+        Ptr _previous;
+    };
+
+    /// @param blockSize: Size of the blocks memory is taken from, larger
+    ///                   allocations get a block of their own.
+    explicit Arena(std::size_t blockSize=64*1024) : _blockSize(blockSize) {}
+
+    Arena(Arena const&) = delete;
+    Arena& operator=(Arena const&) = delete;
+
+    /// @return memory for 'bytes' bytes aligned to 'alignment'.
+    void* allocate(std::size_t bytes, std::size_t alignment);
+
+    /// @return total size of the blocks.
+    std::size_t getBytes() const { return _bytes; }
+
+    /// @return number of allocations so far.
+    std::size_t getAllocations() const { return _allocations; }
+
+    /// @return Arena allocations of this thread go to, null pointer if none.
+    static Ptr const& current();
+
+private:
+    std::size_t const _blockSize;
+    std::vector<std::unique_ptr<char[]>> _blocks;
+    char* _next{nullptr};   ///< Free space in the latest block
+    std::size_t _left{0};   ///< Size of the free space
+    std::size_t _bytes{0};
+    std::size_t _allocations{0};
+};
+
+/// Standard allocator taking memory from an Arena, deallocation is a no-op.
+template <typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    explicit ArenaAllocator(Arena::Ptr const& arena) : _arena(arena) {}
+    template <typename U>
+    ArenaAllocator(ArenaAllocator<U> const& other) : _arena(other._arena) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(_arena->allocate(n*sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, std::size_t) {}
+
+    template <typename U>
+    bool operator==(ArenaAllocator<U> const& other) const { return _arena == other._arena; }
+    template <typename U>
+    bool operator!=(ArenaAllocator<U> const& other) const { return _arena != other._arena; }
+
+private:
+    template <typename U> friend class ArenaAllocator;
+    Arena::Ptr _arena; ///< Keeps the memory of the allocated objects alive
+};
+
+/// Replacement for std::make_shared for IR nodes, allocating from the
+/// current Arena of the thread if there is one.
+template <typename T, typename... Args>
+std::shared_ptr<T> makeShared(Args&&... args) {
+    Arena::Ptr const& arena = Arena::current();
+    if (arena) {
+        return std::allocate_shared<T>(ArenaAllocator<T>(arena), std::forward<Args>(args)...);
+    }
+    return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+}}} // namespace lsst::qserv::query
+
+#endif // LSST_QSERV_QUERY_ARENA_H
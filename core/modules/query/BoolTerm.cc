@@ -42,6 +42,7 @@
 #include "lsst/log/Log.h"
 
 // Qserv headers
+#include "query/Arena.h"
 #include "query/Predicate.h"
 #include "query/QueryTemplate.h"
 #include "query/ValueExpr.h"
@@ -187,7 +188,7 @@ bool BoolFactor::_reduceTerms(BoolFactorTerm::PtrVector& newTerms,
                     } else {
                         // still a reduction in the term, replace
                         std::shared_ptr<BoolTermFactor> newBtf;
-                        newBtf = std::make_shared<BoolTermFactor>();
+                        newBtf = makeShared<BoolTermFactor>();
                         newBtf->_term = reduced;
                         newTerms.push_back(newBtf);
                         hasReduction = true;
@@ -270,22 +271,22 @@ namespace {
 } // anonymous namespace
 
 std::shared_ptr<BoolTerm> OrTerm::clone() const {
-    std::shared_ptr<OrTerm> ot = std::make_shared<OrTerm>();
+    std::shared_ptr<OrTerm> ot = makeShared<OrTerm>();
     copyTerms<BoolTerm::PtrVector, deepCopy>(ot->_terms, _terms);
     return ot;
 }
 std::shared_ptr<BoolTerm> AndTerm::clone() const {
-    std::shared_ptr<AndTerm> t = std::make_shared<AndTerm>();
+    std::shared_ptr<AndTerm> t = makeShared<AndTerm>();
     copyTerms<BoolTerm::PtrVector, deepCopy>(t->_terms, _terms);
     return t;
 }
 std::shared_ptr<BoolTerm> BoolFactor::clone() const {
-    std::shared_ptr<BoolFactor> t = std::make_shared<BoolFactor>();
+    std::shared_ptr<BoolFactor> t = makeShared<BoolFactor>();
     copyTerms<BoolFactorTerm::PtrVector, deepCopy>(t->_terms, _terms);
     return t;
 }
 std::shared_ptr<BoolTerm> UnknownTerm::clone() const {
-    return  std::make_shared<UnknownTerm>(); // TODO what is unknown now?
+    return  makeShared<UnknownTerm>(); // TODO what is unknown now?
 }
 BoolFactorTerm::Ptr PassListTerm::clone() const {
     PassListTerm* p = new PassListTerm;
@@ -299,17 +300,17 @@ BoolFactorTerm::Ptr BoolTermFactor::clone() const {
 }
 // copySyntax
 std::shared_ptr<BoolTerm> OrTerm::copySyntax() const {
-    std::shared_ptr<OrTerm> ot = std::make_shared<OrTerm>();
+    std::shared_ptr<OrTerm> ot = makeShared<OrTerm>();
     copyTerms<BoolTerm::PtrVector, syntaxCopy>(ot->_terms, _terms);
     return ot;
 }
 std::shared_ptr<BoolTerm> AndTerm::copySyntax() const {
-    std::shared_ptr<AndTerm> at = std::make_shared<AndTerm>();
+    std::shared_ptr<AndTerm> at = makeShared<AndTerm>();
     copyTerms<BoolTerm::PtrVector, syntaxCopy>(at->_terms, _terms);
     return at;
 }
 std::shared_ptr<BoolTerm> BoolFactor::copySyntax() const {
-    std::shared_ptr<BoolFactor> bf = std::make_shared<BoolFactor>();
+    std::shared_ptr<BoolFactor> bf = makeShared<BoolFactor>();
     copyTerms<BoolFactorTerm::PtrVector, syntaxCopy>(bf->_terms, _terms);
     return bf;
 }
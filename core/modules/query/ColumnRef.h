@@ -37,6 +37,9 @@
 
 // Third-party headers
 
+// Qserv headers
+#include "query/Arena.h"
+
 namespace lsst {
 namespace qserv {
 namespace query {
@@ -54,7 +57,7 @@ public:
     static Ptr newShared(std::string const& db_,
                          std::string const& table_,
                          std::string const& column_) {
-        return std::make_shared<ColumnRef>(db_, table_, column_);
+        return makeShared<ColumnRef>(db_, table_, column_);
     }
 
     std::string db;
@@ -37,6 +37,9 @@
 
 // Third-party headers
 
+// Qserv headers
+#include "query/Arena.h"
+
 namespace lsst {
 namespace qserv {
 namespace query {
@@ -110,9 +113,9 @@ FromList::renderTo(QueryTemplate& qt) const {
 
 std::shared_ptr<FromList>
 FromList::copySyntax() {
-    std::shared_ptr<FromList> newL = std::make_shared<FromList>(*this);
+    std::shared_ptr<FromList> newL = makeShared<FromList>(*this);
     // Shallow copy of expr list is okay.
-    newL->_tableRefs  = std::make_shared<TableRefList>(*_tableRefs);
+    newL->_tableRefs  = makeShared<TableRefList>(*_tableRefs);
     // For the other fields, default-copied versions are okay.
     return newL;
 }
@@ -120,9 +123,9 @@ FromList::copySyntax() {
 std::shared_ptr<FromList>
 FromList::clone() const {
     typedef TableRefList::const_iterator Iter;
-    std::shared_ptr<FromList> newL = std::make_shared<FromList>(*this);
+    std::shared_ptr<FromList> newL = makeShared<FromList>(*this);
 
-    newL->_tableRefs = std::make_shared<TableRefList>();
+    newL->_tableRefs = makeShared<TableRefList>();
 
     for(Iter i=_tableRefs->begin(), e=_tableRefs->end(); i != e; ++ i) {
         newL->_tableRefs->push_back((*i)->clone());
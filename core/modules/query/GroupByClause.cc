@@ -40,6 +40,7 @@
 // Third-party headers
 
 // Qserv headers
+#include "query/Arena.h"
 #include "query/QueryTemplate.h"
 #include "query/ValueExpr.h"
 
@@ -111,14 +112,14 @@ GroupByTerm callClone(GroupByTerm const& t) {
 }
 
 std::shared_ptr<GroupByClause> GroupByClause::clone() const {
-    GroupByClause::Ptr p = std::make_shared<GroupByClause>();
+    GroupByClause::Ptr p = makeShared<GroupByClause>();
     std::transform(_terms->begin(), _terms->end(),
                    std::back_inserter(*p->_terms), callClone);
     return p;
 }
 
 std::shared_ptr<GroupByClause> GroupByClause::copySyntax() {
-    return std::make_shared<GroupByClause>(*this);
+    return makeShared<GroupByClause>(*this);
 }
 
 void GroupByClause::findValueExprs(ValueExprPtrVector& list) {
@@ -37,12 +37,14 @@
 #include <string>
 
 // Local headers
+#include "query/Arena.h"
 #include "query/typedefs.h"
 
 // Forward declarations
 namespace lsst {
 namespace qserv {
 namespace parser {
+    class FastSelectParser;
     class ModFactory;
 }
 
@@ -80,7 +82,7 @@ public:
     typedef std::shared_ptr<GroupByClause> Ptr;
     typedef std::deque<GroupByTerm> List;
 
-    GroupByClause() : _terms(std::make_shared<List>()) {}
+    GroupByClause() : _terms(makeShared<List>()) {}
     ~GroupByClause() {}
 
     std::string getGenerated();
@@ -92,6 +94,7 @@ public:
 
 private:
     friend std::ostream& operator<<(std::ostream& os, GroupByClause const& gc);
+    friend class parser::FastSelectParser;
     friend class parser::ModFactory;
 
     void _addTerm(GroupByTerm const& t) { _terms->push_back(t); }
@@ -37,6 +37,7 @@
 // Third-party headers
 
 // Qserv headers
+#include "query/Arena.h"
 #include "query/BoolTerm.h"
 #include "query/QueryTemplate.h"
 
@@ -70,7 +71,7 @@ HavingClause::renderTo(QueryTemplate& qt) const {
 
 std::shared_ptr<HavingClause>
 HavingClause::clone() const {
-    std::shared_ptr<HavingClause> hc = std::make_shared<HavingClause>();
+    std::shared_ptr<HavingClause> hc = makeShared<HavingClause>();
     if (_tree) {
         hc->_tree = _tree->clone();
     }
@@ -79,7 +80,7 @@ HavingClause::clone() const {
 
 std::shared_ptr<HavingClause>
 HavingClause::copySyntax() {
-    return std::make_shared<HavingClause>(*this);
+    return makeShared<HavingClause>(*this);
 }
 
 void
@@ -26,6 +26,9 @@
 
  // Third-party headers
 
+// Qserv headers
+#include "query/Arena.h"
+
 namespace lsst {
 namespace qserv {
 namespace query {
@@ -51,7 +54,7 @@ JoinRef::Ptr JoinRef::clone() const {
     if (_right) { r = _right->clone(); }
     JoinSpec::Ptr s;
     if (_spec) { s = _spec->clone(); }
-    return std::make_shared<JoinRef>(r, _joinType, _isNatural, s);
+    return makeShared<JoinRef>(r, _joinType, _isNatural, s);
 }
 
 void JoinRef::_putJoinTemplate(QueryTemplate& qt) const {
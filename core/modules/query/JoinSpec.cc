@@ -33,6 +33,7 @@
 // Third-party headers
 
 // Qserv headers
+#include "query/Arena.h"
 #include "query/BoolTerm.h"
 #include "query/ColumnRef.h"
 #include "query/QueryTemplate.h"
@@ -80,10 +81,10 @@ JoinSpec::Ptr JoinSpec::clone() const {
         throw std::logic_error("Can't clone JoinSpec with ON and USING");
     }
     if (_usingColumn) {
-        std::shared_ptr<ColumnRef> col = std::make_shared<ColumnRef>(*_usingColumn);
-        return std::make_shared<JoinSpec>(col);
+        std::shared_ptr<ColumnRef> col = makeShared<ColumnRef>(*_usingColumn);
+        return makeShared<JoinSpec>(col);
     } else {
-        return std::make_shared<JoinSpec>(_onTerm->copySyntax());
+        return makeShared<JoinSpec>(_onTerm->copySyntax());
     }
 
 }
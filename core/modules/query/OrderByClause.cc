@@ -42,6 +42,7 @@
 #include "lsst/log/Log.h"
 
 // Qserv headers
+#include "query/Arena.h"
 #include "query/QueryTemplate.h"
 #include "query/ValueExpr.h"
 
@@ -83,6 +84,12 @@ public:
 ////////////////////////////////////////////////////////////////////////
 // OrderByTerm
 ////////////////////////////////////////////////////////////////////////
+OrderByTerm::OrderByTerm(std::shared_ptr<ValueExpr> val,
+                         Order order,
+                         std::string collate)
+    : _expr(val), _order(order), _collate(collate) {
+}
+
 void
 OrderByTerm::renderTo(QueryTemplate& qt) const {
     ValueExpr::render r(qt, true);
@@ -151,10 +158,10 @@ OrderByClause::renderTo(QueryTemplate& qt) const {
 }
 
 std::shared_ptr<OrderByClause> OrderByClause::clone() const {
-    return std::make_shared<OrderByClause>(*this); // FIXME
+    return makeShared<OrderByClause>(*this); // FIXME
 }
 std::shared_ptr<OrderByClause> OrderByClause::copySyntax() {
-    return std::make_shared<OrderByClause>(*this);
+    return makeShared<OrderByClause>(*this);
 }
 
 void OrderByClause::findValueExprs(ValueExprPtrVector& list) {
@@ -37,6 +37,7 @@
 #include <string>
 
 // Local headers
+#include "query/Arena.h"
 #include "query/typedefs.h"
 
 namespace lsst {
@@ -87,7 +88,7 @@ public:
     typedef std::shared_ptr<OrderByClause> Ptr;
     typedef std::vector<OrderByTerm> OrderByTermVector;
 
-    OrderByClause() : _terms(std::make_shared<OrderByTermVector>()) {}
+    OrderByClause() : _terms(makeShared<OrderByTermVector>()) {}
     ~OrderByClause() {}
 
     std::string sqlFragment() const;
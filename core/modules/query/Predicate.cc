@@ -36,6 +36,7 @@
 #include <stdexcept>
 
 // Qserv headers
+#include "query/Arena.h"
 #include "query/QueryTemplate.h"
 #include "query/SqlSQL2Tokens.h" // (generated) SqlSQL2Tokens
 #include "query/ValueExpr.h"
@@ -206,7 +207,7 @@ namespace {
 }
 
 BoolFactorTerm::Ptr InPredicate::clone() const {
-    InPredicate::Ptr p  = std::make_shared<InPredicate>();
+    InPredicate::Ptr p  = makeShared<InPredicate>();
     if (value) p->value = value->clone();
     std::transform(cands.begin(), cands.end(),
                    std::back_inserter(p->cands),
@@ -215,7 +216,7 @@ BoolFactorTerm::Ptr InPredicate::clone() const {
 }
 
 BoolFactorTerm::Ptr BetweenPredicate::clone() const {
-    BetweenPredicate::Ptr p = std::make_shared<BetweenPredicate>();
+    BetweenPredicate::Ptr p = makeShared<BetweenPredicate>();
     if (value) p->value = value->clone();
     if (minValue) p->minValue = minValue->clone();
     if (maxValue) p->maxValue = maxValue->clone();
@@ -223,14 +224,14 @@ BoolFactorTerm::Ptr BetweenPredicate::clone() const {
 }
 
 BoolFactorTerm::Ptr LikePredicate::clone() const {
-    LikePredicate::Ptr p = std::make_shared<LikePredicate>();
+    LikePredicate::Ptr p = makeShared<LikePredicate>();
     if (value) p->value = value->clone();
     if (charValue) p->charValue = charValue->clone();
     return BoolFactorTerm::Ptr(p);
 }
 
 BoolFactorTerm::Ptr NullPredicate::clone() const {
-    NullPredicate::Ptr p = std::make_shared<NullPredicate>();
+    NullPredicate::Ptr p = makeShared<NullPredicate>();
     if (value) p->value = value->clone();
     p->hasNot = hasNot;
     return BoolFactorTerm::Ptr(p);
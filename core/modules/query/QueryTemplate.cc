@@ -45,6 +45,7 @@
 
 // Qserv headers
 #include "global/sqltoken.h" // sqlShouldSeparate
+#include "query/Arena.h"
 #include "query/ColumnRef.h"
 #include "query/TableRef.h"
 
@@ -121,13 +122,13 @@ std::ostream& operator<<(std::ostream& os, QueryTemplate const& queryTemplate) {
 
 
 void QueryTemplate::append(std::string const& s) {
-    std::shared_ptr<Entry> e = std::make_shared<StringEntry>(s);
+    std::shared_ptr<Entry> e = makeShared<StringEntry>(s);
     _entries.push_back(e);
 }
 
 
 void QueryTemplate::append(ColumnRef const& cr) {
-    std::shared_ptr<Entry> e = std::make_shared<ColumnEntry>(cr);
+    std::shared_ptr<Entry> e = makeShared<ColumnEntry>(cr);
     _entries.push_back(e);
 }
 
@@ -151,4 +152,16 @@ QueryTemplate::clear() {
     _entries.clear();
 }
 
+
+void QueryTemplate::replaceStrings(std::map<std::string, std::string> const& values) {
+    for (auto& entry : _entries) {
+        if (entry->isDynamic()) continue;
+        auto iter = values.find(entry->getValue());
+        if (iter != values.end()) {
+            // Entries may be shared with other templates, replace rather than modify.
+            entry = makeShared<StringEntry>(iter->second);
+        }
+    }
+}
+
 }}} // namespace lsst::qserv::query
@@ -29,6 +29,7 @@
   */
 
 // System headers
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -135,6 +136,10 @@ public:
     std::string generate(EntryMapping const& em) const;
     void clear();
 
+    /// Replace each non-dynamic entry whose value is a key of 'values' by
+    /// a string entry with the mapped value.
+    void replaceStrings(std::map<std::string, std::string> const& values);
+
     template <class T>
     static std::ostream& renderDbg(std::ostream& os, T const& t) {
         QueryTemplate qt;
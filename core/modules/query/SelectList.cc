@@ -55,6 +55,7 @@
 #include "lsst/log/Log.h"
 
 // Qserv headers
+#include "query/Arena.h"
 #include "query/QueryTemplate.h"
 #include "query/typedefs.h"
 #include "query/ValueFactor.h"
@@ -125,17 +126,17 @@ void SelectList::renderTo(QueryTemplate& qt) const {
 
 
 std::shared_ptr<SelectList> SelectList::clone() const {
-    std::shared_ptr<SelectList> newS = std::make_shared<SelectList>(*this);
-    newS->_valueExprList = std::make_shared<ValueExprPtrVector>();
+    std::shared_ptr<SelectList> newS = makeShared<SelectList>(*this);
+    newS->_valueExprList = makeShared<ValueExprPtrVector>();
     cloneValueExprPtrVector(*(newS->_valueExprList), *_valueExprList);
     // For the other fields, default-copied versions are okay.
     return newS;
 }
 
 std::shared_ptr<SelectList> SelectList::copySyntax() {
-    std::shared_ptr<SelectList> newS = std::make_shared<SelectList>(*this);
+    std::shared_ptr<SelectList> newS = makeShared<SelectList>(*this);
     // Shallow copy of expr list is okay.
-    newS->_valueExprList = std::make_shared<ValueExprPtrVector>(*_valueExprList);
+    newS->_valueExprList = makeShared<ValueExprPtrVector>(*_valueExprList);
     // For the other fields, default-copied versions are okay.
     return newS;
 }
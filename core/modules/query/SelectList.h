@@ -35,6 +35,7 @@
 
 // Local headers
 #include "global/stringTypes.h"
+#include "query/Arena.h"
 #include "query/ColumnRef.h"
 #include "query/ValueExpr.h"
 
@@ -64,7 +65,7 @@ class SelectList {
 public:
     typedef std::shared_ptr<SelectList> Ptr;
 
-    SelectList() : _valueExprList(std::make_shared<ValueExprPtrVector>()) {}
+    SelectList() : _valueExprList(makeShared<ValueExprPtrVector>()) {}
     ~SelectList() {}
     void addStar(std::string const& table);
     void dbgPrint(std::ostream& os) const;
@@ -46,6 +46,7 @@
 #include "lsst/log/Log.h"
 
 // Qserv headers
+#include "query/Arena.h"
 #include "query/FromList.h"
 #include "query/GroupByClause.h"
 #include "query/HavingClause.h"
@@ -133,7 +134,7 @@ SelectStmt::getWhere() const {
 
 std::shared_ptr<SelectStmt>
 SelectStmt::clone() const {
-    std::shared_ptr<SelectStmt> newS = std::make_shared<SelectStmt>(*this);
+    std::shared_ptr<SelectStmt> newS = makeShared<SelectStmt>(*this);
     // Starting from a shallow copy, make a copy of the syntax portion.
     cloneIf(newS->_fromList, _fromList);
     cloneIf(newS->_selectList, _selectList);
@@ -149,7 +150,7 @@ SelectStmt::clone() const {
 // reate a merge statement for current object
 std::shared_ptr<SelectStmt>
 SelectStmt::copyMerge() const {
-    std::shared_ptr<SelectStmt> newS = std::make_shared<SelectStmt>(*this);
+    std::shared_ptr<SelectStmt> newS = makeShared<SelectStmt>(*this);
     copySyntaxIf(newS->_selectList, _selectList);
     // Final sort has to be performed by final query on result table, launched by mysql-proxy.
     // This forces the final result to be in the right order (simple SELECT *
@@ -167,9 +168,9 @@ SelectStmt::copyMerge() const {
 }
 
 void SelectStmt::setFromListAsTable(std::string const& t) {
-    TableRefListPtr tr = std::make_shared<TableRefList>();
-    tr->push_back(std::make_shared<TableRef>("", t, ""));
-    _fromList = std::make_shared<FromList>(tr);
+    TableRefListPtr tr = makeShared<TableRefList>();
+    tr->push_back(makeShared<TableRef>("", t, ""));
+    _fromList = makeShared<FromList>(tr);
 }
 
 ////////////////////////////////////////////////////////////////////////
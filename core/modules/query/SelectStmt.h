@@ -43,6 +43,7 @@ class SqlSQL2Parser;
 namespace lsst {
 namespace qserv {
 namespace parser {
+    class FastSelectParser;
     class SelectFactory;
 }
 namespace query {
@@ -150,6 +151,7 @@ public:
 
  private:
     // Declarations
+    friend class parser::FastSelectParser;
     friend class parser::SelectFactory;
 
     // Fields
@@ -38,6 +38,7 @@
  // Third-party headers
 
 // Qserv headers
+#include "query/Arena.h"
 #include "query/JoinRef.h"
 #include "query/JoinSpec.h"
 
@@ -118,7 +119,7 @@ void TableRef::apply(TableRef::FuncC& f) const {
 }
 
 TableRef::Ptr TableRef::clone() const {
-    TableRef::Ptr newCopy = std::make_shared<TableRef>(_db, _table, _alias);
+    TableRef::Ptr newCopy = makeShared<TableRef>(_db, _table, _alias);
     std::transform(_joinRefs.begin(), _joinRefs.end(),
                    std::back_inserter(newCopy->_joinRefs), joinRefClone);
     return newCopy;
@@ -42,6 +42,7 @@
 #include <sstream>
 
 // Qserv headers
+#include "query/Arena.h"
 #include "query/ColumnRef.h"
 #include "query/FuncExpr.h"
 #include "query/QueryTemplate.h"
@@ -52,14 +53,14 @@ namespace qserv {
 namespace query {
 
 ValueFactorPtr ValueFactor::newColumnRefFactor(std::shared_ptr<ColumnRef const> cr) {
-    ValueFactorPtr term = std::make_shared<ValueFactor>();
+    ValueFactorPtr term = makeShared<ValueFactor>();
     term->_type = COLUMNREF;
-    term->_columnRef = std::make_shared<ColumnRef>(*cr);
+    term->_columnRef = makeShared<ColumnRef>(*cr);
     return term;
 }
 
 ValueFactorPtr ValueFactor::newStarFactor(std::string const& table) {
-    ValueFactorPtr term = std::make_shared<ValueFactor>();
+    ValueFactorPtr term = makeShared<ValueFactor>();
     term->_type = STAR;
     if (!table.empty()) {
         term->_tableStar = table;
@@ -67,14 +68,14 @@ ValueFactorPtr ValueFactor::newStarFactor(std::string const& table) {
     return term;
 }
 ValueFactorPtr ValueFactor::newFuncFactor(std::shared_ptr<FuncExpr> fe) {
-    ValueFactorPtr term = std::make_shared<ValueFactor>();
+    ValueFactorPtr term = makeShared<ValueFactor>();
     term->_type = FUNCTION;
     term->_funcExpr = fe;
     return term;
 }
 
 ValueFactorPtr ValueFactor::newAggFactor(std::shared_ptr<FuncExpr> fe) {
-    ValueFactorPtr term = std::make_shared<ValueFactor>();
+    ValueFactorPtr term = makeShared<ValueFactor>();
     term->_type = AGGFUNC;
     term->_funcExpr = fe;
     return term;
@@ -82,7 +83,7 @@ ValueFactorPtr ValueFactor::newAggFactor(std::shared_ptr<FuncExpr> fe) {
 
 ValueFactorPtr
 ValueFactor::newConstFactor(std::string const& alnum) {
-    ValueFactorPtr term = std::make_shared<ValueFactor>();
+    ValueFactorPtr term = makeShared<ValueFactor>();
     term->_type = CONST;
     term->_tableStar = alnum;
     return term;
@@ -90,7 +91,7 @@ ValueFactor::newConstFactor(std::string const& alnum) {
 
 ValueFactorPtr
 ValueFactor::newExprFactor(std::shared_ptr<ValueExpr> ve) {
-    ValueFactorPtr factor = std::make_shared<ValueFactor>();
+    ValueFactorPtr factor = makeShared<ValueFactor>();
     factor->_type = EXPR;
     factor->_valueExpr = ve;
     return factor;
@@ -116,10 +117,10 @@ void ValueFactor::findColumnRefs(ColumnRef::Vector& vector) {
 }
 
 ValueFactorPtr ValueFactor::clone() const{
-    ValueFactorPtr expr = std::make_shared<ValueFactor>(*this);
+    ValueFactorPtr expr = makeShared<ValueFactor>(*this);
     // Clone refs.
     if (_columnRef.get()) {
-        expr->_columnRef = std::make_shared<ColumnRef>(*_columnRef);
+        expr->_columnRef = makeShared<ColumnRef>(*_columnRef);
     }
     if (_funcExpr.get()) {
         expr->_funcExpr = _funcExpr->clone();
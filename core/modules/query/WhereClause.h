@@ -46,6 +46,7 @@
 namespace lsst {
 namespace qserv {
 namespace parser {
+    class FastSelectParser;
     class WhereFactory;
 }
 namespace query {
@@ -84,6 +85,7 @@ public:
 
 private:
     friend std::ostream& operator<<(std::ostream& os, WhereClause const& wc);
+    friend class parser::FastSelectParser;
     friend class parser::WhereFactory;
 
     std::string _original;
@@ -0,0 +1,110 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// System headers
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+// Third-party headers
+
+// Qserv headers
+#include "query/Arena.h"
+#include "query/ColumnRef.h"
+
+// Boost unit test header
+#define BOOST_TEST_MODULE Arena
+#include "boost/test/included/unit_test.hpp"
+
+namespace test = boost::test_tools;
+
+using lsst::qserv::query::Arena;
+using lsst::qserv::query::ColumnRef;
+using lsst::qserv::query::makeShared;
+
+BOOST_AUTO_TEST_SUITE(Suite)
+
+BOOST_AUTO_TEST_CASE(Allocate) {
+    Arena arena(1024);
+    void* p1 = arena.allocate(1, 1);
+    void* p2 = arena.allocate(8, 8);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(p2) % 8, 0U);
+    BOOST_CHECK(static_cast<char*>(p2) > static_cast<char*>(p1));
+    BOOST_CHECK_EQUAL(arena.getBytes(), 1024U);
+
+    // Large allocations get their own block, the current one stays in use.
+    arena.allocate(4000, 8);
+    BOOST_CHECK_EQUAL(arena.getBytes(), 1024U + 4000U);
+    void* p3 = arena.allocate(8, 8);
+    BOOST_CHECK_EQUAL(static_cast<char*>(p3), static_cast<char*>(p2) + 8);
+
+    // Full block.
+    for (int i = 0; i < 200; ++i) arena.allocate(8, 8);
+    BOOST_CHECK_EQUAL(arena.getBytes(), 2*1024U + 4000U);
+    BOOST_CHECK_EQUAL(arena.getAllocations(), 204U);
+}
+
+BOOST_AUTO_TEST_CASE(Scope) {
+    BOOST_CHECK(!Arena::current());
+    auto outer = std::make_shared<Arena>();
+    auto inner = std::make_shared<Arena>();
+    {
+        Arena::Scope outerScope(outer);
+        BOOST_CHECK_EQUAL(Arena::current(), outer);
+        {
+            Arena::Scope innerScope(inner);
+            BOOST_CHECK_EQUAL(Arena::current(), inner);
+            // Other threads do not see the arena.
+            std::thread t([]() { BOOST_CHECK(!Arena::current()); });
+            t.join();
+        }
+        BOOST_CHECK_EQUAL(Arena::current(), outer);
+        {
+            Arena::Scope noArena(nullptr);
+            BOOST_CHECK(!Arena::current());
+        }
+    }
+    BOOST_CHECK(!Arena::current());
+}
+
+BOOST_AUTO_TEST_CASE(MakeShared) {
+    ColumnRef::Ptr heapRef = makeShared<ColumnRef>("db", "table", "column");
+    ColumnRef::Ptr arenaRef;
+    std::weak_ptr<Arena> weakArena;
+    {
+        auto arena = std::make_shared<Arena>();
+        weakArena = arena;
+        Arena::Scope scope(arena);
+        arenaRef = makeShared<ColumnRef>("db", "table", "column");
+        auto copy = makeShared<ColumnRef>(*arenaRef);
+        BOOST_CHECK_EQUAL(arena->getAllocations(), 2U);
+    }
+    BOOST_CHECK_EQUAL(arenaRef->column, "column");
+    BOOST_CHECK_EQUAL(heapRef->column, "column");
+    // Nodes keep their arena alive.
+    BOOST_CHECK(!weakArena.expired());
+    arenaRef.reset();
+    BOOST_CHECK(weakArena.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -64,8 +64,8 @@
 #include "rproc/ProtoRowBuffer.h"
 #include "sql/Schema.h"
 #include "sql/SqlConnection.h"
-#include "sql/SqlResults.h"
 #include "sql/SqlErrorObject.h"
+#include "sql/SqlRowStream.h"
 #include "sql/statement.h"
 #include "util/StringHash.h"
 
@@ -208,6 +208,9 @@ bool InfileMerger::merge(std::shared_ptr<proto::WorkerResponse> response) {
         return true;
     }
     ret = _applyMysql(infileStatement);
+    if (ret) {
+        _publisher.addRows(resultJobId, response->result.row_size());
+    }
     _invalidJobAttemptMgr.decrConcurrentMergeCount();
     auto end = std::chrono::system_clock::now();
     auto mergeDur = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
@@ -280,7 +283,13 @@ bool InfileMerger::finalize() {
         if (!cleanupOk) {
             LOGS(_log, LOG_LVL_DEBUG, "Failure cleaning up table " << _mergeTable);
         }
+        _publisher.close(std::chrono::milliseconds(0));
     } else {
+        // Result stream readers select rows by jobId, let them finish first.
+        if (!_publisher.close(_config.streamDrainTimeout)) {
+            LOGS(_log, LOG_LVL_WARN, _getQueryIdStr() << " result stream reader did not catch up in "
+                 << _config.streamDrainTimeout.count() << "ms, closing stream");
+        }
         // Remove jobId and attemptCount information from the result table.
         // Returning a view could be faster, but is more complicated.
         std::string sqlDropCol = std::string("ALTER TABLE ") + _mergeTable
@@ -326,10 +335,58 @@ int InfileMerger::makeJobIdAttempt(int jobId, int attemptCount) {
 
 bool InfileMerger::scrubResults(int jobId, int attemptCount) {
     int jobIdAttempt = makeJobIdAttempt(jobId, attemptCount);
+    _publisher.discard(jobIdAttempt);
     return _invalidJobAttemptMgr.holdMergingForRowDelete(jobIdAttempt);
 }
 
 
+bool InfileMerger::publishJobAttempt(int jobId, int attemptCount) {
+    int jobIdAttempt = makeJobIdAttempt(jobId, attemptCount);
+    if (_invalidJobAttemptMgr.isJobAttemptInvalid(jobIdAttempt)) {
+        return true;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_publishedMtx);
+        if (!_publishedJobIds.insert(jobId).second) {
+            LOGS(_log, LOG_LVL_INFO, _getQueryIdStr() << " jobId=" << jobId << " attempt=" << attemptCount
+                 << " not published, another attempt of the job was published first");
+            return false;
+        }
+    }
+    _publisher.publish(jobIdAttempt);
+    return true;
+}
+
+
+ResultPublisher::Segment InfileMerger::getResultSegment(std::size_t cursor) {
+    if (_config.mergeStmt) {
+        // Rows are only final after the merge step.
+        ResultPublisher::Segment segment;
+        segment.complete = _isFinished;
+        return segment;
+    }
+    auto segment = _publisher.getSegment(cursor);
+    std::string columns;
+    {
+        std::lock_guard<std::mutex> lock(_resultColumnsMtx);
+        columns = _resultColumns;
+    }
+    if (segment.rows > 0 && !columns.empty()) {
+        std::ostringstream os;
+        os << "SELECT " << columns << " FROM " << _mergeTable
+           << " WHERE " << _jobIdColName << " IN (";
+        char const* sep = "";
+        for (int jobIdAttempt : segment.jobIdAttempts) {
+            os << sep << jobIdAttempt;
+            sep = ",";
+        }
+        os << ")";
+        segment.query = os.str();
+    }
+    return segment;
+}
+
+
 bool InfileMerger::_applySqlLocal(std::string const& sql, std::string const& logMsg) {
     auto begin = std::chrono::system_clock::now();
     bool success = _applySqlLocal(sql);
@@ -362,7 +419,8 @@ bool InfileMerger::_applySqlLocal(std::string const& sql) {
 
 bool InfileMerger::_sqlConnect(sql::SqlErrorObject& errObj) {
     if (_sqlConn == nullptr) {
-        _sqlConn = std::make_shared<sql::SqlConnection>(_config.mySqlConfig, true);
+        _sqlConn = std::make_shared<sql::SqlConnection>(_config.mySqlConfig, true,
+                                                        _config.connectionPool);
         if (not _sqlConn->connectToDb(errObj)) {
             _error = util::Error(errObj.errNo(), "Error connecting to db: " + errObj.printErrMsg(),
                            util::ErrorCode::MYSQLCONNECT);
@@ -385,30 +443,32 @@ size_t InfileMerger::_getResultTableSizeMB() {
     LOGS(_log, LOG_LVL_DEBUG, "Checking ResultTableSize " << tableSizeSql);
     std::lock_guard<std::mutex> m(_sqlMutex);
     sql::SqlErrorObject errObj;
-    sql::SqlResults results;
     if (not _sqlConnect(errObj)) {
         return 0;
     }
-    if (not _sqlConn->runQuery(tableSizeSql, results, errObj)) {
-        _error = util::Error(errObj.errNo(), "error getting size sql: " + errObj.printErrMsg(),
+    sql::SqlRowStream::Ptr rows = _sqlConn->streamQuery(tableSizeSql);
+
+    // There should only be 1 row
+    auto iter = rows->begin();
+    if (rows->getErrorObject().isSet()) {
+        sql::SqlErrorObject& rowsErr = rows->getErrorObject();
+        _error = util::Error(rowsErr.errNo(), "error getting size sql: " + rowsErr.printErrMsg(),
                        util::ErrorCode::MYSQLEXEC);
         LOGS(_log, LOG_LVL_ERROR, _getQueryIdStr() << "result table size error: " << _error.getMsg());
         return 0;
     }
-
-    // There should only be 1 row
-    auto iter = results.begin();
-    if (iter == results.end()) {
+    if (iter == rows->end()) {
         LOGS(_log, LOG_LVL_ERROR, _getQueryIdStr() << " result table size no rows returned " << _mergeTable);
         return 0;
     }
-    auto& row = *iter;
-    std::string tbName = row[0].first;
-    std::string tbSize = row[1].first;
-    size_t sz = std::stoul(tbSize);
+    double tbSize = 0;
+    if (not (*iter)[1].toDouble(tbSize)) {
+        LOGS(_log, LOG_LVL_ERROR, _getQueryIdStr() << " result table size not a number " << _mergeTable);
+        return 0;
+    }
     LOGS(_log, LOG_LVL_DEBUG,
-         _getQueryIdStr() << " ResultTableSizeMB tbl=" << tbName << " tbSize=" << tbSize);
-    return sz;
+         _getQueryIdStr() << " ResultTableSizeMB tbl=" << (*iter)[0].str() << " tbSize=" << tbSize);
+    return static_cast<size_t>(tbSize);
 }
 
 
@@ -493,6 +553,15 @@ bool InfileMerger::_setupTable(proto::WorkerResponse const& response) {
             schema.columns.push_back(scs);
             schema.columns.insert(schema.columns.end(), sch.columns.begin(), sch.columns.end());
         }
+        {
+            std::string columns;
+            for (auto const& col : sch.columns) {
+                if (!columns.empty()) columns += ", ";
+                columns += "`" + col.name + "`";
+            }
+            std::lock_guard<std::mutex> lock(_resultColumnsMtx);
+            _resultColumns = columns;
+        }
         std::string createStmt = sql::formCreateTable(_mergeTable, schema);
         // Specifying engine. There is some question about whether InnoDB or MyISAM is the better
         // choice when multiple threads are writing to the result table.
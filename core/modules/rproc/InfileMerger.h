@@ -30,6 +30,7 @@
 /// (see individual class documentation for more information)
 
 // System headers
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -39,6 +40,7 @@
 #include "mysql/LocalInfile.h"
 #include "mysql/MySqlConfig.h"
 #include "mysql/MySqlConnection.h"
+#include "rproc/ResultPublisher.h"
 #include "sql/SqlConnection.h"
 #include "util/Error.h"
 #include "util/EventThread.h"
@@ -48,6 +50,7 @@ namespace lsst {
 namespace qserv {
 namespace mysql {
     class MySqlConfig;
+    class MySqlConnectionPool;
 }
 namespace proto {
     class ProtoHeader;
@@ -91,6 +94,11 @@ public:
     mysql::MySqlConfig const mySqlConfig;
     std::string targetTable;
     std::shared_ptr<query::SelectStmt> mergeStmt;
+    /// How long finalize() waits for a result stream reader to consume the
+    /// published rows before the result table is rewritten.
+    std::chrono::milliseconds streamDrainTimeout{0};
+    /// Pool of connections for the SQL statements of the merger, may be null.
+    std::shared_ptr<mysql::MySqlConnectionPool> connectionPool;
 };
 
 
@@ -178,6 +186,17 @@ public:
     bool scrubResults(int jobId, int attempt);
     int makeJobIdAttempt(int jobId, int attemptCount);
 
+    /// Make the rows of a job attempt that delivered its last message
+    /// available to result stream readers.
+    /// @return false if another attempt of the job, e.g. a speculative duplicate,
+    ///         was published first. The rows of this attempt must not be kept.
+    bool publishJobAttempt(int jobId, int attemptCount);
+
+    /// @return rows published since cursor, with a query reading them from
+    ///         the result table. Only queries without a merge step publish
+    ///         rows, the others complete with an empty stream.
+    ResultPublisher::Segment getResultSegment(std::size_t cursor);
+
 private:
     bool _applyMysql(std::string const& query);
     bool _merge(std::shared_ptr<proto::WorkerResponse>& response);
@@ -234,6 +253,12 @@ private:
     InvalidJobAttemptMgr _invalidJobAttemptMgr;
     bool _deleteInvalidRows(int jobIdAttempt);
 
+    ResultPublisher _publisher;
+    std::set<int> _publishedJobIds; ///< Jobs with a published attempt, protected by _publishedMtx
+    std::mutex _publishedMtx;
+    std::mutex _resultColumnsMtx; ///< protects _resultColumns
+    std::string _resultColumns; ///< Result columns without the jobId column, for stream readers.
+
 
     int _sizeCheckRowCount{0}; ///< Number of rows read since last size check.
     int _checkSizeEveryXRows{1000}; ///< Check the size of the result table after every x number of rows.
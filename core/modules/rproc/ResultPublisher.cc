@@ -0,0 +1,107 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "rproc/ResultPublisher.h"
+
+// System headers
+#include <algorithm>
+
+namespace lsst {
+namespace qserv {
+namespace rproc {
+
+void ResultPublisher::addRows(int jobIdAttempt, std::uint64_t rows) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _pendingRows[jobIdAttempt] += rows;
+}
+
+
+void ResultPublisher::publish(int jobIdAttempt) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    if (_closed) {
+        return;
+    }
+    std::uint64_t rows = 0;
+    auto iter = _pendingRows.find(jobIdAttempt);
+    if (iter != _pendingRows.end()) {
+        rows = iter->second;
+        _pendingRows.erase(iter);
+    }
+    // Attempts without rows need no segment.
+    if (rows > 0) {
+        _published.emplace_back(jobIdAttempt, rows);
+        _publishedRows += rows;
+    }
+}
+
+
+void ResultPublisher::discard(int jobIdAttempt) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _pendingRows.erase(jobIdAttempt);
+}
+
+
+ResultPublisher::Segment ResultPublisher::getSegment(std::size_t cursor) {
+    Segment segment;
+    std::lock_guard<std::mutex> lock(_mtx);
+    _readerAttached = true;
+    cursor = std::min(cursor, _published.size());
+    if (cursor > _acknowledged) {
+        _acknowledged = cursor;
+        _cv.notify_all();
+    }
+    segment.nextCursor = _published.size();
+    segment.complete = _closed;
+    if (_expired) {
+        segment.truncated = cursor < _published.size();
+        return segment;
+    }
+    for (auto i = cursor; i < _published.size(); ++i) {
+        segment.jobIdAttempts.push_back(_published[i].first);
+        segment.rows += _published[i].second;
+    }
+    return segment;
+}
+
+
+bool ResultPublisher::close(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(_mtx);
+    _closed = true;
+    _pendingRows.clear();
+    bool caughtUp = true;
+    if (_readerAttached) {
+        caughtUp = _cv.wait_for(lock, timeout,
+                                [this]() { return _acknowledged >= _published.size(); });
+    }
+    _expired = true;
+    return caughtUp;
+}
+
+
+std::uint64_t ResultPublisher::getPublishedRows() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _publishedRows;
+}
+
+}}} // namespace lsst::qserv::rproc
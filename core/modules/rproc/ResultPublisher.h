@@ -0,0 +1,104 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef LSST_QSERV_RPROC_RESULTPUBLISHER_H
+#define LSST_QSERV_RPROC_RESULTPUBLISHER_H
+
+// System headers
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace lsst {
+namespace qserv {
+namespace rproc {
+
+/// ResultPublisher tracks which rows of a result table are final, so that
+/// they can be read before the whole query completes. Rows of a job attempt
+/// become final once the attempt has delivered its last message: until then
+/// the attempt may still be invalidated and its rows scrubbed. Final rows are
+/// published in segments, addressed by a cursor counting the published job
+/// attempts.
+///
+/// A reader repeatedly calls getSegment() with the cursor returned by the
+/// previous call, which acknowledges that the earlier segments were read.
+/// Once a reader has attached, close() gives it a chance to catch up before
+/// the table is rewritten.
+class ResultPublisher {
+public:
+    /// Rows published since a cursor.
+    struct Segment {
+        std::vector<int> jobIdAttempts; ///< job attempts whose rows make up the segment
+        std::uint64_t rows{0};          ///< number of rows in the segment
+        std::size_t nextCursor{0};      ///< cursor to use in the next call
+        bool complete{false};           ///< true if nothing more will be published
+        bool truncated{false};          ///< true if the rows can no longer be read by
+                                        ///< segment, the full result has to be read instead
+        std::string query;              ///< SELECT returning the rows, empty if none
+    };
+
+    ResultPublisher() {}
+    ResultPublisher(ResultPublisher const&) = delete;
+    ResultPublisher& operator=(ResultPublisher const&) = delete;
+
+    /// Count rows merged for a job attempt that is not yet published.
+    void addRows(int jobIdAttempt, std::uint64_t rows);
+
+    /// Make all rows of a job attempt visible to readers.
+    void publish(int jobIdAttempt);
+
+    /// Forget the rows of a job attempt that was invalidated.
+    void discard(int jobIdAttempt);
+
+    /// @return the segments published since cursor.
+    Segment getSegment(std::size_t cursor);
+
+    /// Stop publishing. If a reader is attached, wait up to timeout for it to
+    /// acknowledge all published segments. Segments not acknowledged by then
+    /// are reported as truncated.
+    /// @return false if an attached reader did not catch up in time.
+    bool close(std::chrono::milliseconds timeout);
+
+    /// @return total number of published rows.
+    std::uint64_t getPublishedRows() const;
+
+private:
+    mutable std::mutex _mtx;
+    std::condition_variable _cv;
+    std::map<int, std::uint64_t> _pendingRows; ///< rows per unpublished job attempt
+    std::vector<std::pair<int, std::uint64_t>> _published; ///< in publication order
+    std::uint64_t _publishedRows{0};
+    std::size_t _acknowledged{0}; ///< highest cursor seen from the reader
+    bool _readerAttached{false};
+    bool _closed{false};
+    bool _expired{false}; ///< set when close() returns, segments are no longer readable
+};
+
+}}} // namespace lsst::qserv::rproc
+
+#endif // LSST_QSERV_RPROC_RESULTPUBLISHER_H
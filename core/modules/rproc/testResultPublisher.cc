@@ -0,0 +1,133 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+
+// Class header
+#include "rproc/ResultPublisher.h"
+
+// System headers
+#include <chrono>
+#include <thread>
+
+// LSST headers
+#include "lsst/log/Log.h"
+
+// Boost unit test header
+#define BOOST_TEST_MODULE ResultPublisher_1
+#include "boost/test/included/unit_test.hpp"
+
+
+namespace test = boost::test_tools;
+
+namespace rproc = lsst::qserv::rproc;
+
+BOOST_AUTO_TEST_SUITE(Suite)
+
+BOOST_AUTO_TEST_CASE(PublishedSegments) {
+    rproc::ResultPublisher publisher;
+
+    LOGS_DEBUG("Rows are not visible before their job attempt is published.");
+    publisher.addRows(10, 5);
+    publisher.addRows(20, 3);
+    auto segment = publisher.getSegment(0);
+    BOOST_CHECK(segment.jobIdAttempts.empty());
+    BOOST_CHECK_EQUAL(segment.rows, 0U);
+    BOOST_CHECK_EQUAL(segment.nextCursor, 0U);
+    BOOST_CHECK(!segment.complete);
+
+    publisher.addRows(10, 2);
+    publisher.publish(10);
+    segment = publisher.getSegment(0);
+    BOOST_CHECK_EQUAL(segment.jobIdAttempts.size(), 1U);
+    BOOST_CHECK_EQUAL(segment.jobIdAttempts[0], 10);
+    BOOST_CHECK_EQUAL(segment.rows, 7U);
+    BOOST_CHECK_EQUAL(segment.nextCursor, 1U);
+
+    LOGS_DEBUG("Discarded job attempts and attempts without rows are never published.");
+    publisher.discard(20);
+    publisher.publish(20);
+    publisher.publish(30);
+    publisher.addRows(21, 4);
+    publisher.publish(21);
+    segment = publisher.getSegment(1);
+    BOOST_CHECK_EQUAL(segment.jobIdAttempts.size(), 1U);
+    BOOST_CHECK_EQUAL(segment.jobIdAttempts[0], 21);
+    BOOST_CHECK_EQUAL(segment.rows, 4U);
+    BOOST_CHECK_EQUAL(segment.nextCursor, 2U);
+    BOOST_CHECK_EQUAL(publisher.getPublishedRows(), 11U);
+
+    LOGS_DEBUG("Reading from an old cursor returns everything since.");
+    segment = publisher.getSegment(0);
+    BOOST_CHECK_EQUAL(segment.jobIdAttempts.size(), 2U);
+    BOOST_CHECK_EQUAL(segment.rows, 11U);
+}
+
+BOOST_AUTO_TEST_CASE(CloseWithoutReader) {
+    rproc::ResultPublisher publisher;
+    publisher.addRows(1, 1);
+    publisher.publish(1);
+    // Nobody reads the stream, closing must not wait.
+    BOOST_CHECK(publisher.close(std::chrono::milliseconds(60000)));
+    publisher.addRows(2, 1);
+    publisher.publish(2);
+    auto segment = publisher.getSegment(1);
+    BOOST_CHECK(segment.complete);
+    BOOST_CHECK(segment.jobIdAttempts.empty());
+    BOOST_CHECK(!segment.truncated);
+}
+
+BOOST_AUTO_TEST_CASE(CloseWaitsForReader) {
+    rproc::ResultPublisher publisher;
+    publisher.addRows(1, 1);
+    publisher.publish(1);
+    auto segment = publisher.getSegment(0);
+    BOOST_CHECK_EQUAL(segment.nextCursor, 1U);
+
+    LOGS_DEBUG("The reader acknowledges the segment while close() waits.");
+    std::thread reader([&publisher, &segment]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        publisher.getSegment(segment.nextCursor);
+    });
+    BOOST_CHECK(publisher.close(std::chrono::milliseconds(60000)));
+    reader.join();
+    segment = publisher.getSegment(1);
+    BOOST_CHECK(segment.complete);
+    BOOST_CHECK(!segment.truncated);
+}
+
+BOOST_AUTO_TEST_CASE(CloseTimesOut) {
+    rproc::ResultPublisher publisher;
+    publisher.getSegment(0);
+    publisher.addRows(1, 1);
+    publisher.publish(1);
+    BOOST_CHECK(!publisher.close(std::chrono::milliseconds(10)));
+
+    LOGS_DEBUG("Rows the reader missed can no longer be read by segment.");
+    auto segment = publisher.getSegment(0);
+    BOOST_CHECK(segment.complete);
+    BOOST_CHECK(segment.truncated);
+    BOOST_CHECK(segment.jobIdAttempts.empty());
+    BOOST_CHECK_EQUAL(segment.nextCursor, 1U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -44,5 +44,11 @@ MockSql::getQueryIter(std::string const& query) {
     return iter;
 }
 
+SqlRowStream::Ptr
+MockSql::streamQuery(std::string const& query) {
+    typedef StringVectorVector::const_iterator SubIter;
+    return std::make_shared<RowStream<SubIter> >(vec.begin(), vec.end());
+}
+
 } // namespace sql
 }} // namespace lsst::qserv
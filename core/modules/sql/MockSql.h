@@ -46,6 +46,7 @@ public:
                           SqlErrorObject&) {
         return false; }
     virtual std::shared_ptr<SqlResultIter> getQueryIter(std::string const& query);
+    virtual SqlRowStream::Ptr streamQuery(std::string const& query);
     virtual bool runQuery(std::string const query, SqlErrorObject&) {
         return false; }
     virtual bool dbExists(std::string const& dbName, SqlErrorObject&) {
@@ -95,6 +96,30 @@ public:
         TupleListIter _end;
     };
 
+    /// Stream over rows of strings, which must outlive the stream.
+    template <class TupleListIter>
+    struct RowStream : public SqlRowStream {
+        RowStream(TupleListIter begin, TupleListIter end)
+            : _cursor(begin), _end(end) {}
+    protected:
+        bool _fetch() override {
+            if (_cursor == _end) { return false; }
+            _cells.clear();
+            _lengths.clear();
+            for (auto const& value : *_cursor) {
+                _cells.push_back(value.data());
+                _lengths.push_back(value.size());
+            }
+            _row.set(_cells.data(), _lengths.data(), _cells.size());
+            ++_cursor;
+            return true;
+        }
+        TupleListIter _cursor;
+        TupleListIter _end;
+        std::vector<char const*> _cells;
+        std::vector<unsigned long> _lengths;
+    };
+
 private:
 }; // class MockSql
 
@@ -36,6 +36,7 @@
 
 // Qserv headers
 #include "mysql/MySqlConnection.h"
+#include "mysql/MySqlConnectionPool.h"
 #include "sql/SqlResults.h"
 
 namespace {
@@ -65,8 +66,9 @@ namespace sql {
 // class SqlResultIter
 ////////////////////////////////////////////////////////////////////////
 SqlResultIter::SqlResultIter(mysql::MySqlConfig const& sqlConfig,
-                             std::string const& query) {
-    if (!_setup(sqlConfig, query)) { return; }
+                             std::string const& query,
+                             std::shared_ptr<mysql::MySqlConnectionPool> const& pool) {
+    if (!_setup(sqlConfig, query, pool)) { return; }
     // if not error, prime the iterator
     ++(*this);
 }
@@ -96,10 +98,16 @@ SqlResultIter::done() const {
 
 bool
 SqlResultIter::_setup(mysql::MySqlConfig const& sqlConfig,
-                      std::string const& query) {
+                      std::string const& query,
+                      std::shared_ptr<mysql::MySqlConnectionPool> const& pool) {
     _columnCount = 0;
-    _connection = std::make_shared<mysql::MySqlConnection>(sqlConfig);
-    if (!_connection->connect()) {
+    if (pool) {
+        _connection = pool->acquire(sqlConfig);
+    } else {
+        _connection = std::make_shared<mysql::MySqlConnection>(sqlConfig);
+        _connection->connect();
+    }
+    if (!_connection->connected()) {
         populateErrorObject(*_connection, _errObj);
         return false;
     }
@@ -117,8 +125,9 @@ SqlConnection::SqlConnection()
     : _connection() {
 }
 
-SqlConnection::SqlConnection(mysql::MySqlConfig const& sc, bool)
-    : _connection(std::make_shared<mysql::MySqlConnection>(sc)) {
+SqlConnection::SqlConnection(mysql::MySqlConfig const& sc, bool,
+                             std::shared_ptr<mysql::MySqlConnectionPool> const& pool)
+    : _connection(std::make_shared<mysql::MySqlConnection>(sc)), _pool(pool) {
 }
 
 void
@@ -140,7 +149,12 @@ SqlConnection::connectToDb(SqlErrorObject& errObj) {
     }
 
     LOGS(_log, LOG_LVL_DEBUG, "connectToDb trying to connect");
-    if (!_connection->connect()) {
+    if (_pool) {
+        _connection = _pool->acquire(_connection->getConfig());
+    } else {
+        _connection->connect();
+    }
+    if (!_connection->connected()) {
         LOGS(_log, LOG_LVL_ERROR, "connectToDb failed to connect!");
         _setErrorObject(errObj);
         return false;
@@ -227,10 +241,19 @@ SqlConnection::runQuery(std::string const query,
 std::shared_ptr<SqlResultIter>
 SqlConnection::getQueryIter(std::string const& query) {
     std::shared_ptr<SqlResultIter> i =
-            std::make_shared<SqlResultIter>(_connection->getConfig(), query);
+            std::make_shared<SqlResultIter>(_connection->getConfig(), query, _pool);
     return i; // Can't defer to iterator without thread mgmt.
 }
 
+SqlRowStream::Ptr
+SqlConnection::streamQuery(std::string const& query) {
+    SqlErrorObject errObj;
+    if (!connectToDb(errObj)) {
+        LOGS(_log, LOG_LVL_ERROR, "streamQuery failed connectToDb: " << query);
+    }
+    return std::make_shared<MySqlRowStream>(_connection, query);
+}
+
 bool
 SqlConnection::dbExists(std::string const& dbName, SqlErrorObject& errObj) {
     if (!connectToDb(errObj)) return false;
@@ -42,12 +42,14 @@
 #include "global/stringTypes.h"
 #include "mysql/MySqlConfig.h"
 #include "sql/SqlErrorObject.h"
+#include "sql/SqlRowStream.h"
 
 // Forward declarations
 namespace lsst {
 namespace qserv {
 namespace mysql {
     class MySqlConnection;
+    class MySqlConnectionPool;
 }
 namespace sql {
     class SqlResults;
@@ -61,7 +63,9 @@ namespace sql {
 class SqlResultIter {
 public:
     SqlResultIter() : _columnCount(0) {}
-    SqlResultIter(mysql::MySqlConfig const& sc, std::string const& query);
+    /// @param pool if not null, the connection comes from this pool
+    SqlResultIter(mysql::MySqlConfig const& sc, std::string const& query,
+                  std::shared_ptr<mysql::MySqlConnectionPool> const& pool=nullptr);
     virtual ~SqlResultIter() {}
     virtual SqlErrorObject& getErrorObject() { return _errObj; }
 
@@ -70,7 +74,8 @@ public:
     virtual bool done() const; // Would like to relax LSST standard 3-4 for iterator classes
 
 private:
-    bool _setup(mysql::MySqlConfig const& sqlConfig, std::string const& query);
+    bool _setup(mysql::MySqlConfig const& sqlConfig, std::string const& query,
+                std::shared_ptr<mysql::MySqlConnectionPool> const& pool);
 
     std::shared_ptr<mysql::MySqlConnection> _connection;
     StringVector _current;
@@ -82,7 +87,10 @@ private:
 class SqlConnection {
 public:
     SqlConnection();
-    SqlConnection(mysql::MySqlConfig const& sc, bool useThreadMgmt=false);
+    /// @param pool if not null, connections come from this pool and are
+    ///             returned to it when this object is destroyed
+    SqlConnection(mysql::MySqlConfig const& sc, bool useThreadMgmt=false,
+                  std::shared_ptr<mysql::MySqlConnectionPool> const& pool=nullptr);
     virtual ~SqlConnection();
     virtual void reset(mysql::MySqlConfig const& sc, bool useThreadMgmt=false);
     virtual bool connectToDb(SqlErrorObject&);
@@ -94,6 +102,9 @@ public:
                           SqlErrorObject&);
     /// with runQueryIter SqlConnection is busy until SqlResultIter is closed
     virtual std::shared_ptr<SqlResultIter> getQueryIter(std::string const& query);
+    /// Run a query and read its rows as they arrive, without storing the
+    /// result first. SqlConnection is busy until the stream is destroyed.
+    virtual SqlRowStream::Ptr streamQuery(std::string const& query);
     virtual bool runQuery(std::string const query, SqlErrorObject&);
     virtual bool dbExists(std::string const& dbName, SqlErrorObject&);
     virtual bool createDb(std::string const& dbName, SqlErrorObject&,
@@ -145,6 +156,7 @@ private:
     bool _setErrorObject(SqlErrorObject&,
                          std::string const& details=std::string(""));
     std::shared_ptr<mysql::MySqlConnection> _connection;
+    std::shared_ptr<mysql::MySqlConnectionPool> _pool;
 }; // class SqlConnection
 
 }}} // namespace lsst::qserv::sql
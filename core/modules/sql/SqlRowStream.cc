@@ -0,0 +1,157 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "sql/SqlRowStream.h"
+
+// System headers
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+// Third-party headers
+#include <mysql/mysql.h>
+
+// LSST headers
+#include "lsst/log/Log.h"
+
+// Qserv headers
+#include "mysql/MySqlConfig.h"
+#include "mysql/MySqlConnection.h"
+
+namespace {
+
+LOG_LOGGER _log = LOG_GET("lsst.qserv.sql.SqlRowStream");
+
+/// Copy a cell to buf as a null-terminated string, numbers are short.
+template <std::size_t N>
+bool copyNumber(lsst::qserv::sql::SqlCell const& cell, char (&buf)[N]) {
+    if (cell.isNull() || cell.size() == 0 || cell.size() >= N) {
+        return false;
+    }
+    std::memcpy(buf, cell.data(), cell.size());
+    buf[cell.size()] = '\0';
+    return true;
+}
+
+} // anonymous namespace
+
+namespace lsst {
+namespace qserv {
+namespace sql {
+
+////////////////////////////////////////////////////////////////////////
+// class SqlCell
+////////////////////////////////////////////////////////////////////////
+bool SqlCell::toInt(std::int64_t& value) const {
+    char buf[32];
+    if (!copyNumber(*this, buf)) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    long long v = std::strtoll(buf, &end, 10);
+    if (errno != 0 || end != buf + _size) {
+        return false;
+    }
+    value = v;
+    return true;
+}
+
+bool SqlCell::toDouble(double& value) const {
+    char buf[64];
+    if (!copyNumber(*this, buf)) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    double v = std::strtod(buf, &end);
+    if (errno != 0 || end != buf + _size) {
+        return false;
+    }
+    value = v;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+// class SqlRowStream
+////////////////////////////////////////////////////////////////////////
+SqlRowStream::iterator SqlRowStream::begin() {
+    if (!_started) {
+        _started = true;
+        _advance();
+    }
+    return iterator(this);
+}
+
+////////////////////////////////////////////////////////////////////////
+// class MySqlRowStream
+////////////////////////////////////////////////////////////////////////
+MySqlRowStream::MySqlRowStream(std::shared_ptr<mysql::MySqlConnection> const& conn,
+                               std::string const& query)
+    : _conn(conn), _columnCount(0) {
+    if (!_conn->connected() || _conn->getMySql() == nullptr) {
+        _errObj.setErrNo(-999);
+        _errObj.addErrMsg("Error connecting to mysql with config:" + _conn->getConfig().toString());
+        return;
+    }
+    if (!_conn->queryUnbuffered(query)) {
+        _setError("Unable to execute query: " + query);
+        return;
+    }
+    _columnCount = mysql_num_fields(_conn->getResult());
+}
+
+MySqlRowStream::~MySqlRowStream() {
+    if (_conn->getResult() != nullptr) {
+        // Rows left unread must be drained before the connection is reused.
+        while (mysql_fetch_row(_conn->getResult()));
+        _conn->freeResult();
+    }
+}
+
+bool MySqlRowStream::_fetch() {
+    MYSQL_RES* result = _conn->getResult();
+    if (result == nullptr) {
+        return false;
+    }
+    MYSQL_ROW row = mysql_fetch_row(result);
+    if (row == nullptr) {
+        if (mysql_errno(_conn->getMySql()) != 0) {
+            _setError("Error reading rows");
+        }
+        _conn->freeResult();
+        return false;
+    }
+    _row.set(row, mysql_fetch_lengths(result), _columnCount);
+    return true;
+}
+
+void MySqlRowStream::_setError(std::string const& msg) {
+    _errObj.setErrNo(mysql_errno(_conn->getMySql()));
+    _errObj.addErrMsg(mysql_error(_conn->getMySql()));
+    _errObj.addErrMsg(msg);
+    LOGS(_log, LOG_LVL_ERROR, _errObj.printErrMsg());
+}
+
+}}} // namespace lsst::qserv::sql
@@ -0,0 +1,181 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+// SqlRowStream is a result of a query whose rows are read from the server one
+// at a time (mysql_use_result), instead of being stored on the client first
+// like SqlResults. Cells refer to the buffer of the current row, nothing is
+// copied unless requested.
+
+#ifndef LSST_QSERV_SQL_SQLROWSTREAM_H
+#define LSST_QSERV_SQL_SQLROWSTREAM_H
+
+// System headers
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+
+// Third-party headers
+#include "boost/utility.hpp"
+
+// Qserv headers
+#include "sql/SqlErrorObject.h"
+
+// Forward declarations
+namespace lsst {
+namespace qserv {
+namespace mysql {
+    class MySqlConnection;
+}}} // End of forward declarations
+
+namespace lsst {
+namespace qserv {
+namespace sql {
+
+/// SqlCell is a non-owning view of a cell value, valid until the stream
+/// moves to the next row.
+class SqlCell {
+public:
+    SqlCell() : _data(nullptr), _size(0) {}
+    SqlCell(char const* data, std::size_t size) : _data(data), _size(size) {}
+
+    /// @return true for a NULL value
+    bool isNull() const { return _data == nullptr; }
+    char const* data() const { return _data; }
+    std::size_t size() const { return _size; }
+    char const* begin() const { return _data; }
+    char const* end() const { return _data + _size; }
+
+    /// @return a copy of the value, empty for NULL
+    std::string str() const { return isNull() ? std::string() : std::string(_data, _size); }
+
+    /// @return false if the value is NULL or not an integer
+    bool toInt(std::int64_t& value) const;
+
+    /// @return false if the value is NULL or not a number
+    bool toDouble(double& value) const;
+
+private:
+    char const* _data;
+    std::size_t _size;
+};
+
+/// SqlRow is the current row of a SqlRowStream.
+class SqlRow {
+public:
+    SqlRow() : _cells(nullptr), _lengths(nullptr), _size(0) {}
+
+    std::size_t size() const { return _size; }
+    SqlCell operator[](std::size_t i) const {
+        return SqlCell(_cells[i], _cells[i] == nullptr ? 0 : _lengths[i]);
+    }
+
+    /// Point the row to new cell values, for SqlRowStream implementations.
+    void set(char const* const* cells, unsigned long const* lengths, std::size_t size) {
+        _cells = cells;
+        _lengths = lengths;
+        _size = size;
+    }
+
+private:
+    char const* const* _cells;
+    unsigned long const* _lengths;
+    std::size_t _size;
+};
+
+/**
+ *  SqlRowStream iterates once over the rows of a query result:
+ *
+ *      auto rows = sqlConn.streamQuery("SELECT ...");
+ *      for (sql::SqlRow const& row : *rows) { ... }
+ *      if (rows->getErrorObject().isSet()) { ... }
+ *
+ *  Errors, either running the query or reading the rows, end the iteration
+ *  and are reported by the error object.
+ */
+class SqlRowStream : boost::noncopyable {
+public:
+    typedef std::shared_ptr<SqlRowStream> Ptr;
+
+    class iterator : public std::iterator<std::input_iterator_tag, SqlRow const> {
+    public:
+        iterator() : _stream(nullptr) {}
+        explicit iterator(SqlRowStream* stream) : _stream(stream) {}
+
+        SqlRow const& operator*() const { return _stream->_row; }
+        SqlRow const* operator->() const { return &_stream->_row; }
+        iterator& operator++() { _stream->_advance(); return *this; }
+
+        bool operator==(iterator const& other) const { return _atEnd() == other._atEnd(); }
+        bool operator!=(iterator const& other) const { return not operator==(other); }
+
+    private:
+        bool _atEnd() const { return _stream == nullptr || _stream->_done; }
+        SqlRowStream* _stream;
+    };
+
+    virtual ~SqlRowStream() {}
+
+    /// Start reading rows. Rows can only be read once.
+    iterator begin();
+    iterator end() { return iterator(); }
+
+    SqlErrorObject& getErrorObject() { return _errObj; }
+
+protected:
+    SqlRowStream() : _started(false), _done(false) {}
+
+    /// Make _row the next row.
+    /// @return false after the last row, or on error after setting _errObj.
+    virtual bool _fetch() = 0;
+
+    SqlRow _row;
+    SqlErrorObject _errObj;
+
+private:
+    void _advance() { _done = !_fetch(); }
+
+    bool _started;
+    bool _done;
+};
+
+/// MySqlRowStream reads the result of a query on a MySqlConnection, which
+/// is busy until the stream is destroyed.
+class MySqlRowStream : public SqlRowStream {
+public:
+    MySqlRowStream(std::shared_ptr<mysql::MySqlConnection> const& conn, std::string const& query);
+    ~MySqlRowStream() override;
+
+protected:
+    bool _fetch() override;
+
+private:
+    void _setError(std::string const& msg);
+
+    std::shared_ptr<mysql::MySqlConnection> _conn;
+    std::size_t _columnCount;
+};
+
+}}} // namespace lsst::qserv::sql
+
+#endif // LSST_QSERV_SQL_SQLROWSTREAM_H
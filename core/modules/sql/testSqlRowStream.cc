@@ -0,0 +1,108 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+/**
+  * @brief Test SqlRowStream, SqlRow and SqlCell, without a database.
+  */
+
+// System headers
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Qserv headers
+#include "sql/MockSql.h"
+#include "sql/SqlRowStream.h"
+
+// Boost unit test header
+#define BOOST_TEST_MODULE SqlRowStream_1
+#include "boost/test/included/unit_test.hpp"
+
+namespace test = boost::test_tools;
+using namespace lsst::qserv::sql;
+
+namespace {
+
+typedef std::vector<std::string> Tuple;
+typedef std::vector<Tuple> TupleVector;
+typedef MockSql::RowStream<TupleVector::const_iterator> RowStream;
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(Suite)
+
+BOOST_AUTO_TEST_CASE(Iteration) {
+    TupleVector tuples = {{"1", "a"}, {"2", "bb"}, {"3", "ccc"}};
+    RowStream rows(tuples.begin(), tuples.end());
+    std::vector<std::string> seen;
+    for (SqlRow const& row : rows) {
+        BOOST_CHECK_EQUAL(row.size(), 2u);
+        seen.push_back(row[0].str() + row[1].str());
+    }
+    BOOST_CHECK_EQUAL(seen.size(), 3u);
+    BOOST_CHECK_EQUAL(seen[2], "3ccc");
+    BOOST_CHECK(!rows.getErrorObject().isSet());
+    // Rows are read once.
+    BOOST_CHECK(rows.begin() == rows.end());
+}
+
+BOOST_AUTO_TEST_CASE(Empty) {
+    TupleVector tuples;
+    RowStream rows(tuples.begin(), tuples.end());
+    BOOST_CHECK(rows.begin() == rows.end());
+}
+
+BOOST_AUTO_TEST_CASE(CellsReferToRow) {
+    TupleVector tuples = {{"hello"}};
+    RowStream rows(tuples.begin(), tuples.end());
+    SqlCell cell = (*rows.begin())[0];
+    BOOST_CHECK(cell.data() == tuples[0][0].data());
+    BOOST_CHECK_EQUAL(cell.size(), 5u);
+    BOOST_CHECK_EQUAL(std::string(cell.begin(), cell.end()), "hello");
+}
+
+BOOST_AUTO_TEST_CASE(Conversions) {
+    std::int64_t i = 0;
+    double d = 0;
+    std::string s = "-1234567890123";
+    BOOST_CHECK(SqlCell(s.data(), s.size()).toInt(i));
+    BOOST_CHECK_EQUAL(i, -1234567890123LL);
+    s = "12.75";
+    BOOST_CHECK(SqlCell(s.data(), s.size()).toDouble(d));
+    BOOST_CHECK_CLOSE(d, 12.75, 1e-9);
+    BOOST_CHECK(!SqlCell(s.data(), s.size()).toInt(i));
+    // Only the cell's bytes are converted, not what follows them.
+    BOOST_CHECK(SqlCell(s.data(), 2).toInt(i));
+    BOOST_CHECK_EQUAL(i, 12);
+    s = "12abc";
+    BOOST_CHECK(!SqlCell(s.data(), s.size()).toInt(i));
+    BOOST_CHECK(!SqlCell(s.data(), s.size()).toDouble(d));
+    BOOST_CHECK(!SqlCell(s.data(), 0).toInt(i));
+
+    SqlCell null;
+    BOOST_CHECK(null.isNull());
+    BOOST_CHECK(!null.toInt(i));
+    BOOST_CHECK(!null.toDouble(d));
+    BOOST_CHECK_EQUAL(null.str(), "");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
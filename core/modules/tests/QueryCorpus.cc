@@ -0,0 +1,237 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "tests/QueryCorpus.h"
+
+// System headers
+#include <iterator>
+
+namespace {
+
+char const* const corpus[] = {
+    "select sum(pm_declErr),chunkId, avg(bMagF2) bmf2 from LSST.Object "
+    "where bMagF > 20.0 GROUP BY chunkId;",
+    "select chunkId, avg(bMagF2) bmf2 from LSST.Object where bMagF > "
+    "20.0;",
+    "select * from Object where objectIdObjTest between 386942193651347 "
+    "and 386942193651349;",
+    "select * from Object where someField between 386942193651347 and "
+    "386942193651349;",
+    "select * from Object where objectIdObjTest between 38 and 40 and "
+    "objectIdObjTest IN (10, 30, 70);",
+    "select * from Object o, Source s where o.objectIdObjTest between 38 "
+    "and 40 AND s.objectIdSourceTest IN (10, 30, 70);",
+    "select chunkId as f1, pm_declErr AS f1 from LSST.Object where bMagF "
+    "> 20.0 GROUP BY chunkId;",
+    "select chunkId, CHUNKID from LSST.Object where bMagF > 20.0 GROUP "
+    "BY chunkId;",
+    "select sum(pm_declErr), chunkId as f1, chunkId AS f1, "
+    "avg(pm_declErr) from LSST.Object where bMagF > 20.0 GROUP BY "
+    "chunkId;",
+    "select pm_declErr, chunkId, ra_Test from LSST.Object where bMagF > "
+    "20.0 GROUP BY chunkId;",
+    "SELECT o1.objectId, o2.objectId, scisql_angSep(o1.ra_PS, "
+    "o1.decl_PS, o2.ra_PS, o2.decl_PS) AS distance FROM Object o1, "
+    "Object o2 WHERE scisql_angSep(o1.ra_PS, o1.decl_PS, o2.ra_PS, "
+    "o2.decl_PS) < 0.05 AND  o1.objectId <> o2.objectId;",
+    "SELECT * FROM Object WHERE someField > 5.0;",
+    "SELECT * FROM LSST.Object WHERE someField > 5.0;",
+    "SELECT * FROM Filter WHERE filterId=4;",
+    "select * from LSST.Object WHERE ra_PS BETWEEN 150 AND 150.2 and "
+    "decl_PS between 1.6 and 1.7 limit 2;",
+    "select * from LSST.Object WHERE ra_PS BETWEEN 150 AND 150.2 and "
+    "decl_PS between 1.6 and 1.7 ORDER BY objectId;",
+    "select * from Object where qserv_areaspec_box(0,0,1,1);",
+    "select count(*) from Object as o1, Object as o2 where "
+    "qserv_areaspec_box(6,6,7,7) AND rFlux_PS<0.005 AND "
+    "scisql_angSep(o1.ra_Test,o1.decl_Test,o2.ra_Test,o2.decl_Test) < "
+    "0.001;",
+    "select * from LSST.Object as o1, LSST.Object as o2, LSST.Source "
+    "where o1.id != o2.id and 0.024 > "
+    "scisql_angSep(o1.ra_Test,o1.decl_Test,o2.ra_Test,o2.decl_Test) and "
+    "Source.objectIdSourceTest=o2.objectIdObjTest;",
+    "select count(*) from Bad.Object as o1, Object o2 where "
+    "qserv_areaspec_box(6,6,7,7) AND o1.ra_PS between 6 and 7 and "
+    "o1.decl_PS between 6 and 7 ;",
+    "select * from LSST.Object o, Source s WHERE "
+    "qserv_areaspec_box(2,2,3,3) AND o.objectIdObjTest = "
+    "s.objectIdSourceTest;",
+    "select count(*) from Object as o1, Object as o2;",
+    "select count(*) from LSST.Object as o1, LSST.Object as o2 WHERE "
+    "o1.objectIdObjTest = o2.objectIdObjTest and o1.iFlux > 0.4 and "
+    "o2.gFlux > 0.4;",
+    "select o1.objectId, o2.objectI2, "
+    "scisql_angSep(o1.ra_PS,o1.decl_PS,o2.ra_PS,o2.decl_PS) AS distance "
+    "from LSST.Object as o1, LSST.Object as o2 where o1.foo <> o2.foo "
+    "and o1.objectIdObjTest = o2.objectIdObjTest;",
+    "select count(*) from LSST.Object as o1, LSST.Object as o2;",
+    "select count(*) from LSST.Object o1,LSST.Object o2 WHERE "
+    "qserv_areaspec_box(5.5, 5.5, 6.1, 6.1) AND "
+    "scisql_angSep(o1.ra_Test,o1.decl_Test,o2.ra_Test,o2.decl_Test) < "
+    "0.02",
+    "select o1.ra_PS, o1.ra_PS_Sigma, o2.ra_PS ra_PS2, o2.ra_PS_Sigma "
+    "ra_PS_Sigma2 from Object o1, Object o2 where o1.ra_PS_Sigma < 4e-7 "
+    "and o2.ra_PS_Sigma < 4e-7;",
+    "select o1.ra_PS, o1.ra_PS_Sigma, s.dummy, Exposure.exposureTime "
+    "from LSST.Object o1,  Source s, Exposure WHERE o1.objectIdObjTest = "
+    "s.objectIdSourceTest AND Exposure.id = o1.exposureId;",
+    "select count(*) from Object where qserv_areaspec_box(359.1, 3.16, "
+    "359.2,3.17);",
+    "select count(*) from LSST.Object where qserv_areaspec_box(359.1, "
+    "3.16, 359.2,3.17);",
+    " SELECT count(*) AS n, AVG(ra_PS), AVG(decl_PS), _chunkId FROM "
+    "Object GROUP BY _chunkId;",
+    " SELECT count(*) AS n, AVG(ra_PS), AVG(decl_PS), x_chunkId FROM "
+    "Object GROUP BY x_chunkId;",
+    "select count(*) from Object where qserv_areaspec_box(359.1, 3.16, "
+    "359.2, 3.17);",
+    "SELECT offset, mjdRef, drift FROM LeapSeconds where offset = 10",
+    "SELECT count(*) from Object;",
+    "SELECT count(*) from LSST.Source;",
+    "SELECT * from Science_Ccd_Exposure limit 3;",
+    "SELECT subQueryColumn FROM (SELECT * FROM Object WHERE filterId=4) "
+    "WHERE rFlux_PS > 0.3;",
+    "SELECT * FROM (Object) WHERE rFlux_PS > 0.3;",
+    "SELECT count(*), sum(Source.flux), flux2, Source.flux3 from Source "
+    "where qserv_areaspec_box(0,0,1,1) and flux4=2 and Source.flux5=3;",
+    "SELECT count(*) FROM Object WHERE  qserv_areaspec_box(1,3,2,4) AND  "
+    "scisql_fluxToAbMag(zFlux_PS) BETWEEN 21 AND 21.5;",
+    "SELECT f(one)/f2(two) FROM  Object where "
+    "qserv_areaspec_box(0,0,1,1);",
+    "SELECT (1+f(one))/f2(two) FROM  Object where "
+    "qserv_areaspec_box(0,0,1,1);",
+    "SELECT objectId as id, COUNT(sourceId) AS c FROM Source GROUP BY "
+    "objectId HAVING  c > 1000 LIMIT 10;",
+    "SELECT "
+    "ROUND(scisql_fluxToAbMag(uFlux_PS)-scisql_fluxToAbMag(gFlux_PS), 0) "
+    "AS UG, "
+    "ROUND(scisql_fluxToAbMag(gFlux_PS)-scisql_fluxToAbMag(rFlux_PS), 0) "
+    "AS GR FROM Object WHERE scisql_fluxToAbMag(gFlux_PS) < 0.2 AND "
+    "scisql_fluxToAbMag(uFlux_PS)-scisql_fluxToAbMag(gFlux_PS) >=-0.27 "
+    "AND scisql_fluxToAbMag(gFlux_PS)-scisql_fluxToAbMag(rFlux_PS) "
+    ">=-0.24 AND "
+    "scisql_fluxToAbMag(rFlux_PS)-scisql_fluxToAbMag(iFlux_PS) >=-0.27 "
+    "AND scisql_fluxToAbMag(iFlux_PS)-scisql_fluxToAbMag(zFlux_PS) "
+    ">=-0.35 AND "
+    "scisql_fluxToAbMag(zFlux_PS)-scisql_fluxToAbMag(yFlux_PS) >=-0.40;",
+    "SELECT DISTINCT foo FROM Filter f;",
+    "SELECT foo FROM Filter f limit 5",
+    "SELECT  o1.objectId FROM Object o1 WHERE ABS( "
+    "(scisql_fluxToAbMag(o1.gFlux_PS)-scisql_fluxToAbMag(o1.rFlux_PS)) - "
+    "(scisql_fluxToAbMag(o1.gFlux_PS)-scisql_fluxToAbMag(o1.rFlux_PS)) ) "
+    "< 1;",
+    "SELECT * FROM RefObjMatch;",
+    "SELECT * FROM RefObjMatch WHERE foo!=bar AND baz<3.14159;",
+    "LECT sce.filterName,sce.field FROM LSST.Science_Ccd_Exposure AS sce "
+    "WHERE sce.field=535 AND sce.camcol LIKE '%' ",
+    "SELECT s.ra, s.decl, o.foo FROM Source s, Object o WHERE "
+    "s.objectIdSourceTest=o.objectIdObjTest and o.objectIdObjTest = "
+    "430209694171136;",
+    "SELECT s.ra, s.decl, o.foo FROM Object o JOIN Source2 s USING "
+    "(objectIdObjTest) JOIN Source2 s2 USING (objectIdObjTest) WHERE "
+    "o.objectId = 430209694171136;",
+    "SELECT s.ra, s.decl, o.foo FROM Object o JOIN Source s ON "
+    "s.objectIdSourceTest = Object.objectIdObjTest JOIN Source s2 ON "
+    "s.objectIdSourceTest = s2.objectIdSourceTest WHERE "
+    "LSST.Object.objectId = 430209694171136;",
+    "SELECT s1.foo, s2.foo AS s2_foo FROM Source s1 NATURAL LEFT JOIN "
+    "Source s2 WHERE s1.bar = s2.bar;",
+    "SELECT s1.foo, s2.foo AS s2_foo FROM Source s1 UNION JOIN Source s2 "
+    "WHERE s1.bar = s2.bar;",
+    "SELECT * FROM Source s1 CROSS JOIN Source s2 WHERE s1.bar = s2.bar;",
+    "SELECT * FROM Filter f JOIN Science_Ccd_Exposure USING(exposureId);",
+    "SELECT * FROM Object WHERE objectIdObjTest = 430213989000;",
+    "SELECT s.ra, s.decl, o.raRange, o.declRange FROM   Object o JOIN   "
+    "Source2 s USING (objectIdObjTest) WHERE  o.objectIdObjTest = "
+    "390034570102582 AND    o.latestObsTime = s.taiMidPoint;",
+    "SELECT sce.filterId, sce.filterName FROM Science_Ccd_Exposure AS "
+    "sce WHERE (sce.visit = 887404831) AND (sce.raftName = '3,3') AND "
+    "(sce.ccdName LIKE '%')",
+    "SELECT objectId, iE1_SG, ABS(iE1_SG) FROM Object WHERE iE1_SG "
+    "between -0.1 and 0.1 ORDER BY ABS(iE1_SG);",
+    "SELECT objectId, ROUND(iE1_SG, 3), ROUND(ABS(iE1_SG), 3) FROM "
+    "Object WHERE iE1_SG between -0.1 and 0.1 ORDER BY "
+    "ROUND(ABS(iE1_SG), 3);",
+    "SELECT objectId, taiMidPoint, scisql_fluxToAbMag(psfFlux) FROM   "
+    "Source JOIN   Object USING(objectId) JOIN   Filter USING(filterId) "
+    "WHERE qserv_areaspec_box(355, 0, 360, 20) AND filterName = 'g' "
+    "ORDER BY objectId, taiMidPoint ASC;",
+    "SELECT DISTINCT rFlux_PS FROM Object;",
+    "SELECT count(*) FROM   Object o INNER JOIN RefObjMatch o2t ON "
+    "(o.objectIdObjTest = o2t.objectId) INNER JOIN SimRefObject t ON "
+    "(o2t.refObjectId = t.refObjectId) WHERE  closestToObj = 1 OR "
+    "closestToObj is NULL;",
+    "select objectId, sro.*, (sro.refObjectId-1)/2%pow(2,10), typeId "
+    "from Source s join RefObjMatch rom using (objectId) join "
+    "SimRefObject sro using (refObjectId) where isStar =1 limit 10;",
+    "SELECT objectId, scisql_fluxToAbMag(uFlux_PS), "
+    "scisql_fluxToAbMag(gFlux_PS), scisql_fluxToAbMag(rFlux_PS), "
+    "scisql_fluxToAbMag(iFlux_PS), scisql_fluxToAbMag(zFlux_PS), "
+    "scisql_fluxToAbMag(yFlux_PS), ra_PS, decl_PS FROM   Object WHERE  ( "
+    "scisql_fluxToAbMag(gFlux_PS)-scisql_fluxToAbMag(rFlux_PS) > 0.7 OR "
+    "scisql_fluxToAbMag(gFlux_PS) > 22.3 ) AND    "
+    "scisql_fluxToAbMag(gFlux_PS)-scisql_fluxToAbMag(rFlux_PS) > 0.1 AND "
+    "   ( scisql_fluxToAbMag(rFlux_PS)-scisql_fluxToAbMag(iFlux_PS) < "
+    "(0.08 + 0.42 * "
+    "(scisql_fluxToAbMag(gFlux_PS)-scisql_fluxToAbMag(rFlux_PS) - 0.96)) "
+    " OR scisql_fluxToAbMag(gFlux_PS)-scisql_fluxToAbMag(rFlux_PS) > "
+    "1.26 ) AND    "
+    "scisql_fluxToAbMag(iFlux_PS)-scisql_fluxToAbMag(zFlux_PS) < 0.8;",
+    "SELECT  COUNT(*) AS totalCount, SUM(CASE WHEN (typeId=3) THEN 1 "
+    "ELSE 0 END) AS galaxyCount FROM Object WHERE rFlux_PS > 10;",
+    "SELECT scisql_fluxToAbMag(uFlux_PS) FROM   Object WHERE  (objectId "
+    "% 100 ) = 40;",
+    "select * from Object where objectIdObjTest in (2,3145,9999);",
+    "select COUNT(*) AS N FROM Source WHERE objectId IN(386950783579546, "
+    "386942193651348);",
+    "select * from Object as o1 where objectIdObjTest IN (2,3145,9999);",
+    "SELECT objectId, taiMidPoint FROM Source ORDER BY objectId ASC",
+    "SELECT * FROM Filter ORDER BY filterId",
+    "SELECT objectId, taiMidPoint FROM Source ORDER BY objectId, "
+    "taiMidPoint ASC",
+    "SELECT * FROM Source ORDER BY objectId, taiMidPoint, xFlux DESC",
+    "SELECT objectId, AVG(taiMidPoint) FROM Source GROUP BY objectId "
+    "ORDER BY objectId ASC",
+    "SELECT filterId, SUM(photClam) FROM Filter GROUP BY filterId ORDER "
+    "BY filterId",
+    "SELECT objectId, taiMidPoint FROM Source ORDER BY objectId ASC "
+    "LIMIT 5",
+    "SELECT objectId, AVG(taiMidPoint) FROM Source GROUP BY objectId "
+    "ORDER BY objectId ASC LIMIT 2",
+    "SELECT filterId, SUM(photClam) FROM Filter GROUP BY filterId ORDER "
+    "BY filterId LIMIT 3",
+};
+
+} // anonymous namespace
+
+namespace lsst {
+namespace qserv {
+namespace tests {
+
+std::vector<std::string> const& queryAnaCorpus() {
+    static std::vector<std::string> const statements(std::begin(corpus), std::end(corpus));
+    return statements;
+}
+
+}}} // namespace lsst::qserv::tests
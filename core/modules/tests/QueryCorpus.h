@@ -0,0 +1,45 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_QSERV_TESTS_QUERYCORPUS_H
+#define LSST_QSERV_TESTS_QUERYCORPUS_H
+
+// System headers
+#include <string>
+#include <vector>
+
+namespace lsst {
+namespace qserv {
+namespace tests {
+
+/**
+ *  @brief Statements of the qproc/testQueryAna* suites
+ *
+ *  Used by tests and benchmarks which replay realistic user queries. Some
+ *  statements are invalid on purpose and fail to parse or to analyze.
+ */
+std::vector<std::string> const& queryAnaCorpus();
+
+}}} // namespace lsst::qserv::tests
+
+#endif // LSST_QSERV_TESTS_QUERYCORPUS_H
@@ -0,0 +1,243 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+/**
+  * @file
+  *
+  * @brief Benchmark of czar query preparation.
+  *
+  * Replays the statements of the qproc/testQueryAna* suites through the
+  * stages of query preparation and reports, for each stage, latency
+  * percentiles and heap allocations per statement:
+  *   - parse:     SelectParser
+  *   - analyze:   QuerySession::analyzeQuery
+  *   - templates: QuerySession::makeQueryTemplates
+  *   - chunks:    QuerySession::buildChunkQuerySpec for every chunk
+  *
+  * This is not a unit test, compare its output between two builds to catch
+  * regressions:
+  *
+  *   testQueryPrepBenchmark [-i iterations] [-c chunks] [-a]
+  *
+  * where -a skips the fast SELECT parser and always uses ANTLR.
+  */
+
+// System headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+// Qserv headers
+#include "parser/ParseException.h"
+#include "parser/SelectParser.h"
+#include "qproc/ChunkQuerySpec.h"
+#include "qproc/ChunkSpec.h"
+#include "qproc/QuerySession.h"
+#include "query/QueryTemplate.h"
+#include "query/SelectStmt.h"
+#include "tests/QueryAnaFixture.h"
+#include "tests/QueryCorpus.h"
+
+using lsst::qserv::parser::ParseException;
+using lsst::qserv::parser::SelectParser;
+using lsst::qserv::qproc::ChunkSpec;
+using lsst::qserv::qproc::QuerySession;
+using lsst::qserv::query::QueryTemplate;
+using lsst::qserv::query::SelectStmt;
+using lsst::qserv::tests::QueryAnaFixture;
+using lsst::qserv::tests::queryAnaCorpus;
+
+namespace {
+
+// Every heap allocation of the process goes through the operators below.
+std::atomic<std::uint64_t> allocCount(0);
+std::atomic<std::uint64_t> allocBytes(0);
+
+/// Latencies and allocations of one preparation stage.
+struct Stage {
+    explicit Stage(char const* name_) : name(name_) {}
+
+    /// Run f, and record its duration and allocations if record is set.
+    template <typename F>
+    void measure(bool record, F f) {
+        std::uint64_t const count0 = allocCount;
+        std::uint64_t const bytes0 = allocBytes;
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        auto const end = std::chrono::steady_clock::now();
+        if (record) {
+            micros.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            allocs += allocCount - count0;
+            bytes += allocBytes - bytes0;
+        }
+    }
+
+    /// @return the p-th percentile (nearest rank) of the recorded latencies
+    double percentile(double p) const {
+        std::size_t rank = static_cast<std::size_t>(p * micros.size() + 0.5);
+        return sorted[std::min(std::max<std::size_t>(rank, 1), sorted.size()) - 1];
+    }
+
+    void print(std::ostream& os) {
+        os << std::left << std::setw(10) << name << std::right << std::setw(8) << micros.size();
+        if (micros.empty()) {
+            os << "\n";
+            return;
+        }
+        sorted = micros;
+        std::sort(sorted.begin(), sorted.end());
+        double const n = micros.size();
+        os << std::fixed << std::setprecision(1)
+           << std::setw(10) << percentile(0.50)
+           << std::setw(10) << percentile(0.90)
+           << std::setw(10) << percentile(0.99)
+           << std::setw(10) << sorted.back()
+           << std::setw(12) << allocs / n
+           << std::setw(12) << bytes / n / 1024 << "\n";
+    }
+
+    char const* name;
+    std::vector<double> micros;
+    std::vector<double> sorted;
+    std::uint64_t allocs = 0;
+    std::uint64_t bytes = 0;
+};
+
+void usage(char const* prog) {
+    std::cerr << "Usage: " << prog << " [-i iterations] [-c chunks] [-a]\n"
+              << "  -i  passes over the statement corpus, after one warm-up pass (default 10)\n"
+              << "  -c  chunks added to every query session (default 100)\n"
+              << "  -a  always use the ANTLR parser\n";
+}
+
+} // anonymous namespace
+
+void* operator new(std::size_t size) {
+    ++allocCount;
+    allocBytes += size;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = 10;
+    int chunkCount = 100;
+    bool useFastPath = true;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            iterations = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            chunkCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-a") == 0) {
+            useFastPath = false;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (iterations < 1 || chunkCount < 1) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    QueryAnaFixture fixture;
+    Stage parse("parse");
+    Stage analyze("analyze");
+    Stage templates("templates");
+    Stage chunks("chunks");
+    int parseErrors = 0;
+    int analysisErrors = 0;
+
+    for (int iter = 0; iter <= iterations; ++iter) {
+        bool const record = iter > 0;
+        for (std::string const& sql : queryAnaCorpus()) {
+            std::shared_ptr<SelectStmt> stmt;
+            parse.measure(record, [&]() {
+                try {
+                    auto parser = SelectParser::newInstance(sql, useFastPath);
+                    parser->setup();
+                    stmt = parser->getSelectStmt();
+                } catch (ParseException const&) {
+                    stmt.reset();
+                }
+            });
+            if (!stmt) {
+                if (!record) ++parseErrors;
+                continue;
+            }
+
+            QuerySession qs(fixture.qsTest);
+            analyze.measure(record, [&]() { qs.analyzeQuery(sql, stmt); });
+            if (!qs.getError().empty()) {
+                if (!record) ++analysisErrors;
+                continue;
+            }
+            for (int chunkId = 100; chunkId < 100 + chunkCount; ++chunkId) {
+                qs.addChunk(ChunkSpec::makeFake(chunkId, true));
+            }
+
+            std::vector<QueryTemplate> queryTemplates;
+            templates.measure(record, [&]() { queryTemplates = qs.makeQueryTemplates(); });
+            chunks.measure(record, [&]() {
+                for (auto i = qs.cQueryBegin(), e = qs.cQueryEnd(); i != e; ++i) {
+                    qs.buildChunkQuerySpec(queryTemplates, *i);
+                }
+            });
+        }
+    }
+
+    std::cout << queryAnaCorpus().size() << " statements, " << parseErrors << " parse errors, "
+              << analysisErrors << " analysis errors, " << iterations << " iterations, "
+              << chunkCount << " chunks, " << (useFastPath ? "fast" : "ANTLR") << " parser\n\n"
+              << std::left << std::setw(10) << "stage" << std::right << std::setw(8) << "samples"
+              << std::setw(10) << "p50 us" << std::setw(10) << "p90 us" << std::setw(10) << "p99 us"
+              << std::setw(10) << "max us" << std::setw(12) << "allocs/op" << std::setw(12) << "KiB/op"
+              << "\n";
+    for (Stage* stage : {&parse, &analyze, &templates, &chunks}) {
+        stage->print(std::cout);
+    }
+    return 0;
+}
@@ -58,4 +58,12 @@ std::ostream & operator<<(std::ostream & os, Timer const & timer) {
     return os;
 }
 
+std::chrono::microseconds threadCpuTime() {
+    struct ::timespec ts;
+    if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return std::chrono::microseconds(0);
+    }
+    return std::chrono::microseconds(ts.tv_sec * 1000000LL + ts.tv_nsec / 1000);
+}
+
 }}} // namespace lsst::qserv::util
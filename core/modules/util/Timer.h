@@ -25,6 +25,7 @@
 #define LSST_QSERV_UTIL_TIMER_H
 
 // System headers
+#include <chrono>
 #include <cstddef>
 #include <ostream>
 #include <sys/time.h>
@@ -63,6 +64,9 @@ struct Timer {
 
 std::ostream& operator<<(std::ostream & os, Timer const & tm);
 
+/// Return the CPU time consumed so far by the calling thread.
+std::chrono::microseconds threadCpuTime();
+
 }}} // namespace lsst::qserv::util
 
 #endif // LSST_QSERV_UTIL_TIMER_H
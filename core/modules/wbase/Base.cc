@@ -112,6 +112,64 @@ std::string const CREATE_DUMMY_SUBCHUNK_SCRIPT =
     "ENGINE = MEMORY "
     "AS SELECT * FROM %1%.%2%_%4% WHERE %3% = %5%;";
 
+// Parameters:
+// %1% database (e.g., LSST)
+// %2% table (e.g., Object)
+// %3% chunkId (e.g. 2523)
+// %4% subChunkId (e.g., 34)
+// Creates empty subchunk tables with the schema of the chunk tables. Rows are
+// filled afterwards by STAGE_SUBCHUNKS_SCRIPT and FILL_SUBCHUNK_SCRIPT.
+std::string const CREATE_EMPTY_SUBCHUNK_SCRIPT =
+    "CREATE DATABASE IF NOT EXISTS " + SUBCHUNKDB_PREFIX_STR + "%1%_%3%;"
+    "DROP TABLE IF EXISTS " + SUBCHUNKDB_PREFIX_STR + "%1%_%3%.%2%_%3%_%4%;"
+    "CREATE TABLE " + SUBCHUNKDB_PREFIX_STR + "%1%_%3%.%2%_%3%_%4% ENGINE = MEMORY "
+    "AS SELECT * FROM %1%.%2%_%3% LIMIT 0;"
+    "DROP TABLE IF EXISTS " + SUBCHUNKDB_PREFIX_STR + "%1%_%3%.%2%FullOverlap_%3%_%4%;"
+    "CREATE TABLE " + SUBCHUNKDB_PREFIX_STR + "%1%_%3%.%2%FullOverlap_%3%_%4% "
+    "ENGINE = MEMORY "
+    "AS SELECT * FROM %1%.%2%FullOverlap_%3% LIMIT 0;";
+
+// Parameters:
+// %1% database (e.g., LSST)
+// %2% table (e.g., Object)
+// %3% subchunk column name (e.g. x_subChunkId)
+// %4% chunkId (e.g. 2523)
+// %5% comma separated subChunkIds (e.g., 34,35)
+// Reads the rows of all requested subchunks with a single scan of the chunk
+// table and of its overlap table into temporary tables of the session,
+// hashed on the subchunk column so that FILL_SUBCHUNK_SCRIPT reads each
+// subchunk directly.
+std::string const STAGE_SUBCHUNKS_SCRIPT =
+    "DROP TEMPORARY TABLE IF EXISTS " + SUBCHUNKDB_PREFIX_STR + "%1%_%4%.%2%_%4%_staged;"
+    "CREATE TEMPORARY TABLE " + SUBCHUNKDB_PREFIX_STR + "%1%_%4%.%2%_%4%_staged "
+    "(INDEX (%3%)) ENGINE = MEMORY "
+    "AS SELECT * FROM %1%.%2%_%4% WHERE %3% IN (%5%);"
+    "DROP TEMPORARY TABLE IF EXISTS " + SUBCHUNKDB_PREFIX_STR + "%1%_%4%.%2%FullOverlap_%4%_staged;"
+    "CREATE TEMPORARY TABLE " + SUBCHUNKDB_PREFIX_STR + "%1%_%4%.%2%FullOverlap_%4%_staged "
+    "(INDEX (%3%)) ENGINE = MEMORY "
+    "AS SELECT * FROM %1%.%2%FullOverlap_%4% WHERE %3% IN (%5%);";
+
+// Parameters:
+// %1% database (e.g., LSST)
+// %2% table (e.g., Object)
+// %3% subchunk column name (e.g. x_subChunkId)
+// %4% chunkId (e.g. 2523)
+// %5% subChunkId (e.g., 34)
+// Copies one subchunk from the tables made by STAGE_SUBCHUNKS_SCRIPT.
+std::string const FILL_SUBCHUNK_SCRIPT =
+    "INSERT INTO " + SUBCHUNKDB_PREFIX_STR + "%1%_%4%.%2%_%4%_%5% "
+    "SELECT * FROM " + SUBCHUNKDB_PREFIX_STR + "%1%_%4%.%2%_%4%_staged WHERE %3% = %5%;"
+    "INSERT INTO " + SUBCHUNKDB_PREFIX_STR + "%1%_%4%.%2%FullOverlap_%4%_%5% "
+    "SELECT * FROM " + SUBCHUNKDB_PREFIX_STR + "%1%_%4%.%2%FullOverlap_%4%_staged WHERE %3% = %5%;";
+
+// Parameters:
+// %1% database (e.g., LSST)
+// %2% table (e.g., Object)
+// %3% chunkId (e.g. 2523)
+std::string const DROP_STAGED_SUBCHUNKS_SCRIPT =
+    "DROP TEMPORARY TABLE IF EXISTS " + SUBCHUNKDB_PREFIX_STR + "%1%_%3%.%2%_%3%_staged;"
+    "DROP TEMPORARY TABLE IF EXISTS " + SUBCHUNKDB_PREFIX_STR + "%1%_%3%.%2%FullOverlap_%3%_staged;";
+
 // Note:
 // Not all Object partitions will have overlap tables created by the
 // partitioner.  Thus we need to create empty overlap tables to prevent
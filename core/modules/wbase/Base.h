@@ -60,6 +60,10 @@ extern std::string DUMP_BASE; // Non-const to allow runtime-update via config
 extern std::string const CREATE_SUBCHUNK_SCRIPT;
 extern std::string const CLEANUP_SUBCHUNK_SCRIPT;
 extern std::string const CREATE_DUMMY_SUBCHUNK_SCRIPT;
+extern std::string const CREATE_EMPTY_SUBCHUNK_SCRIPT;
+extern std::string const STAGE_SUBCHUNKS_SCRIPT;
+extern std::string const FILL_SUBCHUNK_SCRIPT;
+extern std::string const DROP_STAGED_SUBCHUNKS_SCRIPT;
 
 // Result-writing
 void updateResultPath(char const* resultPath=0);
@@ -31,6 +31,9 @@
 // Class header
 #include "wbase/Task.h"
 
+// System headers
+#include <algorithm>
+
 // Third-party headers
 #include "boost/regex.hpp"
 
@@ -125,6 +128,11 @@ Task::Task(Task::TaskMsgPtr const& t, SendChannel::Ptr const& sc)
     }
     _scanInfo.scanRating = msg->scanpriority();
     _scanInfo.sortTablesSlowestFirst();
+    for (auto const& fragment : msg->fragment()) {
+        for (auto const& dbTbl : fragment.subchunks().dbtbl()) {
+            _subchunkTables.emplace(dbTbl.db(), dbTbl.tbl());
+        }
+    }
     _scanInteractive = msg->scaninteractive();
 }
 
@@ -233,6 +241,30 @@ std::chrono::milliseconds Task::getRunTime() const {
 }
 
 
+Task::Usage& Task::Usage::operator+=(Usage const& other) {
+    cpuTime += other.cpuTime;
+    bytesLocked += other.bytesLocked;
+    rowsExamined += other.rowsExamined;
+    rowsReturned += other.rowsReturned;
+    bytesTransmitted += other.bytesTransmitted;
+    subchunkBytes = std::max(subchunkBytes, other.subchunkBytes);
+    return *this;
+}
+
+
+/// @return the resources used so far by the Task.
+Task::Usage Task::getUsage() const {
+    std::lock_guard<std::mutex> guard(_stateMtx);
+    return _usage;
+}
+
+
+void Task::addUsage(Usage const& usage) {
+    std::lock_guard<std::mutex> guard(_stateMtx);
+    _usage += usage;
+}
+
+
 /// Wait for MemMan to finish reserving resources. The mlock call can take several seconds
 /// and only one mlock call can be running at a time. Further, queries finish slightly faster
 /// if they are mlock'ed in the same order they were scheduled, hence the ulockEvents
@@ -262,6 +294,11 @@ void Task::waitForMemMan() {
         if (cmd->errorCode) {
             LOGS(_log, LOG_LVL_WARN, _idStr << " mlock err=" << cmd->errorCode);
         }
+        auto status = _memMan->getStatus(_memHandle);
+        Usage usage;
+        usage.bytesLocked = status.bytesLock;
+        usage.subchunkBytes = status.bytesCopy;
+        addUsage(usage);
 
     }
     LOGS(_log, LOG_LVL_DEBUG, _idStr << " waitForMemMan end");
@@ -284,6 +321,16 @@ std::ostream& operator<<(std::ostream& os, Task const& t) {
     return os;
 }
 
+std::ostream& operator<<(std::ostream& os, Task::Usage const& usage) {
+    os << "cpuMs=" << usage.cpuTime.count() / 1000
+       << " bytesLocked=" << usage.bytesLocked
+       << " rowsExamined=" << usage.rowsExamined
+       << " rowsReturned=" << usage.rowsReturned
+       << " bytesTransmitted=" << usage.bytesTransmitted
+       << " subchunkBytes=" << usage.subchunkBytes;
+    return os;
+}
+
 std::ostream& operator<<(std::ostream& os, IdSet const& idSet) {
     // Limiting output as number of entries can be very large.
     int maxDisp = idSet.maxDisp; // only affects the amount of data printed.
@@ -28,6 +28,7 @@
 // System headers
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -36,6 +37,7 @@
 #include <string>
 
 // Qserv headers
+#include "global/DbTable.h"
 #include "global/intTypes.h"
 #include "memman/MemMan.h"
 #include "proto/ScanTableInfo.h"
@@ -112,6 +114,19 @@ public:
 
     enum class State {CREATED, QUEUED, RUNNING, FINISHED};
 
+    /// Resources used by a Task, or by all Tasks of a user query.
+    struct Usage {
+        std::chrono::microseconds cpuTime{0}; ///< CPU time of the worker thread running the Task.
+        std::uint64_t bytesLocked{0}; ///< Bytes of chunk tables locked in memory by MemMan.
+        std::uint64_t rowsExamined{0}; ///< Rows read by mysqld, 0 unless counting is enabled.
+        std::uint64_t rowsReturned{0}; ///< Rows sent to the czar.
+        std::uint64_t bytesTransmitted{0}; ///< Result bytes sent to the czar, headers included.
+        std::uint64_t subchunkBytes{0}; ///< Peak memory reserved for subchunk tables.
+
+        /// Add the values of 'other', except for subchunkBytes which keeps the peak.
+        Usage& operator+=(Usage const& other);
+    };
+
     struct ChunkEqual {
         bool operator()(Task::Ptr const& x, Task::Ptr const& y);
     };
@@ -148,6 +163,8 @@ public:
     int getAttemptCount() const { return _attemptCount; }
     bool getScanInteractive() {return _scanInteractive; }
     proto::ScanInfo& getScanInfo() { return _scanInfo; }
+    /// @return tables that subchunk tables are built from while this task runs.
+    DbTableSet const& getSubchunkTables() const { return _subchunkTables; }
     void setOnInteractive(bool val) { _onInteractive = val; }
     bool getOnInteractive() { return _onInteractive; }
     bool hasMemHandle() const { return _memHandle != memman::MemMan::HandleType::INVALID; }
@@ -171,6 +188,9 @@ public:
     void started(std::chrono::system_clock::time_point const& now);
     std::chrono::milliseconds finished(std::chrono::system_clock::time_point const& now);
 
+    Usage getUsage() const;
+    void addUsage(Usage const& usage); ///< Add 'usage' to the resources used by this Task.
+
 private:
     QueryId  const    _qId{0}; //< queryId from czar
     int      const    _jId{0}; //< jobId from czar
@@ -182,18 +202,22 @@ private:
     TaskQueryRunner::Ptr _taskQueryRunner;
     std::weak_ptr<TaskScheduler> _taskScheduler;
     proto::ScanInfo _scanInfo;
+    DbTableSet _subchunkTables;
     bool _scanInteractive; ///< True if the czar thinks this query should be interactive.
     bool _onInteractive{false}; ///< True if the scheduler put this task on the interactive (group) scheduler.
     std::atomic<memman::MemMan::Handle> _memHandle{memman::MemMan::HandleType::INVALID};
     memman::MemMan::Ptr _memMan;
 
-    mutable std::mutex _stateMtx; ///< Mutex to protect state related members _state, _???Time.
+    mutable std::mutex _stateMtx; ///< Mutex to protect state related members _state, _???Time, _usage.
     State _state{State::CREATED};
     std::chrono::system_clock::time_point _queueTime;
     std::chrono::system_clock::time_point _startTime;
     std::chrono::system_clock::time_point _finishTime;
+    Usage _usage; ///< Protected by _stateMtx.
 };
 
+std::ostream& operator<<(std::ostream& os, Task::Usage const& usage);
+
 /// MsgProcessor implementations handle incoming Task objects.
 struct MsgProcessor {
     virtual ~MsgProcessor() {}
@@ -49,9 +49,18 @@ WorkerConfig::WorkerConfig(const util::ConfigStore& configStore)
     : _mySqlConfig(configStore.getRequired("mysql.username"),
             configStore.get("mysql.password"),
             configStore.getRequired("mysql.socket")),
+      _mySqlPoolMaxIdle(configStore.getInt("mysql.pool_max_idle", 8)),
+      _mySqlPoolIdleTimeout(configStore.getInt("mysql.pool_idle_timeout", 300)),
+      _mySqlCountRowsExamined(configStore.getInt("mysql.count_rows_examined", 0) != 0),
+      _inventorySnapshot(configStore.get("inventory.snapshot")),
+      _inventoryThreads(configStore.getInt("inventory.threads", 4)),
+      _monitorPort(configStore.getInt("monitor.port", 0)),
+      _monitorPeriodMs(configStore.getInt("monitor.period_ms", 1000)),
       _memManClass(configStore.get("memman.class", "MemManReal")),
       _memManSizeMb(configStore.getInt("memman.memory", 1000)),
+      _memManCopyPercent(configStore.getInt("memman.copy_percent", 300)),
       _memManLocation(configStore.getRequired("memman.location")),
+      _resultCacheSizeMb(configStore.getInt("resultcache.memory", 0)),
       _threadPoolSize(configStore.getInt("scheduler.thread_pool_size", wsched::BlendScheduler::getMinPoolSize())),
       _maxGroupSize(configStore.getInt("scheduler.group_size", 1)),
       _requiredTasksCompleted(configStore.getInt("scheduler.required_tasks_completed", 25)),
@@ -77,8 +86,17 @@ WorkerConfig::WorkerConfig(const util::ConfigStore& configStore)
 std::ostream& operator<<(std::ostream &out, WorkerConfig const& workerConfig) {
     out << "MemManClass=" << workerConfig._memManClass;
     if (workerConfig._memManClass == "MemManReal") {
-        out << "MemManSizeMb=" << workerConfig._memManSizeMb;
+        out << "MemManSizeMb=" << workerConfig._memManSizeMb
+            << " MemManCopyPercent=" << workerConfig._memManCopyPercent;
     }
+    out << " resultCacheSizeMb=" << workerConfig._resultCacheSizeMb;
+    out << " mySqlPoolMaxIdle=" << workerConfig._mySqlPoolMaxIdle
+        << " mySqlPoolIdleTimeout=" << workerConfig._mySqlPoolIdleTimeout
+        << " mySqlCountRowsExamined=" << workerConfig._mySqlCountRowsExamined;
+    out << " inventorySnapshot=" << workerConfig._inventorySnapshot
+        << " inventoryThreads=" << workerConfig._inventoryThreads;
+    out << " monitorPort=" << workerConfig._monitorPort
+        << " monitorPeriodMs=" << workerConfig._monitorPeriodMs;
     out << " poolSize=" << workerConfig._threadPoolSize << ", maxGroupSize=" << workerConfig._maxGroupSize;
     out << " requiredTasksCompleted=" << workerConfig._requiredTasksCompleted;
 
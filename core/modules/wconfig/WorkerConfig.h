@@ -185,6 +185,79 @@ public:
         return _memManSizeMb;
     }
 
+    /* Get memory reserved by Memory Manager for an in-memory copy of a table
+     *
+     * @return reservation in percent of the size of the table's data file
+     */
+    unsigned int getMemManCopyPercent() const {
+        return _memManCopyPercent;
+    }
+
+    /* Get maximum amount of memory used to cache chunk query results, 0 disables the cache
+     *
+     * @return maximum amount of memory used to cache chunk query results, in MB
+     */
+    uint64_t getResultCacheSizeMb() const {
+        return _resultCacheSizeMb;
+    }
+
+    /* Get maximum number of idle MySQL connections kept per user, 0 disables pooling
+     *
+     * @return maximum number of idle MySQL connections kept per user
+     */
+    unsigned int getMySqlPoolMaxIdle() const {
+        return _mySqlPoolMaxIdle;
+    }
+
+    /* Get time after which idle pooled MySQL connections are closed
+     *
+     * @return time after which idle pooled MySQL connections are closed, in seconds
+     */
+    unsigned int getMySqlPoolIdleTimeout() const {
+        return _mySqlPoolIdleTimeout;
+    }
+
+    /* Get whether the rows mysqld reads for chunk queries are counted, which
+     * costs two status queries per task
+     *
+     * @return true if rows examined by chunk queries are counted
+     */
+    bool getMySqlCountRowsExamined() const {
+        return _mySqlCountRowsExamined;
+    }
+
+    /* Get path of the chunk inventory snapshot, empty disables the snapshot
+     *
+     * @return path of the chunk inventory snapshot
+     */
+    std::string const& getInventorySnapshot() const {
+        return _inventorySnapshot;
+    }
+
+    /* Get maximum number of databases scanned at once when building the chunk inventory
+     *
+     * @return maximum number of databases scanned at once
+     */
+    unsigned int getInventoryThreads() const {
+        return _inventoryThreads;
+    }
+
+    /* Get port of the HTTP status monitor, 0 disables the monitor
+     *
+     * @return port of the HTTP status monitor
+     */
+    unsigned int getMonitorPort() const {
+        return _monitorPort;
+    }
+
+    /* Get time between updates of the HTTP status monitor
+     *
+     * @return time between updates of the status, in milliseconds
+     */
+    unsigned int getMonitorPeriodMs() const {
+        return _monitorPeriodMs;
+    }
+
     /* Get MySQL configuration for worker MySQL instance
      *
      * @return a structure containing MySQL parameters
@@ -271,11 +344,23 @@ private:
     WorkerConfig(util::ConfigStore const& configStore);
 
     mysql::MySqlConfig const _mySqlConfig;
+    unsigned int const _mySqlPoolMaxIdle;
+    unsigned int const _mySqlPoolIdleTimeout;
+    bool const _mySqlCountRowsExamined;
+
+    std::string const _inventorySnapshot;
+    unsigned int const _inventoryThreads;
+
+    unsigned int const _monitorPort;
+    unsigned int const _monitorPeriodMs;
 
     std::string const _memManClass;
     uint64_t const _memManSizeMb;
+    unsigned int const _memManCopyPercent;
     std::string const _memManLocation;
 
+    uint64_t const _resultCacheSizeMb;
+
     unsigned int const _threadPoolSize;
     unsigned int const _maxGroupSize;
     unsigned int const _requiredTasksCompleted;
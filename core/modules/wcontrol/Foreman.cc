@@ -38,10 +38,12 @@
 
 // Qserv headers
 #include "mysql/MySqlConfig.h"
+#include "mysql/MySqlConnectionPool.h"
 #include "proto/worker.pb.h"
 #include "wbase/Base.h"
 #include "wbase/SendChannel.h"
 #include "wdb/ChunkResource.h"
+#include "wdb/ChunkResultCache.h"
 #include "wdb/QueryRunner.h"
 
 namespace {
@@ -53,8 +55,12 @@ namespace qserv {
 namespace wcontrol {
 
 Foreman::Foreman(Scheduler::Ptr const& s, uint poolSize, mysql::MySqlConfig const& mySqlConfig,
-    wpublish::QueriesAndChunks::Ptr const& queries)
-    : _scheduler{s}, _mySqlConfig(mySqlConfig), _queries{queries} {
+    wpublish::QueriesAndChunks::Ptr const& queries,
+    std::shared_ptr<wdb::ChunkResultCache> const& resultCache,
+    std::shared_ptr<mysql::MySqlConnectionPool> const& connectionPool,
+    bool countRowsExamined)
+    : _scheduler{s}, _mySqlConfig(mySqlConfig), _queries{queries}, _resultCache{resultCache},
+      _connectionPool{connectionPool}, _countRowsExamined{countRowsExamined} {
     // Make the chunk resource mgr
     // Creating backend makes a connection to the database for making temporary tables.
     // It will delete temporary tables that it can identify as being created by a worker.
@@ -88,7 +94,9 @@ void Foreman::processTask(std::shared_ptr<wbase::Task> const& task) {
                 task->sendChannel->sendError("Unsupported wire protocol", 1);
             }
         } else {
-            auto qr = wdb::QueryRunner::newQueryRunner(task, _chunkResourceMgr, _mySqlConfig);
+            auto qr = wdb::QueryRunner::newQueryRunner(task, _chunkResourceMgr, _mySqlConfig,
+                                                       _resultCache, _connectionPool,
+                                                       _countRowsExamined);
             qr->runQuery();
         }
     };
@@ -98,4 +106,19 @@ void Foreman::processTask(std::shared_ptr<wbase::Task> const& task) {
     _scheduler->queCmd(task);
 }
 
+
+boost::property_tree::ptree Foreman::statusJson() {
+    boost::property_tree::ptree status;
+    status.put("threadPool.size", _pool->size());
+    status.put("threadPool.target", _pool->getTargetThrdCount());
+    status.add_child("scheduler", _scheduler->statusJson());
+    status.add_child("queries", _queries->statusJson());
+    return status;
+}
+
+
+boost::property_tree::ptree Foreman::chunkStatusJson() {
+    return _queries->chunkStatusJson();
+}
+
 }}} // namespace
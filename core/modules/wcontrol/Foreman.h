@@ -28,6 +28,9 @@
 #include <atomic>
 #include <memory>
 
+// Third-party headers
+#include "boost/property_tree/ptree.hpp"
+
 // Qserv headers
 #include "mysql/MySqlConfig.h"
 #include "util/EventThread.h"
@@ -39,9 +42,13 @@
 // Forward declarations
 namespace lsst {
 namespace qserv {
+namespace mysql {
+    class MySqlConnectionPool;
+}
 namespace wdb {
     class SQLBackend;
     class ChunkResourceMgr;
+    class ChunkResultCache;
     class QueryRunner;
 }}}
 
@@ -58,6 +65,13 @@ public:
 
     virtual std::string getName() const = 0; //< @return the name of the scheduler.
 
+    /// @return a tree describing the current state of the scheduler, meant to be written as JSON.
+    virtual boost::property_tree::ptree statusJson() {
+        boost::property_tree::ptree status;
+        status.put("name", getName());
+        return status;
+    }
+
     /// Take appropriate action when a task in the Schedule is cancelled. Doing
     /// nothing should be harmless, but some Schedulers may work better if cancelled
     /// tasks are removed.
@@ -69,8 +83,13 @@ public:
 /// The schedulers may limit the number of threads they will use from the thread pool.
 class Foreman : public wbase::MsgProcessor {
 public:
+    /// @param resultCache - cache for chunk query results, may be null.
+    /// @param connectionPool - pool of MySQL connections for tasks, may be null.
     Foreman(Scheduler::Ptr const& s, uint poolSize, mysql::MySqlConfig const& mySqlConfig,
-            wpublish::QueriesAndChunks::Ptr const& queries);
+            wpublish::QueriesAndChunks::Ptr const& queries,
+            std::shared_ptr<wdb::ChunkResultCache> const& resultCache=nullptr,
+            std::shared_ptr<mysql::MySqlConnectionPool> const& connectionPool=nullptr,
+            bool countRowsExamined=false);
     virtual ~Foreman();
     // This class should not be copied.
     Foreman(Foreman const&) = delete;
@@ -78,6 +97,13 @@ public:
 
     void processTask(std::shared_ptr<wbase::Task> const& task) override;
 
+    /// @return a tree describing the thread pool, the scheduler and the user queries
+    ///         on this worker, meant to be written as JSON.
+    boost::property_tree::ptree statusJson();
+
+    /// @return statistics for every scan table in every chunk, meant to be written as JSON.
+    boost::property_tree::ptree chunkStatusJson();
+
 private:
     std::shared_ptr<wdb::SQLBackend> _backend;
     std::shared_ptr<wdb::ChunkResourceMgr> _chunkResourceMgr;
@@ -85,6 +111,9 @@ private:
     Scheduler::Ptr _scheduler;
     mysql::MySqlConfig const _mySqlConfig;
     wpublish::QueriesAndChunks::Ptr _queries;
+    std::shared_ptr<wdb::ChunkResultCache> _resultCache;
+    std::shared_ptr<mysql::MySqlConnectionPool> _connectionPool;
+    bool const _countRowsExamined; ///< Passed to every QueryRunner.
 
 };
 
@@ -0,0 +1,119 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "wcontrol/HttpMonitor.h"
+
+// System headers
+#include <sstream>
+
+// Third-party headers
+#include "boost/property_tree/json_parser.hpp"
+
+// LSST headers
+#include "lsst/log/Log.h"
+
+namespace {
+LOG_LOGGER _log = LOG_GET("lsst.qserv.wcontrol.HttpMonitor");
+}
+
+namespace lsst {
+namespace qserv {
+namespace wcontrol {
+
+HttpMonitor::HttpMonitor(unsigned short port, std::chrono::milliseconds period,
+                         StatusFunc const& status, StatusFunc const& chunkStatus)
+    : _period{period}, _statusFunc{status}, _chunkStatusFunc{chunkStatus}, _timer{_service} {
+    _server = qhttp::Server::create(_service, port);
+    _port = _server->getPort();
+    _server->addHandlers({
+        {"GET", "/status", [this](qhttp::Request::Ptr, qhttp::Response::Ptr resp) {
+            resp->send(getStatus(), "application/json");
+        }},
+        {"GET", "/status/chunks", [this](qhttp::Request::Ptr, qhttp::Response::Ptr resp) {
+            try {
+                resp->send(toJson(_chunkStatusFunc()), "application/json");
+            } catch (std::exception const& e) {
+                LOGS(_log, LOG_LVL_WARN, "HttpMonitor chunk status failed " << e.what());
+                resp->sendStatus(500);
+            }
+        }}
+    });
+    _live = _server->addAjaxEndpoint("/status/live");
+    _server->accept();
+
+    // The first status is built as soon as the service starts.
+    _service.post([this]() { _update(); });
+    _thread = std::thread([this]() { _service.run(); });
+    LOGS(_log, LOG_LVL_INFO, "HttpMonitor listening on port " << _port);
+}
+
+
+HttpMonitor::~HttpMonitor() {
+    _service.stop();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+
+std::string HttpMonitor::getStatus() {
+    std::lock_guard<std::mutex> lock(_statusMtx);
+    return _status;
+}
+
+
+std::string HttpMonitor::toJson(boost::property_tree::ptree const& tree) {
+    std::ostringstream os;
+    boost::property_tree::write_json(os, tree, false);
+    return os.str();
+}
+
+
+void HttpMonitor::_scheduleUpdate() {
+    _timer.expires_from_now(_period);
+    _timer.async_wait([this](boost::system::error_code const& ec) {
+        if (!ec) _update();
+    });
+}
+
+
+/// Rebuild the status, hand it to pending long polls, and schedule the next rebuild.
+void HttpMonitor::_update() {
+    try {
+        auto tree = _statusFunc();
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        tree.put("timeMs", std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+        std::string json = toJson(tree);
+        {
+            std::lock_guard<std::mutex> lock(_statusMtx);
+            _status = json;
+        }
+        _live->update(json);
+    } catch (std::exception const& e) {
+        LOGS(_log, LOG_LVL_WARN, "HttpMonitor status failed " << e.what());
+    }
+    _scheduleUpdate();
+}
+
+}}} // namespace lsst::qserv::wcontrol
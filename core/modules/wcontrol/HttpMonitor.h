@@ -0,0 +1,103 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_QSERV_WCONTROL_HTTPMONITOR_H
+#define LSST_QSERV_WCONTROL_HTTPMONITOR_H
+
+// System headers
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Third-party headers
+#include "boost/asio.hpp"
+#include "boost/asio/steady_timer.hpp"
+#include "boost/property_tree/ptree.hpp"
+
+// Qserv headers
+#include "qhttp/AjaxEndpoint.h"
+#include "qhttp/Server.h"
+
+namespace lsst {
+namespace qserv {
+namespace wcontrol {
+
+/// HttpMonitor serves the state of the worker as JSON over HTTP.
+///
+/// The status is rebuilt once per period on the server's own thread, so the cost
+/// of monitoring does not depend on how many clients are polling:
+///   GET /status         - the most recent status.
+///   GET /status/live    - long poll, answered with the next status when it is built.
+///   GET /status/chunks  - scan table statistics for every chunk, built on request
+///                         as this can be large.
+class HttpMonitor {
+public:
+    using Ptr = std::shared_ptr<HttpMonitor>;
+    using StatusFunc = std::function<boost::property_tree::ptree()>;
+
+    /// @param port - TCP port to listen on, 0 lets the system pick one.
+    /// @param period - time between rebuilding the status.
+    /// @param status - returns the status of the worker.
+    /// @param chunkStatus - returns the chunk statistics of the worker.
+    /// @throws boost::system::system_error if the port cannot be bound.
+    HttpMonitor(unsigned short port, std::chrono::milliseconds period,
+                StatusFunc const& status, StatusFunc const& chunkStatus);
+    ~HttpMonitor();
+
+    HttpMonitor(HttpMonitor const&) = delete;
+    HttpMonitor& operator=(HttpMonitor const&) = delete;
+
+    unsigned short getPort() { return _port; }
+
+    /// @return the most recent status, as a JSON string.
+    std::string getStatus();
+
+    /// @return 'tree' written as a JSON string.
+    static std::string toJson(boost::property_tree::ptree const& tree);
+
+private:
+    void _scheduleUpdate();
+    void _update();
+
+    std::chrono::milliseconds const _period;
+    StatusFunc const _statusFunc;
+    StatusFunc const _chunkStatusFunc;
+
+    boost::asio::io_service _service;
+    boost::asio::steady_timer _timer;
+    qhttp::Server::Ptr _server;
+    qhttp::AjaxEndpoint::Ptr _live;
+    unsigned short _port{0};
+
+    std::mutex _statusMtx; ///< Protects _status.
+    std::string _status{"{}"};
+
+    std::thread _thread; ///< Runs _service.
+};
+
+}}} // namespace lsst::qserv::wcontrol
+
+#endif // LSST_QSERV_WCONTROL_HTTPMONITOR_H
@@ -0,0 +1,159 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// Class header
+#include "wdb/ChunkResultCache.h"
+
+// System headers
+#include <algorithm>
+#include <cctype>
+
+// Qserv headers
+#include "util/StringHash.h"
+
+namespace {
+
+inline bool isIdentChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+} // namespace
+
+namespace lsst {
+namespace qserv {
+namespace wdb {
+
+ChunkResultCache::ChunkResultCache(std::uint64_t maxBytes)
+    : _maxBytes(maxBytes) {
+}
+
+
+std::string ChunkResultCache::makeKey(std::string const& description) {
+    return util::StringHash::getSha256Hex(description.data(), description.size());
+}
+
+
+std::vector<ChunkResultCache::DbTable>
+ChunkResultCache::getChunkTables(std::string const& query, int chunkId) {
+    std::vector<DbTable> tables;
+    std::string const suffix = "_" + std::to_string(chunkId);
+    std::size_t const size = query.size();
+    for (auto pos = query.find(suffix); pos != std::string::npos; pos = query.find(suffix, pos + 1)) {
+        std::size_t const end = pos + suffix.size();
+        if (end < size && isIdentChar(query[end])) {
+            continue; // e.g. subchunk table or longer chunk number
+        }
+        std::size_t tblBegin = pos;
+        while (tblBegin > 0 && isIdentChar(query[tblBegin - 1])) --tblBegin;
+        if (tblBegin == pos || tblBegin < 2 || query[tblBegin - 1] != '.') {
+            continue; // not qualified by a database name
+        }
+        std::size_t const dbEnd = tblBegin - 1;
+        std::size_t dbBegin = dbEnd;
+        while (dbBegin > 0 && isIdentChar(query[dbBegin - 1])) --dbBegin;
+        if (dbBegin == dbEnd) {
+            continue;
+        }
+        DbTable dbTable(query.substr(dbBegin, dbEnd - dbBegin), query.substr(tblBegin, end - tblBegin));
+        if (std::find(tables.begin(), tables.end(), dbTable) == tables.end()) {
+            tables.push_back(dbTable);
+        }
+    }
+    return tables;
+}
+
+
+ChunkResultCache::MessagesPtr ChunkResultCache::get(std::string const& key) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto iter = _map.find(key);
+    if (iter == _map.end()) {
+        ++_misses;
+        return MessagesPtr();
+    }
+    ++_hits;
+    // Move to the front of the LRU list, iterators stay valid.
+    _lru.splice(_lru.begin(), _lru, iter->second);
+    return iter->second->messages;
+}
+
+
+void ChunkResultCache::put(std::string const& key, MessagesPtr const& messages) {
+    std::uint64_t const bytes = sizeOf(*messages);
+    if (bytes > getMaxEntryBytes()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto iter = _map.find(key);
+    if (iter != _map.end()) {
+        _bytes -= iter->second->bytes;
+        iter->second->messages = messages;
+        iter->second->bytes = bytes;
+        _bytes += bytes;
+        _lru.splice(_lru.begin(), _lru, iter->second);
+    } else {
+        _lru.push_front(Entry{key, messages, bytes});
+        _map[key] = _lru.begin();
+        _bytes += bytes;
+    }
+    while (_bytes > _maxBytes) {
+        auto& last = _lru.back();
+        _bytes -= last.bytes;
+        _map.erase(last.key);
+        _lru.pop_back();
+    }
+}
+
+
+std::size_t ChunkResultCache::size() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _map.size();
+}
+
+
+std::uint64_t ChunkResultCache::getBytes() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _bytes;
+}
+
+
+std::uint64_t ChunkResultCache::getHits() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _hits;
+}
+
+
+std::uint64_t ChunkResultCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _misses;
+}
+
+
+std::uint64_t ChunkResultCache::sizeOf(Messages const& messages) {
+    std::uint64_t bytes = 0;
+    for (auto const& msg : messages) {
+        bytes += msg.size();
+    }
+    return bytes;
+}
+
+}}} // namespace lsst::qserv::wdb
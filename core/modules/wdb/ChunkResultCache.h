@@ -0,0 +1,111 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef LSST_QSERV_WDB_CHUNKRESULTCACHE_H
+#define LSST_QSERV_WDB_CHUNKRESULTCACHE_H
+
+// System headers
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace lsst {
+namespace qserv {
+namespace wdb {
+
+/// ChunkResultCache keeps the serialized proto::Result messages sent for a
+/// chunk query, so that identical chunk queries, e.g. retried jobs or
+/// resubmitted user queries, are answered without running them again.
+///
+/// Entries are keyed by a hash of everything that determines the result:
+/// the fragment queries, chunk, subchunks, user and the version of the chunk
+/// tables (see makeKey() and getChunkTables()). The total size of the cached
+/// messages is bounded, the least recently used entries are evicted first.
+///
+/// All methods are thread-safe.
+class ChunkResultCache {
+public:
+    typedef std::shared_ptr<ChunkResultCache> Ptr;
+    /// Serialized proto::Result messages of a chunk query, in transmission order.
+    typedef std::vector<std::string> Messages;
+    typedef std::shared_ptr<Messages const> MessagesPtr;
+    /// Database and table name.
+    typedef std::pair<std::string, std::string> DbTable;
+
+    /// @param maxBytes - maximum total size of the cached messages, 0 disables caching.
+    explicit ChunkResultCache(std::uint64_t maxBytes);
+
+    ChunkResultCache(ChunkResultCache const&) = delete;
+    ChunkResultCache& operator=(ChunkResultCache const&) = delete;
+
+    /// @return cache key for the text describing a chunk query.
+    static std::string makeKey(std::string const& description);
+
+    /// @return the chunk tables, e.g. LSST.Object_1234 or
+    /// LSST.ObjectFullOverlap_1234, referenced as db.table in a query.
+    /// Subchunk tables are made from the chunk tables and are not listed.
+    static std::vector<DbTable> getChunkTables(std::string const& query, int chunkId);
+
+    /// @return cached messages, null pointer if key is not cached.
+    MessagesPtr get(std::string const& key);
+
+    /// Add messages under key, ignored if they are larger than getMaxEntryBytes().
+    void put(std::string const& key, MessagesPtr const& messages);
+
+    /// @return the size above which results are not cached.
+    std::uint64_t getMaxEntryBytes() const { return _maxBytes / 4; }
+
+    bool isEnabled() const { return _maxBytes > 0; }
+
+    std::size_t size() const;
+    std::uint64_t getBytes() const;
+    std::uint64_t getHits() const;
+    std::uint64_t getMisses() const;
+
+    /// @return total size of messages.
+    static std::uint64_t sizeOf(Messages const& messages);
+
+private:
+    struct Entry {
+        std::string key;
+        MessagesPtr messages;
+        std::uint64_t bytes;
+    };
+    typedef std::list<Entry> EntryList;
+
+    std::uint64_t const _maxBytes;
+    EntryList _lru; ///< Most recently used first.
+    std::unordered_map<std::string, EntryList::iterator> _map;
+    std::uint64_t _bytes{0};
+    std::uint64_t _hits{0};
+    std::uint64_t _misses{0};
+    mutable std::mutex _mtx; ///< Protects all members above.
+};
+
+}}} // namespace lsst::qserv::wdb
+
+#endif // LSST_QSERV_WDB_CHUNKRESULTCACHE_H
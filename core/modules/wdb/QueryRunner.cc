@@ -33,9 +33,12 @@
 
 // System headers
 #include <algorithm>
+#include <cctype>
 #include <cstddef>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <sstream>
 
 // Third-party headers
 #include <mysql/mysql.h>
@@ -63,12 +66,21 @@
 #include "util/MultiError.h"
 #include "util/StringHash.h"
 #include "util/threadSafe.h"
+#include "util/Timer.h"
 #include "wbase/Base.h"
 #include "wbase/SendChannel.h"
 #include "wdb/ChunkResource.h"
+#include "wdb/ChunkResultCache.h"
 
 namespace {
 LOG_LOGGER _log = LOG_GET("lsst.qserv.wdb.QueryRunner");
+
+/// @return true if name is a non-empty plain identifier, safe to quote in SQL.
+bool isIdentifier(std::string const& name) {
+    return !name.empty() && std::all_of(name.begin(), name.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+    });
+}
 }
 
 namespace lsst {
@@ -77,8 +89,12 @@ namespace wdb {
 
 QueryRunner::Ptr QueryRunner::newQueryRunner(wbase::Task::Ptr const& task,
                                              ChunkResourceMgr::Ptr const& chunkResourceMgr,
-                                             mysql::MySqlConfig const& mySqlConfig) {
-    Ptr qr{new QueryRunner{task, chunkResourceMgr, mySqlConfig}}; // Private constructor.
+                                             mysql::MySqlConfig const& mySqlConfig,
+                                             ChunkResultCache::Ptr const& resultCache,
+                                             mysql::MySqlConnectionPool::Ptr const& connectionPool,
+                                             bool countRowsExamined) {
+    Ptr qr{new QueryRunner{task, chunkResourceMgr, mySqlConfig, resultCache,
+                           connectionPool, countRowsExamined}}; // Private constructor.
     // Let the Task know this is its QueryRunner.
     bool cancelled = qr->_task->setTaskQueryRunner(qr);
     if (cancelled) {
@@ -92,8 +108,13 @@ QueryRunner::Ptr QueryRunner::newQueryRunner(wbase::Task::Ptr const& task,
 /// and correct setup of enable_shared_from_this.
 QueryRunner::QueryRunner(wbase::Task::Ptr const& task,
                          ChunkResourceMgr::Ptr const& chunkResourceMgr,
-                         mysql::MySqlConfig const& mySqlConfig)
-    : _task(task), _chunkResourceMgr(chunkResourceMgr), _mySqlConfig(mySqlConfig) {
+                         mysql::MySqlConfig const& mySqlConfig,
+                         ChunkResultCache::Ptr const& resultCache,
+                         mysql::MySqlConnectionPool::Ptr const& connectionPool,
+                         bool countRowsExamined)
+    : _task(task), _chunkResourceMgr(chunkResourceMgr), _mySqlConfig(mySqlConfig),
+      _connectionPool(connectionPool), _resultCache(resultCache),
+      _countRowsExamined(countRowsExamined) {
     int rc = mysql_thread_init();
     assert(rc == 0);
     assert(_task->msg);
@@ -103,9 +124,14 @@ QueryRunner::QueryRunner(wbase::Task::Ptr const& task,
 bool QueryRunner::_initConnection() {
     mysql::MySqlConfig localMySqlConfig(_mySqlConfig);
     localMySqlConfig.username = _task->user; // Override with czar-passed username.
-    _mysqlConn.reset(new mysql::MySqlConnection(localMySqlConfig));
+    if (_connectionPool) {
+        _mysqlConn = _connectionPool->acquire(localMySqlConfig);
+    } else {
+        _mysqlConn = std::make_shared<mysql::MySqlConnection>(localMySqlConfig);
+        _mysqlConn->connect();
+    }
 
-    if (not _mysqlConn->connect()) {
+    if (not _mysqlConn->connected()) {
         LOGS(_log, LOG_LVL_ERROR, "Unable to connect to MySQL: " << localMySqlConfig);
         util::Error error(-1, "Unable to connect to MySQL; " + localMySqlConfig.toString());
         _multiError.push_back(error);
@@ -134,12 +160,44 @@ bool QueryRunner::runQuery() {
         wbase::TaskQueryRunner *_tqr;
     };
     Release release(_task, this);
+    // Record the resources used by the task however this function exits.
+    class RecordUsage {
+    public:
+        RecordUsage(QueryRunner& qr) : _qr(qr), _cpuStart{util::threadCpuTime()} {}
+        ~RecordUsage() {
+            _qr._usage.cpuTime = util::threadCpuTime() - _cpuStart;
+            _qr._task->addUsage(_qr._usage);
+        }
+    private:
+        QueryRunner& _qr;
+        std::chrono::microseconds _cpuStart;
+    };
+    RecordUsage recordUsage(*this);
 
     if (_task->getCancelled()) {
         LOGS(_log, LOG_LVL_DEBUG, _task->getIdStr() << " runQuery, task was cancelled before it started.");
         return false;
     }
 
+    _setDb();
+    bool connOk = false;
+    // Check the result cache before waiting for memman, a cached result doesn't need
+    // the tables to be locked in memory.
+    if (_resultCache != nullptr && _resultCache->isEnabled()
+        && _task->msg->has_protocol() && _task->msg->protocol() == 2) {
+        connOk = _initConnection();
+        if (!connOk) { return false; }
+        _resultCacheKey = _makeResultCacheKey();
+        if (!_resultCacheKey.empty()) {
+            auto messages = _resultCache->get(_resultCacheKey);
+            if (messages != nullptr) {
+                LOGS(_log, LOG_LVL_DEBUG, _task->getIdStr() << " sending cached result");
+                return _replayResult(*messages);
+            }
+            _cacheMessages = std::make_shared<ChunkResultCache::Messages>();
+        }
+    }
+
     // Wait for memman to finish reserving resources. This can take several seconds.
     _task->waitForMemMan();
 
@@ -148,10 +206,11 @@ bool QueryRunner::runQuery() {
         return false;
     }
 
-    _setDb();
     LOGS(_log, LOG_LVL_DEBUG,  _task->getIdStr() << " Exec in flight for Db=" << _dbName);
-    bool connOk = _initConnection();
-    if (!connOk) { return false; }
+    if (!connOk) {
+        connOk = _initConnection();
+        if (!connOk) { return false; }
+    }
 
     if (_task->msg->has_protocol()) {
         switch(_task->msg->protocol()) {
@@ -293,6 +352,14 @@ void QueryRunner::_transmit(bool last, uint rowCount, size_t tSize) {
         LOGS(_log, LOG_LVL_ERROR, msg);
     }
     _result->SerializeToString(&resultString);
+    if (_cacheMessages != nullptr) {
+        _cacheBytes += resultString.size();
+        if (_cacheBytes > _resultCache->getMaxEntryBytes()) {
+            _cacheMessages.reset(); // Too large to be cached, stop recording.
+        } else {
+            _cacheMessages->push_back(resultString);
+        }
+    }
     _transmitHeader(resultString);
     LOGS(_log, LOG_LVL_DEBUG, "_transmit last=" << last << " " << _task->getIdStr()
          << " resultString=" << util::prettyCharList(resultString, 5));
@@ -300,6 +367,9 @@ void QueryRunner::_transmit(bool last, uint rowCount, size_t tSize) {
         bool sent = _task->sendChannel->sendStream(resultString.data(), resultString.size(), last);
         if (!sent) {
             LOGS(_log, LOG_LVL_ERROR, _task->getIdStr() << " Failed to transmit message!");
+        } else {
+            _usage.rowsReturned += rowCount;
+            _usage.bytesTransmitted += resultString.size();
         }
     } else {
         LOGS(_log, LOG_LVL_DEBUG, "_transmit cancelled");
@@ -327,12 +397,138 @@ void QueryRunner::_transmitHeader(std::string& msg) {
         bool sent = _task->sendChannel->sendStream(msgBuf.data(), msgBuf.size(), false);
         if (!sent) {
             LOGS(_log, LOG_LVL_ERROR, _task->getIdStr() << " Failed to transmit header!");
+        } else {
+            _usage.bytesTransmitted += msgBuf.size();
         }
     } else {
         LOGS(_log, LOG_LVL_DEBUG, _task->getIdStr() << " _transmitHeader cancelled");
     }
 }
 
+/// @return the key of the result cache entry for the task, or an empty string if the
+/// result cannot be cached. The key covers the fragment queries, the subchunks and
+/// the version (update time and row count) of every chunk table the queries read,
+/// including the chunk and overlap tables the subchunk tables are made from.
+/// Results of queries that don't read a chunk table, or read tables without an
+/// update time, are not cached as changes to those tables cannot be detected.
+std::string QueryRunner::_makeResultCacheKey() {
+    proto::TaskMsg const& m = *_task->msg;
+    std::ostringstream desc;
+    desc << "user=" << _task->user << " db=" << _dbName << " chunk=" << m.chunkid();
+    std::vector<ChunkResultCache::DbTable> tables;
+    for (auto const& fragment : m.fragment()) {
+        for (auto const& query : fragment.query()) {
+            desc << " query=" << query;
+            for (auto const& dbTable : ChunkResultCache::getChunkTables(query, m.chunkid())) {
+                if (std::find(tables.begin(), tables.end(), dbTable) == tables.end()) {
+                    tables.push_back(dbTable);
+                }
+            }
+        }
+        if (fragment.has_subchunks()) {
+            proto::TaskMsg_Subchunk const& sc = fragment.subchunks();
+            desc << " subchunks=" << sc.database();
+            for (auto const& dbTbl : sc.dbtbl()) {
+                desc << "," << dbTbl.db() << "." << dbTbl.tbl();
+                // Subchunk tables are filled from the chunk table and its
+                // overlap, which the queries don't name.
+                if (!isIdentifier(dbTbl.db()) || !isIdentifier(dbTbl.tbl())) {
+                    return std::string();
+                }
+                std::string const chunkSuffix = "_" + std::to_string(m.chunkid());
+                for (auto const& dbTable : {
+                        ChunkResultCache::DbTable(dbTbl.db(), dbTbl.tbl() + chunkSuffix),
+                        ChunkResultCache::DbTable(dbTbl.db(), dbTbl.tbl() + "FullOverlap" + chunkSuffix)}) {
+                    if (std::find(tables.begin(), tables.end(), dbTable) == tables.end()) {
+                        tables.push_back(dbTable);
+                    }
+                }
+            }
+            for (auto id : sc.id()) {
+                desc << "," << id;
+            }
+        }
+    }
+    if (tables.empty()) {
+        return std::string();
+    }
+
+    // Names found by getChunkTables() or checked above only contain identifier characters.
+    std::string sql;
+    for (auto const& dbTable : tables) {
+        if (!sql.empty()) sql += " UNION ALL ";
+        sql += "SELECT TABLE_SCHEMA, TABLE_NAME, UPDATE_TIME, TABLE_ROWS FROM information_schema.TABLES"
+               " WHERE TABLE_SCHEMA='" + dbTable.first + "' AND TABLE_NAME='" + dbTable.second + "'";
+    }
+    if (!_mysqlConn->queryUnbuffered(sql)) {
+        LOGS(_log, LOG_LVL_WARN, _task->getIdStr() << " result cache, failed to get table versions: "
+             << _mysqlConn->getError());
+        return std::string();
+    }
+    MYSQL_RES* result = _mysqlConn->getResult();
+    unsigned int numRows = 0;
+    bool versioned = true;
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(result))) {
+        ++numRows;
+        if (row[0] == nullptr || row[1] == nullptr || row[2] == nullptr) {
+            versioned = false;
+            continue;
+        }
+        desc << " table=" << row[0] << "." << row[1] << "@" << row[2] << ":" << (row[3] ? row[3] : "");
+    }
+    _mysqlConn->freeResult();
+    if (!versioned || numRows != tables.size()) {
+        return std::string();
+    }
+    return ChunkResultCache::makeKey(desc.str());
+}
+
+/// Send a cached result, as if it had been produced by running the queries.
+bool QueryRunner::_replayResult(ChunkResultCache::Messages const& messages) {
+    _initMsgs();
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        if (_cancelled) {
+            _multiError.push_back(util::Error(-1, "Poisoned."));
+            return false;
+        }
+        _result = std::make_shared<proto::Result>();
+        if (!_result->ParseFromString(messages[i])) {
+            throw Bug("QueryRunner: Unparseable cached result");
+        }
+        if (_task->msg->has_session()) {
+            _result->set_session(_task->msg->session());
+        }
+        bool last = (i + 1 == messages.size());
+        _transmit(last, _result->rowcount(), _result->transmitsize());
+    }
+    return true;
+}
+
+/// Get the sum of the Handler_read counters of the session, the number of rows
+/// mysqld has read for it so far. The status query itself reads a few rows, so
+/// differences are slightly high.
+/// @return false if the counters could not be read.
+bool QueryRunner::_handlerReads(std::uint64_t& reads) {
+    reads = 0;
+    if (!_mysqlConn->queryUnbuffered("SHOW SESSION STATUS LIKE 'Handler_read%'")) {
+        LOGS(_log, LOG_LVL_DEBUG, _task->getIdStr() << " can't read Handler_read counters "
+             << _mysqlConn->getError());
+        return false;
+    }
+    MYSQL_RES* res = _mysqlConn->getResult();
+    if (res != nullptr) {
+        MYSQL_ROW row;
+        while ((row = mysql_fetch_row(res))) {
+            if (row[1] != nullptr) {
+                reads += std::strtoull(row[1], nullptr, 10);
+            }
+        }
+    }
+    _mysqlConn->freeResult();
+    return true;
+}
+
 class ChunkResourceRequest {
 public:
     ChunkResourceRequest(std::shared_ptr<ChunkResourceMgr> const& mgr,
@@ -391,6 +587,9 @@ bool QueryRunner::_dispatchChannel() {
 
     uint rowCount = 0;
     size_t tSize = 0;
+    // Counting rows examined costs a status query before and after the fragments.
+    std::uint64_t readsBefore = 0;
+    bool const countReads = _countRowsExamined && _handlerReads(readsBefore);
 
     try {
         for(int i=0; i < m.fragment_size(); ++i) {
@@ -426,9 +625,16 @@ bool QueryRunner::_dispatchChannel() {
         util::Error worker_err(e.errNo(), e.errMsg());
         _multiError.push_back(worker_err);
     }
+    std::uint64_t readsAfter = 0;
+    if (countReads && _handlerReads(readsAfter) && readsAfter >= readsBefore) {
+        _usage.rowsExamined += readsAfter - readsBefore;
+    }
     if (!_cancelled) {
         // Send results.
         _transmit(true, rowCount, tSize);
+        if (!erred && _multiError.empty() && _cacheMessages != nullptr) {
+            _resultCache->put(_resultCacheKey, _cacheMessages);
+        }
     } else {
         erred = true;
         // Send poison error.
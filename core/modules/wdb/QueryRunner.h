@@ -40,9 +40,11 @@
 // Qserv headers
 #include "mysql/MySqlConfig.h"
 #include "mysql/MySqlConnection.h"
+#include "mysql/MySqlConnectionPool.h"
 #include "util/MultiError.h"
 #include "wbase/Task.h"
 #include "wdb/ChunkResource.h"
+#include "wdb/ChunkResultCache.h"
 
 namespace lsst {
 namespace qserv {
@@ -62,7 +64,10 @@ public:
     using Ptr = std::shared_ptr<QueryRunner>;
     static QueryRunner::Ptr newQueryRunner(wbase::Task::Ptr const& task,
                                            ChunkResourceMgr::Ptr const& chunkResourceMgr,
-                                           mysql::MySqlConfig const& mySqlConfig);
+                                           mysql::MySqlConfig const& mySqlConfig,
+                                           ChunkResultCache::Ptr const& resultCache=nullptr,
+                                           mysql::MySqlConnectionPool::Ptr const& connectionPool=nullptr,
+                                           bool countRowsExamined=false);
     // Having more than one copy of this would making tracking its progress difficult.
     QueryRunner(QueryRunner const&) = delete;
     QueryRunner& operator=(QueryRunner const&) = delete;
@@ -74,7 +79,10 @@ public:
 protected:
     QueryRunner(wbase::Task::Ptr const& task,
                 ChunkResourceMgr::Ptr const& chunkResourceMgr,
-                mysql::MySqlConfig const& mySqlConfig);
+                mysql::MySqlConfig const& mySqlConfig,
+                ChunkResultCache::Ptr const& resultCache,
+                mysql::MySqlConnectionPool::Ptr const& connectionPool,
+                bool countRowsExamined);
 private:
     bool _initConnection();
     void _setDb();
@@ -87,6 +95,9 @@ private:
     void _initMsg();
     void _transmit(bool last, uint rowCount, size_t size);
     void _transmitHeader(std::string& msg);
+    std::string _makeResultCacheKey();
+    bool _handlerReads(std::uint64_t& reads);
+    bool _replayResult(ChunkResultCache::Messages const& messages);
 
     ///< Actual task
     wbase::Task::Ptr _task;
@@ -96,7 +107,8 @@ private:
     std::string _dbName;
     std::atomic<bool> _cancelled{false};
     mysql::MySqlConfig const _mySqlConfig;
-    std::unique_ptr<mysql::MySqlConnection> _mysqlConn;
+    mysql::MySqlConnectionPool::Ptr _connectionPool; ///< null if connections are not pooled
+    std::shared_ptr<mysql::MySqlConnection> _mysqlConn;
 
     util::MultiError _multiError; // Error log
 
@@ -104,6 +116,15 @@ private:
     std::shared_ptr<proto::Result> _result;
     bool _largeResult{false}; //< True for all transmits after the first transmit.
     unsigned int _initialBlockSize{5000}; //< Maximum size of initial transmit block.
+
+    ChunkResultCache::Ptr _resultCache; //< May be null.
+    std::string _resultCacheKey; //< Empty when the result cannot be cached.
+    /// Serialized messages recorded for _resultCache, null when not recording.
+    std::shared_ptr<ChunkResultCache::Messages> _cacheMessages;
+    std::uint64_t _cacheBytes{0}; //< Size of _cacheMessages.
+
+    wbase::Task::Usage _usage; //< Resources used, added to _task when runQuery() returns.
+    bool const _countRowsExamined; //< Fill _usage.rowsExamined from the Handler_read counters.
 };
 
 }}} // namespace
@@ -26,9 +26,11 @@
 #include "wdb/SQLBackend.h"
 
 // System headers
+#include <cstdlib>
 #include <iostream>
-
-// Third-party headers
+#include <map>
+#include <sstream>
+#include <utility>
 
 // LSST headers
 #include "lsst/log/Log.h"
@@ -57,22 +59,54 @@ std::ostream& operator<<(std::ostream& os, ScTable const& st) {
 
 
 bool SQLBackend::load(ScTableVector const& v, sql::SqlErrorObject& err) {
-    using namespace lsst::qserv::wbase;
     memLockRequireOwnership();
-    for(ScTableVector::const_iterator i=v.begin(), e=v.end();
-            i != e; ++i) {
+    // Group the subchunks by chunk table so that every chunk table is
+    // scanned once, no matter how many of its subchunks are needed.
+    std::map<std::pair<int, DbTable>, IntVector> chunkTables;
+    for (auto const& scTbl : v) {
+        chunkTables[std::make_pair(scTbl.chunkId, scTbl.dbTable)].push_back(scTbl.subChunkId);
+    }
+    ScTableVector loaded;
+    for (auto const& elem : chunkTables) {
+        int chunkId = elem.first.first;
+        DbTable const& dbTable = elem.first.second;
+        IntVector const& subChunkIds = elem.second;
+        ScTableVector group;
+        for (int subChunkId : subChunkIds) {
+            group.push_back(ScTable(chunkId, dbTable, subChunkId));
+        }
+        bool loadOk = false;
+        if (chunkId == DUMMY_CHUNK || subChunkIds.size() == 1) {
+            // Nothing to gain from grouping a single subchunk.
+            loadOk = _loadEach(group, err);
+        } else {
+            loadOk = _loadGroup(chunkId, dbTable, subChunkIds, err);
+        }
+        loaded.insert(loaded.end(), group.begin(), group.end());
+        if (!loadOk) {
+            // Partially built tables of this group are dropped as well.
+            _discard(loaded.begin(), loaded.end());
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool SQLBackend::_loadEach(ScTableVector const& v, sql::SqlErrorObject& err) {
+    using namespace lsst::qserv::wbase;
+    for(auto const& scTbl : v) {
         std::string const* createScript = nullptr;
-        if (i->chunkId == DUMMY_CHUNK) {
+        if (scTbl.chunkId == DUMMY_CHUNK) {
             createScript = &CREATE_DUMMY_SUBCHUNK_SCRIPT;
         } else {
             createScript = &CREATE_SUBCHUNK_SCRIPT;
         }
         std::string create = (boost::format(*createScript)
-            % i->dbTable.db % i->dbTable.table % SUB_CHUNK_COLUMN
-                % i->chunkId % i->subChunkId).str();
+            % scTbl.dbTable.db % scTbl.dbTable.table % SUB_CHUNK_COLUMN
+                % scTbl.chunkId % scTbl.subChunkId).str();
 
-        if (!_sqlConn.runQuery(create, err)) {
-            _discard(v.begin(), i);
+        if (!_sqlConn->runQuery(create, err)) {
             return false;
         }
     }
@@ -80,6 +114,32 @@ bool SQLBackend::load(ScTableVector const& v, sql::SqlErrorObject& err) {
 }
 
 
+bool SQLBackend::_loadGroup(int chunkId, DbTable const& dbTable,
+                           IntVector const& subChunkIds, sql::SqlErrorObject& err) {
+    std::string script;
+    std::string subChunkList;
+    for (int subChunkId : subChunkIds) {
+        script += (boost::format(wbase::CREATE_EMPTY_SUBCHUNK_SCRIPT)
+            % dbTable.db % dbTable.table % chunkId % subChunkId).str();
+        if (!subChunkList.empty()) subChunkList += ",";
+        subChunkList += std::to_string(subChunkId);
+    }
+    // The chunk and overlap tables are scanned once, subchunks are then
+    // split from the staged rows through their hash index.
+    script += (boost::format(wbase::STAGE_SUBCHUNKS_SCRIPT)
+        % dbTable.db % dbTable.table % SUB_CHUNK_COLUMN % chunkId % subChunkList).str();
+    for (int subChunkId : subChunkIds) {
+        script += (boost::format(wbase::FILL_SUBCHUNK_SCRIPT)
+            % dbTable.db % dbTable.table % SUB_CHUNK_COLUMN % chunkId % subChunkId).str();
+    }
+    script += (boost::format(wbase::DROP_STAGED_SUBCHUNKS_SCRIPT)
+        % dbTable.db % dbTable.table % chunkId).str();
+    LOGS(_log, LOG_LVL_DEBUG, "group load of " << dbTable << " chunk=" << chunkId
+         << " subchunks=" << subChunkIds.size());
+    return _sqlConn->runQuery(script, err);
+}
+
+
 void SQLBackend::discard(ScTableVector const& v) {
     _discard(v.begin(), v.end());
 }
@@ -99,7 +159,7 @@ void SQLBackend::_discard(ScTableVector::const_iterator begin,
         std::string discard = (boost::format(lsst::qserv::wbase::CLEANUP_SUBCHUNK_SCRIPT)
                 % i->dbTable.db % i->dbTable.table % i->chunkId % i->subChunkId).str();
         sql::SqlErrorObject err;
-        if (!_sqlConn.runQuery(discard, err)) {
+        if (!_sqlConn->runQuery(discard, err)) {
             throw err;
         }
     }
@@ -109,7 +169,7 @@ void SQLBackend::_discard(ScTableVector::const_iterator begin,
 void SQLBackend::_execLockSql(std::string const& query) {
     LOGS(_log, LOG_LVL_DEBUG, "execLockSql " << query);
     sql::SqlErrorObject err;
-    if (!_sqlConn.runQuery(query, err)) {
+    if (!_sqlConn->runQuery(query, err)) {
         _exitDueToConflict("Lock failed, exiting. query=" + query + " err=" + err.printErrMsg());
     }
 }
@@ -119,7 +179,7 @@ SQLBackend::LockStatus SQLBackend::_memLockStatus() {
     std::string sql = "SELECT uid FROM " + _lockDbTbl + " WHERE keyId = 1";
     sql::SqlResults results;
     sql::SqlErrorObject err;
-    if (!_sqlConn.runQuery(sql, results, err)) {
+    if (!_sqlConn->runQuery(sql, results, err)) {
         // Assuming UNLOCKED should be safe as either it must be LOCKED_OURS to continue
         // or we are about to try to lock. Failure to lock will cause the program to exit.
         LOGS(_log, LOG_LVL_WARN, "memLockStatus query failed, assuming UNLOCKED. " << sql << " err=" << err.printErrMsg());
@@ -168,7 +228,7 @@ void SQLBackend::_memLockAcquire() {
     sql = "SHOW DATABASES LIKE '" + subChunkPrefix + "%'";
     sql::SqlResults results;
     sql::SqlErrorObject err;
-    if (!_sqlConn.runQuery(sql, results, err)) {
+    if (!_sqlConn->runQuery(sql, results, err)) {
         _exitDueToConflict("SQLBackend query failed, exiting. " + sql + " err=" + err.printErrMsg());
     }
     std::vector<std::string> databases;
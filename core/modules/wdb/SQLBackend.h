@@ -27,6 +27,7 @@
 
 // System headers
 #include <atomic>
+#include <memory>
 #include <set>
 #include <string>
 #include <sys/types.h>
@@ -34,6 +35,7 @@
 
 // Qserv headers
 #include "global/DbTable.h"
+#include "global/intTypes.h"
 #include "sql/SqlConnection.h"
 #include "sql/SqlErrorObject.h"
 
@@ -75,7 +77,7 @@ public:
     using Ptr=std::shared_ptr<SQLBackend>;
 
     SQLBackend(mysql::MySqlConfig const& mc)
-        : _sqlConn(mc), _uid(getpid()) {
+        : _sqlConn(std::make_shared<sql::SqlConnection>(mc)), _uid(getpid()) {
         _memLockAcquire();
     }
 
@@ -83,6 +85,10 @@ public:
         _memLockRelease();
     }
 
+    /// Create the subchunk tables in 'v'. Subchunks of the same chunk table
+    /// are created with one round trip which scans the chunk table and its
+    /// overlap table once. Rows are copied by the server and never pass
+    /// through the worker.
     virtual bool load(ScTableVector const& v, sql::SqlErrorObject& err);
 
     virtual void discard(ScTableVector const& v);
@@ -97,8 +103,22 @@ protected:
     /// Construct a fake instance
     SQLBackend(char) : _uid(getpid()) {}
 
+    /// Construct an instance using 'sqlConn' without taking the memory table lock, for unit tests.
+    explicit SQLBackend(std::shared_ptr<sql::SqlConnection> const& sqlConn)
+        : _sqlConn(sqlConn), _uid(getpid()) {}
+
     virtual void _discard(ScTableVector::const_iterator begin, ScTableVector::const_iterator end);
 
+    /// Create each subchunk table with its own CREATE TABLE ... SELECT.
+    bool _loadEach(ScTableVector const& v, sql::SqlErrorObject& err);
+
+    /// Create all 'subChunkIds' tables of 'dbTable' for 'chunkId' with one
+    /// round trip. Rows of all subchunks are staged in temporary tables by
+    /// one scan of the chunk and overlap tables, then split into the
+    /// subchunk tables with INSERT ... SELECT on the server.
+    bool _loadGroup(int chunkId, DbTable const& dbTable,
+                    IntVector const& subChunkIds, sql::SqlErrorObject& err);
+
     /// Run the 'query'. If it fails, terminate the program.
     void _execLockSql(std::string const& query);
 
@@ -114,7 +134,7 @@ protected:
     /// Exit the program immediately to reduce minimize possible problems.
     void _exitDueToConflict(const std::string& msg);
 
-    sql::SqlConnection _sqlConn;
+    std::shared_ptr<sql::SqlConnection> _sqlConn;
 
     // Memory lock table members.
     std::atomic<bool> _lockConflict{false};
@@ -0,0 +1,124 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+/**
+  * @brief Simple testing for class ChunkResultCache
+  */
+
+// System headers
+#include <memory>
+#include <string>
+#include <vector>
+
+// Qserv headers
+#include "wdb/ChunkResultCache.h"
+
+// Boost unit test header
+#define BOOST_TEST_MODULE ChunkResultCache_1
+#include "boost/test/included/unit_test.hpp"
+
+namespace test = boost::test_tools;
+
+using lsst::qserv::wdb::ChunkResultCache;
+
+namespace {
+
+ChunkResultCache::MessagesPtr makeMessages(std::size_t count, std::size_t size) {
+    auto messages = std::make_shared<ChunkResultCache::Messages>();
+    for (std::size_t i = 0; i < count; ++i) {
+        messages->push_back(std::string(size, 'a' + i));
+    }
+    return messages;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(Suite)
+
+BOOST_AUTO_TEST_CASE(ChunkTables) {
+    typedef ChunkResultCache::DbTable DbTable;
+    std::string query = "SELECT o.objectId, s.sourceId FROM LSST.Object_3240 AS o, "
+        "LSST.Source_3240 AS s, Subchunks_LSST_3240.ObjectFullOverlap_3240_17 AS ov "
+        "WHERE o.objectId=s.objectId AND o.chunkId=3240 AND LSST.Object_3240.ra>1 "
+        "UNION SELECT * FROM LSST.Object_32401, Object_3240";
+    auto tables = ChunkResultCache::getChunkTables(query, 3240);
+    std::vector<DbTable> expected = {DbTable("LSST", "Object_3240"), DbTable("LSST", "Source_3240")};
+    BOOST_CHECK(tables == expected);
+    BOOST_CHECK(ChunkResultCache::getChunkTables("SELECT 1", 3240).empty());
+    tables = ChunkResultCache::getChunkTables("SELECT * FROM LSST.Object_7", 7);
+    BOOST_REQUIRE_EQUAL(tables.size(), 1U);
+    BOOST_CHECK_EQUAL(tables[0].second, "Object_7");
+}
+
+BOOST_AUTO_TEST_CASE(Key) {
+    auto key = ChunkResultCache::makeKey("user=qsmaster query=SELECT 1");
+    BOOST_CHECK_EQUAL(key, ChunkResultCache::makeKey("user=qsmaster query=SELECT 1"));
+    BOOST_CHECK(key != ChunkResultCache::makeKey("user=qsmaster query=SELECT 2"));
+}
+
+BOOST_AUTO_TEST_CASE(GetPut) {
+    ChunkResultCache cache(4000);
+    BOOST_CHECK(cache.isEnabled());
+    BOOST_CHECK(cache.get("a") == nullptr);
+    auto messages = makeMessages(2, 100);
+    cache.put("a", messages);
+    auto cached = cache.get("a");
+    BOOST_REQUIRE(cached != nullptr);
+    BOOST_CHECK(*cached == *messages);
+    BOOST_CHECK_EQUAL(cache.getBytes(), 200U);
+    BOOST_CHECK_EQUAL(cache.getHits(), 1U);
+    BOOST_CHECK_EQUAL(cache.getMisses(), 1U);
+
+    // Replacing an entry updates the size.
+    cache.put("a", makeMessages(1, 50));
+    BOOST_CHECK_EQUAL(cache.size(), 1U);
+    BOOST_CHECK_EQUAL(cache.getBytes(), 50U);
+
+    // Entries larger than a quarter of the cache are not cached.
+    cache.put("b", makeMessages(1, 1001));
+    BOOST_CHECK(cache.get("b") == nullptr);
+    BOOST_CHECK_EQUAL(cache.size(), 1U);
+
+    ChunkResultCache disabled(0);
+    BOOST_CHECK(!disabled.isEnabled());
+    disabled.put("a", makeMessages(1, 1));
+    BOOST_CHECK(disabled.get("a") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Eviction) {
+    ChunkResultCache cache(4000);
+    cache.put("a", makeMessages(1, 1000));
+    cache.put("b", makeMessages(1, 1000));
+    cache.put("c", makeMessages(1, 1000));
+    cache.put("d", makeMessages(1, 1000));
+    BOOST_CHECK_EQUAL(cache.size(), 4U);
+    // Use "a" so that "b" is the least recently used entry.
+    BOOST_CHECK(cache.get("a") != nullptr);
+    cache.put("e", makeMessages(1, 1000));
+    BOOST_CHECK_EQUAL(cache.size(), 4U);
+    BOOST_CHECK_EQUAL(cache.getBytes(), 4000U);
+    BOOST_CHECK(cache.get("b") == nullptr);
+    BOOST_CHECK(cache.get("a") != nullptr);
+    BOOST_CHECK(cache.get("e") != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,134 @@
+// -*- LSST-C++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2017 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+  /**
+  * @brief Test the SQL that SQLBackend uses to build subchunk tables.
+  */
+
+// System headers
+#include <memory>
+#include <string>
+#include <vector>
+
+// Qserv headers
+#include "sql/MockSql.h"
+#include "wdb/SQLBackend.h"
+
+// Boost unit test header
+#define BOOST_TEST_MODULE SQLBackend_1
+#include "boost/test/included/unit_test.hpp"
+
+namespace test = boost::test_tools;
+
+using lsst::qserv::DbTable;
+using lsst::qserv::sql::SqlErrorObject;
+using lsst::qserv::wdb::ScTable;
+using lsst::qserv::wdb::ScTableVector;
+
+namespace {
+
+/// Records every statement instead of running it.
+class RecordingSql : public lsst::qserv::sql::MockSql {
+public:
+    bool runQuery(std::string const query, SqlErrorObject&) override {
+        queries.push_back(query);
+        return true;
+    }
+    std::vector<std::string> queries;
+};
+
+class TestBackend : public lsst::qserv::wdb::SQLBackend {
+public:
+    explicit TestBackend(std::shared_ptr<RecordingSql> const& sql) : SQLBackend(sql) {}
+    void memLockRequireOwnership() override {}
+};
+
+int count(std::string const& str, std::string const& sub) {
+    int n = 0;
+    for (auto pos = str.find(sub); pos != std::string::npos; pos = str.find(sub, pos + 1)) {
+        ++n;
+    }
+    return n;
+}
+
+} // anonymous namespace
+
+
+BOOST_AUTO_TEST_SUITE(Suite)
+
+BOOST_AUTO_TEST_CASE(GroupLoad) {
+    auto sql = std::make_shared<RecordingSql>();
+    TestBackend backend(sql);
+    DbTable object("LSST", "Object");
+    ScTableVector v{ScTable(1234, object, 5), ScTable(1234, object, 7)};
+    SqlErrorObject err;
+    BOOST_REQUIRE(backend.load(v, err));
+
+    // Both subchunks of the chunk table are built by one script.
+    BOOST_REQUIRE_EQUAL(sql->queries.size(), 1u);
+    std::string const& script = sql->queries[0];
+    // Each source table is scanned once for all subchunks, empty tables
+    // are made with LIMIT 0.
+    BOOST_CHECK_EQUAL(count(script, "FROM LSST.Object_1234 WHERE"), 1);
+    BOOST_CHECK_EQUAL(count(script, "FROM LSST.ObjectFullOverlap_1234 WHERE"), 1);
+    BOOST_CHECK(script.find("CREATE TEMPORARY TABLE Subchunks_LSST_1234.Object_1234_staged "
+                            "(INDEX (subChunkId)) ENGINE = MEMORY "
+                            "AS SELECT * FROM LSST.Object_1234 WHERE subChunkId IN (5,7);")
+                != std::string::npos);
+    BOOST_CHECK(script.find("AS SELECT * FROM LSST.ObjectFullOverlap_1234 WHERE subChunkId IN (5,7);")
+                != std::string::npos);
+    // Subchunks are split from the staged rows.
+    for (int sc : {5, 7}) {
+        std::string const scStr = std::to_string(sc);
+        BOOST_CHECK(script.find("INSERT INTO Subchunks_LSST_1234.Object_1234_" + scStr
+                                + " SELECT * FROM Subchunks_LSST_1234.Object_1234_staged"
+                                + " WHERE subChunkId = " + scStr) != std::string::npos);
+        BOOST_CHECK(script.find("INSERT INTO Subchunks_LSST_1234.ObjectFullOverlap_1234_" + scStr
+                                + " SELECT * FROM Subchunks_LSST_1234.ObjectFullOverlap_1234_staged"
+                                + " WHERE subChunkId = " + scStr) != std::string::npos);
+    }
+    BOOST_CHECK_EQUAL(count(script, "INSERT INTO"), 4);
+    BOOST_CHECK_EQUAL(count(script, "CREATE TABLE"), 4);
+    // Staged rows are released by the same script.
+    BOOST_CHECK_EQUAL(count(script, "CREATE TEMPORARY TABLE"), 2);
+    BOOST_CHECK_EQUAL(count(script, "DROP TEMPORARY TABLE"), 4);
+    std::string const lastDrop =
+        "DROP TEMPORARY TABLE IF EXISTS Subchunks_LSST_1234.ObjectFullOverlap_1234_staged;";
+    BOOST_CHECK_EQUAL(script.rfind(lastDrop), script.size() - lastDrop.size());
+}
+
+BOOST_AUTO_TEST_CASE(SingleSubchunk) {
+    auto sql = std::make_shared<RecordingSql>();
+    TestBackend backend(sql);
+    DbTable object("LSST", "Object");
+    DbTable source("LSST", "Source");
+    ScTableVector v{ScTable(1234, object, 5), ScTable(99, source, 3), ScTable(99, source, 4)};
+    SqlErrorObject err;
+    BOOST_REQUIRE(backend.load(v, err));
+    // One script for the Source group, ordered by chunk, and one for the lone Object subchunk.
+    BOOST_REQUIRE_EQUAL(sql->queries.size(), 2u);
+    BOOST_CHECK_EQUAL(count(sql->queries[0], "INSERT INTO Subchunks_LSST_99.Source"), 4);
+    BOOST_CHECK_EQUAL(count(sql->queries[1],
+                            "CREATE TABLE IF NOT EXISTS Subchunks_LSST_1234.Object_1234_5"), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -26,10 +26,17 @@
 #include "wpublish/ChunkInventory.h"
 
 // System headers
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdio>
 #include <exception>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
+#include <sys/stat.h>
+#include <thread>
 
 // Third-party headers
 #include "boost/regex.hpp"
@@ -46,8 +53,10 @@ namespace { // File-scope helpers
 LOG_LOGGER _log = LOG_GET("lsst.qserv.wpublish.ChunkInventory");
 
 using lsst::qserv::sql::SqlConnection;
+using lsst::qserv::sql::SqlCell;
 using lsst::qserv::sql::SqlErrorObject;
-using lsst::qserv::sql::SqlResultIter;
+using lsst::qserv::sql::SqlRow;
+using lsst::qserv::sql::SqlRowStream;
 using lsst::qserv::wpublish::ChunkInventory;
 
 class CorruptDbError : public std::exception {
@@ -75,24 +84,23 @@ void fetchDbs(std::string const& instanceName,
 
     // get list of tables
     // Assume table has schema that includes char column named "db"
-    SqlErrorObject sqlErrorObject;
     std::string tableNameDbListing = getTableNameDbListing(instanceName);
 
     std::string listq = "SELECT db FROM " + tableNameDbListing;
     LOGS(_log, LOG_LVL_DEBUG, "Launching query: " << listq);
-    std::shared_ptr<SqlResultIter> resultP = sc.getQueryIter(listq);
-    assert(resultP.get());
-    if (resultP->getErrorObject().isSet()) {
-        SqlErrorObject& seo = resultP->getErrorObject();
-        LOGS(_log, LOG_LVL_ERROR, "ChunkInventory can't get list of publishable dbs.");
-        LOGS(_log, LOG_LVL_ERROR, seo.printErrMsg());
-        return;
-    }
+    SqlRowStream::Ptr rows = sc.streamQuery(listq);
+    assert(rows.get());
     bool nothing = true;
-    for(; !resultP->done(); ++(*resultP)) {
-        dbs.push_back((**resultP)[0]);
+    for (SqlRow const& row : *rows) {
+        dbs.push_back(row[0].str());
         nothing = false;
     }
+    if (rows->getErrorObject().isSet()) {
+        LOGS(_log, LOG_LVL_ERROR, "ChunkInventory can't get list of publishable dbs.");
+        LOGS(_log, LOG_LVL_ERROR, rows->getErrorObject().printErrMsg());
+        dbs.clear();
+        return;
+    }
     if (nothing) {
         LOGS(_log, LOG_LVL_WARN, "TEST: No databases found to export: " << listq);
     }
@@ -103,9 +111,9 @@ class doTable {
 public:
     doTable(boost::regex& regex, ChunkInventory::ChunkMap& chunkMap)
         : _regex(regex), _chunkMap(chunkMap) {}
-    void operator()(std::string const& tableName) {
-        boost::smatch what;
-        if (boost::regex_match(tableName, what, _regex)) {
+    void operator()(SqlCell const& tableName) {
+        boost::cmatch what;
+        if (boost::regex_match(tableName.begin(), tableName.end(), what, _regex)) {
             //std::cout << "Found chunk table: " << what[1]
             //<< "(" << what[2] << ")" << std::endl;
             // Get chunk# slot. Append/set table name.
@@ -136,69 +144,91 @@ struct printChunk {
     std::ostream& _os;
 };
 
-/// Functor for iterating over a ChunkMap and updating a StringSet.
-struct addDbItem {
-    addDbItem(std::string const& dbName, ChunkInventory::StringSet& stringSet)
-        : _dbName(dbName), _stringSet(stringSet) {}
-    void operator()(ChunkInventory::ChunkMap::value_type const& tuple) {
-        // Ignore tuple.second (list of tables for this chunk)
-        _stringSet.insert(ChunkInventory::makeKey(_dbName, tuple.first));
+/// Scan the tables of one db and fill chunkMap with its chunks
+void scanDb(SqlConnection& conn, boost::regex& regex,
+            std::string const& dbName, ChunkInventory::ChunkMap& chunkMap) {
+    // Table names are matched as they are read, a db may have
+    // hundreds of thousands of chunk tables.
+    chunkMap.clear(); // Clear out stale entries to avoid mixing.
+    SqlRowStream::Ptr rows = conn.streamQuery("SHOW TABLES FROM `" + dbName + "`");
+    doTable matchTable(regex, chunkMap);
+    for (SqlRow const& row : *rows) {
+        matchTable(row[0]);
     }
-    std::string const& _dbName;
-    ChunkInventory::StringSet& _stringSet;
-};
+    bool ok = !rows->getErrorObject().isSet();
+    if (!ok) {
+        LOGS(_log, LOG_LVL_ERROR, "SQL error: " << rows->getErrorObject().errMsg());
+        assert(ok);
+    }
+    // All databases get a dummy chunk.
+    // Partitioned databases should already have acceptable dummy chunk
+    // partitioned tables (e.g., Object_1234567890, Source_1234567890)
+    // Non-partitioned databases need a dummy chunk anyway.
+    if (chunkMap.empty()) {
+        // No partitioned tables in this db. Publish an empty chunk anyway.
+        chunkMap[lsst::qserv::DUMMY_CHUNK];
+    } else {
+        // Verify that there is a dummy chunk entry
+        if (chunkMap.find(lsst::qserv::DUMMY_CHUNK) == chunkMap.end()) {
+            LOGS(_log, LOG_LVL_ERROR, "Missing dummy chunk for db=" << dbName);
 
-/// Functor to load db
-class doDb {
-public:
-    doDb(SqlConnection& conn,
-         boost::regex& regex,
-         ChunkInventory::ExistMap& existMap)
-        : _conn(conn),
-          _regex(regex),
-          _existMap(existMap)
-        {}
-
-    void operator()(std::string const& dbName) {
-        // get list of tables
-        std::vector<std::string> tables;
-        SqlErrorObject sqlErrorObject;
-        bool ok = _conn.listTables(tables,  sqlErrorObject, "", dbName);
-        if (!ok) {
-            LOGS(_log, LOG_LVL_ERROR, "SQL error: " << sqlErrorObject.errMsg());
-            assert(ok);
+            // FIXME enable once loader/installer can ensure that the
+            // dummy chunk exists exactly when appropriate
+
+            // std::string msg = "Missing dummy chunk for db=" + dbName;
+            // throw CorruptDbError(msg);
         }
-        ChunkInventory::ChunkMap& chunkMap = _existMap[dbName];
-        chunkMap.clear(); // Clear out stale entries to avoid mixing.
-        std::for_each(tables.begin(), tables.end(),
-                      doTable(_regex, chunkMap));
-        // All databases get a dummy chunk.
-        // Partitioned databases should already have acceptable dummy chunk
-        // partitioned tables (e.g., Object_1234567890, Source_1234567890)
-        // Non-partitioned databases need a dummy chunk anyway.
-        if (chunkMap.empty()) {
-            // No partitioned tables in this db. Publish an empty chunk anyway.
-            chunkMap[lsst::qserv::DUMMY_CHUNK];
-        } else {
-            // Verify that there is a dummy chunk entry
-            if (chunkMap.find(lsst::qserv::DUMMY_CHUNK) == chunkMap.end()) {
-                LOGS(_log, LOG_LVL_ERROR, "Missing dummy chunk for db=" << dbName);
+    }
+    // TODO: Sanity check: do all tables have the same chunks represented?
+}
 
-                // FIXME enable once loader/installer can ensure that the
-                // dummy chunk exists exactly when appropriate
+/// @return modification time of the db directory in nanoseconds, 0 if it
+///         can't be determined. Creating or dropping a table changes it.
+std::int64_t dbDirMtime(std::string const& dataDir, std::string const& dbName) {
+    struct stat st;
+    if (dataDir.empty() || ::stat((dataDir + "/" + dbName).c_str(), &st) != 0) {
+        return 0;
+    }
+    return std::int64_t(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
 
-                // std::string msg = "Missing dummy chunk for db=" + dbName;
-                // throw CorruptDbError(msg);
-            }
-        }
-        //std::for_each(chunkMap.begin(), chunkMap.end(), printChunk(std::cout));
-        // TODO: Sanity check: do all tables have the same chunks represented?
-        }
-private:
-    SqlConnection& _conn;
-    boost::regex& _regex;
-    ChunkInventory::ExistMap& _existMap;
-};
+// Snapshot file layout, all integers in native byte order:
+//   magic, version, instance name, db count, then for each db:
+//     name, mtime, table count, table names, chunk count, then for each chunk:
+//       chunk id, table count, indexes into the db table names
+// Strings are stored as a 32-bit length followed by the characters.
+char const SNAPSHOT_MAGIC[4] = {'Q', 'C', 'I', 'S'};
+std::uint32_t const SNAPSHOT_VERSION = 1;
+std::uint32_t const SNAPSHOT_MAX_STRING = 1 << 16;
+
+template <typename T>
+void writeValue(std::ostream& os, T value) {
+    os.write(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+void writeString(std::ostream& os, std::string const& str) {
+    writeValue<std::uint32_t>(os, str.size());
+    os.write(str.data(), str.size());
+}
+
+template <typename T>
+bool readValue(std::istream& is, T& value) {
+    return bool(is.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+bool readString(std::istream& is, std::string& str) {
+    std::uint32_t size = 0;
+    if (!readValue(is, size) || size > SNAPSHOT_MAX_STRING) {
+        return false;
+    }
+    str.resize(size);
+    return size == 0 || bool(is.read(&str[0], size));
+}
+
+/// @return the key of a (db, chunk) pair in ChunkInventory::_chunkKeys
+inline std::uint64_t chunkKey(std::uint32_t dbId, int chunk) {
+    return (std::uint64_t(dbId) << 32) | std::uint32_t(chunk);
+}
 
 class Validator : public lsst::qserv::ResourceUnit::Checker {
 public:
@@ -215,19 +245,38 @@ namespace qserv {
 namespace wpublish {
 
 ChunkInventory::ChunkInventory(std::string const& name,
-                               std::shared_ptr<SqlConnection> sc)
+                               std::shared_ptr<SqlConnection> sc,
+                               BuildConfig const& buildConfig)
+    : _name(name) {
+    _init(*sc, ConnectionFactory(), buildConfig);
+}
+
+ChunkInventory::ChunkInventory(std::string const& name,
+                               ConnectionFactory const& newConnection,
+                               BuildConfig const& buildConfig)
     : _name(name) {
-    _init(*sc);
+    std::shared_ptr<SqlConnection> sc = newConnection();
+    _init(*sc, newConnection, buildConfig);
 }
 
-void ChunkInventory::init(std::string const& name, mysql::MySqlConfig const& mySqlConfig) {
+void ChunkInventory::init(std::string const& name, mysql::MySqlConfig const& mySqlConfig,
+                          BuildConfig const& buildConfig) {
     _name = name;
     SqlConnection sc(mySqlConfig, true);
-    _init(sc);
+    ConnectionFactory newConnection = [mySqlConfig]() {
+        return std::make_shared<SqlConnection>(mySqlConfig, true);
+    };
+    _init(sc, newConnection, buildConfig);
 }
 
 bool ChunkInventory::has(std::string const& db, int chunk,
                          std::string table) const {
+    if (table.empty()) {
+        auto const di = _dbIds.find(db);
+        if (di == _dbIds.end()) { return false; }
+        return _chunkKeys.count(chunkKey(di->second, chunk)) != 0;
+    }
+
     ExistMap::const_iterator di = _existMap.find(db);
     if (di == _existMap.end()) { return false; }
 
@@ -235,12 +284,8 @@ bool ChunkInventory::has(std::string const& db, int chunk,
     ChunkMap::const_iterator ci = cm.find(chunk);
     if (ci == cm.end()) { return false; }
 
-    if (table.empty()) {
-        return true;
-    } else {
-        StringSet const& si = ci->second;
-        return si.find(table) != si.end();
-    }
+    StringSet const& si = ci->second;
+    return si.find(table) != si.end();
 }
 
 std::shared_ptr<ResourceUnit::Checker> ChunkInventory::newValidator() {
@@ -275,22 +320,214 @@ void ChunkInventory::dbgPrint(std::ostream& os) {
     os << ")";
 }
 
-void ChunkInventory::_init(SqlConnection& sc) {
-    std::string chunkedForm("(\\w+)_(\\d+)");
-    boost::regex regex(chunkedForm);
+void ChunkInventory::_init(SqlConnection& sc, ConnectionFactory const& newConnection,
+                           BuildConfig const& buildConfig) {
     // Check metadata for databases to track
+    std::vector<std::string> dbs;
+    fetchDbs(_name, sc, dbs);
 
-    std::deque<std::string> dbs;
+    // A snapshot entry is only reused when the mtime of the db directory
+    // is known and unchanged.
+    DbEntryMap snapshot;
+    if (!buildConfig.snapshotPath.empty() && !buildConfig.dataDir.empty()) {
+        if (!_readSnapshot(buildConfig.snapshotPath, snapshot)) {
+            snapshot.clear();
+        }
+    }
 
-    fetchDbs(_name, sc, dbs);
-    // If we want to merge in the fs-level files/dirs, we will need the
-    // export path (from getenv(XRDLCLROOT))
-    // std::string exportRoot("/tmp/testExport");
-
-    // get chunkList
-    // SHOW TABLES IN db;
-    std::deque<std::string> chunks;
-    std::for_each(dbs.begin(), dbs.end(), doDb(sc, regex, _existMap));
+    DbEntryMap entries;
+    std::vector<std::string> scanDbs;
+    std::vector<DbEntry*> scanEntries;
+    for (auto const& db : dbs) {
+        DbEntry& entry = entries[db];
+        // Taken before scanning so that tables created during the scan
+        // invalidate the entry at the next startup.
+        entry.mtime = dbDirMtime(buildConfig.dataDir, db);
+        auto const si = snapshot.find(db);
+        if (entry.mtime != 0 && si != snapshot.end() && si->second.mtime == entry.mtime) {
+            entry.chunks.swap(si->second.chunks);
+        } else {
+            scanDbs.push_back(db);
+            scanEntries.push_back(&entry);
+        }
+    }
+    _scannedDbCount = scanDbs.size();
+    _scanDbs(scanDbs, scanEntries, sc, newConnection, buildConfig.threads);
+    LOGS(_log, LOG_LVL_INFO, "ChunkInventory dbs=" << entries.size()
+         << " scanned=" << _scannedDbCount
+         << " fromSnapshot=" << entries.size() - _scannedDbCount);
+
+    if (!buildConfig.snapshotPath.empty()
+        && (_scannedDbCount > 0 || snapshot.size() != entries.size())) {
+        _writeSnapshot(buildConfig.snapshotPath, entries);
+    }
+
+    _existMap.clear();
+    for (auto& entry : entries) {
+        _existMap[entry.first].swap(entry.second.chunks);
+    }
+    _buildIndex();
+}
+
+void ChunkInventory::_scanDbs(std::vector<std::string> const& dbs,
+                              std::vector<DbEntry*> const& entries,
+                              SqlConnection& sc, ConnectionFactory const& newConnection,
+                              unsigned int threads) {
+    std::string const chunkedForm("(\\w+)_(\\d+)");
+    if (!newConnection || threads < 2 || dbs.size() < 2) {
+        boost::regex regex(chunkedForm);
+        for (std::size_t i = 0; i < dbs.size(); ++i) {
+            scanDb(sc, regex, dbs[i], entries[i]->chunks);
+        }
+        return;
+    }
+    // Each thread takes the next db to scan until none are left. Results
+    // go to separate entries, so only the counter is shared.
+    std::atomic<std::size_t> next(0);
+    auto scanNext = [&]() {
+        std::shared_ptr<SqlConnection> conn = newConnection();
+        boost::regex regex(chunkedForm);
+        for (std::size_t i = next++; i < dbs.size(); i = next++) {
+            scanDb(*conn, regex, dbs[i], entries[i]->chunks);
+        }
+    };
+    std::vector<std::thread> workers;
+    threads = std::min<std::size_t>(threads, dbs.size());
+    for (unsigned int t = 0; t < threads; ++t) {
+        workers.emplace_back(scanNext);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+bool ChunkInventory::_readSnapshot(std::string const& path, DbEntryMap& entries) const {
+    std::ifstream is(path, std::ios::binary);
+    if (!is) {
+        LOGS(_log, LOG_LVL_INFO, "No ChunkInventory snapshot at " << path);
+        return false;
+    }
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    std::uint32_t version = 0;
+    std::string name;
+    std::uint32_t dbCount = 0;
+    if (!is.read(magic, sizeof(magic))
+        || !std::equal(magic, magic + sizeof(magic), SNAPSHOT_MAGIC)
+        || !readValue(is, version) || version != SNAPSHOT_VERSION
+        || !readString(is, name) || !readValue(is, dbCount)) {
+        LOGS(_log, LOG_LVL_WARN, "Ignoring ChunkInventory snapshot with bad header " << path);
+        return false;
+    }
+    if (name != _name) {
+        LOGS(_log, LOG_LVL_WARN, "Ignoring ChunkInventory snapshot of instance " << name
+             << " in " << path);
+        return false;
+    }
+    for (std::uint32_t d = 0; d < dbCount; ++d) {
+        std::string db;
+        std::uint32_t tableCount = 0;
+        DbEntry entry;
+        if (!readString(is, db) || !readValue(is, entry.mtime)
+            || !readValue(is, tableCount)) {
+            break;
+        }
+        std::vector<std::string> tables(std::min(tableCount, SNAPSHOT_MAX_STRING));
+        if (tableCount != tables.size()) {
+            break;
+        }
+        bool ok = true;
+        for (auto& table : tables) {
+            ok = ok && readString(is, table);
+        }
+        std::uint32_t chunkCount = 0;
+        ok = ok && readValue(is, chunkCount);
+        for (std::uint32_t c = 0; ok && c < chunkCount; ++c) {
+            std::int32_t chunk = 0;
+            std::uint32_t chunkTableCount = 0;
+            ok = readValue(is, chunk) && readValue(is, chunkTableCount);
+            StringSet& chunkTables = entry.chunks[chunk];
+            for (std::uint32_t t = 0; ok && t < chunkTableCount; ++t) {
+                std::uint32_t index = 0;
+                ok = readValue(is, index) && index < tables.size();
+                if (ok) {
+                    chunkTables.insert(tables[index]);
+                }
+            }
+        }
+        if (!ok) {
+            break;
+        }
+        entries[db] = std::move(entry);
+    }
+    if (entries.size() != dbCount) {
+        LOGS(_log, LOG_LVL_WARN, "Ignoring truncated ChunkInventory snapshot " << path);
+        return false;
+    }
+    return true;
+}
+
+bool ChunkInventory::_writeSnapshot(std::string const& path, DbEntryMap const& entries) const {
+    // Write to a temporary file first so that a crash never leaves a
+    // partial snapshot behind.
+    std::string const tmpPath = path + ".tmp";
+    {
+        std::ofstream os(tmpPath, std::ios::binary | std::ios::trunc);
+        os.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+        writeValue(os, SNAPSHOT_VERSION);
+        writeString(os, _name);
+        writeValue<std::uint32_t>(os, entries.size());
+        for (auto const& entry : entries) {
+            // Chunk tables share a handful of names, store each once.
+            std::map<std::string, std::uint32_t> tableIndex;
+            for (auto const& chunk : entry.second.chunks) {
+                for (auto const& table : chunk.second) {
+                    tableIndex.insert(std::make_pair(table, 0));
+                }
+            }
+            std::uint32_t index = 0;
+            for (auto& table : tableIndex) {
+                table.second = index++;
+            }
+            writeString(os, entry.first);
+            writeValue(os, entry.second.mtime);
+            writeValue<std::uint32_t>(os, tableIndex.size());
+            for (auto const& table : tableIndex) {
+                writeString(os, table.first);
+            }
+            writeValue<std::uint32_t>(os, entry.second.chunks.size());
+            for (auto const& chunk : entry.second.chunks) {
+                writeValue<std::int32_t>(os, chunk.first);
+                writeValue<std::uint32_t>(os, chunk.second.size());
+                for (auto const& table : chunk.second) {
+                    writeValue(os, tableIndex[table]);
+                }
+            }
+        }
+        os.close();
+        if (!os) {
+            LOGS(_log, LOG_LVL_WARN, "Failed to write ChunkInventory snapshot " << tmpPath);
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        LOGS(_log, LOG_LVL_WARN, "Failed to rename ChunkInventory snapshot to " << path);
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void ChunkInventory::_buildIndex() {
+    _dbIds.clear();
+    _chunkKeys.clear();
+    for (auto const& db : _existMap) {
+        std::uint32_t const dbId = _dbIds.size();
+        _dbIds[db.first] = dbId;
+        for (auto const& chunk : db.second) {
+            _chunkKeys.insert(chunkKey(dbId, chunk.first));
+        }
+    }
 }
 
 }}} // lsst::qserv::wpublish
@@ -29,12 +29,17 @@
 #define LSST_QSERV_WPUBLISH_CHUNKINVENTORY_H
 
 // System headers
+#include <cstdint>
 #include <deque>
+#include <functional>
+#include <iosfwd>
 #include <map>
 #include <memory>
 #include <set>
-#include <sstream>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 // Qserv headers
 #include "global/ResourceUnit.h"
@@ -54,27 +59,39 @@ namespace wpublish {
 
 /// ChunkInventory contains a record of what chunks are available for execution
 /// on a worker node.
+/// The inventory can be saved to a binary snapshot file and reloaded at the
+/// next startup. A database is scanned again only when its directory in the
+/// MySQL data directory has been modified since the snapshot was written.
+/// Databases that need scanning are scanned in parallel, each thread with
+/// its own connection.
 class ChunkInventory {
 public:
     typedef std::deque<std::string> StringDeque;
-    // These should be converted to unordered_* with C++11
     typedef std::set<std::string> StringSet;
     typedef std::map<int,StringSet> ChunkMap;
     typedef std::map<std::string, ChunkMap> ExistMap;
     typedef std::shared_ptr<ChunkInventory> Ptr;
     typedef std::shared_ptr<ChunkInventory const> CPtr;
+    typedef std::function<std::shared_ptr<sql::SqlConnection>()> ConnectionFactory;
+
+    /// Settings for building the inventory
+    struct BuildConfig {
+        BuildConfig() : threads(1) {}
+        std::string snapshotPath; ///< Snapshot file, empty disables the snapshot
+        std::string dataDir; ///< MySQL data directory, empty disables snapshot reuse
+        unsigned int threads; ///< Maximum number of databases scanned at once
+    };
 
     ChunkInventory() {}
-    ChunkInventory(std::string const& name, std::shared_ptr<sql::SqlConnection> sc);
+    ChunkInventory(std::string const& name, std::shared_ptr<sql::SqlConnection> sc,
+                   BuildConfig const& buildConfig=BuildConfig());
+    /// @param newConnection called once by each thread scanning databases
+    ChunkInventory(std::string const& name, ConnectionFactory const& newConnection,
+                   BuildConfig const& buildConfig);
 
-    void init(std::string const& name, mysql::MySqlConfig const& mysqlConfig);
+    void init(std::string const& name, mysql::MySqlConfig const& mysqlConfig,
+              BuildConfig const& buildConfig=BuildConfig());
 
-    /// (helper) Create a key string from a (db, chunk) pair
-    static inline std::string makeKey(std::string const& db, int chunk) {
-        std::stringstream ss;
-        ss << db << chunk << "**key";
-        return std::string(ss.str());
-    }
     /// @return true if the specified db and chunk are in the inventory
     bool has(std::string const& db, int chunk,
              std::string table=std::string()) const;
@@ -84,11 +101,35 @@ public:
 
     void dbgPrint(std::ostream& os);
 
+    /// @return the number of databases scanned by the last build, the others
+    ///         were taken from the snapshot
+    unsigned int getScannedDbCount() const { return _scannedDbCount; }
+
 private:
-    void _init(sql::SqlConnection& sc);
+    /// A database as stored in the snapshot
+    struct DbEntry {
+        std::int64_t mtime = 0; ///< mtime of the db directory in ns, 0 if unknown
+        ChunkMap chunks;
+    };
+    typedef std::map<std::string, DbEntry> DbEntryMap;
+
+    void _init(sql::SqlConnection& sc, ConnectionFactory const& newConnection,
+               BuildConfig const& buildConfig);
+    void _scanDbs(std::vector<std::string> const& dbs, std::vector<DbEntry*> const& entries,
+                  sql::SqlConnection& sc, ConnectionFactory const& newConnection,
+                  unsigned int threads);
+    bool _readSnapshot(std::string const& path, DbEntryMap& entries) const;
+    bool _writeSnapshot(std::string const& path, DbEntryMap const& entries) const;
+    void _buildIndex();
 
     ExistMap _existMap;
     std::string _name;
+    unsigned int _scannedDbCount = 0;
+
+    /// (db, chunk) pairs for has() without a table name, db names are
+    /// mapped to small integers so that keys are not built from strings.
+    std::unordered_map<std::string, std::uint32_t> _dbIds;
+    std::unordered_set<std::uint64_t> _chunkKeys;
 };
 
 }}} // namespace lsst::qserv::wpublish
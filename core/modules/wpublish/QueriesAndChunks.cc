@@ -23,6 +23,11 @@
 
 // Class header
 #include "wpublish/QueriesAndChunks.h"
+
+// System headers
+#include <utility>
+#include <vector>
+
 // LSST headers
 #include "lsst/log/Log.h"
 
@@ -34,6 +39,17 @@
 
 namespace {
 LOG_LOGGER _log = LOG_GET("lsst.qserv.wpublish.QueriesAndChunks");
+
+boost::property_tree::ptree usageJson(lsst::qserv::wbase::Task::Usage const& usage) {
+    boost::property_tree::ptree pt;
+    pt.put("cpuMs", usage.cpuTime.count()/1000);
+    pt.put("bytesLocked", usage.bytesLocked);
+    pt.put("subchunkBytes", usage.subchunkBytes);
+    pt.put("rowsExamined", usage.rowsExamined);
+    pt.put("rowsReturned", usage.rowsReturned);
+    pt.put("bytesTransmitted", usage.bytesTransmitted);
+    return pt;
+}
 }
 
 namespace lsst {
@@ -78,6 +94,11 @@ QueriesAndChunks::~QueriesAndChunks() {
     } catch (std::system_error const& e) {
         LOGS(_log, LOG_LVL_ERROR, "~QueriesAndChunks " << e.what());
     }
+    ChunkSample* sample = _chunkSamples.exchange(nullptr);
+    while (sample != nullptr) {
+        std::unique_ptr<ChunkSample> done(sample);
+        sample = sample->next;
+    }
 }
 
 
@@ -93,12 +114,20 @@ void QueriesAndChunks::setRequiredTasksCompleted(unsigned int value) {
 /// Add statistics for the Task, creating a QueryStatistics object if needed.
 void QueriesAndChunks::addTask(wbase::Task::Ptr const& task) {
     auto qid = task->getQueryId();
-    std::unique_lock<std::mutex> guardStats(_queryStatsMtx);
-    QueryStatistics::Ptr& stats = _queryStats[qid];
+    QueryStatistics::Ptr stats = getStats(qid);
     if (stats == nullptr) {
-        stats = std::make_shared<QueryStatistics>(qid);
+        std::lock_guard<std::mutex> guardStats(_queryStatsMtx);
+        auto queryStats = _getQueryStats();
+        auto iter = queryStats->find(qid);
+        if (iter != queryStats->end()) {
+            stats = iter->second;
+        } else {
+            stats = std::make_shared<QueryStatistics>(qid);
+            auto newStats = std::make_shared<QueryStatsMap>(*queryStats);
+            (*newStats)[qid] = stats;
+            std::atomic_store(&_queryStats, std::shared_ptr<QueryStatsMap const>(newStats));
+        }
     }
-    guardStats.unlock();
     stats->addTask(task);
 }
 
@@ -110,7 +139,6 @@ void QueriesAndChunks::queuedTask(wbase::Task::Ptr const& task) {
 
     QueryStatistics::Ptr stats = getStats(task->getQueryId());
     if (stats != nullptr) {
-        std::lock_guard<std::mutex>(stats->_qStatsMtx);
         stats->_touched = now;
         stats->_size += 1;
     }
@@ -124,7 +152,6 @@ void QueriesAndChunks::startedTask(wbase::Task::Ptr const& task) {
 
     QueryStatistics::Ptr stats = getStats(task->getQueryId());
     if (stats != nullptr) {
-        std::lock_guard<std::mutex>(stats->_qStatsMtx);
         stats->_touched = now;
         stats->_tasksRunning += 1;
     }
@@ -134,21 +161,17 @@ void QueriesAndChunks::startedTask(wbase::Task::Ptr const& task) {
 /// Update statistics for the Task that finished and the chunk it was querying.
 void QueriesAndChunks::finishedTask(wbase::Task::Ptr const& task) {
     auto now = std::chrono::system_clock::now();
-    double taskDuration = (double)(task->finished(now).count());
+    auto taskDurationMs = task->finished(now).count();
+    double taskDuration = (double)taskDurationMs;
     taskDuration /= 60000.0; // convert to minutes.
 
     QueryId qId = task->getQueryId();
     QueryStatistics::Ptr stats = getStats(qId);
     if (stats != nullptr) {
-        bool mostlyDead = false;
-        {
-            std::lock_guard<std::mutex> gs(stats->_qStatsMtx);
-            stats->_touched = now;
-            stats->_tasksRunning -= 1;
-            stats->_tasksCompleted += 1;
-            stats->_totalTimeMinutes += taskDuration;
-            mostlyDead = stats->_isMostlyDead();
-        }
+        stats->_touched = now;
+        stats->_tasksRunning -= 1;
+        stats->_totalTimeMs += taskDurationMs;
+        bool mostlyDead = (++stats->_tasksCompleted >= stats->_size);
         if (mostlyDead) {
             std::lock_guard<std::mutex> gd(_newlyDeadMtx);
             (*_newlyDeadQueries)[qId] = stats;
@@ -159,29 +182,53 @@ void QueriesAndChunks::finishedTask(wbase::Task::Ptr const& task) {
 }
 
 
-/// Update statistics for the Task that finished and the chunk it was querying.
+/// Record the run time of the Task that finished for the chunk it was querying.
+/// The sample is pushed onto _chunkSamples and added to _chunkStats by the next reader.
 void QueriesAndChunks::_finishedTaskForChunk(wbase::Task::Ptr const& task, double minutes) {
-    std::unique_lock<std::mutex> ul(_chunkMtx);
-    std::pair<int, ChunkStatistics::Ptr> ele(task->getChunkId(), nullptr);
-    auto res = _chunkStats.insert(ele);
-    if (res.second) {
-        res.first->second = std::make_shared<ChunkStatistics>(task->getChunkId());
-    }
-    ul.unlock();
-    auto iter = res.first->second;
     proto::ScanInfo& scanInfo = task->getScanInfo();
     std::string tblName;
     if (!scanInfo.infoTables.empty()) {
         proto::ScanTableInfo& sti = scanInfo.infoTables.at(0);
         tblName = ChunkTableStats::makeTableName(sti.db, sti.table);
     }
-    ChunkTableStats::Ptr tableStats = iter->add(tblName, minutes);
+    auto sample = new ChunkSample{task->getChunkId(), tblName, minutes, _chunkSamples.load()};
+    while (!_chunkSamples.compare_exchange_weak(sample->next, sample)) {}
+}
+
+
+/// Add all samples pushed by finished Tasks to _chunkStats, in the order the Tasks finished.
+/// Precondition, _chunkMtx must be locked.
+void QueriesAndChunks::_foldChunkSamples() {
+    ChunkSample* sample = _chunkSamples.exchange(nullptr);
+    // The stack is newest first, reverse it as the average completion time depends on order.
+    ChunkSample* oldest = nullptr;
+    while (sample != nullptr) {
+        ChunkSample* next = sample->next;
+        sample->next = oldest;
+        oldest = sample;
+        sample = next;
+    }
+    while (oldest != nullptr) {
+        std::unique_ptr<ChunkSample> done(oldest);
+        oldest = oldest->next;
+        ChunkStatistics::Ptr& chunkStats = _chunkStats[done->chunkId];
+        if (chunkStats == nullptr) {
+            chunkStats = std::make_shared<ChunkStatistics>(done->chunkId);
+        }
+        chunkStats->add(done->tableName, done->minutes);
+    }
 }
 
 
 /// Go through the list of possibly dead queries and remove those that are too old.
 void QueriesAndChunks::removeDead() {
-    std::vector<QueryStatistics::Ptr> dList;
+    {
+        // Keeps samples from piling up when nothing else reads the chunk statistics.
+        std::lock_guard<std::mutex> g(_chunkMtx);
+        _foldChunkSamples();
+    }
+
+    std::vector<QueryId> dList;
     auto now = std::chrono::system_clock::now();
     {
         std::shared_ptr<DeadQueriesType> newlyDead;
@@ -203,7 +250,7 @@ void QueriesAndChunks::removeDead() {
             if (statPtr->isDead(_deadAfter, now)) {
                 LOGS(_log, LOG_LVL_DEBUG, QueryIdHelper::makeIdStr(statPtr->_queryId)
                      << " QueriesAndChunks::removeDead added to list");
-                dList.push_back(statPtr);
+                dList.push_back(statPtr->_queryId);
                 iter = _deadQueries.erase(iter);
             } else {
                 ++iter;
@@ -211,9 +258,7 @@ void QueriesAndChunks::removeDead() {
         }
     }
 
-    for (auto const& dead : dList) {
-        removeDead(dead);
-    }
+    _eraseQueryStats(dList);
 }
 
 
@@ -221,20 +266,34 @@ void QueriesAndChunks::removeDead() {
 /// Query Ids should be unique for the life of the system, so erasing
 /// a qId multiple times from _queryStats should be harmless.
 void QueriesAndChunks::removeDead(QueryStatistics::Ptr const& queryStats) {
-    std::unique_lock<std::mutex> gS(queryStats->_qStatsMtx);
-    QueryId qId = queryStats->_queryId;
-    gS.unlock();
-    LOGS(_log, LOG_LVL_DEBUG, QueryIdHelper::makeIdStr(qId) << " Queries::removeDead");
+    _eraseQueryStats({queryStats->_queryId});
+}
+
 
+/// Replace _queryStats with a copy that does not contain 'qIds'.
+void QueriesAndChunks::_eraseQueryStats(std::vector<QueryId> const& qIds) {
+    if (qIds.empty()) return;
     std::lock_guard<std::mutex> gQ(_queryStatsMtx);
-    _queryStats.erase(qId);
+    auto newStats = std::make_shared<QueryStatsMap>(*_getQueryStats());
+    for (auto qId : qIds) {
+        LOGS(_log, LOG_LVL_DEBUG, QueryIdHelper::makeIdStr(qId) << " Queries::removeDead");
+        newStats->erase(qId);
+    }
+    std::atomic_store(&_queryStats, std::shared_ptr<QueryStatsMap const>(newStats));
 }
 
+
+/// @return the current map of user query statistics, which will not change.
+std::shared_ptr<QueriesAndChunks::QueryStatsMap const> QueriesAndChunks::_getQueryStats() const {
+    return std::atomic_load(&_queryStats);
+}
+
+
 /// @return the statistics for a user query.
 QueryStatistics::Ptr QueriesAndChunks::getStats(QueryId const& qId) const {
-    std::lock_guard<std::mutex> g(_queryStatsMtx);
-    auto iter = _queryStats.find(qId);
-    if (iter != _queryStats.end()) {
+    auto queryStats = _getQueryStats();
+    auto iter = queryStats->find(qId);
+    if (iter != queryStats->end()) {
         return iter->second;
     }
     return nullptr;
@@ -249,15 +308,10 @@ void QueriesAndChunks::examineAll() {
     // in each chunk, and their percentage total of the whole.
     auto scanTblSums = _calcScanTableSums();
 
-    // Copy a vector of the Queries in the map and work with the copy
-    // to free up the mutex.
+    // The map of Queries is not modified once published, so it can be used without locking.
     std::vector<QueryStatistics::Ptr> uqs;
-    {
-        std::lock_guard<std::mutex> g(_queryStatsMtx);
-        for (auto const& ele : _queryStats) {
-            auto const& q = ele.second;
-            uqs.push_back(q);
-        }
+    for (auto const& ele : *_getQueryStats()) {
+        uqs.push_back(ele.second);
     }
 
     // Go through all Tasks in each query and examine the running ones.
@@ -333,6 +387,7 @@ QueriesAndChunks::ScanTableSumsMap QueriesAndChunks::_calcScanTableSums() {
     std::vector<ChunkStatistics::Ptr> chks;
     {
         std::lock_guard<std::mutex> g(_chunkMtx);
+        _foldChunkSamples();
         for (auto const& ele : _chunkStats) {
             auto const& chk = ele.second;
             chks.push_back(chk);
@@ -414,18 +469,26 @@ void QueryStatistics::addTask(wbase::Task::Ptr const& task) {
 }
 
 
-/// @return the number of Tasks that have been booted for this user query.
-int QueryStatistics::getTasksBooted() {
+wbase::Task::Usage QueryStatistics::getUsage() const {
     std::lock_guard<std::mutex> guard(_qStatsMtx);
-    return _tasksBooted;
+    return _getUsage();
+}
+
+
+/// Precondition, _qStatsMtx must be locked.
+wbase::Task::Usage QueryStatistics::_getUsage() const {
+    wbase::Task::Usage usage;
+    for (auto const& elem : _taskMap) {
+        usage += elem.second->getUsage();
+    }
+    return usage;
 }
 
 
 /// @return true if this query is done and has not been touched for deadTime.
 bool QueryStatistics::isDead(std::chrono::seconds deadTime, std::chrono::system_clock::time_point now) {
-    std::lock_guard<std::mutex> guard(_qStatsMtx);
     if (_isMostlyDead()) {
-        if (now - _touched > deadTime) {
+        if (now - _touched.load() > deadTime) {
             return true;
         }
     }
@@ -434,7 +497,6 @@ bool QueryStatistics::isDead(std::chrono::seconds deadTime, std::chrono::system_
 
 
 /// @return true if all Tasks for this query are complete.
-/// Precondition, _qStatsMtx must be locked.
 bool QueryStatistics::_isMostlyDead() const {
     return _tasksCompleted >= _size;
 }
@@ -442,11 +504,12 @@ bool QueryStatistics::_isMostlyDead() const {
 std::ostream& operator<<(std::ostream& os, QueryStatistics const& q) {
     std::lock_guard<std::mutex> gd(q._qStatsMtx);
     os << QueryIdHelper::makeIdStr(q._queryId)
-       << " time="           << q._totalTimeMinutes
+       << " time="           << q._totalTimeMs/60000.0
        << " size="           << q._size
        << " tasksCompleted=" << q._tasksCompleted
        << " tasksRunning="   << q._tasksRunning
-       << " tasksBooted="    << q._tasksBooted;
+       << " tasksBooted="    << q._tasksBooted
+       << " "                << q._getUsage();
     return os;
 }
 
@@ -462,13 +525,12 @@ QueriesAndChunks::removeQueryFrom(QueryId const& qId, wsched::SchedulerBase::Ptr
     std::vector<wbase::Task::Ptr> removedList; // Return value;
 
     // Find the user query.
-    std::unique_lock<std::mutex> lock(_queryStatsMtx);
-    auto query = _queryStats.find(qId);
-    if (query == _queryStats.end()) {
+    auto queryStats = _getQueryStats();
+    auto query = queryStats->find(qId);
+    if (query == queryStats->end()) {
         LOGS(_log, LOG_LVL_DEBUG, QueryIdHelper::makeIdStr(qId) << " was not found by removeQueryFrom");
         return removedList;
     }
-    lock.unlock();
 
     // Remove Tasks from their scheduler put them on 'removedList', but only if their Scheduler is the same
     // as 'sched' or if sched == nullptr.
@@ -509,6 +571,74 @@ QueriesAndChunks::removeQueryFrom(QueryId const& qId, wsched::SchedulerBase::Ptr
 }
 
 
+boost::property_tree::ptree QueriesAndChunks::statusJson() {
+    boost::property_tree::ptree queries;
+    boost::property_tree::ptree running;
+    for (auto const& elem : *_getQueryStats()) {
+        auto const& q = elem.second;
+        boost::property_tree::ptree query;
+        query.put("queryId", q->_queryId);
+        query.put("timeMinutes", q->_totalTimeMs/60000.0);
+        query.put("size", q->_size.load());
+        query.put("tasksCompleted", q->_tasksCompleted.load());
+        query.put("tasksRunning", q->_tasksRunning.load());
+        query.put("tasksBooted", q->_tasksBooted.load());
+        query.put("queryBooted", q->_queryBooted.load());
+        std::lock_guard<std::mutex> g(q->_qStatsMtx);
+        wbase::Task::Usage usage;
+        for (auto const& elem : q->_taskMap) {
+            auto const& task = elem.second;
+            usage += task->getUsage();
+            if (task->getState() != wbase::Task::State::RUNNING) continue;
+            boost::property_tree::ptree taskStatus;
+            taskStatus.put("queryId", task->getQueryId());
+            taskStatus.put("jobId", task->getJobId());
+            taskStatus.put("chunkId", task->getChunkId());
+            taskStatus.put("runTimeMs", task->getRunTime().count());
+            running.push_back(std::make_pair("", taskStatus));
+        }
+        query.add_child("usage", usageJson(usage));
+        queries.push_back(std::make_pair("", query));
+    }
+
+    boost::property_tree::ptree status;
+    status.add_child("userQueries", queries);
+    status.add_child("runningTasks", running);
+    return status;
+}
+
+
+boost::property_tree::ptree QueriesAndChunks::chunkStatusJson() {
+    std::vector<ChunkStatistics::Ptr> chunkList;
+    {
+        std::lock_guard<std::mutex> g(_chunkMtx);
+        _foldChunkSamples();
+        for (auto const& elem : _chunkStats) {
+            chunkList.push_back(elem.second);
+        }
+    }
+
+    boost::property_tree::ptree tables;
+    for (auto const& chunk : chunkList) {
+        std::lock_guard<std::mutex> g(chunk->_tStatsMtx);
+        for (auto const& elem : chunk->_tableStats) {
+            auto data = elem.second->getData();
+            boost::property_tree::ptree table;
+            table.put("chunkId", chunk->_chunkId);
+            table.put("table", elem.first);
+            table.put("tasksCompleted", data.tasksCompleted);
+            table.put("tasksBooted", data.tasksBooted);
+            table.put("avgCompletionMinutes", data.avgCompletionTime);
+            tables.push_back(std::make_pair("", table));
+        }
+    }
+
+    boost::property_tree::ptree status;
+    status.add_child("chunkTables", tables);
+    return status;
+}
+
+
 std::ostream& operator<<(std::ostream& os, QueriesAndChunks const& qc) {
     std::lock_guard<std::mutex> g(qc._chunkMtx);
     os << "Chunks(";
@@ -25,6 +25,14 @@
 #define LSST_QSERV_WPUBLISH_QUERIESANDCHUNKS_H
 
 // System headers
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+// Third-party headers
+#include "boost/property_tree/ptree.hpp"
 
 // Qserv headers
 #include "wbase/Task.h"
@@ -47,6 +55,7 @@ class QueriesAndChunks;
 
 
 /// Statistics for a single user query.
+/// The counters are atomic so that Task transitions never wait for readers.
 class QueryStatistics {
 public:
     using Ptr = std::shared_ptr<QueryStatistics>;
@@ -57,26 +66,30 @@ public:
 
     bool isDead(std::chrono::seconds deadTime, std::chrono::system_clock::time_point now);
 
-    int getTasksBooted();
+    int getTasksBooted() { return _tasksBooted; }
     bool getQueryBooted() { return _queryBooted; }
 
+    /// @return the resources used so far by the Tasks of this user query.
+    wbase::Task::Usage getUsage() const;
+
     friend class QueriesAndChunks;
     friend std::ostream& operator<<(std::ostream& os, QueryStatistics const& q);
 
 private:
     bool _isMostlyDead() const;
+    wbase::Task::Usage _getUsage() const;
 
-    mutable std::mutex _qStatsMtx;
+    mutable std::mutex _qStatsMtx; ///< Protects _taskMap.
     QueryId const _queryId;
-    std::chrono::system_clock::time_point _touched{std::chrono::system_clock::now()};
+    std::atomic<std::chrono::system_clock::time_point> _touched{std::chrono::system_clock::now()};
 
-    int _size{0};
-    int _tasksCompleted{0};
-    int _tasksRunning{0};
-    int _tasksBooted{0}; ///< Number of Tasks booted for being too slow.
+    std::atomic<int> _size{0};
+    std::atomic<int> _tasksCompleted{0};
+    std::atomic<int> _tasksRunning{0};
+    std::atomic<int> _tasksBooted{0}; ///< Number of Tasks booted for being too slow.
     std::atomic<bool> _queryBooted{false}; ///< True when the entire query booted.
 
-    double _totalTimeMinutes{0.0};
+    std::atomic<std::int64_t> _totalTimeMs{0}; ///< Sum of the run times of completed Tasks.
 
     std::map<int, wbase::Task::Ptr> _taskMap; ///< Map of Tasks keyed by job id.
 };
@@ -169,6 +182,13 @@ public:
 
     void examineAll();
 
+    /// @return the user queries known to this worker and their Tasks that are running,
+    ///         meant to be written as JSON.
+    boost::property_tree::ptree statusJson();
+
+    /// @return statistics for every scan table in every chunk, meant to be written as JSON.
+    boost::property_tree::ptree chunkStatusJson();
+
     // Figure out each chunkTable's percentage of time.
     // Store average time for a task to run on this table for this chunk.
     struct ChunkTimePercent {
@@ -186,15 +206,34 @@ public:
     friend std::ostream& operator<<(std::ostream& os, QueriesAndChunks const& qc);
 
 private:
+    using QueryStatsMap = std::map<QueryId, QueryStatistics::Ptr>;
+
+    /// Run time of a finished Task that has not been added to _chunkStats yet.
+    struct ChunkSample {
+        int chunkId;
+        std::string tableName;
+        double minutes;
+        ChunkSample* next;
+    };
+
     void _bootTask(QueryStatistics::Ptr const& uq, wbase::Task::Ptr const& task,
                        std::shared_ptr<wsched::SchedulerBase> const& sched);
     ScanTableSumsMap _calcScanTableSums();
     void _finishedTaskForChunk(wbase::Task::Ptr const& task, double minutes);
+    void _foldChunkSamples();
+    std::shared_ptr<QueryStatsMap const> _getQueryStats() const;
+    void _eraseQueryStats(std::vector<QueryId> const& qIds);
+
+    /// Map of Query stats indexed by QueryId. A published map is never modified, readers get
+    /// it with _getQueryStats() and writers replace it with a modified copy.
+    std::shared_ptr<QueryStatsMap const> _queryStats{std::make_shared<QueryStatsMap>()};
+    std::mutex _queryStatsMtx; ///< Serializes writers of _queryStats.
 
-    mutable std::mutex _queryStatsMtx; ///< protects _queryStats;
-    std::map<QueryId, QueryStatistics::Ptr> _queryStats; ///< Map of Query stats indexed by QueryId.
+    /// Samples pushed by finishedTask without locking, newest first. Readers of _chunkStats
+    /// move them into _chunkStats, so Tasks finishing never wait on those readers.
+    std::atomic<ChunkSample*> _chunkSamples{nullptr};
 
-    mutable std::mutex _chunkMtx;
+    mutable std::mutex _chunkMtx; ///< Protects _chunkStats.
     std::map<int, ChunkStatistics::Ptr> _chunkStats;///< Map of Chunk stats indexed by chunk id.
 
     std::weak_ptr<wsched::BlendScheduler> _blendSched; ///< Pointer to the BlendScheduler.
@@ -22,6 +22,15 @@
  */
 /// Test ChunkInventory
 
+// System headers
+#include <atomic>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
 // Third-party headers
 
 // Qserv headers
@@ -34,7 +43,7 @@
 
 namespace test = boost::test_tools;
 using lsst::qserv::sql::MockSql;
-using lsst::qserv::sql::SqlResultIter;
+using lsst::qserv::sql::SqlRowStream;
 using lsst::qserv::sql::SqlErrorObject;
 using lsst::qserv::wpublish::ChunkInventory;
 
@@ -42,53 +51,68 @@ namespace {
 bool startswith(std::string const& a, std::string const& start) {
     return 0 == a.compare(0, start.length(), start);
 }
+
+std::atomic<int> showTablesCount(0);
 }
 
 struct ChunkInvFixture {
     ChunkInvFixture(void) {
+        char dirTemplate[] = "/tmp/testChunkInventory.XXXXXX";
+        tmpDir = ::mkdtemp(dirTemplate);
+        ::mkdir((tmpDir + "/LSST").c_str(), 0700);
+        buildConfig.snapshotPath = tmpDir + "/snapshot";
+        buildConfig.dataDir = tmpDir;
+    };
+    ~ChunkInvFixture(void) {
+        ::unlink(buildConfig.snapshotPath.c_str());
+        ::rmdir((tmpDir + "/LSST").c_str());
+        ::rmdir(tmpDir.c_str());
     };
-    ~ChunkInvFixture(void) {};
 
+    std::string tmpDir;
+    ChunkInventory::BuildConfig buildConfig;
 };
 
 struct ChunkSql : public MockSql {
-    ChunkSql(char const* const* tablesBegin, char const* const* tablesEnd)
+    ChunkSql(char const* const* tablesBegin, char const* const* tablesEnd,
+             std::vector<std::string> const& dbs=std::vector<std::string>(1, "LSST"))
         : _tablesBegin(tablesBegin), _tablesEnd(tablesEnd) {
-        Tuple t;
-        t.push_back("LSST");
-        _selectDbTuples.push_back(t);
-
-    }
-    virtual bool listTables(std::vector<std::string>& v,
-                            SqlErrorObject& errObj,
-                            std::string const& prefixed,
-                            std::string const& dbName) {
-        if (dbName == "LSST") {
-            v.insert(v.begin(), _tablesBegin, _tablesEnd);
-            return true;
-        } else {
-            return false;
+        for (auto const& db : dbs) {
+            _selectDbTuples.push_back(Tuple(1, db));
         }
     }
     virtual std::string getActiveDb() const {
         return std::string("LSST");
     }
-    virtual std::shared_ptr<SqlResultIter> getQueryIter(std::string const& query) {
+    virtual SqlRowStream::Ptr streamQuery(std::string const& query) {
         if (startswith(query, "SELECT db FROM")) {
-            std::shared_ptr<SqlIter> it;
-            it = std::make_shared<SqlIter>(_selectDbTuples.begin(),
-                                           _selectDbTuples.end());
-            return it;
+            return std::make_shared<RowStream>(_selectDbTuples.begin(),
+                                               _selectDbTuples.end());
+        }
+        for (auto const& db : _selectDbTuples) {
+            if (query == "SHOW TABLES FROM `" + db[0] + "`") {
+                ++showTablesCount;
+                _tableTuples.clear();
+                for (char const* const* t = _tablesBegin; t != _tablesEnd; ++t) {
+                    _tableTuples.push_back(Tuple(1, *t));
+                }
+                return std::make_shared<RowStream>(_tableTuples.begin(),
+                                                   _tableTuples.end());
+            }
         }
-        return std::shared_ptr<SqlIter>();
+        auto empty = std::make_shared<RowStream>(_tableTuples.end(),
+                                                 _tableTuples.end());
+        empty->getErrorObject().addErrMsg("Unknown query " + query);
+        return empty;
     }
 
     typedef std::vector<std::string> Tuple;
     typedef std::vector<Tuple> TupleVector;
     typedef TupleVector::const_iterator TupleVectorIter;
-    typedef MockSql::Iter<TupleVectorIter> SqlIter;
+    typedef MockSql::RowStream<TupleVectorIter> RowStream;
 
     TupleVector _selectDbTuples;
+    TupleVector _tableTuples;
     char const* const* _tablesBegin;
     char const* const* _tablesEnd;
 };
@@ -124,4 +148,55 @@ BOOST_AUTO_TEST_CASE(MissingDummy) {
     BOOST_CHECK(!ci.has("LSST", 123));
 
 }
+
+BOOST_AUTO_TEST_CASE(Snapshot) {
+    auto cs = std::make_shared<ChunkSql>(tables, tables+tablesSize);
+    ChunkInventory first("test", cs, buildConfig);
+    BOOST_CHECK_EQUAL(first.getScannedDbCount(), 1u);
+
+    // Unchanged db directory, the snapshot is used even though the tables
+    // listed by the mock have changed.
+    cs = std::make_shared<ChunkSql>(tables, tables+2);
+    int const showTables = showTablesCount;
+    ChunkInventory second("test", cs, buildConfig);
+    BOOST_CHECK_EQUAL(second.getScannedDbCount(), 0u);
+    BOOST_CHECK_EQUAL(showTablesCount, showTables);
+    BOOST_CHECK(second.has("LSST", 31415));
+    BOOST_CHECK(second.has("LSST", 1234567890));
+    BOOST_CHECK(second.has("LSST", 31415, "Source"));
+    BOOST_CHECK(!second.has("LSST", 31415, "Filter"));
+
+    // Another instance doesn't use the snapshot.
+    ChunkInventory other("other", cs, buildConfig);
+    BOOST_CHECK_EQUAL(other.getScannedDbCount(), 1u);
+    BOOST_CHECK(!other.has("LSST", 1234567890));
+
+    // Modifying the db directory makes the db scanned again.
+    ChunkInventory("test", std::make_shared<ChunkSql>(tables, tables+tablesSize), buildConfig);
+    struct timespec times[2] = {{1, 0}, {1, 0}};
+    ::utimensat(AT_FDCWD, (tmpDir + "/LSST").c_str(), times, 0);
+    ChunkInventory third("test", cs, buildConfig);
+    BOOST_CHECK_EQUAL(third.getScannedDbCount(), 1u);
+    BOOST_CHECK(third.has("LSST", 31415));
+    BOOST_CHECK(!third.has("LSST", 1234567890));
+}
+
+BOOST_AUTO_TEST_CASE(ParallelBuild) {
+    std::vector<std::string> dbs;
+    for (int i = 0; i < 10; ++i) {
+        dbs.push_back("Db" + std::to_string(i));
+    }
+    buildConfig.snapshotPath.clear();
+    buildConfig.threads = 4;
+    ChunkInventory ci("test", [&dbs]() {
+            return std::make_shared<ChunkSql>(tables, tables+tablesSize, dbs);
+        }, buildConfig);
+    BOOST_CHECK_EQUAL(ci.getScannedDbCount(), dbs.size());
+    for (auto const& db : dbs) {
+        BOOST_CHECK(ci.has(db, 31415));
+        BOOST_CHECK(ci.has(db, 1234567890, "Object"));
+    }
+    BOOST_CHECK(!ci.has("LSST", 31415));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -38,6 +38,7 @@
 #include <iostream>
 #include <mutex>
 #include <sstream>
+#include <utility>
 
 // LSST headers
 #include "lsst/log/Log.h"
@@ -346,6 +347,31 @@ int BlendScheduler::getInFlight() const {
 }
 
 
+boost::property_tree::ptree BlendScheduler::statusJson() {
+    std::vector<SchedulerBase::Ptr> schedulers;
+    {
+        std::lock_guard<std::mutex> lock(util::CommandQueue::_mx);
+        schedulers = _schedulers;
+    }
+    boost::property_tree::ptree status;
+    status.put("name", getName());
+    status.put("maxThreads", _schedMaxThreads);
+    int inFlight = 0;
+    std::size_t queued = 0;
+    boost::property_tree::ptree subSchedulers;
+    for (auto const& sched : schedulers) {
+        auto subStatus = sched->statusJson();
+        inFlight += subStatus.get<int>("inFlight");
+        queued += subStatus.get<std::size_t>("queued");
+        subSchedulers.push_back(std::make_pair("", subStatus));
+    }
+    status.put("inFlight", inFlight);
+    status.put("queued", queued);
+    status.add_child("schedulers", subSchedulers);
+    return status;
+}
+
+
 void BlendScheduler::_logChunkStatus() {
     if (LOG_CHECK_LVL(_log, LOG_LVL_DEBUG)) {
         std::string str;
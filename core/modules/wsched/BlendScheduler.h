@@ -116,6 +116,9 @@ public:
     bool ready() override;
     int applyAvailableThreads(int tempMax) override { return tempMax;} //< does nothing
 
+    /// @return the state of this scheduler and of all its sub-schedulers.
+    boost::property_tree::ptree statusJson() override;
+
     void setFlagReorderScans() { _flagReorderScans = true; }
     int calcAvailableTheads();
 
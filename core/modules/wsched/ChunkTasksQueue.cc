@@ -392,6 +392,15 @@ ChunkTasks::ReadyState ChunkTasks::ready(bool useFlexibleLock) {
             memman::TableInfo ti(tbl.db + "/" + tbl.table, lckOptTbl, lckOptIdx);
             tblVect.push_back(ti);
         }
+        // Subchunk MEMORY tables are built from the chunk table and its
+        // overlap table, memory for them must be reserved as well. MemMan
+        // scales the data file sizes to the size of the MEMORY tables.
+        memman::TableInfo::LockType const lckOptNone = memman::TableInfo::LockType::NOLOCK;
+        for (auto const& tbl : task->getSubchunkTables()) {
+            std::string const name = tbl.db + "/" + tbl.table;
+            tblVect.emplace_back(name, lckOptNone, lckOptNone, lckOptTbl);
+            tblVect.emplace_back(name + "FullOverlap", lckOptNone, lckOptNone, lckOptTbl);
+        }
         // If tblVect is empty, we should get the empty handle
         memman::MemMan::Handle handle = _memMan->prepare(tblVect, chunkId);
         if (handle == 0) {
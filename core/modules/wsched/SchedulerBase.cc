@@ -24,6 +24,7 @@
 #include "wsched/SchedulerBase.h"
 
 // System headers
+#include <utility>
 
 // LSST headers
 #include "lsst/log/Log.h"
@@ -131,6 +132,31 @@ std::string SchedulerBase::chunkStatusStr() {
 }
 
 
+boost::property_tree::ptree SchedulerBase::statusJson() {
+    boost::property_tree::ptree status;
+    status.put("name", getName());
+    status.put("priority", _priority);
+    status.put("inFlight", getInFlight());
+    status.put("queued", getSize());
+    status.put("maxInFlight", maxInFlight());
+    status.put("maxReserve", _maxReserve);
+    status.put("userQueries", getUserQueriesInQ());
+    status.put("maxActiveChunks", _maxActiveChunks);
+    boost::property_tree::ptree chunks;
+    {
+        std::lock_guard<std::mutex> lock(_countsMutex);
+        for (auto const& entry:_chunkTasks) {
+            boost::property_tree::ptree chunk;
+            chunk.put("chunkId", entry.first);
+            chunk.put("tasks", entry.second);
+            chunks.push_back(std::make_pair("", chunk));
+        }
+    }
+    status.add_child("activeChunks", chunks);
+    return status;
+}
+
+
 void SchedulerBase::setMaxActiveChunks(int maxActive) {
     if (maxActive < 1) maxActive = 1;
     _maxActiveChunks = maxActive;
@@ -102,6 +102,8 @@ public:
 
     std::string chunkStatusStr(); //< @return a string
 
+    boost::property_tree::ptree statusJson() override;
+
     /// Remove task from this scheduler.
     /// @return - If task was still in the queue, return true.
     /// Most schedulers do not support this operation. Currently only supports
@@ -27,6 +27,10 @@
   * @author Daniel L. Wang, SLAC
   */
 
+// System headers
+#include <atomic>
+#include <thread>
+#include <vector>
 
 // LSST headers
 #include "lsst/log/Log.h"
@@ -350,6 +354,30 @@ BOOST_AUTO_TEST_CASE(ChunkDiskMemManNoneTest) {
 }
 
 
+BOOST_AUTO_TEST_CASE(SubchunkFootprint) {
+    auto memMan = std::make_shared<lsst::qserv::memman::MemManNone>(1, false);
+    lsst::qserv::QueryId qIdInc = 1;
+
+    // No subchunked tables, MemManNone grants an empty handle.
+    wsched::ChunkTasks plain(47, memMan);
+    Task::Ptr a47 = makeTask(newTaskMsg(47, qIdInc++, 0));
+    BOOST_CHECK(a47->getSubchunkTables().empty());
+    plain.queTask(a47);
+    BOOST_CHECK(plain.ready(false) == wsched::ChunkTasks::ReadyState::READY);
+
+    // Memory for the subchunk tables must be reserved even though nothing is scanned.
+    wsched::ChunkTasks subchunked(47, memMan);
+    auto taskMsg = newTaskMsg(47, qIdInc++, 0);
+    auto dbTbl = taskMsg->mutable_fragment(0)->mutable_subchunks()->add_dbtbl();
+    dbTbl->set_db("elephant");
+    dbTbl->set_tbl("Object");
+    Task::Ptr b47 = makeTask(taskMsg);
+    BOOST_CHECK_EQUAL(b47->getSubchunkTables().size(), 1u);
+    subchunked.queTask(b47);
+    BOOST_CHECK(subchunked.ready(false) == wsched::ChunkTasks::ReadyState::NO_RESOURCES);
+    BOOST_CHECK(subchunked.ready(true) == wsched::ChunkTasks::ReadyState::READY);
+}
+
 BOOST_AUTO_TEST_CASE(ScanScheduleTest) {
     auto memMan = std::make_shared<lsst::qserv::memman::MemManNone>(1, false);
     wsched::ScanScheduler sched{"ScanSchedA", 2, 1, 0, 20, memMan, 0, 100, oneHr};
@@ -735,6 +763,38 @@ BOOST_AUTO_TEST_CASE(BlendScheduleThreadLimitingTest) {
 }
 
 
+BOOST_AUTO_TEST_CASE(BlendStatusJson) {
+    SchedFixture f;
+    lsst::qserv::QueryId qid = f.qIdInc++;
+    int const fast = lsst::qserv::proto::ScanInfo::Rating::FAST;
+    Task::Ptr t1 = makeTask(newTaskMsgScan(27, fast, qid, 0));
+    Task::Ptr t2 = makeTask(newTaskMsgScan(28, fast, qid, 1));
+    f.queries->addTask(t1);
+    f.queries->addTask(t2);
+    f.blend->queCmd(t1);
+    f.blend->queCmd(t2);
+    auto cmd = f.blend->getCmd(false);
+    BOOST_REQUIRE(cmd != nullptr);
+    f.blend->commandStart(cmd);
+
+    auto status = f.blend->statusJson();
+    BOOST_CHECK_EQUAL(status.get<int>("inFlight"), 1);
+    BOOST_CHECK_EQUAL(status.get<int>("queued"), 1);
+    BOOST_CHECK_EQUAL(status.get_child("schedulers").size(), 4u);
+
+    auto queryStatus = f.queries->statusJson();
+    BOOST_CHECK_EQUAL(queryStatus.get_child("userQueries").size(), 1u);
+    auto const& running = queryStatus.get_child("runningTasks");
+    BOOST_REQUIRE_EQUAL(running.size(), 1u);
+    BOOST_CHECK_EQUAL(running.front().second.get<int>("chunkId"), 27);
+
+    f.blend->commandFinish(cmd);
+    BOOST_CHECK_EQUAL(f.queries->statusJson().get_child("runningTasks").size(), 0u);
+    auto chunkStatus = f.queries->chunkStatusJson();
+    BOOST_CHECK_EQUAL(chunkStatus.get_child("chunkTables").size(), 1u);
+}
+
+
 BOOST_AUTO_TEST_CASE(BlendScheduleQueryRemovalTest) {
     // Test that space is appropriately reserved for each scheduler as Tasks are started and finished.
     // In this case, memMan->lock(..) always returns true (really HandleType::ISEMPTY).
@@ -873,6 +933,76 @@ BOOST_AUTO_TEST_CASE(BlendScheduleQueryBootTaskTest) {
 
 
 
+BOOST_AUTO_TEST_CASE(QueryUsage) {
+    auto queries = std::make_shared<lsst::qserv::wpublish::QueriesAndChunks>(
+            std::chrono::seconds(1), std::chrono::seconds(1), 5);
+    lsst::qserv::QueryId qid = 11;
+    Task::Ptr a = makeTask(newTaskMsgScan(27, 0, qid, 0));
+    Task::Ptr b = makeTask(newTaskMsgScan(28, 0, qid, 1));
+    queries->addTask(a);
+    queries->addTask(b);
+
+    Task::Usage usage;
+    usage.cpuTime = std::chrono::microseconds(1500);
+    usage.rowsReturned = 10;
+    usage.bytesTransmitted = 1000;
+    usage.subchunkBytes = 300;
+    a->addUsage(usage);
+    usage.subchunkBytes = 200;
+    b->addUsage(usage);
+    b->addUsage(usage);
+
+    BOOST_CHECK_EQUAL(b->getUsage().rowsReturned, 20u);
+    auto total = queries->getStats(qid)->getUsage();
+    BOOST_CHECK_EQUAL(total.cpuTime.count(), 4500);
+    BOOST_CHECK_EQUAL(total.rowsReturned, 30u);
+    BOOST_CHECK_EQUAL(total.bytesTransmitted, 3000u);
+    BOOST_CHECK_EQUAL(total.subchunkBytes, 300u);
+    BOOST_CHECK_EQUAL(total.rowsExamined, 0u);
+}
+
+
+BOOST_AUTO_TEST_CASE(QueryStatsConcurrentUpdate) {
+    // Tasks move through their states on several threads while statistics are read.
+    auto queries = std::make_shared<lsst::qserv::wpublish::QueriesAndChunks>(
+            std::chrono::seconds(1), std::chrono::seconds(0), 5);
+    lsst::qserv::QueryId qid = 12;
+    int const fast = lsst::qserv::proto::ScanInfo::Rating::FAST;
+    int const threadCount = 4;
+    int const tasksPerThread = 50;
+    std::atomic<int> done{0};
+    std::vector<std::thread> threads;
+    for (int t=0; t<threadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int j=0; j<tasksPerThread; ++j) {
+                Task::Ptr task = makeTask(newTaskMsgScan(30 + j%3, fast, qid, t*tasksPerThread + j));
+                queries->addTask(task);
+                queries->queuedTask(task);
+                queries->startedTask(task);
+                queries->finishedTask(task);
+            }
+            ++done;
+        });
+    }
+    while (done < threadCount) {
+        queries->statusJson();
+        queries->chunkStatusJson();
+    }
+    for (auto& thrd : threads) thrd.join();
+
+    auto query = queries->statusJson().get_child("userQueries").front().second;
+    BOOST_CHECK_EQUAL(query.get<int>("size"), threadCount*tasksPerThread);
+    BOOST_CHECK_EQUAL(query.get<int>("tasksCompleted"), threadCount*tasksPerThread);
+    BOOST_CHECK_EQUAL(query.get<int>("tasksRunning"), 0);
+    int completed = 0;
+    auto chunkStatus = queries->chunkStatusJson();
+    for (auto const& table : chunkStatus.get_child("chunkTables")) {
+        completed += table.second.get<int>("tasksCompleted");
+    }
+    BOOST_CHECK_EQUAL(completed, threadCount*tasksPerThread);
+}
+
+
 BOOST_AUTO_TEST_CASE(SlowTableHeapTest) {
     wsched::ChunkTasks::SlowTableHeap heap{};
     lsst::qserv::QueryId qIdInc = 1;
@@ -124,7 +124,11 @@ bool SsiProviderServer::Init(XrdSsiLogger* logP,  XrdSsiCluster* clsP,
     // calls either in the data provider and the metadata provider (we can be
     // either one).
     //
-    _chunkInventory.init(x.getName(), workerConfig.getMySqlConfig());
+    wpublish::ChunkInventory::BuildConfig inventoryConfig;
+    inventoryConfig.snapshotPath = workerConfig.getInventorySnapshot();
+    inventoryConfig.dataDir = workerConfig.getMemManLocation();
+    inventoryConfig.threads = workerConfig.getInventoryThreads();
+    _chunkInventory.init(x.getName(), workerConfig.getMySqlConfig(), inventoryConfig);
 
     // If we are a data provider (i.e. xrootd) then we need to get the service
     // object. It will print the exported paths. Otherwise, we need to print
@@ -26,6 +26,7 @@
 
 // System headers
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include <string>
 #include <stdlib.h>
@@ -42,11 +43,13 @@
 #include "memman/MemMan.h"
 #include "memman/MemManNone.h"
 #include "mysql/MySqlConnection.h"
-#include "sql/SqlConnection.h"
+#include "mysql/MySqlConnectionPool.h"
 #include "wbase/Base.h"
 #include "wconfig/WorkerConfig.h"
 #include "wconfig/WorkerConfigError.h"
 #include "wcontrol/Foreman.h"
+#include "wcontrol/HttpMonitor.h"
+#include "wdb/ChunkResultCache.h"
 #include "wpublish/ChunkInventory.h"
 #include "wsched/BlendScheduler.h"
 #include "wsched/FifoScheduler.h"
@@ -67,6 +70,24 @@ void initMDC() {
 }
 int dummyInitMDC = LOG_MDC_INIT(initMDC);
 
+boost::property_tree::ptree memManJson(lsst::qserv::memman::MemMan& memMan) {
+    auto s = memMan.getStatistics();
+    boost::property_tree::ptree pt;
+    pt.put("bytesLockMax", s.bytesLockMax);
+    pt.put("bytesLocked", s.bytesLocked);
+    pt.put("bytesReserved", s.bytesReserved);
+    pt.put("numFSets", s.numFSets);
+    pt.put("numFiles", s.numFiles);
+    pt.put("numReqdFiles", s.numReqdFiles);
+    pt.put("numFlexFiles", s.numFlexFiles);
+    pt.put("numFlexLock", s.numFlexLock);
+    pt.put("numLocks", s.numLocks);
+    pt.put("numErrors", s.numErrors);
+    pt.put("numMapErrors", s.numMapErrors);
+    pt.put("numLokErrors", s.numLokErrors);
+    return pt;
+}
+
 }
 
 namespace lsst {
@@ -82,7 +103,7 @@ SsiService::SsiService(XrdSsiLogger* log, wconfig::WorkerConfig const& workerCon
         LOGS(_log, LOG_LVL_FATAL, "Unable to connect to MySQL using configuration:" << _mySqlConfig);
         throw wconfig::WorkerConfigError("Unable to connect to MySQL");
     }
-    _initInventory();
+    _initInventory(workerConfig);
 
     std::string cfgMemMan = workerConfig.getMemManClass();
     memman::MemMan::Ptr memMan;
@@ -91,7 +112,8 @@ SsiService::SsiService(XrdSsiLogger* log, wconfig::WorkerConfig const& workerCon
         uint64_t memManSize = workerConfig.getMemManSizeMb()*1000000;
         LOGS(_log, LOG_LVL_DEBUG, "Using MemManReal with memManSizeMb=" << workerConfig.getMemManSizeMb() 
             << " location=" <<  workerConfig.getMemManLocation());
-        memMan = std::shared_ptr<memman::MemMan>(memman::MemMan::create(memManSize, workerConfig.getMemManLocation()));
+        memMan = std::shared_ptr<memman::MemMan>(memman::MemMan::create(memManSize, workerConfig.getMemManLocation(),
+                                                                        workerConfig.getMemManCopyPercent()));
     } else if (cfgMemMan == "MemManNone"){
         memMan = std::make_shared<memman::MemManNone>(1, false);
     } else {
@@ -146,8 +168,41 @@ SsiService::SsiService(XrdSsiLogger* log, wconfig::WorkerConfig const& workerCon
     unsigned int requiredTasksCompleted = workerConfig.getRequiredTasksCompleted();
     queries->setRequiredTasksCompleted(requiredTasksCompleted);
 
+    uint64_t resultCacheSize = workerConfig.getResultCacheSizeMb()*1000000;
+    LOGS(_log, LOG_LVL_DEBUG, "Chunk result cache size=" << resultCacheSize);
+    auto resultCache = std::make_shared<wdb::ChunkResultCache>(resultCacheSize);
+
+    mysql::MySqlConnectionPool::Ptr connectionPool;
+    if (workerConfig.getMySqlPoolMaxIdle() > 0) {
+        mysql::MySqlConnectionPool::Config poolConfig;
+        poolConfig.maxIdle = workerConfig.getMySqlPoolMaxIdle();
+        poolConfig.idleTimeout = std::chrono::seconds(workerConfig.getMySqlPoolIdleTimeout());
+        connectionPool = mysql::MySqlConnectionPool::create(poolConfig);
+    }
+
     _foreman = std::make_shared<wcontrol::Foreman>(
-            blendSched, poolSize, workerConfig.getMySqlConfig(), queries);
+            blendSched, poolSize, workerConfig.getMySqlConfig(), queries, resultCache,
+            connectionPool, workerConfig.getMySqlCountRowsExamined());
+
+    if (workerConfig.getMonitorPort() != 0) {
+        auto foreman = _foreman;
+        auto status = [foreman, memMan]() {
+            auto tree = foreman->statusJson();
+            tree.add_child("memMan", memManJson(*memMan));
+            return tree;
+        };
+        auto chunkStatus = [foreman]() { return foreman->chunkStatusJson(); };
+        try {
+            _monitor = std::make_shared<wcontrol::HttpMonitor>(
+                    workerConfig.getMonitorPort(),
+                    std::chrono::milliseconds(workerConfig.getMonitorPeriodMs()),
+                    status, chunkStatus);
+        } catch (boost::system::system_error const& e) {
+            // The worker is still useful without monitoring.
+            LOGS(_log, LOG_LVL_ERROR, "Unable to start HttpMonitor on port "
+                 << workerConfig.getMonitorPort() << " " << e.what());
+        }
+    }
 }
 
 SsiService::~SsiService() {
@@ -162,15 +217,20 @@ void SsiService::Provision(XrdSsiService::Resource* r,
     r->ProvisionDone(session); // Step 3: trigger client-side ProvisionDone()
 }
 
-void SsiService::_initInventory() {
+void SsiService::_initInventory(wconfig::WorkerConfig const& workerConfig) {
     XrdName x;
     if (not _mySqlConfig.dbName.empty()) {
         LOGS(_log, LOG_LVL_FATAL, "dbName must be empty to prevent accidental context");
         throw std::runtime_error("dbName must be empty to prevent accidental context");
     }
-    auto conn = std::make_shared<sql::SqlConnection>(_mySqlConfig, true);
-    assert(conn);
-    _chunkInventory = std::make_shared<wpublish::ChunkInventory>(x.getName(), conn);
+    // The provider has normally just written the snapshot, so this only
+    // scans databases modified in between.
+    wpublish::ChunkInventory::BuildConfig inventoryConfig;
+    inventoryConfig.snapshotPath = workerConfig.getInventorySnapshot();
+    inventoryConfig.dataDir = workerConfig.getMemManLocation();
+    inventoryConfig.threads = workerConfig.getInventoryThreads();
+    _chunkInventory = std::make_shared<wpublish::ChunkInventory>();
+    _chunkInventory->init(x.getName(), _mySqlConfig, inventoryConfig);
     std::ostringstream os;
     os << "Paths exported: ";
     _chunkInventory->dbgPrint(os);
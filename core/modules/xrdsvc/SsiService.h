@@ -41,6 +41,7 @@ namespace lsst {
 namespace qserv {
 namespace wcontrol {
   class Foreman;
+  class HttpMonitor;
 }
 namespace wpublish {
   class ChunkInventory;
@@ -72,11 +73,12 @@ public:
                            bool userConn=false) override;
 
 private:
-    void _initInventory();
+    void _initInventory(wconfig::WorkerConfig const& workerConfig);
     void _configure();
 
     std::shared_ptr<wpublish::ChunkInventory> _chunkInventory;
     std::shared_ptr<wcontrol::Foreman> _foreman;
+    std::shared_ptr<wcontrol::HttpMonitor> _monitor; ///< May be null if monitoring is disabled.
 
     mysql::MySqlConfig const _mySqlConfig;
 